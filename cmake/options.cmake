@@ -27,6 +27,7 @@ option(ENABLE_SYM_FILE "enable sym file" OFF)
 option(BUILD_DEV_MODE "MindSpore build nightly dev mode" OFF)
 option(ENABLE_FAST_HASH_TABLE "Enable use fast hash table instead of std ones" ON)
 option(USE_LLVM "use llvm" OFF)
+option(ENABLE_CPU_NATIVE_FUSION "Enable cpu elementwise graph kernel fusion without akg" OFF)
 option(USE_MS_THREADPOOL_FOR_DNNL "use ms threadpool for onednn ops" ON)
 
 if(NOT CMAKE_SYSTEM_NAME MATCHES "Linux")
@@ -158,6 +159,14 @@ endif()
 
 if(ENABLE_AKG AND CMAKE_SYSTEM_NAME MATCHES "Linux")
     add_compile_definitions(ENABLE_AKG)
+    set(ENABLE_GRAPH_KERNEL ON)
+    add_compile_definitions(ENABLE_GRAPH_KERNEL)
+endif()
+
+if(ENABLE_CPU_NATIVE_FUSION AND ENABLE_CPU AND CMAKE_SYSTEM_NAME MATCHES "Linux")
+    add_compile_definitions(ENABLE_CPU_NATIVE_FUSION)
+else()
+    set(ENABLE_CPU_NATIVE_FUSION OFF)
 endif()
 
 if(USE_LLVM)
@@ -26,12 +26,14 @@
 #include "runtime/device/kernel_runtime.h"
 #include "plugin/device/cpu/kernel/akg/akg_cpu_kernel_build.h"
 #include "plugin/device/cpu/kernel/cpu_kernel_factory.h"
+#include "plugin/device/cpu/kernel/fused_elemwise_cpu_kernel.h"
 #include "plugin/device/cpu/hal/device/kernel_select_cpu.h"
 #include "backend/common/optimizer/optimizer.h"
 #include "backend/common/optimizer/pass_manager.h"
 #include "plugin/device/cpu/optimizer/insert_cast_cpu.h"
 #include "plugin/device/cpu/optimizer/insert_format_transform_op.h"
 #include "common/graph_kernel/adapter/graph_kernel_optimization.h"
+#include "common/graph_kernel/adapter/cpu_native_fusion_optimization.h"
 #include "backend/common/pass/replace_node_by_proxy.h"
 #include "backend/common/pass/erase_visit_attr.h"
 #include "debug/anf_ir_dump.h"
@@ -106,11 +108,15 @@ void CPUSession::Optimize(const std::shared_ptr<KernelGraph> &kernel_graph) {
 }
 
 void CPUSession::GraphKernelOptimize(const std::shared_ptr<KernelGraph> &kernel_graph) {
-#ifdef ENABLE_AKG
+#if defined(ENABLE_GRAPH_KERNEL) || defined(ENABLE_CPU_NATIVE_FUSION)
   if (!graphkernel::GraphKernelFlags::GetInstance().IsEnableGraphKernel()) {
     return;
   }
+#ifdef ENABLE_GRAPH_KERNEL
   graphkernel::GraphKernelOptimize(kernel_graph);
+#else
+  graphkernel::CpuNativeFusionOptimize(kernel_graph);
+#endif
   kernel_graph->SetExecOrderByDefault();
 #endif
 }
@@ -365,15 +371,20 @@ void CPUSession::BuildKernel(const KernelGraph *kernel_graph) {
     MS_EXCEPTION_IF_NULL(kernel_node);
     std::string kernel_name = AnfAlgo::GetCNodeName(kernel_node);
     MS_LOG(INFO) << "Cpu building operator[" << kernel_name << "].";
+    std::shared_ptr<kernel::NativeCpuKernelMod> cpu_kernel_mod;
     if (session::AnfRuntimeAlgorithm::GetKernelType(kernel_node) == KernelType::AKG_KERNEL) {
-      if (!bin_map->initialized()) {
-        bin_map->Initialize();
+      // Elementwise clusters run natively, only the others need AKG code generation.
+      if (!kernel::FusedElemwiseCpuKernelMod::IsSupported(kernel_node)) {
+        if (!bin_map->initialized()) {
+          bin_map->Initialize();
+        }
+        akg_nodes.push_back(kernel_node);
+        continue;
       }
-      akg_nodes.push_back(kernel_node);
-      continue;
+      cpu_kernel_mod = std::make_shared<kernel::FusedElemwiseCpuKernelMod>();
+    } else {
+      cpu_kernel_mod = kernel::NativeCpuKernelModFactory::GetInstance().Create(kernel_name, kernel_node);
     }
-    std::shared_ptr<kernel::NativeCpuKernelMod> cpu_kernel_mod =
-      kernel::NativeCpuKernelModFactory::GetInstance().Create(kernel_name, kernel_node);
     if (cpu_kernel_mod == nullptr) {
       KernelNotSupportException(kernel_node);
     }
@@ -388,6 +399,11 @@ void CPUSession::BuildKernel(const KernelGraph *kernel_graph) {
 #ifdef ENABLE_AKG
   kernel::AkgCpuKernelBuilder akg_cpu_kernel_builder;
   (void)akg_cpu_kernel_builder.AkgKernelParallelBuild(akg_nodes);
+#else
+  if (!akg_nodes.empty()) {
+    MS_LOG(EXCEPTION) << "Graph kernel " << akg_nodes[0]->fullname_with_scope()
+                      << " needs AKG, but MindSpore is built without AKG.";
+  }
 #endif
 }
 }  // namespace session
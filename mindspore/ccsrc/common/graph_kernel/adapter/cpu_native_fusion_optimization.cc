@@ -0,0 +1,125 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "common/graph_kernel/adapter/cpu_native_fusion_optimization.h"
+
+#include <vector>
+#include <memory>
+
+#include "ir/func_graph.h"
+#include "utils/context/graph_kernel_flags.h"
+#include "common/graph_kernel/core/graph_kernel_cluster.h"
+#include "common/graph_kernel/core/eliminate_redundant_output.h"
+#include "common/graph_kernel/adapter/graph_kernel_splitter_with_py.h"
+#include "common/graph_kernel/adapter/graph_kernel_expander_with_py.h"
+#include "common/graph_kernel/graph_kernel_cse.h"
+#include "common/graph_kernel/core/shape_ops_splitter.h"
+#include "common/graph_kernel/value_graph_binder.h"
+#include "common/graph_kernel/core/update_state_formatter.h"
+#include "backend/common/pass/getitem_tuple.h"
+#include "backend/common/pass/common_subexpression_elimination.h"
+#include "common/graph_kernel/adapter/graph_kernel_pass_manager.h"
+#include "common/graph_kernel/rewrite_output_shape.h"
+#include "common/graph_kernel/depend_elimination.h"
+#include "common/graph_kernel/core/graph_kernel_utils.h"
+
+namespace mindspore::graphkernel {
+using opt::CommonSubexpressionElimination;
+using opt::GetitemTuple;
+using opt::GraphOptimizer;
+
+PassManagerPtr CpuNativeFusionOptimizer::PreProcess() const {
+  auto pm = std::make_shared<GraphKernelPassManager>(0, "preprocess");
+  // Do DependElimination all passes of graphkernel
+  pm->AddPass(std::make_shared<DependElimination>(), OptLevel_1);
+
+  // Do cse before all passes of graphkernel
+  pm->AddPass(std::make_shared<CommonSubexpressionElimination>("cse1"), OptLevel_1);
+
+  // Save the original output info
+  pm->AddPass(std::make_shared<SaveOutputShape>(), OptLevel_1);
+
+  // Spread the MakeTuple input of UpdateState
+  pm->AddPass(std::make_shared<SpreadUpdateState>(), OptLevel_1);
+  // Eliminate the common nodes that generated in SpreadUpdateState
+  pm->AddPass(std::make_shared<CommonSubexpressionElimination>("cse2"), OptLevel_1);
+  return pm;
+}
+
+PassManagerPtr CpuNativeFusionOptimizer::Cluster() const {
+  auto pm = std::make_shared<GraphKernelPassManager>(1, "cluster");
+
+  // Expand complex basic kernels to composite kernels, limited by the flag enable_cpu_native_fusion
+  pm->AddPass(std::make_shared<GraphKernelExpanderWithPy>(), OptLevel_1);
+
+  // Cluster basic kernels and composite kernels
+  pm->AddPass(std::make_shared<GraphKernelCluster>(), OptLevel_1);
+
+  // Eliminate the outputs without external user
+  pm->AddPass(std::make_shared<EliminateRedundantOutput>(), OptLevel_1);
+  return pm;
+}
+
+PassManagerPtr CpuNativeFusionOptimizer::Split() const {
+  auto pm = std::make_shared<GraphKernelPassManager>(2, "split");
+  // Make certain nodes redundant so that they are used by only one user,
+  // which can avoid unnecessary input-output and get better performance.
+  // preprocess for ShapeOpsSplitter
+  pm->AddPass(std::make_shared<ExtendOutputForUpdateState>(), OptLevel_1);
+  std::vector<PrimitivePtr> duplicated_ops = {prim::kPrimReshape};
+  pm->AddPass(std::make_shared<ShapeOpsSplitter>(duplicated_ops), OptLevel_1);
+
+  // Split kernel according to costmodel
+  pm->AddPass(std::make_shared<GraphKernelSplitterWithPy>(), OptLevel_1);
+
+  // After Splitter, a lot of redundant getitem/maketuple
+  // will be exposed, use GetitemTuple Pass to delete them.
+  pm->AddPass(std::make_shared<GetitemTuple>(), OptLevel_1);
+
+  // Eliminate the redundant node that is copied above but not handled by GraphKernelSplitter
+  pm->AddPass(std::make_shared<MergeOutputForUpdateState>(), OptLevel_1);
+  pm->AddPass(std::make_shared<GraphKernelCSE>(), OptLevel_1);
+  pm->AddPass(std::make_shared<EliminateRedundantOutput>(), OptLevel_1);
+  return pm;
+}
+
+PassManagerPtr CpuNativeFusionOptimizer::PostProcess() const {
+  auto pm = std::make_shared<GraphKernelPassManager>(3, "postprocess");
+  // Make Tuple for the inputs of UpdateState. (the reverse of SpreadUpdateState)
+  pm->AddPass(std::make_shared<ShrinkUpdateState>(), OptLevel_1);
+
+  // Recover the original output info
+  pm->AddPass(std::make_shared<GetitemTuple>(), OptLevel_1);
+  pm->AddPass(std::make_shared<RewriteOutputShape>(), OptLevel_1);
+
+  // Add the new tensors to the kernel_graph
+  pm->AddPass(std::make_shared<BindValueToGraph>(), OptLevel_1);
+  return pm;
+}
+
+void CpuNativeFusionOptimizer::Run(const KernelGraphPtr &kernel_graph) {
+  auto optimizer = std::make_shared<GraphOptimizer>("cpu_native_fusion_optimizer");
+  optimizer->AddPassManager(PreProcess());
+  optimizer->AddPassManager(Cluster());
+  optimizer->AddPassManager(Split());
+  optimizer->AddPassManager(PostProcess());
+
+  auto mng = GkUtils::GetFuncGraphManager(kernel_graph);
+  GkUtils::UpdateFuncGraphManager(mng, kernel_graph);
+  (void)optimizer->Optimize(kernel_graph);
+}
+
+void CpuNativeFusionOptimize(const KernelGraphPtr &kernel_graph) { CpuNativeFusionOptimizer().Run(kernel_graph); }
+}  // namespace mindspore::graphkernel
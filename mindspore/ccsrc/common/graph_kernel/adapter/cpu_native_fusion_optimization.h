@@ -0,0 +1,45 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_BACKEND_OPTIMIZER_GRAPH_KERNEL_ADAPTER_CPU_NATIVE_FUSION_OPTIMIZATION_H_
+#define MINDSPORE_CCSRC_BACKEND_OPTIMIZER_GRAPH_KERNEL_ADAPTER_CPU_NATIVE_FUSION_OPTIMIZATION_H_
+
+#include "ir/anf.h"
+#include "ir/func_graph.h"
+#include "backend/common/session/kernel_graph.h"
+#include "backend/common/optimizer/optimizer.h"
+#include "backend/common/optimizer/pass_manager.h"
+
+namespace mindspore::graphkernel {
+using opt::PassManagerPtr;
+// The graph kernel passes for cpu builds without AKG, the clusters run in the fused elementwise cpu kernel.
+class CpuNativeFusionOptimizer {
+ public:
+  void Run(const KernelGraphPtr &kernel_graph);
+
+ private:
+  // Pre-process
+  PassManagerPtr PreProcess() const;
+  // Cluster kernels
+  PassManagerPtr Cluster() const;
+  // Split kernels
+  PassManagerPtr Split() const;
+  // Post-process
+  PassManagerPtr PostProcess() const;
+};
+
+void CpuNativeFusionOptimize(const KernelGraphPtr &kernel_graph);
+}  // namespace mindspore::graphkernel
+#endif  // MINDSPORE_CCSRC_BACKEND_OPTIMIZER_GRAPH_KERNEL_ADAPTER_CPU_NATIVE_FUSION_OPTIMIZATION_H_
@@ -110,6 +110,30 @@ std::vector<PrimitivePtr> GraphKernelCluster::GetClusterableOpList() {
     {kCPUDevice, OpLevel_0, prim::kPrimLessEqual},
   };
   const auto &flags = GraphKernelFlags::GetInstance();
+  if (flags.enable_cpu_native_fusion) {
+    // The operators that the fused elementwise cpu kernel runs without AKG.
+    clusterable_ops_with_level = {
+      {kCPUDevice, OpLevel_0, prim::kPrimAbs},
+      {kCPUDevice, OpLevel_0, prim::kPrimAdd},
+      {kCPUDevice, OpLevel_0, prim::kPrimDiv},
+      {kCPUDevice, OpLevel_0, prim::kPrimErf},
+      {kCPUDevice, OpLevel_0, prim::kPrimExp},
+      {kCPUDevice, OpLevel_0, prim::kPrimLog},
+      {kCPUDevice, OpLevel_0, prim::kPrimMaximum},
+      {kCPUDevice, OpLevel_0, prim::kPrimMinimum},
+      {kCPUDevice, OpLevel_0, prim::kPrimMul},
+      {kCPUDevice, OpLevel_0, prim::kPrimNeg},
+      {kCPUDevice, OpLevel_0, prim::kPrimRealDiv},
+      {kCPUDevice, OpLevel_0, prim::kPrimReciprocal},
+      {kCPUDevice, OpLevel_0, prim::kPrimRelu},
+      {kCPUDevice, OpLevel_0, prim::kPrimRsqrt},
+      {kCPUDevice, OpLevel_0, prim::kPrimSigmoid},
+      {kCPUDevice, OpLevel_0, prim::kPrimSqrt},
+      {kCPUDevice, OpLevel_0, prim::kPrimSquare},
+      {kCPUDevice, OpLevel_0, prim::kPrimSub},
+      {kCPUDevice, OpLevel_0, prim::kPrimTanh},
+    };
+  }
   return GkUtils::GetValidOps(clusterable_ops_with_level, flags.fusion_ops_level, flags.enable_cluster_ops_only,
                               flags.enable_cluster_ops, flags.disable_cluster_ops);
 }
@@ -89,6 +89,14 @@ std::vector<PrimitivePtr> GetExpandOps() {
     {kCPUDevice, OpLevel_1, prim::kPrimSoftplusGrad},
   };
   const auto &flags = GraphKernelFlags::GetInstance();
+  if (flags.enable_cpu_native_fusion) {
+    // The operators expanded only into operators that the fused elementwise cpu kernel runs without AKG.
+    expand_ops_with_level = {
+      {kCPUDevice, OpLevel_0, prim::kPrimAddN},
+      {kCPUDevice, OpLevel_0, prim::kPrimBiasAdd},
+      {kCPUDevice, OpLevel_0, prim::kPrimGeLU},
+    };
+  }
   return GkUtils::GetValidOps(expand_ops_with_level, flags.fusion_ops_level, flags.enable_expand_ops_only,
                               flags.enable_expand_ops, flags.disable_expand_ops);
 }
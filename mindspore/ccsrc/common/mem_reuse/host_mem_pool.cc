@@ -0,0 +1,180 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "common/mem_reuse/host_mem_pool.h"
+#include <algorithm>
+#include <cstdlib>
+#if !defined(_WIN32) && !defined(_WIN64)
+#include <sys/mman.h>
+#endif
+#include "utils/log_adapter.h"
+
+namespace mindspore {
+namespace device {
+namespace {
+// The minimum size class is one page.
+constexpr size_t kMinClassSize = 4096;
+// The maximum size class, the larger host memory can't be allocated.
+constexpr size_t kMaxClassSize = static_cast<size_t>(1) << 40;
+// The number of size classes between two powers of two.
+constexpr size_t kClassNumPerPowerOfTwo = 4;
+// The host memory is mapped in the alignment of huge page, so the kernel can back it by the transparent huge pages.
+constexpr size_t kHugePageSize = 2 << 20;
+
+void *MapHostMem(size_t size) {
+#if defined(_WIN32) || defined(_WIN64)
+  return malloc(size);
+#else
+  // Map more than the size to align the start address to the huge page, and unmap the head and tail.
+  auto map_size = size + kHugePageSize;
+  auto addr = mmap(nullptr, map_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (addr == MAP_FAILED) {
+    return nullptr;
+  }
+  auto map_start = reinterpret_cast<uintptr_t>(addr);
+  auto aligned_start = (map_start + kHugePageSize - 1) / kHugePageSize * kHugePageSize;
+  auto map_end = map_start + map_size;
+  auto aligned_end = aligned_start + size;
+  if (aligned_start > map_start) {
+    (void)munmap(addr, aligned_start - map_start);
+  }
+  if (map_end > aligned_end) {
+    (void)munmap(reinterpret_cast<void *>(aligned_end), map_end - aligned_end);
+  }
+#ifdef MADV_HUGEPAGE
+  (void)madvise(reinterpret_cast<void *>(aligned_start), size, MADV_HUGEPAGE);
+#endif
+  return reinterpret_cast<void *>(aligned_start);
+#endif
+}
+
+void UnmapHostMem(void *addr, size_t size) {
+#if defined(_WIN32) || defined(_WIN64)
+  free(addr);
+#else
+  if (munmap(addr, size) != 0) {
+    MS_LOG(ERROR) << "Unmap the host memory[" << addr << "] size[" << size << "] failed.";
+  }
+#endif
+}
+}  // namespace
+
+HostMemPool::HostMemPool() {
+  // The size classes in (2^k, 2^(k+1)] are 2^k + 2^k * i / kClassNumPerPowerOfTwo, i = 1, ..., kClassNumPerPowerOfTwo.
+  class_sizes_.push_back(kMinClassSize);
+  for (size_t power_size = kMinClassSize; power_size < kMaxClassSize; power_size <<= 1) {
+    for (size_t i = 1; i <= kClassNumPerPowerOfTwo; ++i) {
+      class_sizes_.push_back(power_size + power_size / kClassNumPerPowerOfTwo * i);
+    }
+  }
+  idle_host_mem_bufs_.resize(class_sizes_.size());
+}
+
+size_t HostMemPool::SizeClassIndex(size_t size) const {
+  const auto &iter = std::lower_bound(class_sizes_.begin(), class_sizes_.end(), size);
+  if (iter == class_sizes_.end()) {
+    MS_LOG(EXCEPTION) << "The host memory size[" << size << "] exceeds the maximum size[" << kMaxClassSize << "].";
+  }
+  return static_cast<size_t>(iter - class_sizes_.begin());
+}
+
+void *HostMemPool::AllocHostMem(size_t size) {
+  auto class_index = SizeClassIndex(std::max(size, kMinClassSize));
+  auto class_size = class_sizes_[class_index];
+  std::lock_guard<std::mutex> locker(mutex_);
+  void *host_addr = nullptr;
+  auto &idle_bufs = idle_host_mem_bufs_[class_index];
+  if (!idle_bufs.empty()) {
+    host_addr = idle_bufs.back();
+    idle_bufs.pop_back();
+  } else if (class_size <= HOST_MEM_SLAB_MAX_CLASS_SIZE) {
+    host_addr = AllocFromSlab(class_index);
+  } else {
+    host_addr = MapHostMem(class_size);
+    if (host_addr != nullptr) {
+      (void)host_mem_mappings_.emplace_back(HostMemMapping{host_addr, class_size});
+      total_mem_size_ += class_size;
+    }
+  }
+  if (host_addr == nullptr) {
+    MS_LOG(ERROR) << "Alloc host memory failed, size[" << size << "], total host memory size[" << total_mem_size_
+                  << "], used host memory size[" << total_used_mem_size_ << "].";
+    return nullptr;
+  }
+  (void)used_host_mem_bufs_.emplace(host_addr, class_index);
+  total_used_mem_size_ += class_size;
+  return host_addr;
+}
+
+void *HostMemPool::AllocFromSlab(size_t class_index) {
+  auto class_size = class_sizes_[class_index];
+  if (slab_rest_size_ < class_size) {
+    // Cache the rest of current slab in the size classes, from the large to the small.
+    while (slab_rest_size_ >= kMinClassSize) {
+      auto rest_index = SizeClassIndex(slab_rest_size_);
+      if (class_sizes_[rest_index] > slab_rest_size_) {
+        --rest_index;
+      }
+      idle_host_mem_bufs_[rest_index].push_back(slab_cur_addr_);
+      slab_cur_addr_ += class_sizes_[rest_index];
+      slab_rest_size_ -= class_sizes_[rest_index];
+    }
+    auto slab_addr = MapHostMem(HOST_MEM_SLAB_SIZE);
+    if (slab_addr == nullptr) {
+      return nullptr;
+    }
+    (void)host_mem_mappings_.emplace_back(HostMemMapping{slab_addr, HOST_MEM_SLAB_SIZE});
+    total_mem_size_ += HOST_MEM_SLAB_SIZE;
+    slab_cur_addr_ = static_cast<uint8_t *>(slab_addr);
+    slab_rest_size_ = HOST_MEM_SLAB_SIZE;
+  }
+  auto host_addr = slab_cur_addr_;
+  slab_cur_addr_ += class_size;
+  slab_rest_size_ -= class_size;
+  return host_addr;
+}
+
+void HostMemPool::FreeHostMem(void *host_addr) {
+  MS_EXCEPTION_IF_NULL(host_addr);
+  std::lock_guard<std::mutex> locker(mutex_);
+  const auto &iter = used_host_mem_bufs_.find(host_addr);
+  if (iter == used_host_mem_bufs_.end()) {
+    MS_LOG(ERROR) << "Can't find the host address[" << host_addr << "] in the host memory pool.";
+    return;
+  }
+  auto class_index = iter->second;
+  (void)used_host_mem_bufs_.erase(iter);
+  idle_host_mem_bufs_[class_index].push_back(host_addr);
+  total_used_mem_size_ -= class_sizes_[class_index];
+}
+
+void HostMemPool::ReleaseHostRes() {
+  std::lock_guard<std::mutex> locker(mutex_);
+  for (auto &host_mem_mapping : host_mem_mappings_) {
+    UnmapHostMem(host_mem_mapping.addr_, host_mem_mapping.size_);
+  }
+  host_mem_mappings_.clear();
+  for (auto &idle_bufs : idle_host_mem_bufs_) {
+    idle_bufs.clear();
+  }
+  used_host_mem_bufs_.clear();
+  slab_cur_addr_ = nullptr;
+  slab_rest_size_ = 0;
+  total_mem_size_ = 0;
+  total_used_mem_size_ = 0;
+}
+}  // namespace device
+}  // namespace mindspore
@@ -0,0 +1,91 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_COMMON_MEM_REUSE_HOST_MEM_POOL_H_
+#define MINDSPORE_CCSRC_COMMON_MEM_REUSE_HOST_MEM_POOL_H_
+
+#include <cstdint>
+#include <vector>
+#include <mutex>
+#include "utils/hash_map.h"
+
+namespace mindspore {
+namespace device {
+// The size of host memory slab, which is carved into the host memory bufs of small size classes.
+static const size_t HOST_MEM_SLAB_SIZE = 64 << 20;
+
+// The maximum size class carved from the slabs, the larger host memory buf is mapped alone.
+static const size_t HOST_MEM_SLAB_MAX_CLASS_SIZE = 4 << 20;
+
+// The host memory pool of the swap and offload staging memory, which is shared by the memory managers of all the
+// devices and graphs in the process. The memory size is rounded up to the size classes, there are four size classes
+// between two powers of two, so the wasted memory of one buf is less than a quarter. The host memory bufs of small size
+// classes are carved from the large slabs backed by the huge pages, and the freed host memory bufs are cached in the
+// size class for the later memory alloc. The host memory isn't initialized to zero.
+class HostMemPool {
+ public:
+  static HostMemPool &GetInstance() {
+    static HostMemPool instance;
+    return instance;
+  }
+
+  // The host memory is not initialized, return nullptr when the host memory is not enough.
+  void *AllocHostMem(size_t size);
+  void FreeHostMem(void *host_addr);
+  // Release all the host memory, the host memory bufs which are not freed are invalid.
+  void ReleaseHostRes();
+
+  // The host memory mapped from the system.
+  size_t TotalMemStatistics() const { return total_mem_size_; }
+  // The host memory in use, counted by the size classes.
+  size_t TotalUsedMemStatistics() const { return total_used_mem_size_; }
+
+ private:
+  HostMemPool();
+  ~HostMemPool() { ReleaseHostRes(); }
+  HostMemPool(const HostMemPool &) = delete;
+  HostMemPool &operator=(const HostMemPool &) = delete;
+
+  struct HostMemMapping {
+    void *addr_;
+    size_t size_;
+  };
+
+  // Return the index of the smallest size class which is not smaller than the size.
+  size_t SizeClassIndex(size_t size) const;
+  // Carve the host memory buf of size class from the current slab, and add the new slab when the rest is not enough.
+  void *AllocFromSlab(size_t class_index);
+
+  std::mutex mutex_;
+  // The sizes of the size classes from small to large.
+  std::vector<size_t> class_sizes_;
+  // The cached idle host memory bufs of each size class.
+  std::vector<std::vector<void *>> idle_host_mem_bufs_;
+  // The size class index of the host memory bufs in use.
+  mindspore::HashMap<void *, size_t> used_host_mem_bufs_;
+  // All the host memory mapped from the system, including the slabs and the large host memory bufs.
+  std::vector<HostMemMapping> host_mem_mappings_;
+  // The rest of current slab to be carved.
+  uint8_t *slab_cur_addr_{nullptr};
+  size_t slab_rest_size_{0};
+
+  size_t total_mem_size_{0};
+  size_t total_used_mem_size_{0};
+};
+}  // namespace device
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_COMMON_MEM_REUSE_HOST_MEM_POOL_H_
@@ -15,6 +15,8 @@
  */
 
 #include "common/mem_reuse/mem_dynamic_allocator.h"
+#include <algorithm>
+#include <iterator>
 #include <string>
 #include "utils/ms_utils.h"
 #include "utils/convert_utils.h"
@@ -29,20 +31,134 @@ constexpr size_t kGBToByte = 1024 << 20;
 // The smallest memory request size, if it is smaller than this size, the device memory request may fail
 // Set experience value to 10M
 const size_t kMinimumAllocMem = 10 << 20;
+// The maximum number of idle memory bufs scanned in the size class for the size-segregated find policy.
+constexpr size_t kMaxSegregatedScanNum = 32;
+
+namespace {
+DynamicMemReleasePolicy GetReleasePolicyFromEnv() {
+  const auto &release_policy = common::GetEnv("MS_DEV_MEMPOOL_RELEASE_POLICY");
+  if (release_policy == "alloc_fail") {
+    return DynamicMemReleasePolicy::kOnAllocFail;
+  }
+  if (release_policy == "free") {
+    return DynamicMemReleasePolicy::kOnFree;
+  }
+  return DynamicMemReleasePolicy::kNever;
+}
+
+DynamicMemFindPolicy GetFindPolicyFromEnv() {
+  const auto &find_policy = common::GetEnv("MS_DEV_MEMPOOL_FIND_POLICY");
+  if (find_policy == "size_segregated") {
+    return DynamicMemFindPolicy::kSizeSegregated;
+  }
+  return DynamicMemFindPolicy::kBestFit;
+}
+
+// The size class of size is [2^k, 2^(k+1)) which contains the size, return 2^(k+1).
+size_t SizeClassUpperBound(size_t size) {
+  size_t upper_bound = DYNAMIC_MEM_ALIGN_SIZE;
+  while ((upper_bound <= size) && (upper_bound <= SIZE_MAX / 2)) {
+    upper_bound <<= 1;
+  }
+  return upper_bound;
+}
+
+// Find the idle memory buf of the lowest device address from the best fit to the end of size class.
+SizeMapMemBuf::iterator FindSegregatedIdleMemBuf(size_t size, const SizeMapMemBuf::iterator &best_fit_iter,
+                                                 SizeMapMemBuf *const idle_mem_buf_map) {
+  MS_EXCEPTION_IF_NULL(idle_mem_buf_map);
+  const auto &class_end_iter = idle_mem_buf_map->lower_bound(SizeClassUpperBound(size));
+  auto found_iter = best_fit_iter;
+  size_t scan_num = 0;
+  for (auto iter = best_fit_iter; (iter != class_end_iter) && (scan_num < kMaxSegregatedScanNum); ++iter, ++scan_num) {
+    MS_EXCEPTION_IF_NULL(iter->second);
+    if (iter->second->device_addr_ < found_iter->second->device_addr_) {
+      found_iter = iter;
+    }
+  }
+  return found_iter;
+}
+}  // namespace
+
+DynamicMemPoolBestFit::DynamicMemPoolBestFit()
+    : persistent_mem_(std::make_shared<MemStatusManager>()),
+      common_mem_(std::make_shared<MemStatusManager>()),
+      mem_buf_cache_(std::make_unique<DynamicMemBufQueue[]>(DYNAMIC_MEM_CACHE_MAX_SIZE / DYNAMIC_MEM_ALIGN_SIZE)),
+      release_policy_(GetReleasePolicyFromEnv()),
+      find_policy_(GetFindPolicyFromEnv()) {}
 
 DynamicMemPoolBestFit::~DynamicMemPoolBestFit() {
   persistent_mem_->clear();
   common_mem_->clear();
 }
 
+bool DynamicMemBufQueue::Push(const DeviceMemPtr &device_addr) {
+  auto pos = push_pos_.load(std::memory_order_relaxed);
+  while (true) {
+    auto &cell = cells_[pos & (DYNAMIC_MEM_CACHE_QUEUE_SIZE - 1)];
+    auto sequence = cell.sequence_.load(std::memory_order_acquire);
+    if (sequence == pos) {
+      if (push_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+        cell.device_addr_ = device_addr;
+        cell.sequence_.store(pos + 1, std::memory_order_release);
+        return true;
+      }
+    } else if (sequence < pos) {
+      // The cell is not popped in the last round, so the queue is full.
+      return false;
+    } else {
+      pos = push_pos_.load(std::memory_order_relaxed);
+    }
+  }
+}
+
+DeviceMemPtr DynamicMemBufQueue::Pop() {
+  auto pos = pop_pos_.load(std::memory_order_relaxed);
+  while (true) {
+    auto &cell = cells_[pos & (DYNAMIC_MEM_CACHE_QUEUE_SIZE - 1)];
+    auto sequence = cell.sequence_.load(std::memory_order_acquire);
+    if (sequence == pos + 1) {
+      if (pop_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+        auto device_addr = cell.device_addr_;
+        cell.sequence_.store(pos + DYNAMIC_MEM_CACHE_QUEUE_SIZE, std::memory_order_release);
+        return device_addr;
+      }
+    } else if (sequence < pos + 1) {
+      // The cell is not pushed in this round, so the queue is empty.
+      return nullptr;
+    } else {
+      pos = pop_pos_.load(std::memory_order_relaxed);
+    }
+  }
+}
+
 DeviceMemPtr DynamicMemPoolBestFit::AllocTensorMem(size_t size, bool from_persistent_mem) {
   size_t align_size = AlignMemorySize(size);
+  // Fetch the small memory buf from the size-classed cache without lock firstly.
+  auto cache_index = from_persistent_mem ? -1 : MemBufCacheIndex(align_size);
+  if (cache_index >= 0) {
+    auto cached_addr = mem_buf_cache_[LongToSize(cache_index)].Pop();
+    if (cached_addr != nullptr) {
+      (void)cached_mem_size_.fetch_sub(align_size, std::memory_order_relaxed);
+      return cached_addr;
+    }
+  }
+
   std::lock_guard<std::mutex> locker(mutex_);
   // Find the idle memory buf by tensor size, if not find, then add new memory block and memory buf.
   DeviceMemPtr device_addr = FindIdleMemBuf(align_size, from_persistent_mem);
   if (!device_addr) {
     device_addr = AddMemBlockAndMemBuf(align_size, from_persistent_mem);
   }
+  // The cached memory bufs may be combined into the required size.
+  if ((!device_addr) && (cached_mem_size_.load(std::memory_order_relaxed) > 0)) {
+    FlushMemBufCache();
+    device_addr = FindIdleMemBuf(align_size, from_persistent_mem);
+  }
+  // The device memory of fully idle memory blocks may be enough to add the memory block of required size.
+  if ((!device_addr) && (release_policy_ != DynamicMemReleasePolicy::kNever) && (ReleaseIdleMemBlocks() > 0)) {
+    device_addr = AddMemBlockAndMemBuf(align_size, from_persistent_mem);
+  }
   if (!device_addr) {
     DumpDynamicMemPoolInfo();
   }
@@ -102,7 +218,10 @@ DeviceMemPtr DynamicMemPoolBestFit::FindIdleMemBuf(size_t size, bool from_persis
     mem_mng = persistent_mem_;
   }
   MS_EXCEPTION_IF_NULL(mem_mng);
-  const auto &iter = mem_mng->idle_mem_buf_map_.lower_bound(size);
+  auto iter = mem_mng->idle_mem_buf_map_.lower_bound(size);
+  if ((iter != mem_mng->idle_mem_buf_map_.end()) && (find_policy_ == DynamicMemFindPolicy::kSizeSegregated)) {
+    iter = FindSegregatedIdleMemBuf(size, iter, &mem_mng->idle_mem_buf_map_);
+  }
   if (iter != mem_mng->idle_mem_buf_map_.end()) {
     auto mem_buf = iter->second;
     MS_EXCEPTION_IF_NULL(mem_buf);
@@ -294,6 +413,10 @@ void DynamicMemPoolBestFit::FreeTensorMem(const DeviceMemPtr &device_addr) {
     return nullptr;
   };
   auto mem_block = fn(common_mem_, device_addr);
+  if ((mem_block != nullptr) && CacheMemBuf(mem_block->block_all_mem_buf_map_.at(device_addr))) {
+    return;
+  }
+  auto mem_mng = common_mem_;
   if (mem_block == nullptr) {
     mem_block = fn(persistent_mem_, device_addr);
     if (mem_block == nullptr) {
@@ -301,9 +424,13 @@ void DynamicMemPoolBestFit::FreeTensorMem(const DeviceMemPtr &device_addr) {
       MS_LOG(DEBUG) << "Can't find the mem_block of the device address[" << device_addr << "].";
       return;
     }
-    CombineMemBuf(mem_block, device_addr, persistent_mem_);
-  } else {
-    CombineMemBuf(mem_block, device_addr, common_mem_);
+    mem_mng = persistent_mem_;
+  }
+  CombineMemBuf(mem_block, device_addr, mem_mng);
+  // Keep the last memory block to avoid adding the memory block again in the next memory alloc.
+  if ((release_policy_ == DynamicMemReleasePolicy::kOnFree) && (mem_mng->mem_block_list_.size() > 1) &&
+      IsMemBlockIdle(mem_block)) {
+    (void)ReleaseIdleMemBlock(mem_block, mem_mng);
   }
 }
 
@@ -376,8 +503,149 @@ void DynamicMemPoolBestFit::EraseIdleMemBuf(size_t size, const DeviceMemPtr &dev
   MS_LOG(ERROR) << "Can't find the size[" << size << "] and device address[" << device_addr << "] in the idle mem_buf.";
 }
 
+int64_t DynamicMemPoolBestFit::MemBufCacheIndex(size_t size) const {
+  if ((size == 0) || (size > DYNAMIC_MEM_CACHE_MAX_SIZE) || (size % DYNAMIC_MEM_ALIGN_SIZE != 0)) {
+    return -1;
+  }
+  return SizeToLong(size / DYNAMIC_MEM_ALIGN_SIZE) - 1;
+}
+
+bool DynamicMemPoolBestFit::CacheMemBuf(const DynamicMemBufPtr &mem_buf) {
+  MS_EXCEPTION_IF_NULL(mem_buf);
+  if (mem_buf->status_ != kMemBufUsed) {
+    MS_LOG(EXCEPTION) << "Find the mem_buf is not used, mem_buf_address[" << mem_buf->device_addr_ << "].";
+  }
+  auto cache_index = MemBufCacheIndex(mem_buf->size_);
+  if (cache_index < 0) {
+    return false;
+  }
+  // The cached memory size is only increased under the lock, so the limit is exact.
+  if (cached_mem_size_.load(std::memory_order_relaxed) + mem_buf->size_ > DYNAMIC_MEM_CACHE_LIMIT_SIZE) {
+    return false;
+  }
+  (void)cached_mem_size_.fetch_add(mem_buf->size_, std::memory_order_relaxed);
+  if (!mem_buf_cache_[LongToSize(cache_index)].Push(mem_buf->device_addr_)) {
+    (void)cached_mem_size_.fetch_sub(mem_buf->size_, std::memory_order_relaxed);
+    return false;
+  }
+  return true;
+}
+
+void DynamicMemPoolBestFit::FlushMemBufCache() {
+  for (size_t i = 0; i < DYNAMIC_MEM_CACHE_MAX_SIZE / DYNAMIC_MEM_ALIGN_SIZE; ++i) {
+    auto cached_addr = mem_buf_cache_[i].Pop();
+    while (cached_addr != nullptr) {
+      (void)cached_mem_size_.fetch_sub((i + 1) * DYNAMIC_MEM_ALIGN_SIZE, std::memory_order_relaxed);
+      auto mem_block = FindMemBlock(cached_addr, common_mem_);
+      MS_EXCEPTION_IF_NULL(mem_block);
+      CombineMemBuf(mem_block, cached_addr, common_mem_);
+      cached_addr = mem_buf_cache_[i].Pop();
+    }
+  }
+}
+
+bool DynamicMemPoolBestFit::ReleaseDeviceMem(const DeviceMemPtr &, size_t) { return false; }
+
+void DynamicMemPoolBestFit::set_release_policy(DynamicMemReleasePolicy release_policy) {
+  std::lock_guard<std::mutex> locker(mutex_);
+  release_policy_ = release_policy;
+}
+
+void DynamicMemPoolBestFit::set_find_policy(DynamicMemFindPolicy find_policy) {
+  std::lock_guard<std::mutex> locker(mutex_);
+  find_policy_ = find_policy;
+}
+
+bool DynamicMemPoolBestFit::IsMemBlockIdle(const DynamicMemBlockPtr &mem_block) {
+  MS_EXCEPTION_IF_NULL(mem_block);
+  if (mem_block->block_all_mem_buf_map_.size() != 1) {
+    return false;
+  }
+  const auto &mem_buf = mem_block->block_all_mem_buf_map_.begin()->second;
+  MS_EXCEPTION_IF_NULL(mem_buf);
+  return (mem_buf->status_ == kMemBufIdle) && (mem_buf->size_ == mem_block->size());
+}
+
+bool DynamicMemPoolBestFit::ReleaseIdleMemBlock(const DynamicMemBlockPtr &mem_block,
+                                                const MemStatusManagerPtr &mem_mng) {
+  MS_EXCEPTION_IF_NULL(mem_block);
+  MS_EXCEPTION_IF_NULL(mem_mng);
+  const auto &iter = std::find(mem_mng->mem_block_list_.begin(), mem_mng->mem_block_list_.end(), mem_block);
+  if (iter == mem_mng->mem_block_list_.end()) {
+    MS_LOG(EXCEPTION) << "Can't find the mem_block of the device address[" << mem_block->device_addr() << "].";
+  }
+  auto device_addr = mem_block->device_addr();
+  auto block_size = mem_block->size();
+  if (!ReleaseDeviceMem(device_addr, block_size)) {
+    return false;
+  }
+  EraseIdleMemBuf(block_size, device_addr, mem_mng);
+  (void)mem_mng->mem_block_list_.erase(iter);
+  if (mem_mng->mps_.total_mem_size_ < block_size) {
+    MS_LOG(EXCEPTION) << "The total mem size is less than the size of mem_block.";
+  }
+  mem_mng->mps_.total_mem_size_ -= block_size;
+  MS_LOG(INFO) << "Release the idle mem_block, device address[" << device_addr << "] size[" << block_size << "].";
+  return true;
+}
+
+size_t DynamicMemPoolBestFit::ReleaseIdleMemBlocks() {
+  size_t released_size = 0;
+  for (const auto &mem_mng : {common_mem_, persistent_mem_}) {
+    // Copy the idle memory blocks, because the memory block list is changed in the releasing.
+    std::vector<DynamicMemBlockPtr> idle_mem_blocks;
+    std::copy_if(mem_mng->mem_block_list_.begin(), mem_mng->mem_block_list_.end(), std::back_inserter(idle_mem_blocks),
+                 IsMemBlockIdle);
+    for (const auto &mem_block : idle_mem_blocks) {
+      auto block_size = mem_block->size();
+      if (!ReleaseIdleMemBlock(mem_block, mem_mng)) {
+        return released_size;
+      }
+      released_size += block_size;
+    }
+  }
+  return released_size;
+}
+
+DynamicMemFragmentation DynamicMemPoolBestFit::CalFragmentation(const MemStatusManagerPtr &mem_mng) const {
+  MS_EXCEPTION_IF_NULL(mem_mng);
+  DynamicMemFragmentation fragmentation;
+  fragmentation.block_count_ = mem_mng->mem_block_list_.size();
+  fragmentation.idle_block_count_ = LongToSize(
+    std::count_if(mem_mng->mem_block_list_.begin(), mem_mng->mem_block_list_.end(), IsMemBlockIdle));
+  fragmentation.idle_mem_buf_count_ = mem_mng->idle_mem_buf_map_.size();
+  for (const auto &idle_mem_buf : mem_mng->idle_mem_buf_map_) {
+    fragmentation.idle_mem_size_ += idle_mem_buf.first;
+  }
+  if (!mem_mng->idle_mem_buf_map_.empty()) {
+    fragmentation.largest_idle_mem_buf_size_ = mem_mng->idle_mem_buf_map_.rbegin()->first;
+  }
+  return fragmentation;
+}
+
+DynamicMemFragmentation DynamicMemPoolBestFit::FragmentationStatistics() {
+  std::lock_guard<std::mutex> locker(mutex_);
+  auto fragmentation = CalFragmentation(common_mem_);
+  const auto &persistent_fragmentation = CalFragmentation(persistent_mem_);
+  fragmentation.block_count_ += persistent_fragmentation.block_count_;
+  fragmentation.idle_block_count_ += persistent_fragmentation.idle_block_count_;
+  fragmentation.idle_mem_size_ += persistent_fragmentation.idle_mem_size_;
+  fragmentation.idle_mem_buf_count_ += persistent_fragmentation.idle_mem_buf_count_;
+  fragmentation.largest_idle_mem_buf_size_ =
+    std::max(fragmentation.largest_idle_mem_buf_size_, persistent_fragmentation.largest_idle_mem_buf_size_);
+  return fragmentation;
+}
+
 void DynamicMemPoolBestFit::ReleaseDeviceRes() {
   std::lock_guard<std::mutex> locker(mutex_);
+  // The cached memory bufs are released with the memory blocks.
+  for (size_t i = 0; i < DYNAMIC_MEM_CACHE_MAX_SIZE / DYNAMIC_MEM_ALIGN_SIZE; ++i) {
+    auto cached_addr = mem_buf_cache_[i].Pop();
+    while (cached_addr != nullptr) {
+      cached_addr = mem_buf_cache_[i].Pop();
+    }
+  }
+  cached_mem_size_.store(0, std::memory_order_relaxed);
   auto fn = [this](const MemStatusManagerPtr &mem_mng) {
     for (auto &iter : mem_mng->mem_block_list_) {
       auto &device_addr = iter->device_addr_base_;
@@ -396,7 +664,7 @@ void DynamicMemPoolBestFit::ReleaseDeviceRes() {
 }
 
 void DynamicMemPoolBestFit::DumpDynamicMemPoolInfo() {
-  auto fn = [](const MemStatusManagerPtr &mem_mng, const std::string &mem_type) {
+  auto fn = [this](const MemStatusManagerPtr &mem_mng, const std::string &mem_type) {
     if (mem_mng->mem_block_list_.empty()) {
       return;
     }
@@ -417,6 +685,14 @@ void DynamicMemPoolBestFit::DumpDynamicMemPoolInfo() {
                     << mem_mng->mps_.total_mem_size_ << ", peak used mem " << mem_mng->mps_.used_mem_peak_size_
                     << ", in used mem " << mem_mng->mps_.total_used_mem_size_ << ", total idle mem "
                     << mem_mng->mps_.total_mem_size_ - mem_mng->mps_.total_used_mem_size_;
+    const auto &fragmentation = CalFragmentation(mem_mng);
+    MS_LOG(WARNING) << mem_type << " fragmentation: idle block counts " << fragmentation.idle_block_count_
+                    << ", idle mem buf counts " << fragmentation.idle_mem_buf_count_ << ", largest idle mem buf "
+                    << fragmentation.largest_idle_mem_buf_size_ << ", fragmentation ratio "
+                    << fragmentation.FragmentationRatio();
+    if (mem_mng == common_mem_) {
+      MS_LOG(WARNING) << mem_type << " cached mem " << cached_mem_size_.load(std::memory_order_relaxed);
+    }
   };
   fn(common_mem_, std::string(kCommonMem));
   fn(persistent_mem_, std::string(kPersistentParamMem));
@@ -24,6 +24,7 @@
 #include <utility>
 #include <thread>
 #include <mutex>
+#include <atomic>
 
 namespace mindspore {
 namespace device {
@@ -38,6 +39,50 @@ static const size_t DYNAMIC_MEM_ALIGN_SIZE = 512;
 // The minimum unit size (1G) of memory block used for dynamic extend.
 static const size_t DYNAMIC_MEM_ALLOC_UNIT_SIZE = 1024 << 20;
 
+// The maximum size of memory buf cached in the size classes, the size classes are the multiples of align size.
+static const size_t DYNAMIC_MEM_CACHE_MAX_SIZE = 64 << 10;
+
+// The capacity of memory buf queue in each size class, which must be the power of two.
+static const size_t DYNAMIC_MEM_CACHE_QUEUE_SIZE = 64;
+
+// The upper limit of total memory size cached in all the size classes.
+static const size_t DYNAMIC_MEM_CACHE_LIMIT_SIZE = 64 << 20;
+
+// The policy of releasing the fully idle memory blocks to the device, which is set by the environment variable
+// MS_DEV_MEMPOOL_RELEASE_POLICY=never|alloc_fail|free.
+enum class DynamicMemReleasePolicy : int {
+  // Keep all the memory blocks until the device resource is released.
+  kNever,
+  // Release the fully idle memory blocks when the memory alloc fails to add the memory block.
+  kOnAllocFail,
+  // Release the memory block as soon as it is fully idle after memory free, except the last memory block.
+  kOnFree
+};
+
+// The policy of finding the idle memory buf, which is set by the environment variable
+// MS_DEV_MEMPOOL_FIND_POLICY=best_fit|size_segregated.
+enum class DynamicMemFindPolicy : int {
+  // Find the smallest idle memory buf which is not smaller than the alloc size.
+  kBestFit,
+  // Find the idle memory buf of the lowest device address in the power-of-two size class of the alloc size, which keeps
+  // the high address of memory blocks idle to be combined, and fall back to the best fit out of the size class.
+  kSizeSegregated
+};
+
+// The fragmentation statistics of memory pool, the cached memory bufs are not counted in the idle memory.
+struct DynamicMemFragmentation {
+  size_t block_count_{0};
+  // The count of memory blocks which have no used memory buf.
+  size_t idle_block_count_{0};
+  size_t idle_mem_size_{0};
+  size_t idle_mem_buf_count_{0};
+  size_t largest_idle_mem_buf_size_{0};
+  // The ratio of idle memory which can't be allocated by one memory alloc, 0 means no fragmentation.
+  float FragmentationRatio() const {
+    return (idle_mem_size_ == 0) ? 0.0f : (1.0f - static_cast<float>(largest_idle_mem_buf_size_) / idle_mem_size_);
+  }
+};
+
 // The Comparator of device address from small to large.
 struct DeviceAddrCmp {
   bool operator()(const DeviceMemPtr &addr1, const DeviceMemPtr &addr2) const { return addr1 < addr2; }
@@ -100,11 +145,37 @@ struct MemStatusManager {
 };
 using MemStatusManagerPtr = std::shared_ptr<MemStatusManager>;
 
+// The lock-free bounded queue of the cached memory bufs in one size class, which supports multiple producers and
+// multiple consumers. The sequence of cell marks whether the cell is ready to push or pop in the round of position.
+class DynamicMemBufQueue {
+ public:
+  DynamicMemBufQueue() {
+    for (size_t i = 0; i < DYNAMIC_MEM_CACHE_QUEUE_SIZE; ++i) {
+      cells_[i].sequence_.store(i, std::memory_order_relaxed);
+    }
+  }
+  ~DynamicMemBufQueue() = default;
+
+  // Return false when the queue is full.
+  bool Push(const DeviceMemPtr &device_addr);
+  // Return nullptr when the queue is empty.
+  DeviceMemPtr Pop();
+
+ private:
+  struct Cell {
+    std::atomic<size_t> sequence_;
+    DeviceMemPtr device_addr_{nullptr};
+  };
+
+  Cell cells_[DYNAMIC_MEM_CACHE_QUEUE_SIZE];
+  alignas(64) std::atomic<size_t> push_pos_{0};
+  alignas(64) std::atomic<size_t> pop_pos_{0};
+};
+
 // The main class of dynamic memory pool.
 class DynamicMemPoolBestFit {
  public:
-  DynamicMemPoolBestFit()
-      : persistent_mem_(std::make_shared<MemStatusManager>()), common_mem_(std::make_shared<MemStatusManager>()) {}
+  DynamicMemPoolBestFit();
   virtual ~DynamicMemPoolBestFit();
 
   // The main program entry of memory alloc.
@@ -126,17 +197,28 @@ class DynamicMemPoolBestFit {
   size_t TotalMemStatistics() const {
     return common_mem_->mps_.total_mem_size_ + persistent_mem_->mps_.total_mem_size_;
   }
+  // The cached memory bufs are still used in the memory blocks, but idle for the users.
   size_t TotalUsedMemStatistics() const {
-    return common_mem_->mps_.total_used_mem_size_ + persistent_mem_->mps_.total_used_mem_size_;
+    return common_mem_->mps_.total_used_mem_size_ + persistent_mem_->mps_.total_used_mem_size_ -
+           cached_mem_size_.load(std::memory_order_relaxed);
   }
+  size_t CachedMemStatistics() const { return cached_mem_size_.load(std::memory_order_relaxed); }
   size_t UsedMemPeakStatistics() const {
     return common_mem_->mps_.used_mem_peak_size_ + persistent_mem_->mps_.used_mem_peak_size_;
   }
+  // The fragmentation statistics of common memory and persistent memory.
+  DynamicMemFragmentation FragmentationStatistics();
+
+  void set_release_policy(DynamicMemReleasePolicy release_policy);
+  void set_find_policy(DynamicMemFindPolicy find_policy);
 
   // The related interface of device memory real operation, needs override by device type.
   virtual size_t AllocDeviceMem(size_t size, DeviceMemPtr *addr) = 0;
   virtual bool FreeDeviceMem(const DeviceMemPtr &addr) = 0;
   virtual size_t free_mem_size() = 0;
+  // Release the device memory of one memory block before the device resource is released, return false when the
+  // device doesn't support releasing the memory block alone.
+  virtual bool ReleaseDeviceMem(const DeviceMemPtr &addr, size_t size);
 
  protected:
   const MemStatusManagerPtr &common_mem() const { return common_mem_; }
@@ -166,11 +248,32 @@ class DynamicMemPoolBestFit {
   void EraseIdleMemBuf(size_t size, const DeviceMemPtr &device_addr, const MemStatusManagerPtr &mem_mng);
   // Display the information of memory block and memory buf.
   void DumpDynamicMemPoolInfo();
+  DynamicMemFragmentation CalFragmentation(const MemStatusManagerPtr &mem_mng) const;
+
+  // The memory block is fully idle when it is combined into one idle memory buf.
+  static bool IsMemBlockIdle(const DynamicMemBlockPtr &mem_block);
+  // Release the fully idle memory block to the device, return false when the device doesn't support.
+  bool ReleaseIdleMemBlock(const DynamicMemBlockPtr &mem_block, const MemStatusManagerPtr &mem_mng);
+  // Release all the fully idle memory blocks of common memory and persistent memory, return the released size.
+  size_t ReleaseIdleMemBlocks();
+
+  // The small memory bufs of common memory are cached by the size class when memory free, and fetched from the cache
+  // without lock when memory alloc. Return the size class index, or -1 when the size isn't cached.
+  int64_t MemBufCacheIndex(size_t size) const;
+  // Try to cache the memory buf when memory free, return false when the cache is full.
+  bool CacheMemBuf(const DynamicMemBufPtr &mem_buf);
+  // Return all the cached memory bufs to the memory blocks, to combine them for the large memory alloc.
+  void FlushMemBufCache();
 
   // Support multi-thread.
   std::mutex mutex_;
   MemStatusManagerPtr persistent_mem_{nullptr};
   MemStatusManagerPtr common_mem_{nullptr};
+  // The size-classed cache of memory bufs in front of the best fit, the size of class i is (i + 1) * align size.
+  std::unique_ptr<DynamicMemBufQueue[]> mem_buf_cache_;
+  std::atomic<size_t> cached_mem_size_{0};
+  DynamicMemReleasePolicy release_policy_{DynamicMemReleasePolicy::kNever};
+  DynamicMemFindPolicy find_policy_{DynamicMemFindPolicy::kBestFit};
   // In the graph mode, the unit size set in the context will be modified through the FetchMemUnitSize function, so it
   // needs to be changed back after that
   size_t config_unit_size_{DYNAMIC_MEM_ALLOC_UNIT_SIZE};
@@ -0,0 +1,75 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_DISTRIBUTED_RPC_TCP_BUFFER_MESSAGE_H_
+#define MINDSPORE_CCSRC_DISTRIBUTED_RPC_TCP_BUFFER_MESSAGE_H_
+
+#include <string>
+#include <vector>
+#include <utility>
+#include <functional>
+
+#include "actor/msg.h"
+
+namespace mindspore {
+namespace distributed {
+namespace rpc {
+/*
+ * The BufferMessage references the payload in the external buffers(eg. the host memory of device tensors) instead of
+ * copying it into the body. The body and the buffers are sent by one sendmsg with an iovec for each of them, and the
+ * receiver gets them as one contiguous payload. The release callback is called when the message is destroyed, which
+ * means the message has been sent or dropped and the owner can reuse the buffers.
+ */
+class BufferMessage : public MessageBase {
+ public:
+  struct Buffer {
+    void *data;
+    size_t size;
+  };
+  using ReleaseCallback = std::function<void()>;
+
+  BufferMessage(const AID &aFrom, const AID &aTo, const std::string &sName, std::vector<Buffer> &&buffers,
+                ReleaseCallback &&release_callback)
+      : MessageBase(aFrom, aTo, sName), buffers_(std::move(buffers)), release_callback_(std::move(release_callback)) {}
+  BufferMessage(const BufferMessage &) = delete;
+  BufferMessage &operator=(const BufferMessage &) = delete;
+
+  ~BufferMessage() override {
+    if (release_callback_ != nullptr) {
+      release_callback_();
+    }
+  }
+
+  const std::vector<Buffer> &buffers() const { return buffers_; }
+
+  // The total size of the buffers, not including the body.
+  size_t BuffersSize() const {
+    size_t size = 0;
+    for (const auto &buffer : buffers_) {
+      size += buffer.size;
+    }
+    return size;
+  }
+
+ private:
+  std::vector<Buffer> buffers_;
+  ReleaseCallback release_callback_;
+};
+}  // namespace rpc
+}  // namespace distributed
+}  // namespace mindspore
+
+#endif
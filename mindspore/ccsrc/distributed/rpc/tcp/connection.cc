@@ -105,6 +105,35 @@ void NewConnectEventHandler(int fd, uint32_t events, void *context) {
   return;
 }
 
+MessageBase *CreateRecvMessage(size_t body_len, MemAllocateCallback allocate_callback, MemFreeCallback free_callback,
+                               void **body_data) {
+  MS_EXCEPTION_IF_NULL(body_data);
+  void *data = nullptr;
+  if (body_len > 0 && allocate_callback != nullptr) {
+    data = allocate_callback(body_len);
+  }
+
+  MessageBase *msg = nullptr;
+  if (data != nullptr) {
+    // The memory is freed with the message.
+    msg = new (std::nothrow) BufferMessage(AID(), AID(), "", {{data, body_len}}, [free_callback, data]() {
+      if (free_callback != nullptr) {
+        free_callback(data);
+      }
+    });
+  } else {
+    msg = new (std::nothrow) MessageBase();
+  }
+  MS_EXCEPTION_IF_NULL(msg);
+
+  if (data == nullptr) {
+    msg->body.resize(body_len);
+    data = const_cast<char *>(msg->body.data());
+  }
+  *body_data = data;
+  return msg;
+}
+
 Connection::Connection()
     : socket_fd(-1),
       deleted(false),
@@ -121,10 +150,14 @@ Connection::Connection()
       total_recv_len(0),
       total_send_len(0),
       recv_len(0),
+      send_io_vec(SEND_MSG_IO_VEC_LEN),
       event_callback(nullptr),
       succ_callback(nullptr),
       write_callback(nullptr),
       read_callback(nullptr),
+      message_handler(nullptr),
+      mem_allocate_callback(nullptr),
+      mem_free_callback(nullptr),
       output_buffer_size(0),
       error_code(0) {
   // Initialize the recv kernel message structure.
@@ -152,7 +185,7 @@ Connection::Connection()
   send_kernel_msg.msg_flags = 0;
   send_kernel_msg.msg_name = nullptr;
   send_kernel_msg.msg_namelen = 0;
-  send_kernel_msg.msg_iov = send_io_vec;
+  send_kernel_msg.msg_iov = send_io_vec.data();
   send_kernel_msg.msg_iovlen = SEND_MSG_IO_VEC_LEN;
 }
 
@@ -325,13 +358,19 @@ void Connection::FillSendMessage(MessageBase *msg, const std::string &advertiseU
   index = 0;
   if (msg->type == MessageBase::Type::KMSG) {
     if (!isHttpKmsg) {
+      // The buffers of buffer message follow the body on the wire.
+      auto buffer_msg = dynamic_cast<BufferMessage *>(msg);
+      size_t body_len = msg->body.size() + (buffer_msg == nullptr ? 0 : buffer_msg->BuffersSize());
+      size_t buffer_num = (buffer_msg == nullptr ? 0 : buffer_msg->buffers().size());
+      send_io_vec.resize(SEND_MSG_IO_VEC_LEN + buffer_num);
+
       send_to = msg->to;
       send_from = msg->from.Name() + "@" + advertiseUrl;
 
       send_msg_header.name_len = htonl(static_cast<uint32_t>(msg->name.size()));
       send_msg_header.to_len = htonl(static_cast<uint32_t>(send_to.size()));
       send_msg_header.from_len = htonl(static_cast<uint32_t>(send_from.size()));
-      send_msg_header.body_len = htonl(static_cast<uint32_t>(msg->body.size()));
+      send_msg_header.body_len = htonl(static_cast<uint32_t>(body_len));
 
       send_io_vec[index].iov_base = &send_msg_header;
       send_io_vec[index].iov_len = sizeof(send_msg_header);
@@ -348,14 +387,21 @@ void Connection::FillSendMessage(MessageBase *msg, const std::string &advertiseU
       send_io_vec[index].iov_base = const_cast<char *>(msg->body.data());
       send_io_vec[index].iov_len = msg->body.size();
       ++index;
-      send_kernel_msg.msg_iov = send_io_vec;
+      if (buffer_msg != nullptr) {
+        for (const auto &buffer : buffer_msg->buffers()) {
+          send_io_vec[index].iov_base = buffer.data;
+          send_io_vec[index].iov_len = buffer.size;
+          ++index;
+        }
+      }
+      send_kernel_msg.msg_iov = send_io_vec.data();
       send_kernel_msg.msg_iovlen = IntToSize(index);
       total_send_len =
-        UlongToUint(sizeof(send_msg_header)) + msg->name.size() + send_to.size() + send_from.size() + msg->body.size();
+        UlongToUint(sizeof(send_msg_header)) + msg->name.size() + send_to.size() + send_from.size() + body_len;
       send_message = msg;
 
       // update metrics
-      send_metrics->UpdateMax(msg->body.size());
+      send_metrics->UpdateMax(body_len);
       send_metrics->last_send_msg_name = msg->name;
 
       return;
@@ -374,7 +420,7 @@ void Connection::FillSendMessage(MessageBase *msg, const std::string &advertiseU
     send_io_vec[index].iov_base = const_cast<char *>(msg->body.data());
     send_io_vec[index].iov_len = msg->body.size();
     ++index;
-    send_kernel_msg.msg_iov = send_io_vec;
+    send_kernel_msg.msg_iov = send_io_vec.data();
     send_kernel_msg.msg_iovlen = IntToSize(index);
     total_send_len = UlongToUint(msg->body.size());
     send_message = msg;
@@ -398,13 +444,12 @@ void Connection::FillRecvMessage() {
   }
 
   int i = 0;
-  MessageBase *msg = new (std::nothrow) MessageBase();
-  MS_EXCEPTION_IF_NULL(msg);
+  void *body_data = nullptr;
+  MessageBase *msg = CreateRecvMessage(recvBodyLen, mem_allocate_callback, mem_free_callback, &body_data);
 
   msg->name.resize(recvNameLen);
   recv_to.resize(recvToLen);
   recv_from.resize(recvFromLen);
-  msg->body.resize(recvBodyLen);
 
   recv_io_vec[i].iov_base = const_cast<char *>(msg->name.data());
   recv_io_vec[i].iov_len = msg->name.size();
@@ -415,13 +460,13 @@ void Connection::FillRecvMessage() {
   recv_io_vec[i].iov_base = const_cast<char *>(recv_from.data());
   recv_io_vec[i].iov_len = recv_from.size();
   ++i;
-  recv_io_vec[i].iov_base = const_cast<char *>(msg->body.data());
-  recv_io_vec[i].iov_len = msg->body.size();
+  recv_io_vec[i].iov_base = body_data;
+  recv_io_vec[i].iov_len = recvBodyLen;
   ++i;
 
   recv_kernel_msg.msg_iov = recv_io_vec;
   recv_kernel_msg.msg_iovlen = IntToSize(i);
-  total_recv_len = UlongToUint(msg->name.size()) + recv_to.size() + recv_from.size() + msg->body.size();
+  total_recv_len = UlongToUint(msg->name.size()) + recv_to.size() + recv_from.size() + recvBodyLen;
   recv_message = msg;
 }
 
@@ -21,8 +21,10 @@
 #include <string>
 #include <mutex>
 #include <memory>
+#include <vector>
 
 #include "actor/msg.h"
+#include "distributed/rpc/tcp/buffer_message.h"
 #include "distributed/rpc/tcp/constants.h"
 #include "distributed/rpc/tcp/event_loop.h"
 #include "distributed/rpc/tcp/socket_operation.h"
@@ -95,6 +97,11 @@ struct SendMetrics {
   std::string last_send_msg_name;
 };
 
+// Create the message to be received, whose body lands in the memory of the allocate callback if it is set and
+// succeeds, otherwise in the body string. The address which the body lands in is returned by body_data.
+MessageBase *CreateRecvMessage(size_t body_len, MemAllocateCallback allocate_callback, MemFreeCallback free_callback,
+                               void **body_data);
+
 /*
  * Represents a TCP or SSL connection.
  */
@@ -194,7 +201,8 @@ struct Connection {
   struct msghdr recv_kernel_msg;
 
   struct iovec recv_io_vec[RECV_MSG_IO_VEC_LEN];
-  struct iovec send_io_vec[SEND_MSG_IO_VEC_LEN];
+  // The send iovecs are extended by the buffers of the buffer message.
+  std::vector<struct iovec> send_io_vec;
 
   ParseType recv_message_type{kUnknown};
 
@@ -207,6 +215,10 @@ struct Connection {
   // Function for handling received messages.
   MessageHandler message_handler;
 
+  // Functions for the memory of received message body, the message is received as a buffer message if it is set.
+  MemAllocateCallback mem_allocate_callback;
+  MemFreeCallback mem_free_callback;
+
   // Buffer for messages to be sent.
   std::queue<MessageBase *> send_message_queue;
 
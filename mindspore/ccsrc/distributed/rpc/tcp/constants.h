@@ -31,9 +31,14 @@ namespace rpc {
 using MessageHandler = void (*)(std::unique_ptr<MessageBase> &&msg);
 using DeleteCallBack = void (*)(const std::string &from, const std::string &to);
 using ConnectionCallBack = void (*)(void *conn);
+// Allocate the memory which the body of received message lands in, return nullptr to receive into the body string.
+using MemAllocateCallback = void *(*)(size_t size);
+using MemFreeCallback = void (*)(void *data);
 
 constexpr int SEND_MSG_IO_VEC_LEN = 5;
 constexpr int RECV_MSG_IO_VEC_LEN = 4;
+// The maximum iovec number of one sendmsg(IOV_MAX of linux), which limits the buffer number of the buffer message.
+constexpr size_t MAX_SEND_MSG_IO_VEC_LEN = 1024;
 
 constexpr unsigned int BUSMAGIC_LEN = 4;
 constexpr int SENDMSG_QUEUELEN = 1024;
@@ -75,6 +80,20 @@ static const char URL_PROTOCOL_IP_SEPARATOR[] = "://";
 static const char URL_IP_PORT_SEPARATOR[] = ":";
 static const char TCP_RECV_EVLOOP_THREADNAME[] = "RECV_EVENT_LOOP";
 static const char TCP_SEND_EVLOOP_THREADNAME[] = "SEND_EVENT_LOOP";
+static const char TCP_RECV_REACTOR_THREADNAME[] = "RECV_EVLOOP_";
+static const char TCP_SEND_REACTOR_THREADNAME[] = "SEND_EVLOOP_";
+
+// The url of server which accepts the clients on the same host by shared memory, eg. shm://127.0.0.1:8080.
+static const char SHM_URL_PREFIX[] = "shm://";
+// The abstract unix socket name of the shared memory server is the prefix followed by the server address.
+static const char SHM_SOCKET_NAME_PREFIX[] = "mindspore_rpc_shm@";
+// The ring size of one shared memory channel, which must be a power of 2.
+constexpr size_t SHM_RING_SIZE = 32 << 20;
+constexpr uint64_t SHM_RING_MAGIC = 0x4d53524d47534853;
+constexpr int SHM_HANDSHAKE_TIMEOUT_SEC = 5;
+
+// The maximum number of the reactors driving the connections.
+constexpr size_t MAX_REACTOR_NUM = 64;
 
 constexpr int RPC_ERROR = -1;
 constexpr int RPC_OK = 0;
@@ -0,0 +1,488 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "distributed/rpc/tcp/shm_channel.h"
+
+#include <securec.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <new>
+
+#include "utils/log_adapter.h"
+
+namespace mindspore {
+namespace distributed {
+namespace rpc {
+namespace {
+// The segment and the two event fds are handed to the consumer in one message.
+constexpr size_t kShmHandshakeFdNum = 3;
+
+// Build the abstract unix socket address of the server address, which is released with the network namespace.
+socklen_t GetShmSocketAddr(const std::string &address, struct sockaddr_un *addr) {
+  std::string name = std::string(SHM_SOCKET_NAME_PREFIX) + address;
+  if (name.size() + 1 > sizeof(addr->sun_path)) {
+    MS_LOG(ERROR) << "The shared memory socket name is too long: " << name;
+    return 0;
+  }
+  (void)memset_s(addr, sizeof(*addr), 0, sizeof(*addr));
+  addr->sun_family = AF_UNIX;
+  // The leading '\0' of the path makes the socket abstract.
+  for (size_t i = 0; i < name.size(); ++i) {
+    addr->sun_path[i + 1] = name[i];
+  }
+  return static_cast<socklen_t>(offsetof(struct sockaddr_un, sun_path) + 1 + name.size());
+}
+
+void SetHandshakeTimeout(int fd) {
+  struct timeval timeout = {SHM_HANDSHAKE_TIMEOUT_SEC, 0};
+  if (setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout)) != 0 ||
+      setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout)) != 0) {
+    MS_LOG(WARNING) << "Failed to set the handshake timeout of fd: " << fd << ", errno: " << errno;
+  }
+}
+
+void CloseFd(int *fd) {
+  if (*fd >= 0) {
+    if (close(*fd) != 0) {
+      MS_LOG(ERROR) << "Failed to close fd: " << *fd;
+    }
+    *fd = -1;
+  }
+}
+}  // namespace
+
+ShmChannel::~ShmChannel() {
+  if (send_message_ != nullptr) {
+    delete send_message_;
+    send_message_ = nullptr;
+  }
+  while (!send_message_queue_.empty()) {
+    delete send_message_queue_.front();
+    send_message_queue_.pop();
+  }
+  if (recv_message_ != nullptr) {
+    delete recv_message_;
+    recv_message_ = nullptr;
+  }
+  if (segment_ != nullptr) {
+    if (munmap(segment_, segment_size_) != 0) {
+      MS_LOG(ERROR) << "Failed to unmap the shared memory segment, errno: " << errno;
+    }
+    segment_ = nullptr;
+  }
+  CloseFd(&unix_fd_);
+  CloseFd(&mem_fd_);
+  CloseFd(&data_event_fd_);
+  CloseFd(&space_event_fd_);
+}
+
+int ShmChannel::Listen(const std::string &address) {
+  struct sockaddr_un addr;
+  socklen_t addr_len = GetShmSocketAddr(address, &addr);
+  if (addr_len == 0) {
+    return -1;
+  }
+  int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+  if (fd < 0) {
+    MS_LOG(ERROR) << "Failed to create the shared memory server socket, errno: " << errno;
+    return -1;
+  }
+  if (bind(fd, reinterpret_cast<struct sockaddr *>(&addr), addr_len) != 0 ||
+      listen(fd, SOCKET_LISTEN_BACKLOG) != 0) {
+    MS_LOG(ERROR) << "Failed to listen on the shared memory server socket of " << address << ", errno: " << errno;
+    CloseFd(&fd);
+    return -1;
+  }
+  return fd;
+}
+
+std::unique_ptr<ShmChannel> ShmChannel::Connect(const std::string &address, const std::string &advertise_url) {
+  struct sockaddr_un addr;
+  socklen_t addr_len = GetShmSocketAddr(address, &addr);
+  if (addr_len == 0) {
+    return nullptr;
+  }
+  std::unique_ptr<ShmChannel> channel(new (std::nothrow) ShmChannel());
+  if (channel == nullptr) {
+    MS_LOG(ERROR) << "Failed to create the shared memory channel to " << address;
+    return nullptr;
+  }
+  channel->advertise_url_ = advertise_url;
+  channel->unix_fd_ = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+  if (channel->unix_fd_ < 0) {
+    MS_LOG(ERROR) << "Failed to create the shared memory client socket, errno: " << errno;
+    return nullptr;
+  }
+  // Nobody listens on the address in this network namespace, so the server is on another host.
+  if (connect(channel->unix_fd_, reinterpret_cast<struct sockaddr *>(&addr), addr_len) != 0) {
+    MS_LOG(INFO) << "The shared memory server " << address << " is not on this host, errno: " << errno;
+    return nullptr;
+  }
+
+  size_t segment_size = sizeof(ShmRingHeader) + SHM_RING_SIZE;
+  channel->mem_fd_ = memfd_create("mindspore_rpc_shm", MFD_CLOEXEC);
+  if (channel->mem_fd_ < 0 || ftruncate(channel->mem_fd_, static_cast<off_t>(segment_size)) != 0 ||
+      !channel->MapSegment(channel->mem_fd_, segment_size, true)) {
+    MS_LOG(WARNING) << "Failed to create the shared memory segment of size " << segment_size << ", errno: " << errno;
+    return nullptr;
+  }
+  channel->data_event_fd_ = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+  channel->space_event_fd_ = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+  if (channel->data_event_fd_ < 0 || channel->space_event_fd_ < 0) {
+    MS_LOG(WARNING) << "Failed to create the event fds of shared memory channel, errno: " << errno;
+    return nullptr;
+  }
+
+  // Hand the segment and event fds to the server, which closes the unix socket if it fails to map the segment.
+  uint64_t size = segment_size;
+  struct iovec io_vec = {&size, sizeof(size)};
+  char control[CMSG_SPACE(sizeof(int) * kShmHandshakeFdNum)];
+  (void)memset_s(control, sizeof(control), 0, sizeof(control));
+  struct msghdr msg;
+  (void)memset_s(&msg, sizeof(msg), 0, sizeof(msg));
+  msg.msg_iov = &io_vec;
+  msg.msg_iovlen = 1;
+  msg.msg_control = control;
+  msg.msg_controllen = sizeof(control);
+  struct cmsghdr *cmsg = CMSG_FIRSTHDR(&msg);
+  cmsg->cmsg_level = SOL_SOCKET;
+  cmsg->cmsg_type = SCM_RIGHTS;
+  cmsg->cmsg_len = CMSG_LEN(sizeof(int) * kShmHandshakeFdNum);
+  int fds[kShmHandshakeFdNum] = {channel->mem_fd_, channel->data_event_fd_, channel->space_event_fd_};
+  if (memcpy_s(CMSG_DATA(cmsg), sizeof(fds), fds, sizeof(fds)) != EOK) {
+    MS_LOG(ERROR) << "Failed to fill the fds of shared memory handshake.";
+    return nullptr;
+  }
+  SetHandshakeTimeout(channel->unix_fd_);
+  if (sendmsg(channel->unix_fd_, &msg, MSG_NOSIGNAL) != static_cast<ssize_t>(sizeof(size))) {
+    MS_LOG(WARNING) << "Failed to send the shared memory handshake to " << address << ", errno: " << errno;
+    return nullptr;
+  }
+  MS_LOG(INFO) << "Connected to the shared memory server " << address << ", ring size: " << channel->capacity_;
+  return channel;
+}
+
+std::unique_ptr<ShmChannel> ShmChannel::Accept(int unix_fd) {
+  std::unique_ptr<ShmChannel> channel(new (std::nothrow) ShmChannel());
+  if (channel == nullptr) {
+    MS_LOG(ERROR) << "Failed to create the shared memory channel of fd: " << unix_fd;
+    CloseFd(&unix_fd);
+    return nullptr;
+  }
+  channel->unix_fd_ = unix_fd;
+
+  uint64_t size = 0;
+  struct iovec io_vec = {&size, sizeof(size)};
+  char control[CMSG_SPACE(sizeof(int) * kShmHandshakeFdNum)];
+  (void)memset_s(control, sizeof(control), 0, sizeof(control));
+  struct msghdr msg;
+  (void)memset_s(&msg, sizeof(msg), 0, sizeof(msg));
+  msg.msg_iov = &io_vec;
+  msg.msg_iovlen = 1;
+  msg.msg_control = control;
+  msg.msg_controllen = sizeof(control);
+  if (recvmsg(unix_fd, &msg, MSG_CMSG_CLOEXEC) != static_cast<ssize_t>(sizeof(size))) {
+    MS_LOG(WARNING) << "Failed to receive the shared memory handshake of fd: " << unix_fd << ", errno: " << errno;
+    return nullptr;
+  }
+  struct cmsghdr *cmsg = CMSG_FIRSTHDR(&msg);
+  if (cmsg == nullptr || cmsg->cmsg_level != SOL_SOCKET || cmsg->cmsg_type != SCM_RIGHTS ||
+      cmsg->cmsg_len != CMSG_LEN(sizeof(int) * kShmHandshakeFdNum)) {
+    MS_LOG(WARNING) << "Invalid shared memory handshake of fd: " << unix_fd;
+    return nullptr;
+  }
+  int fds[kShmHandshakeFdNum];
+  if (memcpy_s(fds, sizeof(fds), CMSG_DATA(cmsg), sizeof(fds)) != EOK) {
+    MS_LOG(ERROR) << "Failed to get the fds of shared memory handshake.";
+    return nullptr;
+  }
+  channel->mem_fd_ = fds[0];
+  channel->data_event_fd_ = fds[1];
+  channel->space_event_fd_ = fds[2];
+
+  if (size <= sizeof(ShmRingHeader) || !channel->MapSegment(channel->mem_fd_, size, false)) {
+    MS_LOG(WARNING) << "Failed to map the shared memory segment of size " << size;
+    return nullptr;
+  }
+  // The segment is created by another process, so check it before use.
+  if (channel->ring_->magic != SHM_RING_MAGIC || channel->capacity_ + sizeof(ShmRingHeader) != size ||
+      (channel->capacity_ & (channel->capacity_ - 1)) != 0) {
+    MS_LOG(WARNING) << "Invalid shared memory segment, magic: " << channel->ring_->magic
+                    << ", capacity: " << channel->capacity_ << ", size: " << size;
+    return nullptr;
+  }
+  channel->PrepareRecvHeader();
+  return channel;
+}
+
+bool ShmChannel::MapSegment(int mem_fd, size_t size, bool init) {
+  void *segment = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, mem_fd, 0);
+  if (segment == MAP_FAILED) {
+    return false;
+  }
+  segment_ = segment;
+  segment_size_ = size;
+  if (init) {
+    ring_ = new (segment) ShmRingHeader();
+    ring_->magic = SHM_RING_MAGIC;
+    ring_->capacity = size - sizeof(ShmRingHeader);
+    ring_->head.store(0);
+    ring_->tail.store(0);
+    ring_->producer_waiting.store(0);
+  } else {
+    ring_ = reinterpret_cast<ShmRingHeader *>(segment);
+  }
+  ring_data_ = reinterpret_cast<char *>(segment) + sizeof(ShmRingHeader);
+  capacity_ = size - sizeof(ShmRingHeader);
+  return true;
+}
+
+void ShmChannel::CopyToRing(uint64_t pos, const char *data, size_t size) {
+  size_t offset = static_cast<size_t>(pos & (capacity_ - 1));
+  size_t first = std::min(size, static_cast<size_t>(capacity_) - offset);
+  (void)memcpy_s(ring_data_ + offset, first, data, first);
+  if (first < size) {
+    (void)memcpy_s(ring_data_, size - first, data + first, size - first);
+  }
+}
+
+void ShmChannel::CopyFromRing(uint64_t pos, char *data, size_t size) const {
+  size_t offset = static_cast<size_t>(pos & (capacity_ - 1));
+  size_t first = std::min(size, static_cast<size_t>(capacity_) - offset);
+  (void)memcpy_s(data, first, ring_data_ + offset, first);
+  if (first < size) {
+    (void)memcpy_s(data + first, size - first, ring_data_, size - first);
+  }
+}
+
+bool ShmChannel::Send(MessageBase *msg) {
+  MS_EXCEPTION_IF_NULL(msg);
+  if (send_message_queue_.size() >= SENDMSG_QUEUELEN) {
+    return false;
+  }
+  send_message_queue_.push(msg);
+  DoSend();
+  return true;
+}
+
+void ShmChannel::DoSend() {
+  uint64_t head = ring_->head.load();
+  while (send_message_ != nullptr || !send_message_queue_.empty()) {
+    if (send_message_ == nullptr) {
+      FillSendMessage(send_message_queue_.front());
+      send_message_queue_.pop();
+    }
+    while (send_io_vec_index_ < send_io_vec_.size()) {
+      auto &io_vec = send_io_vec_[send_io_vec_index_];
+      if (io_vec.iov_len == 0) {
+        ++send_io_vec_index_;
+        continue;
+      }
+      uint64_t space = capacity_ - (send_tail_ - head);
+      if (space == 0) {
+        head = ring_->head.load();
+        space = capacity_ - (send_tail_ - head);
+      }
+      if (space == 0) {
+        // Let the consumer read what has been written, then wait for the space event unless the space is released
+        // after the waiting flag is set.
+        PublishTail();
+        ring_->producer_waiting.store(1);
+        head = ring_->head.load();
+        if (send_tail_ - head == capacity_) {
+          return;
+        }
+        ring_->producer_waiting.store(0);
+        continue;
+      }
+      size_t size = static_cast<size_t>(std::min(space, static_cast<uint64_t>(io_vec.iov_len)));
+      CopyToRing(send_tail_, reinterpret_cast<const char *>(io_vec.iov_base), size);
+      send_tail_ += size;
+      io_vec.iov_base = reinterpret_cast<char *>(io_vec.iov_base) + size;
+      io_vec.iov_len -= size;
+    }
+    // The buffers of buffer message are released once they are copied into the ring.
+    delete send_message_;
+    send_message_ = nullptr;
+  }
+  PublishTail();
+}
+
+void ShmChannel::FillSendMessage(MessageBase *msg) {
+  MS_EXCEPTION_IF_NULL(msg);
+  auto buffer_msg = dynamic_cast<BufferMessage *>(msg);
+  size_t body_len = msg->body.size() + (buffer_msg == nullptr ? 0 : buffer_msg->BuffersSize());
+  send_to_ = msg->to;
+  send_from_ = msg->from.Name() + "@" + advertise_url_;
+
+  // The peer is on the same host, so the header is in the host byte order.
+  send_msg_header_.name_len = static_cast<uint32_t>(msg->name.size());
+  send_msg_header_.to_len = static_cast<uint32_t>(send_to_.size());
+  send_msg_header_.from_len = static_cast<uint32_t>(send_from_.size());
+  send_msg_header_.body_len = static_cast<uint32_t>(body_len);
+
+  send_io_vec_.clear();
+  send_io_vec_.push_back({&send_msg_header_, sizeof(send_msg_header_)});
+  send_io_vec_.push_back({const_cast<char *>(msg->name.data()), msg->name.size()});
+  send_io_vec_.push_back({const_cast<char *>(send_to_.data()), send_to_.size()});
+  send_io_vec_.push_back({const_cast<char *>(send_from_.data()), send_from_.size()});
+  send_io_vec_.push_back({const_cast<char *>(msg->body.data()), msg->body.size()});
+  if (buffer_msg != nullptr) {
+    for (const auto &buffer : buffer_msg->buffers()) {
+      send_io_vec_.push_back({buffer.data, buffer.size});
+    }
+  }
+  send_io_vec_index_ = 0;
+  send_message_ = msg;
+}
+
+void ShmChannel::PublishTail() {
+  if (send_tail_ == published_tail_) {
+    return;
+  }
+  uint64_t last_tail = published_tail_;
+  ring_->tail.store(send_tail_);
+  published_tail_ = send_tail_;
+  // The consumer which has read all the bytes published before may be waiting for the data event.
+  if (ring_->head.load() == last_tail) {
+    Notify(data_event_fd_);
+  }
+}
+
+void ShmChannel::SetMessageHandler(MessageHandler handler, MemAllocateCallback allocate_callback,
+                                   MemFreeCallback free_callback) {
+  message_handler_ = handler;
+  mem_allocate_callback_ = allocate_callback;
+  mem_free_callback_ = free_callback;
+}
+
+int ShmChannel::Receive() {
+  int count = 0;
+  while (true) {
+    if (recv_head_ == recv_tail_) {
+      // Release the read bytes before reloading the tail, so the producer notifies the data event if it writes after
+      // the tail is loaded.
+      ReleaseHead();
+      recv_tail_ = ring_->tail.load();
+      if (recv_head_ == recv_tail_) {
+        return count;
+      }
+      if (recv_tail_ - recv_head_ > capacity_) {
+        MS_LOG(ERROR) << "Invalid shared memory ring, head: " << recv_head_ << ", tail: " << recv_tail_;
+        return -1;
+      }
+    }
+    while (recv_io_vec_index_ < recv_io_vec_.size() && recv_head_ != recv_tail_) {
+      auto &io_vec = recv_io_vec_[recv_io_vec_index_];
+      if (io_vec.iov_len == 0) {
+        ++recv_io_vec_index_;
+        continue;
+      }
+      size_t size = static_cast<size_t>(std::min(recv_tail_ - recv_head_, static_cast<uint64_t>(io_vec.iov_len)));
+      CopyFromRing(recv_head_, reinterpret_cast<char *>(io_vec.iov_base), size);
+      recv_head_ += size;
+      io_vec.iov_base = reinterpret_cast<char *>(io_vec.iov_base) + size;
+      io_vec.iov_len -= size;
+    }
+    // Let the producer reuse the space while the large message is streamed.
+    ReleaseHead();
+    while (recv_io_vec_index_ < recv_io_vec_.size() && recv_io_vec_[recv_io_vec_index_].iov_len == 0) {
+      ++recv_io_vec_index_;
+    }
+    if (recv_io_vec_index_ < recv_io_vec_.size()) {
+      continue;
+    }
+
+    if (recv_state_ == State::kMsgHeader) {
+      if (!FillRecvMessage()) {
+        return -1;
+      }
+      recv_state_ = State::kBody;
+      continue;
+    }
+    std::unique_ptr<MessageBase> msg(recv_message_);
+    recv_message_ = nullptr;
+    if (message_handler_ != nullptr) {
+      message_handler_(std::move(msg));
+    } else {
+      MS_LOG(INFO) << "Message handler was not found";
+    }
+    ++count;
+    PrepareRecvHeader();
+  }
+}
+
+bool ShmChannel::FillRecvMessage() {
+  if (strncmp(recv_msg_header_.magic, RPC_MAGICID, sizeof(RPC_MAGICID) - 1) != 0) {
+    MS_LOG(ERROR) << "Failed to check magicid of the shared memory message.";
+    return false;
+  }
+  size_t name_len = static_cast<size_t>(recv_msg_header_.name_len);
+  size_t to_len = static_cast<size_t>(recv_msg_header_.to_len);
+  size_t from_len = static_cast<size_t>(recv_msg_header_.from_len);
+  size_t body_len = static_cast<size_t>(recv_msg_header_.body_len);
+  if (name_len > MAX_KMSG_NAME_LEN || to_len > MAX_KMSG_TO_LEN || from_len > MAX_KMSG_FROM_LEN ||
+      body_len > MAX_KMSG_BODY_LEN) {
+    MS_LOG(ERROR) << "Drop invalid shared memory data.";
+    return false;
+  }
+
+  void *body_data = nullptr;
+  MessageBase *msg = CreateRecvMessage(body_len, mem_allocate_callback_, mem_free_callback_, &body_data);
+  msg->name.resize(name_len);
+  recv_to_.resize(to_len);
+  recv_from_.resize(from_len);
+
+  recv_io_vec_.clear();
+  recv_io_vec_.push_back({const_cast<char *>(msg->name.data()), msg->name.size()});
+  recv_io_vec_.push_back({const_cast<char *>(recv_to_.data()), recv_to_.size()});
+  recv_io_vec_.push_back({const_cast<char *>(recv_from_.data()), recv_from_.size()});
+  recv_io_vec_.push_back({body_data, body_len});
+  recv_io_vec_index_ = 0;
+  recv_message_ = msg;
+  return true;
+}
+
+void ShmChannel::ReleaseHead() {
+  ring_->head.store(recv_head_);
+  // The producer sets the waiting flag before checking the head again, so one of them sees the other.
+  if (ring_->producer_waiting.load() != 0 && ring_->producer_waiting.exchange(0) != 0) {
+    Notify(space_event_fd_);
+  }
+}
+
+void ShmChannel::PrepareRecvHeader() {
+  recv_state_ = State::kMsgHeader;
+  recv_io_vec_.clear();
+  recv_io_vec_.push_back({&recv_msg_header_, sizeof(recv_msg_header_)});
+  recv_io_vec_index_ = 0;
+}
+
+void ShmChannel::Notify(int event_fd) {
+  uint64_t value = 1;
+  if (write(event_fd, &value, sizeof(value)) != static_cast<ssize_t>(sizeof(value)) && errno != EAGAIN) {
+    MS_LOG(ERROR) << "Failed to notify the event fd: " << event_fd << ", errno: " << errno;
+  }
+}
+}  // namespace rpc
+}  // namespace distributed
+}  // namespace mindspore
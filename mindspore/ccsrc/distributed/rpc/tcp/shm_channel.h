@@ -0,0 +1,154 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_DISTRIBUTED_RPC_TCP_SHM_CHANNEL_H_
+#define MINDSPORE_CCSRC_DISTRIBUTED_RPC_TCP_SHM_CHANNEL_H_
+
+#include <sys/uio.h>
+#include <atomic>
+#include <memory>
+#include <queue>
+#include <string>
+#include <vector>
+
+#include "actor/msg.h"
+#include "distributed/rpc/tcp/constants.h"
+#include "distributed/rpc/tcp/connection.h"
+
+namespace mindspore {
+namespace distributed {
+namespace rpc {
+/*
+ * The header of the ring in the shared memory segment. The head and tail are the total bytes read by the consumer and
+ * written by the producer, and the ring is empty if they are equal.
+ */
+struct ShmRingHeader {
+  uint64_t magic;
+  uint64_t capacity;
+  alignas(64) std::atomic<uint64_t> head;
+  alignas(64) std::atomic<uint64_t> tail;
+  // Set by the producer when the ring is full, then the consumer notifies the space event fd after reading.
+  alignas(64) std::atomic<uint32_t> producer_waiting;
+};
+
+/*
+ * The ShmChannel transfers the messages from one process to another process on the same host by a single producer
+ * single consumer byte ring in a memfd backed shared memory segment. The messages are framed in the ring as the tcp
+ * connection does, so the message larger than the ring is streamed through it. The producer creates the segment and
+ * two event fds, and hands them to the consumer by the unix socket listened by the server address:
+ * data event fd: notified by the producer when the ring becomes not empty.
+ * space event fd: notified by the consumer when the producer waits for the space of full ring.
+ * The producer side is operated in the send event loop thread, and the consumer side in the recv event loop thread.
+ */
+class ShmChannel {
+ public:
+  ~ShmChannel();
+  ShmChannel(const ShmChannel &) = delete;
+  ShmChannel &operator=(const ShmChannel &) = delete;
+
+  // Listen on the unix socket of the server address(ip:port) for the channels from the same host.
+  static int Listen(const std::string &address);
+
+  // Create the producer side of the channel to the server address, return nullptr if the server is not on this host.
+  // The source of the sent messages is advertised by the url as the tcp connection does.
+  static std::unique_ptr<ShmChannel> Connect(const std::string &address, const std::string &advertise_url);
+
+  // Create the consumer side of the channel by the segment and event fds received from the accepted unix socket, which
+  // is called when the handshake is readable and doesn't wait for it. The unix socket is owned by the channel even if
+  // it fails.
+  static std::unique_ptr<ShmChannel> Accept(int unix_fd);
+
+  // Producer side: take the ownership of the message and write it to the ring as much as possible.
+  bool Send(MessageBase *msg);
+  // Producer side: continue to write the pending messages after the space event is notified.
+  void DoSend();
+
+  // Consumer side: read the ring and call the message handler for the completed messages, return -1 if the data is
+  // invalid.
+  int Receive();
+  void SetMessageHandler(MessageHandler handler, MemAllocateCallback allocate_callback, MemFreeCallback free_callback);
+
+  int unix_fd() const { return unix_fd_; }
+  int data_event_fd() const { return data_event_fd_; }
+  int space_event_fd() const { return space_event_fd_; }
+
+ private:
+  ShmChannel() = default;
+
+  // Map the segment of the memfd, the ring header is initialized by the producer.
+  bool MapSegment(int mem_fd, size_t size, bool init);
+
+  // Copy the bytes between the ring and the buffer at the position of the ring.
+  void CopyToRing(uint64_t pos, const char *data, size_t size);
+  void CopyFromRing(uint64_t pos, char *data, size_t size) const;
+
+  // Fill the iovecs of the message to be written or read.
+  void FillSendMessage(MessageBase *msg);
+  bool FillRecvMessage();
+
+  // Publish the written bytes to the consumer, and notify it if it has read all the bytes published before.
+  void PublishTail();
+  // Release the read bytes to the producer, and notify it if it waits for the space.
+  void ReleaseHead();
+
+  // Wait for the header of next message.
+  void PrepareRecvHeader();
+
+  static void Notify(int event_fd);
+
+  int unix_fd_{-1};
+  int mem_fd_{-1};
+  int data_event_fd_{-1};
+  int space_event_fd_{-1};
+
+  // The mapped segment.
+  void *segment_{nullptr};
+  size_t segment_size_{0};
+  ShmRingHeader *ring_{nullptr};
+  char *ring_data_{nullptr};
+  uint64_t capacity_{0};
+
+  // The producer side.
+  std::string advertise_url_;
+  uint64_t send_tail_{0};
+  uint64_t published_tail_{0};
+  std::queue<MessageBase *> send_message_queue_;
+  MessageBase *send_message_{nullptr};
+  MessageHeader send_msg_header_;
+  std::string send_to_;
+  std::string send_from_;
+  std::vector<struct iovec> send_io_vec_;
+  size_t send_io_vec_index_{0};
+
+  // The consumer side.
+  MessageHandler message_handler_{nullptr};
+  MemAllocateCallback mem_allocate_callback_{nullptr};
+  MemFreeCallback mem_free_callback_{nullptr};
+  uint64_t recv_head_{0};
+  uint64_t recv_tail_{0};
+  State recv_state_{State::kMsgHeader};
+  MessageBase *recv_message_{nullptr};
+  MessageHeader recv_msg_header_;
+  std::string recv_to_;
+  std::string recv_from_;
+  std::vector<struct iovec> recv_io_vec_;
+  size_t recv_io_vec_index_{0};
+};
+}  // namespace rpc
+}  // namespace distributed
+}  // namespace mindspore
+
+#endif
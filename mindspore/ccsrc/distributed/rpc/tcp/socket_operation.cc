@@ -67,6 +67,16 @@ int SocketOperation::SetSocketKeepAlive(int fd, int keepalive, int keepidle, int
   return 0;
 }
 
+int SocketOperation::SetBusyPoll(int sock_fd, int busy_poll_usec) {
+  int option_val = busy_poll_usec;
+  int ret = setsockopt(sock_fd, SOL_SOCKET, SO_BUSY_POLL, &option_val, sizeof(option_val));
+  if (ret < 0) {
+    MS_LOG(ERROR) << "Failed to call setsockopt SO_BUSY_POLL, fd: " << sock_fd << ", errno:" << errno;
+    return -1;
+  }
+  return 0;
+}
+
 int SocketOperation::SetSocketOptions(int sock_fd) {
   int option_val = 1;
   int ret = 0;
@@ -283,7 +293,7 @@ int SocketOperation::Connect(int sock_fd, const struct sockaddr *sa, socklen_t s
   return RPC_OK;
 }
 
-int SocketOperation::Listen(const std::string &url) {
+int SocketOperation::Listen(const std::string &url, bool reuse_port) {
   int listenFd = 0;
   SocketAddress addr;
 
@@ -298,6 +308,17 @@ int SocketOperation::Listen(const std::string &url) {
     return -1;
   }
 
+  if (reuse_port) {
+    int option_val = 1;
+    if (setsockopt(listenFd, SOL_SOCKET, SO_REUSEPORT, &option_val, sizeof(option_val))) {
+      MS_LOG(ERROR) << "Failed to call setsockopt SO_REUSEPORT, fd: " << listenFd << ", errno:" << errno;
+      if (close(listenFd) != 0) {
+        MS_LOG(EXCEPTION) << "Failed to close fd:" << listenFd;
+      }
+      return -1;
+    }
+  }
+
   // bind
   if (::bind(listenFd, (struct sockaddr *)&addr, sizeof(SocketAddress))) {
     MS_LOG(ERROR) << "Failed to call bind, url: " << url.c_str();
@@ -54,6 +54,8 @@ class SocketOperation {
   // Set socket options.
   static int SetSocketOptions(int sock_fd);
   static int SetSocketKeepAlive(int fd, int keepalive, int keepidle, int keepinterval, int keepcount);
+  // Busy poll the device queue for the microseconds when receiving on the socket.
+  static int SetBusyPoll(int sock_fd, int busy_poll_usec);
 
   // Connect to the Socket sock_fd.
   static int Connect(int sock_fd, const struct sockaddr *sa, socklen_t saLen, uint16_t *boundPort);
@@ -61,8 +63,9 @@ class SocketOperation {
   // Close the given connection.
   virtual void Close(Connection *connection) = 0;
 
-  // Start and listen on the socket represented by the given url.
-  static int Listen(const std::string &url);
+  // Start and listen on the socket represented by the given url, the port can be listened by multiple sockets if
+  // reuse_port is true.
+  static int Listen(const std::string &url, bool reuse_port = false);
 
   // Accept connection on the server socket.
   static int Accept(int sock_fd);
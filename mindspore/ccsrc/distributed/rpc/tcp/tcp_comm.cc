@@ -16,17 +16,39 @@
 
 #include "distributed/rpc/tcp/tcp_comm.h"
 
+#include <sys/socket.h>
+#include <unistd.h>
 #include <mutex>
 #include <utility>
 #include <memory>
+#include <string>
 
 #include "actor/aid.h"
 #include "distributed/rpc/tcp/constants.h"
 #include "distributed/rpc/tcp/tcp_socket_operation.h"
+#include "utils/ms_utils.h"
 
 namespace mindspore {
 namespace distributed {
 namespace rpc {
+namespace {
+bool IsShmUrl(const std::string &url) { return url.compare(0, sizeof(SHM_URL_PREFIX) - 1, SHM_URL_PREFIX) == 0; }
+
+// Drain the counter of the event fd, the events of the shared memory channel are level triggered.
+void DrainEventFd(int event_fd) {
+  uint64_t count = 0;
+  if (read(event_fd, &count, sizeof(count)) < 0 && errno != EAGAIN) {
+    MS_LOG(ERROR) << "Failed to read the event fd: " << event_fd << ", errno: " << errno;
+  }
+}
+
+void DeleteShmSendChannel(Reactor *reactor, std::map<std::string, std::unique_ptr<ShmChannel>>::iterator iter) {
+  (void)reactor->send_event_loop->DeleteEpollEvent(iter->second->space_event_fd());
+  (void)reactor->send_event_loop->DeleteEpollEvent(iter->second->unix_fd());
+  (void)reactor->shm_send_channels.erase(iter);
+}
+}  // namespace
+
 void DoDisconnect(int fd, Connection *conn, uint32_t error, int soError) {
   if (LOG_CHECK_EVERY_N()) {
     MS_LOG(INFO) << "Failed to call connect, fd: " << fd << ", to: " << conn->destination.c_str()
@@ -67,7 +89,7 @@ void OnAccept(int server, uint32_t events, void *arg) {
     return;
   }
   TCPComm *tcpmgr = reinterpret_cast<TCPComm *>(arg);
-  if (tcpmgr->recv_event_loop_ == nullptr) {
+  if (tcpmgr->reactors_.empty()) {
     MS_LOG(ERROR) << "EventLoop is null, server fd: " << server << ", events: " << events;
     return;
   }
@@ -104,13 +126,28 @@ void OnAccept(int server, uint32_t events, void *arg) {
   conn->socket_fd = acceptFd;
   conn->source = tcpmgr->url_;
   conn->peer = SocketOperation::GetPeer(acceptFd);
+  tcpmgr->SetBusyPoll(acceptFd);
+
+  // The accepted connection is driven by the reactor listening on the server socket if SO_REUSEPORT is enabled,
+  // otherwise it is assigned by the socket fd.
+  Reactor *reactor = tcpmgr->GetReactor(acceptFd);
+  if (tcpmgr->reuse_port_) {
+    for (auto &server_reactor : tcpmgr->reactors_) {
+      if (server_reactor.server_fd == server) {
+        reactor = &server_reactor;
+        break;
+      }
+    }
+  }
 
   conn->is_remote = true;
-  conn->recv_event_loop = tcpmgr->recv_event_loop_;
-  conn->send_event_loop = tcpmgr->send_event_loop_;
+  conn->recv_event_loop = reactor->recv_event_loop;
+  conn->send_event_loop = reactor->send_event_loop;
 
-  conn->conn_mutex = tcpmgr->conn_mutex_;
+  conn->conn_mutex = reactor->conn_mutex;
   conn->message_handler = tcpmgr->message_handler_;
+  conn->mem_allocate_callback = tcpmgr->mem_allocate_callback_;
+  conn->mem_free_callback = tcpmgr->mem_free_callback_;
 
   conn->event_callback = TCPComm::EventCallBack;
   conn->write_callback = TCPComm::WriteCallBack;
@@ -170,52 +207,131 @@ TCPComm::~TCPComm() {
 
 void TCPComm::SetMessageHandler(MessageHandler handler) { message_handler_ = handler; }
 
+void TCPComm::SetMemAllocator(MemAllocateCallback allocate_callback, MemFreeCallback free_callback) {
+  mem_allocate_callback_ = allocate_callback;
+  mem_free_callback_ = free_callback;
+}
+
+void TCPComm::ParseReactorOptions() {
+  auto reactor_num_env = common::GetEnv("MS_DEV_RPC_REACTOR_NUM");
+  if (!reactor_num_env.empty()) {
+    try {
+      reactor_num_ = std::stoul(reactor_num_env);
+    } catch (const std::exception &e) {
+      MS_LOG(EXCEPTION) << "Invalid MS_DEV_RPC_REACTOR_NUM: " << reactor_num_env << ", error: " << e.what();
+    }
+    if (reactor_num_ == 0 || reactor_num_ > MAX_REACTOR_NUM) {
+      MS_LOG(EXCEPTION) << "Invalid MS_DEV_RPC_REACTOR_NUM: " << reactor_num_env << ", the range is [1, "
+                        << MAX_REACTOR_NUM << "].";
+    }
+  }
+  reuse_port_ = (common::GetEnv("MS_DEV_RPC_REUSE_PORT") == "1");
+
+  auto busy_poll_env = common::GetEnv("MS_DEV_RPC_BUSY_POLL");
+  if (!busy_poll_env.empty()) {
+    try {
+      busy_poll_usec_ = std::stoi(busy_poll_env);
+    } catch (const std::exception &e) {
+      MS_LOG(EXCEPTION) << "Invalid MS_DEV_RPC_BUSY_POLL: " << busy_poll_env << ", error: " << e.what();
+    }
+  }
+  MS_LOG(INFO) << "The rpc reactor number: " << reactor_num_ << ", reuse port: " << reuse_port_
+               << ", busy poll usec: " << busy_poll_usec_;
+}
+
 bool TCPComm::Initialize() {
-  conn_pool_ = std::make_shared<ConnectionPool>();
-  MS_EXCEPTION_IF_NULL(conn_pool_);
+  ParseReactorOptions();
+  reactors_.resize(reactor_num_);
+  for (size_t i = 0; i < reactor_num_; ++i) {
+    if (!InitializeReactor(&reactors_[i], i)) {
+      Finalize();
+      reactors_.clear();
+      return false;
+    }
+  }
+  return true;
+}
 
-  conn_mutex_ = std::make_shared<std::mutex>();
-  MS_EXCEPTION_IF_NULL(conn_mutex_);
+bool TCPComm::InitializeReactor(Reactor *reactor, size_t index) {
+  MS_EXCEPTION_IF_NULL(reactor);
+  reactor->conn_pool = std::make_shared<ConnectionPool>();
+  MS_EXCEPTION_IF_NULL(reactor->conn_pool);
 
-  recv_event_loop_ = new (std::nothrow) EventLoop();
-  if (recv_event_loop_ == nullptr) {
+  reactor->conn_mutex = std::make_shared<std::mutex>();
+  MS_EXCEPTION_IF_NULL(reactor->conn_mutex);
+
+  // The thread name is limited to 15 characters, so the threads of other reactors are named by the short prefix.
+  std::string recv_thread_name =
+    (index == 0) ? TCP_RECV_EVLOOP_THREADNAME : TCP_RECV_REACTOR_THREADNAME + std::to_string(index);
+  std::string send_thread_name =
+    (index == 0) ? TCP_SEND_EVLOOP_THREADNAME : TCP_SEND_REACTOR_THREADNAME + std::to_string(index);
+
+  reactor->recv_event_loop = new (std::nothrow) EventLoop();
+  if (reactor->recv_event_loop == nullptr) {
     MS_LOG(ERROR) << "Failed to create recv evLoop.";
     return false;
   }
-
-  bool ok = recv_event_loop_->Initialize(TCP_RECV_EVLOOP_THREADNAME);
-  if (!ok) {
+  if (!reactor->recv_event_loop->Initialize(recv_thread_name)) {
     MS_LOG(ERROR) << "Failed to init recv evLoop";
-    delete recv_event_loop_;
-    recv_event_loop_ = nullptr;
     return false;
   }
 
-  send_event_loop_ = new (std::nothrow) EventLoop();
-  if (send_event_loop_ == nullptr) {
+  reactor->send_event_loop = new (std::nothrow) EventLoop();
+  if (reactor->send_event_loop == nullptr) {
     MS_LOG(ERROR) << "Failed to create send evLoop.";
-    delete recv_event_loop_;
-    recv_event_loop_ = nullptr;
     return false;
   }
-  ok = send_event_loop_->Initialize(TCP_SEND_EVLOOP_THREADNAME);
-  if (!ok) {
+  if (!reactor->send_event_loop->Initialize(send_thread_name)) {
     MS_LOG(ERROR) << "Failed to init send evLoop";
-    delete recv_event_loop_;
-    recv_event_loop_ = nullptr;
-    delete send_event_loop_;
-    send_event_loop_ = nullptr;
     return false;
   }
-
   return true;
 }
 
+Reactor *TCPComm::GetReactor(const std::string &dst_url) {
+  if (reactors_.empty()) {
+    MS_LOG(EXCEPTION) << "The tcp comm is not initialized.";
+  }
+  return &reactors_[std::hash<std::string>()(dst_url) % reactors_.size()];
+}
+
+Reactor *TCPComm::GetReactor(int sock_fd) {
+  if (reactors_.empty()) {
+    MS_LOG(EXCEPTION) << "The tcp comm is not initialized.";
+  }
+  return &reactors_[IntToSize(sock_fd) % reactors_.size()];
+}
+
+void TCPComm::SetBusyPoll(int sock_fd) const {
+  if (busy_poll_usec_ <= 0) {
+    return;
+  }
+  // Raising SO_BUSY_POLL above the system default needs CAP_NET_ADMIN, the connection works without it.
+  if (SocketOperation::SetBusyPoll(sock_fd, busy_poll_usec_) != 0) {
+    MS_LOG(WARNING) << "Failed to set busy poll " << busy_poll_usec_ << " us for fd: " << sock_fd;
+  }
+}
+
 bool TCPComm::StartServerSocket(const std::string &url) {
-  server_fd_ = SocketOperation::Listen(url);
-  if (server_fd_ < 0) {
-    MS_LOG(ERROR) << "Failed to call socket listen, url: " << url.c_str();
-    return false;
+  // Every reactor listens on the server port by itself if SO_REUSEPORT is enabled, and the kernel balances the new
+  // connections between them.
+  size_t listen_num = reuse_port_ ? reactors_.size() : 1;
+  for (size_t i = 0; i < listen_num; ++i) {
+    auto &reactor = reactors_[i];
+    reactor.server_fd = SocketOperation::Listen(url, reuse_port_);
+    if (reactor.server_fd < 0) {
+      MS_LOG(ERROR) << "Failed to call socket listen, url: " << url.c_str();
+      return false;
+    }
+
+    // Register read event callback for server socket
+    int retval = reactor.recv_event_loop->SetEventHandler(reactor.server_fd, EPOLLIN | EPOLLHUP | EPOLLERR, OnAccept,
+                                                          reinterpret_cast<void *>(this));
+    if (retval != RPC_OK) {
+      MS_LOG(ERROR) << "Failed to add server event, url: " << url.c_str();
+      return false;
+    }
+    MS_LOG(INFO) << "Start server succ, fd: " << reactor.server_fd << ", url: " << url.c_str();
   }
   url_ = url;
   size_t index = url.find(URL_PROTOCOL_IP_SEPARATOR);
@@ -223,14 +339,138 @@ bool TCPComm::StartServerSocket(const std::string &url) {
     url_ = url.substr(index + sizeof(URL_PROTOCOL_IP_SEPARATOR) - 1);
   }
 
-  // Register read event callback for server socket
-  int retval = recv_event_loop_->SetEventHandler(server_fd_, EPOLLIN | EPOLLHUP | EPOLLERR, OnAccept,
-                                                 reinterpret_cast<void *>(this));
-  if (retval != RPC_OK) {
-    MS_LOG(ERROR) << "Failed to add server event, url: " << url.c_str();
+  // The clients on the same host find the shared memory server by the address, and the others connect by tcp.
+  if (IsShmUrl(url)) {
+    shm_server_fd_ = ShmChannel::Listen(url_);
+    if (shm_server_fd_ < 0 ||
+        reactors_[0].recv_event_loop->SetEventHandler(shm_server_fd_, EPOLLIN | EPOLLHUP | EPOLLERR, OnShmAccept,
+                                                      reinterpret_cast<void *>(this)) != RPC_OK) {
+      MS_LOG(WARNING) << "Failed to start the shared memory server, the clients connect by tcp, url: " << url;
+      return true;
+    }
+    MS_LOG(INFO) << "Start shared memory server succ, fd: " << shm_server_fd_ << ", url: " << url;
+  }
+  return true;
+}
+
+void TCPComm::OnShmAccept(int server, uint32_t events, void *arg) {
+  if (events & (EPOLLHUP | EPOLLERR)) {
+    MS_LOG(ERROR) << "Invalid error event, shared memory server fd: " << server << ", events: " << events;
+    return;
+  }
+  TCPComm *tcpmgr = reinterpret_cast<TCPComm *>(arg);
+  int unix_fd = accept4(server, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+  if (unix_fd < 0) {
+    MS_LOG(ERROR) << "Failed to call accept, shared memory server fd: " << server << ", errno: " << errno;
+    return;
+  }
+
+  // The handshake is read when it arrives instead of waiting for it here, so a slow client doesn't block the loop.
+  Reactor *reactor = tcpmgr->GetReactor(unix_fd);
+  std::lock_guard<std::mutex> lock(*reactor->conn_mutex);
+  (void)reactor->shm_handshake_fds.insert(unix_fd);
+  if (reactor->recv_event_loop->SetEventHandler(unix_fd, EPOLLIN | EPOLLHUP | EPOLLRDHUP | EPOLLERR, OnShmHandshake,
+                                                arg) != RPC_OK) {
+    MS_LOG(ERROR) << "Failed to add shared memory handshake event, unix fd: " << unix_fd;
+    (void)reactor->shm_handshake_fds.erase(unix_fd);
+    if (close(unix_fd) != 0) {
+      MS_LOG(ERROR) << "Failed to close fd: " << unix_fd;
+    }
+  }
+}
+
+void TCPComm::OnShmHandshake(int unix_fd, uint32_t events, void *arg) {
+  TCPComm *tcpmgr = reinterpret_cast<TCPComm *>(arg);
+  Reactor *reactor = tcpmgr->GetReactor(unix_fd);
+  std::lock_guard<std::mutex> lock(*reactor->conn_mutex);
+  if (reactor->shm_handshake_fds.erase(unix_fd) == 0) {
+    return;
+  }
+  (void)reactor->recv_event_loop->DeleteEpollEvent(unix_fd);
+  if ((events & EPOLLIN) == 0) {
+    MS_LOG(WARNING) << "The shared memory client is closed before the handshake, unix fd: " << unix_fd
+                    << ", events: " << events;
+    if (close(unix_fd) != 0) {
+      MS_LOG(ERROR) << "Failed to close fd: " << unix_fd;
+    }
+    return;
+  }
+  // The handshake is sent in one message, so it is received completely once readable.
+  auto channel = ShmChannel::Accept(unix_fd);
+  if (channel == nullptr) {
+    return;
+  }
+  channel->SetMessageHandler(tcpmgr->message_handler_, tcpmgr->mem_allocate_callback_, tcpmgr->mem_free_callback_);
+
+  ShmChannel *channel_ptr = channel.get();
+  (void)reactor->shm_recv_channels.emplace(unix_fd, std::move(channel));
+  if (reactor->recv_event_loop->SetEventHandler(channel_ptr->data_event_fd(), EPOLLIN, ShmReadCallBack,
+                                                reinterpret_cast<void *>(channel_ptr)) != RPC_OK ||
+      reactor->recv_event_loop->SetEventHandler(unix_fd, EPOLLHUP | EPOLLRDHUP | EPOLLERR, ShmCloseCallBack,
+                                                reinterpret_cast<void *>(reactor)) != RPC_OK) {
+    MS_LOG(ERROR) << "Failed to add shared memory channel event, unix fd: " << unix_fd;
+    (void)reactor->recv_event_loop->DeleteEpollEvent(channel_ptr->data_event_fd());
+    (void)reactor->recv_event_loop->DeleteEpollEvent(unix_fd);
+    (void)reactor->shm_recv_channels.erase(unix_fd);
+    return;
+  }
+  MS_LOG(INFO) << "Accept shared memory channel, unix fd: " << unix_fd;
+}
+
+void TCPComm::ShmReadCallBack(int fd, uint32_t, void *channel) {
+  // Drain the event before reading the ring, so the data written after reading is notified again.
+  DrainEventFd(fd);
+  ShmChannel *shm_channel = reinterpret_cast<ShmChannel *>(channel);
+  if (shm_channel->Receive() < 0) {
+    // The channel is closed by the close event of the unix socket.
+    MS_LOG(ERROR) << "Invalid shared memory data, close the channel of unix fd: " << shm_channel->unix_fd();
+    (void)shutdown(shm_channel->unix_fd(), SHUT_RDWR);
+  }
+}
+
+void TCPComm::ShmWriteCallBack(int fd, uint32_t, void *channel) {
+  DrainEventFd(fd);
+  reinterpret_cast<ShmChannel *>(channel)->DoSend();
+}
+
+void TCPComm::ShmCloseCallBack(int fd, uint32_t events, void *arg) {
+  Reactor *reactor = reinterpret_cast<Reactor *>(arg);
+  std::lock_guard<std::mutex> lock(*reactor->conn_mutex);
+  auto recv_iter = reactor->shm_recv_channels.find(fd);
+  if (recv_iter != reactor->shm_recv_channels.end()) {
+    MS_LOG(INFO) << "The shared memory client is closed, unix fd: " << fd << ", events: " << events;
+    // Deliver the messages written before the client is closed.
+    (void)recv_iter->second->Receive();
+    (void)reactor->recv_event_loop->DeleteEpollEvent(recv_iter->second->data_event_fd());
+    (void)reactor->recv_event_loop->DeleteEpollEvent(fd);
+    (void)reactor->shm_recv_channels.erase(recv_iter);
+    return;
+  }
+  for (auto iter = reactor->shm_send_channels.begin(); iter != reactor->shm_send_channels.end(); ++iter) {
+    if (iter->second->unix_fd() == fd) {
+      MS_LOG(INFO) << "The shared memory server is closed, url: " << iter->first << ", events: " << events;
+      DeleteShmSendChannel(reactor, iter);
+      return;
+    }
+  }
+}
+
+bool TCPComm::ConnectShm(Reactor *reactor, const std::string &dst_url) {
+  auto channel = ShmChannel::Connect(dst_url.substr(sizeof(SHM_URL_PREFIX) - 1), url_);
+  if (channel == nullptr) {
+    return false;
+  }
+  ShmChannel *channel_ptr = channel.get();
+  if (reactor->send_event_loop->SetEventHandler(channel_ptr->space_event_fd(), EPOLLIN, ShmWriteCallBack,
+                                                reinterpret_cast<void *>(channel_ptr)) != RPC_OK ||
+      reactor->send_event_loop->SetEventHandler(channel_ptr->unix_fd(), EPOLLHUP | EPOLLRDHUP | EPOLLERR,
+                                                ShmCloseCallBack, reinterpret_cast<void *>(reactor)) != RPC_OK) {
+    MS_LOG(ERROR) << "Failed to add shared memory channel event, destination: " << dst_url;
+    (void)reactor->send_event_loop->DeleteEpollEvent(channel_ptr->space_event_fd());
+    (void)reactor->send_event_loop->DeleteEpollEvent(channel_ptr->unix_fd());
     return false;
   }
-  MS_LOG(INFO) << "Start server succ, fd: " << server_fd_ << ", url: " << url.c_str();
+  reactor->shm_send_channels[dst_url] = std::move(channel);
   return true;
 }
 
@@ -346,10 +586,34 @@ void TCPComm::DropMessage(MessageBase *msg) {
 }
 
 int TCPComm::Send(MessageBase *msg) {
-  return send_event_loop_->AddTask([msg, this] {
-    std::lock_guard<std::mutex> lock(*conn_mutex_);
+  Reactor *reactor = GetReactor(msg->to.Url());
+  return reactor->send_event_loop->AddTask([msg, reactor, this] {
+    std::lock_guard<std::mutex> lock(*reactor->conn_mutex);
+    // The buffers beyond the iovec number of sendmsg or the body size of receiver can't be sent.
+    auto buffer_msg = dynamic_cast<BufferMessage *>(msg);
+    if (buffer_msg != nullptr && (buffer_msg->buffers().size() + SEND_MSG_IO_VEC_LEN > MAX_SEND_MSG_IO_VEC_LEN ||
+                                  buffer_msg->BuffersSize() + msg->body.size() > MAX_KMSG_BODY_LEN)) {
+      MS_LOG(ERROR) << "The buffer message is too large, buffer number: " << buffer_msg->buffers().size()
+                    << ", size: " << buffer_msg->BuffersSize() + msg->body.size()
+                    << " and the name of dropped message is: " << msg->name.c_str();
+      DropMessage(msg);
+      return;
+    }
+
+    // The server on the same host is sent by shared memory.
+    auto shm_iter = reactor->shm_send_channels.find(msg->to.Url());
+    if (shm_iter != reactor->shm_send_channels.end()) {
+      if (!shm_iter->second->Send(msg)) {
+        MS_LOG(WARNING) << "The message queue is full(max len:" << SENDMSG_QUEUELEN
+                        << ") and the name of dropped message is: " << msg->name.c_str()
+                        << ", to: " << shm_iter->first;
+        DropMessage(msg);
+      }
+      return;
+    }
+
     // Search connection by the target address
-    Connection *conn = conn_pool_->FindConnection(msg->to.Url());
+    Connection *conn = reactor->conn_pool->FindConnection(msg->to.Url());
     if (conn == nullptr) {
       MS_LOG(ERROR) << "Can not found remote link and send fail name: " << msg->name.c_str()
                     << ", from: " << msg->from.Url().c_str() << ", to: " << msg->to.Url().c_str();
@@ -383,11 +647,19 @@ int TCPComm::Send(MessageBase *msg) {
 }
 
 void TCPComm::Connect(const std::string &dst_url) {
-  (void)recv_event_loop_->AddTask([dst_url, this] {
-    std::lock_guard<std::mutex> lock(*conn_mutex_);
+  Reactor *reactor = GetReactor(dst_url);
+  (void)reactor->recv_event_loop->AddTask([dst_url, reactor, this] {
+    std::lock_guard<std::mutex> lock(*reactor->conn_mutex);
+
+    // Connect the server on the same host by shared memory, otherwise fall back to tcp.
+    if (IsShmUrl(dst_url) &&
+        (reactor->shm_send_channels.count(dst_url) > 0 || ConnectShm(reactor, dst_url))) {
+      MS_LOG(INFO) << "Connected to destination by shared memory: " << dst_url;
+      return;
+    }
 
     // Search connection by the target address
-    Connection *conn = conn_pool_->FindConnection(dst_url);
+    Connection *conn = reactor->conn_pool->FindConnection(dst_url);
 
     if (conn == nullptr) {
       MS_LOG(INFO) << "Can not found link destination: " << dst_url;
@@ -399,10 +671,12 @@ void TCPComm::Connect(const std::string &dst_url) {
       conn->source = url_;
       conn->destination = dst_url;
 
-      conn->recv_event_loop = this->recv_event_loop_;
-      conn->send_event_loop = this->send_event_loop_;
-      conn->conn_mutex = conn_mutex_;
+      conn->recv_event_loop = reactor->recv_event_loop;
+      conn->send_event_loop = reactor->send_event_loop;
+      conn->conn_mutex = reactor->conn_mutex;
       conn->message_handler = message_handler_;
+      conn->mem_allocate_callback = mem_allocate_callback_;
+      conn->mem_free_callback = mem_free_callback_;
       conn->InitSocketOperation();
 
       // Create the client socket.
@@ -416,6 +690,7 @@ void TCPComm::Connect(const std::string &dst_url) {
         MS_LOG(ERROR) << "Failed to create client tcp socket to dest url " << dst_url;
         return;
       }
+      SetBusyPoll(sock_fd);
 
       conn->socket_fd = sock_fd;
       conn->event_callback = TCPComm::EventCallBack;
@@ -432,15 +707,22 @@ void TCPComm::Connect(const std::string &dst_url) {
         delete conn;
         return;
       }
-      conn_pool_->AddConnection(conn);
+      reactor->conn_pool->AddConnection(conn);
     }
-    conn_pool_->AddConnInfo(conn->socket_fd, dst_url, nullptr);
+    reactor->conn_pool->AddConnInfo(conn->socket_fd, dst_url, nullptr);
     MS_LOG(INFO) << "Connected to destination: " << dst_url;
   });
 }
 
 bool TCPComm::IsConnected(const std::string &dst_url) {
-  Connection *conn = conn_pool_->FindConnection(dst_url);
+  Reactor *reactor = GetReactor(dst_url);
+  {
+    std::lock_guard<std::mutex> lock(*reactor->conn_mutex);
+    if (reactor->shm_send_channels.count(dst_url) > 0) {
+      return true;
+    }
+  }
+  Connection *conn = reactor->conn_pool->FindConnection(dst_url);
   if (conn != nullptr && conn->state == ConnectionState::kConnected) {
     return true;
   }
@@ -448,9 +730,18 @@ bool TCPComm::IsConnected(const std::string &dst_url) {
 }
 
 void TCPComm::Disconnect(const std::string &dst_url) {
-  (void)recv_event_loop_->AddTask([dst_url, this] {
-    std::lock_guard<std::mutex> lock(*conn_mutex_);
-    conn_pool_->DeleteConnection(dst_url);
+  Reactor *reactor = GetReactor(dst_url);
+  (void)reactor->recv_event_loop->AddTask([dst_url, reactor] {
+    std::lock_guard<std::mutex> lock(*reactor->conn_mutex);
+    reactor->conn_pool->DeleteConnection(dst_url);
+  });
+  // The shared memory channel is operated in the send event loop.
+  (void)reactor->send_event_loop->AddTask([dst_url, reactor] {
+    std::lock_guard<std::mutex> lock(*reactor->conn_mutex);
+    auto iter = reactor->shm_send_channels.find(dst_url);
+    if (iter != reactor->shm_send_channels.end()) {
+      DeleteShmSendChannel(reactor, iter);
+    }
   });
 }
 
@@ -462,34 +753,58 @@ Connection *TCPComm::CreateDefaultConn(std::string to) {
   }
   conn->source = url_.data();
   conn->destination = to;
-  conn->recv_event_loop = this->recv_event_loop_;
-  conn->send_event_loop = this->send_event_loop_;
-  conn->conn_mutex = conn_mutex_;
+  Reactor *reactor = GetReactor(to);
+  conn->recv_event_loop = reactor->recv_event_loop;
+  conn->send_event_loop = reactor->send_event_loop;
+  conn->conn_mutex = reactor->conn_mutex;
   conn->message_handler = message_handler_;
+  conn->mem_allocate_callback = mem_allocate_callback_;
+  conn->mem_free_callback = mem_free_callback_;
   conn->InitSocketOperation();
   return conn;
 }
 
 void TCPComm::Finalize() {
-  if (send_event_loop_ != nullptr) {
-    MS_LOG(INFO) << "Delete send event loop";
-    send_event_loop_->Finalize();
-    delete send_event_loop_;
-    send_event_loop_ = nullptr;
+  for (auto &reactor : reactors_) {
+    if (reactor.send_event_loop != nullptr) {
+      MS_LOG(INFO) << "Delete send event loop";
+      reactor.send_event_loop->Finalize();
+      delete reactor.send_event_loop;
+      reactor.send_event_loop = nullptr;
+    }
   }
 
-  if (recv_event_loop_ != nullptr) {
-    MS_LOG(INFO) << "Delete recv event loop";
-    recv_event_loop_->Finalize();
-    delete recv_event_loop_;
-    recv_event_loop_ = nullptr;
+  for (auto &reactor : reactors_) {
+    if (reactor.recv_event_loop != nullptr) {
+      MS_LOG(INFO) << "Delete recv event loop";
+      reactor.recv_event_loop->Finalize();
+      delete reactor.recv_event_loop;
+      reactor.recv_event_loop = nullptr;
+    }
+
+    if (reactor.server_fd > 0) {
+      if (close(reactor.server_fd) != 0) {
+        MS_LOG(ERROR) << "Failed to close fd: " << reactor.server_fd;
+      }
+      reactor.server_fd = -1;
+    }
+
+    // The peers are notified by the closed unix sockets.
+    reactor.shm_send_channels.clear();
+    reactor.shm_recv_channels.clear();
+    for (int unix_fd : reactor.shm_handshake_fds) {
+      if (close(unix_fd) != 0) {
+        MS_LOG(ERROR) << "Failed to close fd: " << unix_fd;
+      }
+    }
+    reactor.shm_handshake_fds.clear();
   }
 
-  if (server_fd_ > 0) {
-    if (close(server_fd_) != 0) {
-      MS_LOG(ERROR) << "Failed to close fd: " << server_fd_;
+  if (shm_server_fd_ >= 0) {
+    if (close(shm_server_fd_) != 0) {
+      MS_LOG(ERROR) << "Failed to close fd: " << shm_server_fd_;
     }
-    server_fd_ = -1;
+    shm_server_fd_ = -1;
   }
 }
 }  // namespace rpc
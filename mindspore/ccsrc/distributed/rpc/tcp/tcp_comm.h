@@ -18,14 +18,17 @@
 #define MINDSPORE_CCSRC_DISTRIBUTED_RPC_TCP_TCP_COMM_H_
 
 #include <string>
+#include <map>
 #include <memory>
 #include <vector>
 #include <mutex>
+#include <set>
 
 #include "actor/msg.h"
 #include "distributed/rpc/tcp/connection.h"
 #include "distributed/rpc/tcp/connection_pool.h"
 #include "distributed/rpc/tcp/event_loop.h"
+#include "distributed/rpc/tcp/shm_channel.h"
 
 namespace mindspore {
 namespace distributed {
@@ -40,9 +43,43 @@ void DoDisconnect(int fd, Connection *conn, uint32_t error, int soError);
 
 void ConnectedEventHandler(int fd, uint32_t events, void *context);
 
+/*
+ * The reactor drives the socket events and the message sending of a shard of the connections. The connections are
+ * assigned to the reactors by the hash of destination url or the accepted socket fd, so the connections of different
+ * reactors are operated by different threads concurrently.
+ */
+struct Reactor {
+  EventLoop *recv_event_loop{nullptr};
+  EventLoop *send_event_loop{nullptr};
+
+  // The connection pool used to store new connections of this reactor.
+  std::shared_ptr<ConnectionPool> conn_pool;
+
+  // The mutex for connection operations of this reactor.
+  std::shared_ptr<std::mutex> conn_mutex;
+
+  // The server socket listened by this reactor, all the reactors listen on the same port if SO_REUSEPORT is enabled.
+  int server_fd{-1};
+
+  // The shared memory channels to the servers on the same host by destination url, which are operated in the send
+  // event loop, and the channels accepted from the clients on the same host by unix socket fd, which are operated in
+  // the recv event loop. They are guarded by the conn_mutex.
+  std::map<std::string, std::unique_ptr<ShmChannel>> shm_send_channels;
+  std::map<int, std::unique_ptr<ShmChannel>> shm_recv_channels;
+  // The accepted unix sockets waiting for the handshake of the clients in the recv event loop, guarded by conn_mutex.
+  std::set<int> shm_handshake_fds;
+};
+
 class TCPComm {
  public:
-  TCPComm() : server_fd_(-1), recv_event_loop_(nullptr), send_event_loop_(nullptr) {}
+  TCPComm()
+      : message_handler_(nullptr),
+        mem_allocate_callback_(nullptr),
+        mem_free_callback_(nullptr),
+        reactor_num_(1),
+        reuse_port_(false),
+        busy_poll_usec_(0),
+        shm_server_fd_(-1) {}
   TCPComm(const TCPComm &) = delete;
   TCPComm &operator=(const TCPComm &) = delete;
   ~TCPComm();
@@ -53,10 +90,12 @@ class TCPComm {
   // Destroy all the resources.
   void Finalize();
 
-  // Create the server socket represented by url.
+  // Create the server socket represented by url. The server of url shm://ip:port also accepts the clients on the same
+  // host by shared memory.
   bool StartServerSocket(const std::string &url);
 
-  // Connection operation for a specified destination.
+  // Connection operation for a specified destination. The destination shm://ip:port is connected by shared memory if
+  // the server is on the same host, otherwise by tcp.
   void Connect(const std::string &dst_url);
   bool IsConnected(const std::string &dst_url);
   void Disconnect(const std::string &dst_url);
@@ -64,13 +103,43 @@ class TCPComm {
   // Send the message from the source to the destination.
   int Send(MessageBase *msg);
 
-  // Set the message processing handler.
+  // Set the message processing handler, which is called by all the reactor threads concurrently.
   void SetMessageHandler(MessageHandler handler);
 
+  // Set the functions for the memory of received message body, then the received messages are buffer messages whose
+  // payload lands in the allocated memory directly.
+  void SetMemAllocator(MemAllocateCallback allocate_callback, MemFreeCallback free_callback);
+
  private:
+  // Read the reactor number and socket options from the environment variables:
+  // MS_DEV_RPC_REACTOR_NUM: the number of reactors, default 1.
+  // MS_DEV_RPC_REUSE_PORT=1: every reactor listens on the server port by SO_REUSEPORT and accepts by itself.
+  // MS_DEV_RPC_BUSY_POLL: the microseconds of SO_BUSY_POLL on the connection sockets, default 0(disabled).
+  void ParseReactorOptions();
+
+  // Create the event loops and connection pool of the reactor.
+  bool InitializeReactor(Reactor *reactor, size_t index);
+
+  // Get the reactor of the connection to the destination url or the accepted socket fd.
+  Reactor *GetReactor(const std::string &dst_url);
+  Reactor *GetReactor(int sock_fd);
+
+  // Enable the busy poll of the connection socket if configured.
+  void SetBusyPoll(int sock_fd) const;
+
   // Build the connection.
   Connection *CreateDefaultConn(std::string to);
 
+  // Connect the shared memory server of destination url, return false if the server is not on the same host.
+  bool ConnectShm(Reactor *reactor, const std::string &dst_url);
+
+  // The events of shared memory channels.
+  static void OnShmAccept(int server, uint32_t events, void *arg);
+  static void OnShmHandshake(int unix_fd, uint32_t events, void *arg);
+  static void ShmReadCallBack(int fd, uint32_t events, void *channel);
+  static void ShmWriteCallBack(int fd, uint32_t events, void *channel);
+  static void ShmCloseCallBack(int fd, uint32_t events, void *reactor);
+
   // Send a message.
   static void SendExitMsg(const std::string &from, const std::string &to);
 
@@ -92,21 +161,23 @@ class TCPComm {
   // The server url.
   std::string url_;
 
-  // The socket of server.
-  int server_fd_;
-
   // User defined handler for Handling received messages.
   MessageHandler message_handler_;
 
-  // All the connections share the same read and write event loop objects.
-  EventLoop *recv_event_loop_;
-  EventLoop *send_event_loop_;
+  // User defined functions for the memory of received message body.
+  MemAllocateCallback mem_allocate_callback_;
+  MemFreeCallback mem_free_callback_;
+
+  // The connections are sharded to the reactors, which are not changed after initialized.
+  std::vector<Reactor> reactors_;
 
-  // The connection pool used to store new connections.
-  std::shared_ptr<ConnectionPool> conn_pool_;
+  // The reactor options.
+  size_t reactor_num_;
+  bool reuse_port_;
+  int busy_poll_usec_;
 
-  // The mutex for connection operations.
-  std::shared_ptr<std::mutex> conn_mutex_;
+  // The unix socket accepting the shared memory channels, which is driven by the first reactor.
+  int shm_server_fd_;
 
   friend void OnAccept(int server, uint32_t events, void *arg);
   friend void DoSend(Connection *conn);
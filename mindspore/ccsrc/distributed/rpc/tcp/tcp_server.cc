@@ -42,6 +42,10 @@ void TCPServer::Finalize() {
 }
 
 void TCPServer::SetMessageHandler(MessageHandler handler) { tcp_comm_->SetMessageHandler(handler); }
+
+void TCPServer::SetMemAllocator(MemAllocateCallback allocate_callback, MemFreeCallback free_callback) {
+  tcp_comm_->SetMemAllocator(allocate_callback, free_callback);
+}
 }  // namespace rpc
 }  // namespace distributed
 }  // namespace mindspore
@@ -40,6 +40,9 @@ class TCPServer {
   // Set the message processing handler.
   void SetMessageHandler(MessageHandler handler);
 
+  // Set the functions for the memory which the received message body lands in.
+  void SetMemAllocator(MemAllocateCallback allocate_callback, MemFreeCallback free_callback);
+
  private:
   // The basic TCP communication component used by the server.
   std::unique_ptr<TCPComm> tcp_comm_;
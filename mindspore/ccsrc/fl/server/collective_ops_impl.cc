@@ -15,15 +15,50 @@
  */
 
 #include "fl/server/collective_ops_impl.h"
+#include <algorithm>
+#include "base/float16.h"
 
 namespace mindspore {
 namespace fl {
 namespace server {
+namespace {
+// Reduce the src data into the dst data. The switch is out of the loops, so that the loops can be vectorized.
+template <typename T>
+void ReduceData(T *dst, const T *src, size_t count, CollectiveOpReduceType reduce_op) {
+  switch (reduce_op) {
+    case CollectiveOpReduceType::Reduce_Sum:
+      for (size_t i = 0; i < count; i++) {
+        dst[i] = dst[i] + src[i];
+      }
+      break;
+    case CollectiveOpReduceType::Reduce_Max:
+      for (size_t i = 0; i < count; i++) {
+        dst[i] = std::max(dst[i], src[i]);
+      }
+      break;
+    case CollectiveOpReduceType::Reduce_Min:
+      for (size_t i = 0; i < count; i++) {
+        dst[i] = std::min(dst[i], src[i]);
+      }
+      break;
+    case CollectiveOpReduceType::Reduce_Prod:
+      for (size_t i = 0; i < count; i++) {
+        dst[i] = dst[i] * src[i];
+      }
+      break;
+    default:
+      MS_LOG(EXCEPTION) << "The reduce type " << reduce_op << " is not supported.";
+  }
+}
+}  // namespace
+
 void CollectiveOpsImpl::Initialize(const std::shared_ptr<ps::core::ServerNode> &server_node) {
   MS_EXCEPTION_IF_NULL(server_node);
   server_node_ = server_node;
   rank_id_ = server_node_->rank_id();
   server_num_ = ps::PSContext::instance()->initial_server_num();
+  host_topology_inited_ = false;
+  host_ranks_.clear();
   return;
 }
 
@@ -221,6 +256,105 @@ bool CollectiveOpsImpl::ReduceBroadcastAllReduce(const void *sendbuff, void *rec
   return true;
 }
 
+template <typename T>
+bool CollectiveOpsImpl::HierarchicalAllReduce(const void *sendbuff, void *recvbuff, size_t count) {
+  MS_ERROR_IF_NULL_W_RET_VAL(server_node_, false);
+  MS_ERROR_IF_NULL_W_RET_VAL(recvbuff, false);
+  MS_ERROR_IF_NULL_W_RET_VAL(sendbuff, false);
+  if (recvbuff != sendbuff) {
+    int ret = memcpy_s(recvbuff, count * sizeof(T), sendbuff, count * sizeof(T));
+    if (ret != 0) {
+      MS_LOG(ERROR) << "memcpy_s error, errorno(" << ret << ")";
+      return false;
+    }
+  }
+  T *output_buff = reinterpret_cast<T *>(recvbuff);
+  const std::vector<uint32_t> &local_ranks = host_ranks_[host_index_];
+  uint32_t leader_rank = local_ranks[0];
+  MS_LOG(DEBUG) << "Hierarchical AllReduce count:" << count << ", rank_id_:" << rank_id_ << ", host num:"
+                << host_ranks_.size() << ", host index:" << host_index_ << ", local ranks:" << local_ranks;
+
+  // Reduce the data of the servers on this host to the leader, which waits for all of them at once.
+  if (rank_id_ == leader_rank) {
+    std::vector<std::shared_ptr<std::vector<unsigned char>>> recv_strs(local_ranks.size());
+    std::vector<std::pair<uint32_t, uint64_t>> recv_req_ids;
+    for (size_t i = 1; i < local_ranks.size(); i++) {
+      recv_req_ids.push_back(
+        server_node_->CollectiveReceiveAsync(ps::core::NodeRole::SERVER, local_ranks[i], &recv_strs[i]));
+    }
+    for (size_t i = 1; i < local_ranks.size(); i++) {
+      if (!server_node_->CollectiveWait(recv_req_ids[i - 1], kCollectiveCommTimeout)) {
+        MS_LOG(ERROR) << "CollectiveWait " << recv_req_ids[i - 1] << " failed.";
+        return false;
+      }
+      if (recv_strs[i] == nullptr || count * sizeof(T) != recv_strs[i]->size()) {
+        MS_LOG(ERROR) << "Expect receive size " << count * sizeof(T) << " from rank " << local_ranks[i]
+                      << " != real receive size " << (recv_strs[i] == nullptr ? 0 : recv_strs[i]->size());
+        return false;
+      }
+      ReduceData(output_buff, reinterpret_cast<const T *>(recv_strs[i]->data()), count,
+                 CollectiveOpReduceType::Reduce_Sum);
+      recv_strs[i] = nullptr;
+    }
+  } else {
+    auto send_req_id =
+      server_node_->CollectiveSendAsync(ps::core::NodeRole::SERVER, leader_rank, output_buff, count * sizeof(T));
+    if (!server_node_->Wait(send_req_id, kCollectiveCommTimeout)) {
+      MS_LOG(ERROR) << "CollectiveWait " << send_req_id << " failed.";
+      return false;
+    }
+  }
+
+  // AllReduce among the leaders of the hosts, in the group whose group rank is the index of the host.
+  if (rank_id_ == leader_rank) {
+    node_ = server_node_;
+    node_role_ = ps::core::NodeRole::SERVER;
+    rank_size_ = SizeToUint(host_ranks_.size());
+    group_rank_id_ = host_index_;
+    group_global_ranks_.clear();
+    for (const auto &ranks : host_ranks_) {
+      group_global_ranks_.push_back(ranks[0]);
+    }
+    if (!GroupAllReduce<T>(output_buff, count, CollectiveOpReduceType::Reduce_Sum)) {
+      return false;
+    }
+  }
+
+  // Broadcast the result from the leader to the other servers on this host.
+  if (rank_id_ == leader_rank) {
+    std::vector<uint64_t> send_req_ids;
+    for (size_t i = 1; i < local_ranks.size(); i++) {
+      send_req_ids.push_back(server_node_->CollectiveSendAsync(ps::core::NodeRole::SERVER, local_ranks[i],
+                                                               output_buff, count * sizeof(T)));
+    }
+    for (auto send_req_id : send_req_ids) {
+      if (!server_node_->Wait(send_req_id, kCollectiveCommTimeout)) {
+        MS_LOG(ERROR) << "CollectiveWait " << send_req_id << " failed.";
+        return false;
+      }
+    }
+  } else {
+    std::shared_ptr<std::vector<unsigned char>> recv_str;
+    auto recv_req_id = server_node_->CollectiveReceiveAsync(ps::core::NodeRole::SERVER, leader_rank, &recv_str);
+    if (!server_node_->CollectiveWait(recv_req_id, kCollectiveCommTimeout)) {
+      MS_LOG(ERROR) << "CollectiveWait " << recv_req_id << " failed.";
+      return false;
+    }
+    if (recv_str == nullptr || count * sizeof(T) != recv_str->size()) {
+      MS_LOG(ERROR) << "Expect receive size " << count * sizeof(T) << " from rank " << leader_rank
+                    << " != real receive size " << (recv_str == nullptr ? 0 : recv_str->size());
+      return false;
+    }
+    int ret = memcpy_s(output_buff, count * sizeof(T), recv_str->data(), recv_str->size());
+    if (ret != 0) {
+      MS_LOG(ERROR) << "memcpy_s error, errorno(" << ret << ")";
+      return false;
+    }
+  }
+  MS_LOG(DEBUG) << "End hierarchical AllReduce.";
+  return true;
+}
+
 template <typename T>
 bool CollectiveOpsImpl::RingAllGather(const void *sendbuff, void *const recvbuff, size_t send_count) {
   MS_ERROR_IF_NULL_W_RET_VAL(node_, false);
@@ -342,11 +476,21 @@ bool CollectiveOpsImpl::AllReduce(const void *sendbuff, void *recvbuff, size_t c
     MS_LOG(ERROR) << "Rank size should not be 0.";
     return false;
   }
-  if (rank_size_ == 1) {
+  if (rank_size == 1) {
     MS_LOG(INFO) << "Rank size is 1. Do nothing.";
     return true;
   }
 
+  if (!host_topology_inited_) {
+    host_topology_inited_ = true;
+    if (!InitHostTopology()) {
+      host_ranks_.clear();
+    }
+  }
+  // The hierarchical AllReduce only helps when there are multiple hosts and some host has more than one server.
+  if (host_ranks_.size() > 1 && host_ranks_.size() < rank_size) {
+    return HierarchicalAllReduce<T>(sendbuff, recvbuff, count);
+  }
   if (count >= rank_size) {
     return RingAllReduce<T>(sendbuff, recvbuff, count);
   } else {
@@ -415,6 +559,339 @@ bool CollectiveOpsImpl::Broadcast(const void *sendbuff, void *const recvbuff, si
   return Broadcast<T>(sendbuff, recvbuff, count, root, group_info);
 }
 
+bool CollectiveOpsImpl::InitGroupComm(const std::shared_ptr<ps::core::AbstractNode> &node,
+                                      const CommunicationGroupInfo &group_info) {
+  MS_ERROR_IF_NULL_W_RET_VAL(node, false);
+  node_ = node;
+  node_role_ = node_->role();
+  rank_id_ = node_->rank_id();
+  rank_size_ = group_info.size;
+  if (rank_size_ == 0 || group_info.group_to_global_ranks.size() != rank_size_) {
+    MS_LOG(ERROR) << "The group size " << rank_size_ << " is invalid, the number of group ranks is "
+                  << group_info.group_to_global_ranks.size();
+    return false;
+  }
+  auto iter = group_info.global_to_group_ranks.find(rank_id_);
+  if (iter == group_info.global_to_group_ranks.end()) {
+    MS_LOG(ERROR) << "The rank " << rank_id_ << " is not in the group.";
+    return false;
+  }
+  group_rank_id_ = iter->second;
+  group_global_ranks_.clear();
+  for (const auto &group_to_global_rank : group_info.group_to_global_ranks) {
+    group_global_ranks_.push_back(group_to_global_rank.second);
+  }
+  return true;
+}
+
+template <typename T>
+bool CollectiveOpsImpl::Exchange(uint32_t peer_group_rank, const T *send_data, size_t send_count, T *recv_data,
+                                 size_t recv_count, bool reduce, CollectiveOpReduceType reduce_op) {
+  uint32_t peer_rank = group_global_ranks_[peer_group_rank];
+  // The empty data is skipped by both processes, so it isn't sent.
+  uint64_t send_req_id = 0;
+  if (send_count > 0) {
+    send_req_id = node_->CollectiveSendAsync(node_role_, peer_rank, send_data, send_count * sizeof(T));
+  }
+  if (recv_count > 0) {
+    std::shared_ptr<std::vector<unsigned char>> recv_str;
+    auto recv_req_id = node_->CollectiveReceiveAsync(node_role_, peer_rank, &recv_str);
+    if (!node_->CollectiveWait(recv_req_id, kCollectiveCommTimeout)) {
+      MS_LOG(ERROR) << "CollectiveWait " << recv_req_id << " failed.";
+      return false;
+    }
+    if (recv_str == nullptr || recv_count * sizeof(T) != recv_str->size()) {
+      MS_LOG(ERROR) << "Expect receive size " << recv_count * sizeof(T) << " from rank " << peer_rank
+                    << " != real receive size " << (recv_str == nullptr ? 0 : recv_str->size());
+      return false;
+    }
+    if (reduce) {
+      ReduceData(recv_data, reinterpret_cast<const T *>(recv_str->data()), recv_count, reduce_op);
+    } else {
+      int ret = memcpy_s(recv_data, recv_count * sizeof(T), recv_str->data(), recv_str->size());
+      if (ret != 0) {
+        MS_LOG(ERROR) << "memcpy_s error, errorno(" << ret << ")";
+        return false;
+      }
+    }
+  }
+  if (send_count > 0 && !node_->Wait(send_req_id, kCollectiveCommTimeout)) {
+    MS_LOG(ERROR) << "CollectiveWait " << send_req_id << " failed.";
+    return false;
+  }
+  return true;
+}
+
+template <typename T>
+bool CollectiveOpsImpl::RingPipeline(T *buff, const std::vector<size_t> &chunk_sizes,
+                                     const std::vector<size_t> &chunk_offsets, size_t start_chunk_index, bool reduce,
+                                     CollectiveOpReduceType reduce_op) {
+  MS_ERROR_IF_NULL_W_RET_VAL(buff, false);
+  uint32_t send_to_rank = group_global_ranks_[(group_rank_id_ + 1) % rank_size_];
+  uint32_t recv_from_rank = group_global_ranks_[(group_rank_id_ - 1 + rank_size_) % rank_size_];
+  size_t segment_count = std::max(kRingSegmentSize / sizeof(T), static_cast<size_t>(1));
+  std::vector<uint64_t> send_req_ids;
+
+  // The first step sends all the segments of the start chunk.
+  T *start_chunk = buff + chunk_offsets[start_chunk_index];
+  for (size_t offset = 0; offset < chunk_sizes[start_chunk_index]; offset += segment_count) {
+    size_t send_count = std::min(segment_count, chunk_sizes[start_chunk_index] - offset);
+    send_req_ids.push_back(
+      node_->CollectiveSendAsync(node_role_, send_to_rank, start_chunk + offset, send_count * sizeof(T)));
+  }
+  for (size_t i = 0; i < rank_size_ - 1; i++) {
+    // The chunk received in this step is the chunk sent in the next step.
+    size_t recv_chunk_index = (start_chunk_index - i - 1 + rank_size_) % rank_size_;
+    T *recv_chunk = buff + chunk_offsets[recv_chunk_index];
+    MS_LOG(DEBUG) << "Ring send_to_rank:" << send_to_rank << ", recv_from_rank:" << recv_from_rank
+                  << ", recv count:" << chunk_sizes[recv_chunk_index] << ", iteration:" << i << ", reduce:" << reduce;
+    for (size_t offset = 0; offset < chunk_sizes[recv_chunk_index]; offset += segment_count) {
+      size_t recv_count = std::min(segment_count, chunk_sizes[recv_chunk_index] - offset);
+      std::shared_ptr<std::vector<unsigned char>> recv_str;
+      auto recv_req_id = node_->CollectiveReceiveAsync(node_role_, recv_from_rank, &recv_str);
+      if (!node_->CollectiveWait(recv_req_id, kCollectiveCommTimeout)) {
+        MS_LOG(ERROR) << "CollectiveWait " << recv_req_id << " failed.";
+        return false;
+      }
+      if (recv_str == nullptr || recv_count * sizeof(T) != recv_str->size()) {
+        MS_LOG(ERROR) << "Expect receive segment size " << recv_count * sizeof(T) << " from rank " << recv_from_rank
+                      << " != real receive segment size " << (recv_str == nullptr ? 0 : recv_str->size());
+        return false;
+      }
+      if (reduce) {
+        ReduceData(recv_chunk + offset, reinterpret_cast<const T *>(recv_str->data()), recv_count, reduce_op);
+      } else {
+        int ret = memcpy_s(recv_chunk + offset, recv_count * sizeof(T), recv_str->data(), recv_str->size());
+        if (ret != 0) {
+          MS_LOG(ERROR) << "memcpy_s error, errorno(" << ret << ")";
+          return false;
+        }
+      }
+      // Forward the segment at once instead of waiting for the whole chunk.
+      if (i + 2 < rank_size_) {
+        send_req_ids.push_back(
+          node_->CollectiveSendAsync(node_role_, send_to_rank, recv_chunk + offset, recv_count * sizeof(T)));
+      }
+    }
+  }
+  for (auto send_req_id : send_req_ids) {
+    if (!node_->Wait(send_req_id, kCollectiveCommTimeout)) {
+      MS_LOG(ERROR) << "CollectiveWait " << send_req_id << " failed.";
+      return false;
+    }
+  }
+  return true;
+}
+
+template <typename T>
+bool CollectiveOpsImpl::HalvingDoublingAllReduce(T *buff, size_t count, CollectiveOpReduceType reduce_op) {
+  MS_ERROR_IF_NULL_W_RET_VAL(buff, false);
+  uint32_t pow2_size = 1;
+  while (pow2_size * 2 <= rank_size_) {
+    pow2_size *= 2;
+  }
+  uint32_t rest_size = rank_size_ - pow2_size;
+  MS_LOG(DEBUG) << "Halving doubling AllReduce count:" << count << ", rank_size:" << rank_size_
+                << ", group rank:" << group_rank_id_ << ", power of two size:" << pow2_size;
+
+  // Fold: in the first 2*rest_size processes, the even one sends its data to the odd one and waits for the result.
+  bool folded = false;
+  uint32_t new_rank = group_rank_id_ - rest_size;
+  if (group_rank_id_ < 2 * rest_size) {
+    folded = (group_rank_id_ % 2 == 0);
+    new_rank = group_rank_id_ / 2;
+    uint32_t peer = folded ? group_rank_id_ + 1 : group_rank_id_ - 1;
+    if (!Exchange(peer, buff, folded ? count : 0, buff, folded ? 0 : count, true, reduce_op)) {
+      return false;
+    }
+  }
+
+  if (!folded) {
+    auto to_group_rank = [rest_size](uint32_t rank) { return rank < rest_size ? rank * 2 + 1 : rank + rest_size; };
+    std::vector<size_t> chunk_offsets(pow2_size + 1, 0);
+    for (uint32_t i = 0; i < pow2_size; i++) {
+      chunk_offsets[i + 1] = chunk_offsets[i] + count / pow2_size + (i < count % pow2_size ? 1 : 0);
+    }
+    // Recursive halving: keep the half of chunks by the bit of rank and send the other half to the peer.
+    uint32_t lo = 0;
+    uint32_t hi = pow2_size;
+    for (uint32_t distance = pow2_size / 2; distance >= 1; distance /= 2) {
+      uint32_t mid = (lo + hi) / 2;
+      bool keep_low = ((new_rank & distance) == 0);
+      uint32_t send_lo = keep_low ? mid : lo;
+      uint32_t send_hi = keep_low ? hi : mid;
+      lo = keep_low ? lo : mid;
+      hi = keep_low ? mid : hi;
+      if (!Exchange(to_group_rank(new_rank ^ distance), buff + chunk_offsets[send_lo],
+                    chunk_offsets[send_hi] - chunk_offsets[send_lo], buff + chunk_offsets[lo],
+                    chunk_offsets[hi] - chunk_offsets[lo], true, reduce_op)) {
+        return false;
+      }
+    }
+    // Recursive doubling: exchange the reduced chunks with the peer in reverse order.
+    for (uint32_t distance = 1; distance < pow2_size; distance *= 2) {
+      uint32_t width = hi - lo;
+      uint32_t recv_lo = ((new_rank & distance) == 0) ? hi : lo - width;
+      if (!Exchange(to_group_rank(new_rank ^ distance), buff + chunk_offsets[lo], chunk_offsets[hi] - chunk_offsets[lo],
+                    buff + chunk_offsets[recv_lo], chunk_offsets[recv_lo + width] - chunk_offsets[recv_lo], false,
+                    reduce_op)) {
+        return false;
+      }
+      lo = std::min(lo, recv_lo);
+      hi = lo + 2 * width;
+    }
+  }
+
+  // Unfold: the odd process sends the result back to the even one.
+  if (group_rank_id_ < 2 * rest_size) {
+    uint32_t peer = folded ? group_rank_id_ + 1 : group_rank_id_ - 1;
+    if (!Exchange(peer, buff, folded ? 0 : count, buff, folded ? count : 0, false, reduce_op)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+template <typename T>
+bool CollectiveOpsImpl::HalvingReduceScatter(T *buff, size_t chunk_count, CollectiveOpReduceType reduce_op) {
+  MS_ERROR_IF_NULL_W_RET_VAL(buff, false);
+  uint32_t lo = 0;
+  uint32_t hi = rank_size_;
+  for (uint32_t distance = rank_size_ / 2; distance >= 1; distance /= 2) {
+    uint32_t mid = (lo + hi) / 2;
+    bool keep_low = ((group_rank_id_ & distance) == 0);
+    uint32_t send_lo = keep_low ? mid : lo;
+    lo = keep_low ? lo : mid;
+    hi = keep_low ? mid : hi;
+    if (!Exchange(group_rank_id_ ^ distance, buff + send_lo * chunk_count, (hi - lo) * chunk_count,
+                  buff + lo * chunk_count, (hi - lo) * chunk_count, true, reduce_op)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+template <typename T>
+bool CollectiveOpsImpl::AllReduce(const void *sendbuff, void *recvbuff, size_t count, CollectiveOpReduceType reduce_op,
+                                  const std::shared_ptr<ps::core::AbstractNode> &node,
+                                  const CommunicationGroupInfo &group_info) {
+  std::unique_lock<std::mutex> lock(mtx_);
+  MS_ERROR_IF_NULL_W_RET_VAL(recvbuff, false);
+  MS_ERROR_IF_NULL_W_RET_VAL(sendbuff, false);
+  if (!InitGroupComm(node, group_info)) {
+    return false;
+  }
+  if (count == 0) {
+    return true;
+  }
+  if (recvbuff != sendbuff) {
+    int ret = memcpy_s(recvbuff, count * sizeof(T), sendbuff, count * sizeof(T));
+    if (ret != 0) {
+      MS_LOG(ERROR) << "memcpy_s error, errorno(" << ret << ")";
+      return false;
+    }
+  }
+  if (rank_size_ == 1) {
+    MS_LOG(INFO) << "Rank size is 1. Do nothing.";
+    return true;
+  }
+
+  return GroupAllReduce<T>(reinterpret_cast<T *>(recvbuff), count, reduce_op);
+}
+
+template <typename T>
+bool CollectiveOpsImpl::GroupAllReduce(T *buff, size_t count, CollectiveOpReduceType reduce_op) {
+  MS_ERROR_IF_NULL_W_RET_VAL(buff, false);
+  if (count * sizeof(T) <= kHalvingDoublingMaxSize) {
+    return HalvingDoublingAllReduce<T>(buff, count, reduce_op);
+  }
+  // Ring AllReduce: the chunk of group rank i is reduced in the process of group rank i by ring ReduceScatter, and then
+  // gathered by ring AllGather.
+  std::vector<size_t> chunk_sizes(rank_size_, count / rank_size_);
+  std::vector<size_t> chunk_offsets(rank_size_, 0);
+  for (size_t i = 0; i < rank_size_; i++) {
+    chunk_sizes[i] += (i < count % rank_size_) ? 1 : 0;
+    chunk_offsets[i] = (i == 0) ? 0 : chunk_offsets[i - 1] + chunk_sizes[i - 1];
+  }
+  size_t start_chunk_index = (group_rank_id_ - 1 + rank_size_) % rank_size_;
+  if (!RingPipeline<T>(buff, chunk_sizes, chunk_offsets, start_chunk_index, true, reduce_op)) {
+    return false;
+  }
+  return RingPipeline<T>(buff, chunk_sizes, chunk_offsets, group_rank_id_, false, reduce_op);
+}
+
+template <typename T>
+bool CollectiveOpsImpl::ReduceScatter(const void *sendbuff, void *recvbuff, size_t recv_count,
+                                      CollectiveOpReduceType reduce_op,
+                                      const std::shared_ptr<ps::core::AbstractNode> &node,
+                                      const CommunicationGroupInfo &group_info) {
+  std::unique_lock<std::mutex> lock(mtx_);
+  MS_ERROR_IF_NULL_W_RET_VAL(recvbuff, false);
+  MS_ERROR_IF_NULL_W_RET_VAL(sendbuff, false);
+  if (!InitGroupComm(node, group_info)) {
+    return false;
+  }
+  if (recv_count == 0) {
+    return true;
+  }
+
+  // The sendbuff is reduced in the working buffer, which is not modified by the caller.
+  std::vector<T> work_buff(recv_count * rank_size_);
+  const T *input_buff = reinterpret_cast<const T *>(sendbuff);
+  std::copy(input_buff, input_buff + work_buff.size(), work_buff.begin());
+  bool pow2_size = (rank_size_ & (rank_size_ - 1)) == 0;
+  if (rank_size_ > 1) {
+    bool ret = false;
+    if (pow2_size && work_buff.size() * sizeof(T) <= kHalvingDoublingMaxSize) {
+      ret = HalvingReduceScatter<T>(work_buff.data(), recv_count, reduce_op);
+    } else {
+      std::vector<size_t> chunk_sizes(rank_size_, recv_count);
+      std::vector<size_t> chunk_offsets(rank_size_, 0);
+      for (size_t i = 0; i < rank_size_; i++) {
+        chunk_offsets[i] = i * recv_count;
+      }
+      size_t start_chunk_index = (group_rank_id_ - 1 + rank_size_) % rank_size_;
+      ret = RingPipeline<T>(work_buff.data(), chunk_sizes, chunk_offsets, start_chunk_index, true, reduce_op);
+    }
+    if (!ret) {
+      return false;
+    }
+  }
+  int ret = memcpy_s(recvbuff, recv_count * sizeof(T), work_buff.data() + group_rank_id_ * recv_count,
+                     recv_count * sizeof(T));
+  if (ret != 0) {
+    MS_LOG(ERROR) << "memcpy_s error, errorno(" << ret << ")";
+    return false;
+  }
+  return true;
+}
+
+bool CollectiveOpsImpl::InitHostTopology() {
+  MS_ERROR_IF_NULL_W_RET_VAL(server_node_, false);
+  host_ranks_.clear();
+  host_index_ = 0;
+  std::map<std::string, size_t> ip_to_host_index;
+  for (uint32_t rank = 0; rank < server_num_; rank++) {
+    std::string ip = server_node_->GetNodeIp(ps::core::NodeRole::SERVER, rank);
+    if (ip.empty()) {
+      MS_LOG(WARNING) << "The ip of server " << rank << " is unknown, so the AllReduce is not hierarchical.";
+      return false;
+    }
+    auto iter = ip_to_host_index.find(ip);
+    if (iter == ip_to_host_index.end()) {
+      iter = ip_to_host_index.emplace(ip, host_ranks_.size()).first;
+      host_ranks_.emplace_back();
+    }
+    host_ranks_[iter->second].push_back(rank);
+    if (rank == rank_id_) {
+      host_index_ = SizeToUint(iter->second);
+    }
+  }
+  MS_LOG(INFO) << "The " << server_num_ << " servers are on " << host_ranks_.size() << " hosts, this server is on host "
+               << host_index_ << " with the servers " << host_ranks_[host_index_];
+  return true;
+}
+
 bool CollectiveOpsImpl::ReInitForScaling() {
   // If CollectiveOpsImpl is not initialized yet but the scaling event is triggered, do not throw exception.
   if (server_node_ == nullptr) {
@@ -426,6 +903,9 @@ bool CollectiveOpsImpl::ReInitForScaling() {
   server_num_ = server_node_->server_num();
   MS_LOG(INFO) << "After scheduler scaling out, this server's rank is " << rank_id_ << ", server number is "
                << server_num_;
+  // The servers may be moved across the hosts by scaling, so the host topology is rebuilt at the next AllReduce.
+  host_topology_inited_ = false;
+  host_ranks_.clear();
   return true;
 }
 
@@ -437,6 +917,10 @@ template bool CollectiveOpsImpl::ReduceBroadcastAllReduce<float>(const void *sen
 template bool CollectiveOpsImpl::ReduceBroadcastAllReduce<size_t>(const void *sendbuff, void *recvbuff, size_t count);
 template bool CollectiveOpsImpl::ReduceBroadcastAllReduce<int>(const void *sendbuff, void *recvbuff, size_t count);
 
+template bool CollectiveOpsImpl::HierarchicalAllReduce<float>(const void *sendbuff, void *recvbuff, size_t count);
+template bool CollectiveOpsImpl::HierarchicalAllReduce<size_t>(const void *sendbuff, void *recvbuff, size_t count);
+template bool CollectiveOpsImpl::HierarchicalAllReduce<int>(const void *sendbuff, void *recvbuff, size_t count);
+
 template bool CollectiveOpsImpl::AllReduce<float>(const void *sendbuff, void *recvbuff, size_t count);
 template bool CollectiveOpsImpl::AllReduce<size_t>(const void *sendbuff, void *recvbuff, size_t count);
 template bool CollectiveOpsImpl::AllReduce<int>(const void *sendbuff, void *recvbuff, size_t count);
@@ -476,6 +960,64 @@ template bool CollectiveOpsImpl::Broadcast<int>(const void *sendbuff, void *recv
                                                 const CommunicationGroupInfo &group_info);
 template bool CollectiveOpsImpl::Broadcast<char>(const void *sendbuff, void *recvbuff, size_t count, uint32_t root,
                                                  const CommunicationGroupInfo &group_info);
+
+template bool CollectiveOpsImpl::AllReduce<int8_t>(const void *sendbuff, void *recvbuff, size_t count,
+                                                   CollectiveOpReduceType reduce_op,
+                                                   const std::shared_ptr<ps::core::AbstractNode> &node,
+                                                   const CommunicationGroupInfo &group_info);
+template bool CollectiveOpsImpl::AllReduce<int32_t>(const void *sendbuff, void *recvbuff, size_t count,
+                                                    CollectiveOpReduceType reduce_op,
+                                                    const std::shared_ptr<ps::core::AbstractNode> &node,
+                                                    const CommunicationGroupInfo &group_info);
+template bool CollectiveOpsImpl::AllReduce<int64_t>(const void *sendbuff, void *recvbuff, size_t count,
+                                                    CollectiveOpReduceType reduce_op,
+                                                    const std::shared_ptr<ps::core::AbstractNode> &node,
+                                                    const CommunicationGroupInfo &group_info);
+template bool CollectiveOpsImpl::AllReduce<uint64_t>(const void *sendbuff, void *recvbuff, size_t count,
+                                                     CollectiveOpReduceType reduce_op,
+                                                     const std::shared_ptr<ps::core::AbstractNode> &node,
+                                                     const CommunicationGroupInfo &group_info);
+template bool CollectiveOpsImpl::AllReduce<float16>(const void *sendbuff, void *recvbuff, size_t count,
+                                                    CollectiveOpReduceType reduce_op,
+                                                    const std::shared_ptr<ps::core::AbstractNode> &node,
+                                                    const CommunicationGroupInfo &group_info);
+template bool CollectiveOpsImpl::AllReduce<float>(const void *sendbuff, void *recvbuff, size_t count,
+                                                  CollectiveOpReduceType reduce_op,
+                                                  const std::shared_ptr<ps::core::AbstractNode> &node,
+                                                  const CommunicationGroupInfo &group_info);
+template bool CollectiveOpsImpl::AllReduce<double>(const void *sendbuff, void *recvbuff, size_t count,
+                                                   CollectiveOpReduceType reduce_op,
+                                                   const std::shared_ptr<ps::core::AbstractNode> &node,
+                                                   const CommunicationGroupInfo &group_info);
+
+template bool CollectiveOpsImpl::ReduceScatter<int8_t>(const void *sendbuff, void *recvbuff, size_t recv_count,
+                                                       CollectiveOpReduceType reduce_op,
+                                                       const std::shared_ptr<ps::core::AbstractNode> &node,
+                                                       const CommunicationGroupInfo &group_info);
+template bool CollectiveOpsImpl::ReduceScatter<int32_t>(const void *sendbuff, void *recvbuff, size_t recv_count,
+                                                        CollectiveOpReduceType reduce_op,
+                                                        const std::shared_ptr<ps::core::AbstractNode> &node,
+                                                        const CommunicationGroupInfo &group_info);
+template bool CollectiveOpsImpl::ReduceScatter<int64_t>(const void *sendbuff, void *recvbuff, size_t recv_count,
+                                                        CollectiveOpReduceType reduce_op,
+                                                        const std::shared_ptr<ps::core::AbstractNode> &node,
+                                                        const CommunicationGroupInfo &group_info);
+template bool CollectiveOpsImpl::ReduceScatter<uint64_t>(const void *sendbuff, void *recvbuff, size_t recv_count,
+                                                         CollectiveOpReduceType reduce_op,
+                                                         const std::shared_ptr<ps::core::AbstractNode> &node,
+                                                         const CommunicationGroupInfo &group_info);
+template bool CollectiveOpsImpl::ReduceScatter<float16>(const void *sendbuff, void *recvbuff, size_t recv_count,
+                                                        CollectiveOpReduceType reduce_op,
+                                                        const std::shared_ptr<ps::core::AbstractNode> &node,
+                                                        const CommunicationGroupInfo &group_info);
+template bool CollectiveOpsImpl::ReduceScatter<float>(const void *sendbuff, void *recvbuff, size_t recv_count,
+                                                      CollectiveOpReduceType reduce_op,
+                                                      const std::shared_ptr<ps::core::AbstractNode> &node,
+                                                      const CommunicationGroupInfo &group_info);
+template bool CollectiveOpsImpl::ReduceScatter<double>(const void *sendbuff, void *recvbuff, size_t recv_count,
+                                                       CollectiveOpReduceType reduce_op,
+                                                       const std::shared_ptr<ps::core::AbstractNode> &node,
+                                                       const CommunicationGroupInfo &group_info);
 }  // namespace server
 }  // namespace fl
 }  // namespace mindspore
@@ -26,6 +26,7 @@
 #include "ps/ps_context.h"
 #include "ps/core/server_node.h"
 #include "fl/server/common.h"
+#include "runtime/collective/collective_communication_lib.h"
 
 namespace mindspore {
 namespace fl {
@@ -33,6 +34,15 @@ namespace server {
 // The timeout for server collective communication in case of network jitter.
 constexpr uint32_t kCollectiveCommTimeout = 30;
 
+// The AllReduce and ReduceScatter whose data size is not larger than this threshold use the recursive
+// halving-doubling algorithm, which takes 2*log(n) steps instead of the 2*(n-1) steps of the ring algorithm. The larger
+// ones use the ring algorithm, which sends to only one neighbour in each step and pipelines the steps by the segments.
+constexpr size_t kHalvingDoublingMaxSize = 1 << 20;
+// The size of segment pipelined in the ring algorithm.
+constexpr size_t kRingSegmentSize = 1 << 19;
+
+using CollectiveOpReduceType = device::CollectiveOpReduceType;
+
 // The collective communication groups which are composed of multiple processes. Refer to MPI_Group.
 struct CommunicationGroupInfo {
   // This group's rank size.
@@ -51,7 +61,10 @@ struct CommunicationGroupInfo {
 
 // CollectiveOpsImpl is the collective communication API of the server.
 // For now, it implements two AllReduce algorithms: RingAllReduce and BroadcastAllReduce. Elastic AllReduce is also
-// supported for the elastic scaling feature of the server.
+// supported for the elastic scaling feature of the server. When the servers are on multiple hosts and some host has
+// more than one server, the AllReduce of the servers is hierarchical, so that the data crosses the hosts only once per
+// host instead of once per server. The AllReduce and ReduceScatter within the group for the abstract node implement the
+// ring and the recursive halving-doubling algorithms, which are selected by the data size.
 class CollectiveOpsImpl {
  public:
   static CollectiveOpsImpl &GetInstance() {
@@ -74,6 +87,17 @@ class CollectiveOpsImpl {
   bool Broadcast(const void *sendbuff, void *recvbuff, size_t count, uint32_t root,
                  const std::shared_ptr<ps::core::AbstractNode> &node, const CommunicationGroupInfo &group_info);
 
+  // Collective AllReduce within the specified group. The reduce_op is one of sum, max, min and prod.
+  template <typename T>
+  bool AllReduce(const void *sendbuff, void *recvbuff, size_t count, CollectiveOpReduceType reduce_op,
+                 const std::shared_ptr<ps::core::AbstractNode> &node, const CommunicationGroupInfo &group_info);
+
+  // Collective ReduceScatter within the specified group. The sendbuff contains recv_count data for each process in
+  // order of the group ranks, and the recvbuff receives the reduced data of this process.
+  template <typename T>
+  bool ReduceScatter(const void *sendbuff, void *recvbuff, size_t recv_count, CollectiveOpReduceType reduce_op,
+                     const std::shared_ptr<ps::core::AbstractNode> &node, const CommunicationGroupInfo &group_info);
+
   // Reinitialize the ring for collective communication after scaling operations are done.
   bool ReInitForScaling();
 
@@ -97,6 +121,15 @@ class CollectiveOpsImpl {
   template <typename T>
   bool ReduceBroadcastAllReduce(const void *sendbuff, void *recvbuff, size_t count);
 
+  // Implementation of hierarchical AllReduce. The servers on each host reduce their data to the leader of the host,
+  // which is the server of the smallest rank on the host. Then the leaders AllReduce the data among the hosts, and
+  // broadcast the result to the other servers on their hosts.
+  template <typename T>
+  bool HierarchicalAllReduce(const void *sendbuff, void *recvbuff, size_t count);
+
+  // Group the server ranks by the ips of the servers. Return false if the ip of any server is unknown.
+  bool InitHostTopology();
+
   // Implementation of RingAllGather.
   template <typename T>
   bool RingAllGather(const void *sendbuff, void *recvbuff, size_t send_count);
@@ -106,6 +139,36 @@ class CollectiveOpsImpl {
   bool Broadcast(const void *sendbuff, void *recvbuff, size_t count, uint32_t root,
                  const CommunicationGroupInfo &group_info);
 
+  // Initialize the node and the ranks of collective communication within the group.
+  bool InitGroupComm(const std::shared_ptr<ps::core::AbstractNode> &node, const CommunicationGroupInfo &group_info);
+
+  // The ring algorithm on the chunks of buff. In each step, this process sends one chunk to the next process and
+  // receives the previous chunk from the previous process, the chunk sent in the first step is start_chunk_index. The
+  // received chunk is reduced into buff if reduce is true, otherwise it is copied, and each received segment is
+  // forwarded in the next step at once, so the steps are pipelined.
+  template <typename T>
+  bool RingPipeline(T *buff, const std::vector<size_t> &chunk_sizes, const std::vector<size_t> &chunk_offsets,
+                    size_t start_chunk_index, bool reduce, CollectiveOpReduceType reduce_op);
+
+  // Implementation of recursive halving-doubling AllReduce within the group. The non power of two processes are folded
+  // into the power of two processes before the recursive halving and unfolded after the recursive doubling.
+  template <typename T>
+  bool HalvingDoublingAllReduce(T *buff, size_t count, CollectiveOpReduceType reduce_op);
+
+  // Implementation of recursive halving ReduceScatter within the group whose size is power of two. After the halving
+  // steps, the chunk of group rank i is reduced in the process of group rank i.
+  template <typename T>
+  bool HalvingReduceScatter(T *buff, size_t chunk_count, CollectiveOpReduceType reduce_op);
+
+  // AllReduce the buff within the group which is initialized, using the algorithm selected by the data size.
+  template <typename T>
+  bool GroupAllReduce(T *buff, size_t count, CollectiveOpReduceType reduce_op);
+
+  // Exchange the data with the peer process of the group rank, the data received is reduced or copied into recv_data.
+  template <typename T>
+  bool Exchange(uint32_t peer_group_rank, const T *send_data, size_t send_count, T *recv_data, size_t recv_count,
+                bool reduce, CollectiveOpReduceType reduce_op);
+
   std::shared_ptr<ps::core::ServerNode> server_node_;
   uint32_t rank_id_;
   uint32_t server_num_;
@@ -118,6 +181,18 @@ class CollectiveOpsImpl {
   std::shared_ptr<ps::core::AbstractNode> node_;
   ps::core::NodeRole node_role_;
   uint32_t rank_size_;
+
+  // The group rank of this process and the global ranks of the group ranks for the collective communication within the
+  // group.
+  uint32_t group_rank_id_{0};
+  std::vector<uint32_t> group_global_ranks_;
+
+  // The server ranks on each host, in which the first rank is the leader of the host. The hosts are in the order of
+  // their leaders. It is built at the first AllReduce of the servers, and rebuilt after scaling.
+  bool host_topology_inited_{false};
+  std::vector<std::vector<uint32_t>> host_ranks_;
+  // The index of the host of this server in host_ranks_.
+  uint32_t host_index_{0};
 };
 }  // namespace server
 }  // namespace fl
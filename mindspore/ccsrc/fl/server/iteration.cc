@@ -20,6 +20,7 @@
 #include <string>
 #include <numeric>
 #include "fl/server/model_store.h"
+#include "fl/server/model_distributor.h"
 #include "fl/server/server.h"
 
 namespace mindspore {
@@ -323,6 +324,7 @@ bool Iteration::NewInstance(const nlohmann::json &new_instance_json, std::string
   iteration_num_ = 1;
   LocalMetaStore::GetInstance().set_curr_iter_num(iteration_num_);
   ModelStore::GetInstance().Reset();
+  ModelDistributor::GetInstance().Reset();
   if (metrics_ != nullptr) {
     if (!metrics_->Clear()) {
       MS_LOG(WARNING) << "Clear metrics file failed.";
@@ -65,6 +65,13 @@ class AggregationKernelMod : public NativeCpuKernelMod {
     return;
   }
 
+  // Whether the kernel aggregates the upload data of the clients by the method Aggregate, which is thread-safe. Then
+  // the caller doesn't need to copy the upload data into the kernel's inputs and launch it under the lock.
+  virtual bool SupportConcurrentAggregation() const { return false; }
+
+  // Aggregate the upload data of one client directly.
+  virtual bool Aggregate(const UploadData &upload_data) { return false; }
+
   // Reinitialize aggregation kernel after scaling operations are done.
   virtual bool ReInitForScaling() { return true; }
 
@@ -0,0 +1,160 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "fl/server/kernel/fed_avg_accumulator.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <limits>
+#include <thread>
+#include "plugin/device/cpu/kernel/nnacl/fp32/add_fp32.h"
+#include "utils/log_adapter.h"
+
+namespace mindspore {
+namespace fl {
+namespace server {
+namespace kernel {
+namespace {
+// The float16 weight is converted by blocks, which fit in the L1 cache, before being added.
+constexpr size_t kConvertBlockSize = 1024;
+
+// The index of the current thread, which selects its partial sum of each accumulator.
+size_t ThreadIndex() {
+  static std::atomic<size_t> thread_num{0};
+  thread_local size_t thread_index = thread_num++;
+  return thread_index;
+}
+
+// Add the src to the dst by the SIMD add of nnacl, whose size is limited by int.
+void AddTo(float *dst, const float *src, size_t len) {
+  constexpr size_t kMaxAddSize = static_cast<size_t>(std::numeric_limits<int>::max());
+  for (size_t offset = 0; offset < len; offset += kMaxAddSize) {
+    size_t add_size = std::min(kMaxAddSize, len - offset);
+    (void)ElementAdd(dst + offset, src + offset, dst + offset, static_cast<int>(add_size));
+  }
+}
+}  // namespace
+
+void FedAvgAccumulator::Init(size_t len, size_t slot_num) {
+  // More partial sums than the cores don't make the accumulation faster.
+  size_t core_num = std::max<size_t>(1, std::thread::hardware_concurrency());
+  slot_num = (slot_num == 0) ? core_num : std::min(slot_num, core_num);
+  len_ = len;
+  partial_sums_.clear();
+  for (size_t i = 0; i < slot_num; ++i) {
+    (void)partial_sums_.emplace_back(std::make_unique<PartialSum>());
+  }
+}
+
+FedAvgAccumulator::PartialSum *FedAvgAccumulator::AcquirePartialSum(std::unique_lock<std::mutex> *lock) {
+  MS_EXCEPTION_IF_NULL(lock);
+  size_t slot_num = partial_sums_.size();
+  size_t slot = ThreadIndex() % slot_num;
+  // Normally the partial sum of this thread is not locked. Another one is tried only if more threads than the slots are
+  // accumulating, and this thread waits for its own partial sum if all of them are busy.
+  for (size_t i = 0; i < slot_num; ++i) {
+    PartialSum *partial_sum = partial_sums_[(slot + i) % slot_num].get();
+    std::unique_lock<std::mutex> try_lock(partial_sum->lock, std::try_to_lock);
+    if (try_lock.owns_lock()) {
+      *lock = std::move(try_lock);
+      AllocPartialSum(partial_sum);
+      return partial_sum;
+    }
+  }
+  *lock = std::unique_lock<std::mutex>(partial_sums_[slot]->lock);
+  AllocPartialSum(partial_sums_[slot].get());
+  return partial_sums_[slot].get();
+}
+
+void FedAvgAccumulator::AllocPartialSum(PartialSum *partial_sum) const {
+  MS_EXCEPTION_IF_NULL(partial_sum);
+  if (partial_sum->weight.size() != len_) {
+    partial_sum->weight.resize(len_, 0);
+  }
+}
+
+bool FedAvgAccumulator::Accumulate(const float *weight, size_t len, size_t data_size) {
+  if (partial_sums_.empty() || len != len_ || (weight == nullptr && len > 0)) {
+    MS_LOG(ERROR) << "The weight of " << len << " values can't be accumulated to the partial sums of " << len_
+                  << " values.";
+    return false;
+  }
+  std::unique_lock<std::mutex> lock;
+  PartialSum *partial_sum = AcquirePartialSum(&lock);
+  AddTo(partial_sum->weight.data(), weight, len);
+  partial_sum->data_size += data_size;
+  partial_sum->dirty = true;
+  return true;
+}
+
+bool FedAvgAccumulator::Accumulate(const float16 *weight, size_t len, size_t data_size) {
+  if (partial_sums_.empty() || len != len_ || (weight == nullptr && len > 0)) {
+    MS_LOG(ERROR) << "The float16 weight of " << len << " values can't be accumulated to the partial sums of " << len_
+                  << " values.";
+    return false;
+  }
+  std::array<float, kConvertBlockSize> block;
+  std::unique_lock<std::mutex> lock;
+  PartialSum *partial_sum = AcquirePartialSum(&lock);
+  for (size_t offset = 0; offset < len; offset += kConvertBlockSize) {
+    size_t block_size = std::min(kConvertBlockSize, len - offset);
+    for (size_t i = 0; i < block_size; ++i) {
+      block[i] = static_cast<float>(weight[offset + i]);
+    }
+    AddTo(partial_sum->weight.data() + offset, block.data(), block_size);
+  }
+  partial_sum->data_size += data_size;
+  partial_sum->dirty = true;
+  return true;
+}
+
+bool FedAvgAccumulator::Merge(float *weight, size_t len, size_t *data_size) {
+  if (len != len_ || (weight == nullptr && len > 0) || data_size == nullptr) {
+    MS_LOG(ERROR) << "The partial sums of " << len_ << " values can't be merged into the weight of " << len
+                  << " values.";
+    return false;
+  }
+  std::fill(weight, weight + len, 0);
+  *data_size = 0;
+  for (auto &partial_sum : partial_sums_) {
+    std::unique_lock<std::mutex> lock(partial_sum->lock);
+    if (!partial_sum->dirty) {
+      continue;
+    }
+    AddTo(weight, partial_sum->weight.data(), len);
+    *data_size += partial_sum->data_size;
+    std::fill(partial_sum->weight.begin(), partial_sum->weight.end(), 0);
+    partial_sum->data_size = 0;
+    partial_sum->dirty = false;
+  }
+  return true;
+}
+
+void FedAvgAccumulator::Clear() {
+  for (auto &partial_sum : partial_sums_) {
+    std::unique_lock<std::mutex> lock(partial_sum->lock);
+    if (partial_sum->dirty) {
+      std::fill(partial_sum->weight.begin(), partial_sum->weight.end(), 0);
+      partial_sum->data_size = 0;
+      partial_sum->dirty = false;
+    }
+  }
+}
+}  // namespace kernel
+}  // namespace server
+}  // namespace fl
+}  // namespace mindspore
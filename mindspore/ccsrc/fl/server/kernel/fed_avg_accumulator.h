@@ -0,0 +1,78 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_FL_SERVER_KERNEL_FED_AVG_ACCUMULATOR_H_
+#define MINDSPORE_CCSRC_FL_SERVER_KERNEL_FED_AVG_ACCUMULATOR_H_
+
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "base/float16.h"
+
+namespace mindspore {
+namespace fl {
+namespace server {
+namespace kernel {
+// FedAvgAccumulator sums the weights uploaded by the clients for the federated average. The weights are added to
+// several partial sums, and each thread adds to its own partial sum first, so the clients are accumulated concurrently
+// without sharing one lock. The partial sums are merged into the weight when the aggregation of this round is done.
+class FedAvgAccumulator {
+ public:
+  FedAvgAccumulator() = default;
+  ~FedAvgAccumulator() = default;
+
+  // Create the partial sums of len values. The slot_num is the number of partial sums, which is capped by the hardware
+  // concurrency, and it is the hardware concurrency if it is 0. The values of a partial sum are allocated when a thread
+  // adds to it for the first time, so the partial sums which no thread uses take no memory. This method is not
+  // thread-safe.
+  void Init(size_t len, size_t slot_num = 0);
+
+  size_t len() const { return len_; }
+
+  // Add the weight of len values and the data size of one client to a partial sum. The float16 weight is converted to
+  // float32 before being added. These methods are thread-safe.
+  bool Accumulate(const float *weight, size_t len, size_t data_size);
+  bool Accumulate(const float16 *weight, size_t len, size_t data_size);
+
+  // Write the sum of the partial sums into the weight of len values and the data_size, then clear the partial sums.
+  bool Merge(float *weight, size_t len, size_t *data_size);
+
+  // Clear the partial sums without merging them.
+  void Clear();
+
+ private:
+  struct PartialSum {
+    std::mutex lock;
+    std::vector<float> weight;
+    size_t data_size{0};
+    // Whether any weight is added since the partial sum is cleared, the clean partial sums are skipped by Merge.
+    bool dirty{false};
+  };
+
+  // Lock the partial sum of this thread, or another one which is not locked if it is busy.
+  PartialSum *AcquirePartialSum(std::unique_lock<std::mutex> *lock);
+
+  // Allocate the values of the locked partial sum if they are not allocated yet.
+  void AllocPartialSum(PartialSum *partial_sum) const;
+
+  size_t len_{0};
+  std::vector<std::unique_ptr<PartialSum>> partial_sums_;
+};
+}  // namespace kernel
+}  // namespace server
+}  // namespace fl
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_FL_SERVER_KERNEL_FED_AVG_ACCUMULATOR_H_
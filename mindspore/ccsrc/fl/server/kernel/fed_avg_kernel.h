@@ -17,8 +17,10 @@
 #ifndef MINDSPORE_CCSRC_FL_SERVER_KERNEL_FED_AVG_KERNEL_H_
 #define MINDSPORE_CCSRC_FL_SERVER_KERNEL_FED_AVG_KERNEL_H_
 
+#include <atomic>
 #include <memory>
 #include <string>
+#include <type_traits>
 #include <utility>
 #include <vector>
 #include <functional>
@@ -29,6 +31,7 @@
 #include "fl/server/local_meta_store.h"
 #include "fl/server/kernel/aggregation_kernel.h"
 #include "fl/server/kernel/aggregation_kernel_factory.h"
+#include "fl/server/kernel/fed_avg_accumulator.h"
 
 namespace mindspore {
 namespace fl {
@@ -40,8 +43,13 @@ constexpr size_t kFedAvgInputsNum = 4;
 
 // Pay attention that this kernel is the distributed version of federated average, which means each server node in the
 // cluster in invalved in the aggragation process. So the DistributedCountService and CollectiveOpsImpl are called.
+
+// The uploaded weights are added to the partial sums of FedAvgAccumulator concurrently, and the partial sums are merged
+// into the weight when the aggregation is done.
 template <typename T, typename S>
 class FedAvgKernel : public AggregationKernelMod {
+  static_assert(std::is_same<T, float>::value, "The weights of FedAvgKernel are accumulated in float32.");
+
  public:
   FedAvgKernel()
       : cnode_weight_idx_(0),
@@ -70,6 +78,9 @@ class FedAvgKernel : public AggregationKernelMod {
     input_size_list_.push_back(sizeof(size_t));
     input_size_list_.push_back(new_weight_size);
     input_size_list_.push_back(sizeof(size_t));
+    // The weights are accumulated by the threads handling the update model requests, so there is no more partial sum
+    // than these threads.
+    accumulator_.Init(weight_size / sizeof(T), kExecutorThreadPoolSize);
 
     auto weight_node =
       AnfAlgo::VisitKernelWithReturnType(AnfAlgo::GetInputNode(kernel_node, cnode_weight_idx_), 0).first;
@@ -90,6 +101,12 @@ class FedAvgKernel : public AggregationKernelMod {
       T *weight_addr = reinterpret_cast<T *>(weight_addr_->addr);
       size_t weight_size = weight_addr_->size;
       S *data_size_addr = reinterpret_cast<S *>(data_size_addr_->addr);
+      size_t data_size = 0;
+      if (!accumulator_.Merge(weight_addr, weight_size / sizeof(T), &data_size)) {
+        MS_LOG(ERROR) << "Merging the partial sums of federated average failed.";
+        return;
+      }
+      data_size_addr[0] = static_cast<S>(data_size);
       if (!CollectiveOpsImpl::GetInstance().AllReduce<T>(weight_addr, weight_addr, weight_size / sizeof(T))) {
         MS_LOG(ERROR) << "Federated average allreduce failed.";
         return;
@@ -124,34 +141,58 @@ class FedAvgKernel : public AggregationKernelMod {
       MS_ERROR_IF_NULL_W_RET_VAL(inputs[i]->addr, false);
     }
 
-    std::unique_lock<std::mutex> lock(weight_mutex_);
     // The weight and new_weight values should be multiplied by clients already, so we don't need to do multiplication
     // again.
-    T *weight_addr = reinterpret_cast<T *>(inputs[0]->addr);
-    S *data_size_addr = reinterpret_cast<S *>(inputs[1]->addr);
     T *new_weight_addr = reinterpret_cast<T *>(inputs[2]->addr);
     S *new_data_size_addr = reinterpret_cast<S *>(inputs[3]->addr);
-    if (accum_count_ == 0) {
-      ClearWeightAndDataSize();
+    if (!accumulator_.Accumulate(new_weight_addr, inputs[2]->size / sizeof(T), new_data_size_addr[0])) {
+      MS_LOG(ERROR) << "Accumulating the weight of " << name_ << " failed.";
+      return false;
     }
+    return CountUpdate();
+  }
 
-    MS_LOG(DEBUG) << "Iteration: " << LocalMetaStore::GetInstance().curr_iter_num() << " launching FedAvgKernel for "
-                  << name_ << " new data size is " << new_data_size_addr[0] << ", current total data size is "
-                  << data_size_addr[0];
-    for (size_t i = 0; i < inputs[2]->size / sizeof(T); i++) {
-      weight_addr[i] += new_weight_addr[i];
+  // The new weight is uploaded as float32 or float16, which is told by its size, and it is accumulated without being
+  // copied into the inputs. So the clients are aggregated concurrently.
+  bool SupportConcurrentAggregation() const override { return true; }
+
+  bool Aggregate(const UploadData &upload_data) override {
+    auto new_weight = upload_data.find(kNewWeight);
+    auto new_data_size = upload_data.find(kNewDataSize);
+    if (new_weight == upload_data.end() || new_data_size == upload_data.end()) {
+      MS_LOG(ERROR) << "The upload data of " << name_ << " should contain " << kNewWeight << " and " << kNewDataSize;
+      return false;
+    }
+    MS_ERROR_IF_NULL_W_RET_VAL(new_weight->second.addr, false);
+    MS_ERROR_IF_NULL_W_RET_VAL(new_data_size->second.addr, false);
+    if (new_data_size->second.size != sizeof(S)) {
+      MS_LOG(ERROR) << "The size of " << kNewDataSize << " should be " << sizeof(S) << ", but got "
+                    << new_data_size->second.size;
+      return false;
     }
-    data_size_addr[0] += new_data_size_addr[0];
-    lock.unlock();
 
-    accum_count_++;
-    participated_ = true;
-    return DistributedCountService::GetInstance().Count(
-      name_, std::to_string(DistributedCountService::GetInstance().local_rank()) + "_" + std::to_string(accum_count_));
+    S data_size = *reinterpret_cast<const S *>(new_data_size->second.addr);
+    size_t len = accumulator_.len();
+    bool ret = false;
+    if (new_weight->second.size == len * sizeof(float)) {
+      ret = accumulator_.Accumulate(reinterpret_cast<const float *>(new_weight->second.addr), len, data_size);
+    } else if (new_weight->second.size == len * sizeof(float16)) {
+      ret = accumulator_.Accumulate(reinterpret_cast<const float16 *>(new_weight->second.addr), len, data_size);
+    } else {
+      MS_LOG(ERROR) << "The size of " << kNewWeight << " " << new_weight->second.size << " doesn't match the "
+                    << len << " values of " << name_;
+    }
+    if (!ret) {
+      MS_LOG(ERROR) << "Accumulating the weight of " << name_ << " failed.";
+      return false;
+    }
+    return CountUpdate();
   }
 
   void Reset() override {
     accum_count_ = 0;
+    update_count_ = 0;
+    accumulator_.Clear();
     done_ = false;
     participated_ = false;
     DistributedCountService::GetInstance().ResetCounter(name_);
@@ -191,6 +232,16 @@ class FedAvgKernel : public AggregationKernelMod {
     return;
   }
 
+  // Count the update of one client after its weight is accumulated.
+  bool CountUpdate() {
+    size_t update_count = ++update_count_;
+    participated_ = true;
+    MS_LOG(DEBUG) << "Iteration: " << LocalMetaStore::GetInstance().curr_iter_num() << " accumulated FedAvgKernel for "
+                  << name_ << ", update count is " << update_count;
+    return DistributedCountService::GetInstance().Count(
+      name_, std::to_string(DistributedCountService::GetInstance().local_rank()) + "_" + std::to_string(update_count));
+  }
+
   // In some cases, the Launch method is not called and the weights involved in AllReduce should be set to 0.
   void ClearWeightAndDataSize() {
     MS_ERROR_IF_NULL_WO_RET_VAL(weight_addr_);
@@ -222,10 +273,16 @@ class FedAvgKernel : public AggregationKernelMod {
   AddressPtr new_weight_addr_;
   AddressPtr new_data_size_addr_;
 
-  // Whether the kernel's Launch method is called.
-  bool participated_;
+  // Whether any client is accumulated by this kernel in this iteration.
+  std::atomic<bool> participated_;
+
+  // The number of the clients accumulated in this iteration, which makes the count ids unique.
+  std::atomic<size_t> update_count_{0};
+
+  // The partial sums of the uploaded weights and data sizes.
+  FedAvgAccumulator accumulator_;
 
-  // The kernel could be called concurrently so we need lock to ensure threadsafe.
+  // The weight is merged and all-reduced in the counter handlers, which could be called concurrently.
   std::mutex weight_mutex_;
 };
 }  // namespace kernel
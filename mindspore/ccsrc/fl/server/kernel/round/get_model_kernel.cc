@@ -15,12 +15,14 @@
  */
 
 #include "fl/server/kernel/round/get_model_kernel.h"
+#include <algorithm>
 #include <map>
 #include <memory>
 #include <string>
 #include <vector>
 #include "fl/server/iteration.h"
 #include "fl/server/model_store.h"
+#include "fl/server/model_distributor.h"
 
 namespace mindspore {
 namespace fl {
@@ -90,6 +92,18 @@ void GetModelKernel::GetModel(const schema::RequestGetModel *get_model_req, cons
   size_t get_model_iter = IntToSize(get_model_req->iteration());
   const auto &iter_to_model = ModelStore::GetInstance().iteration_to_model();
   size_t latest_iter_num = iter_to_model.rbegin()->first;
+  // The chunks after the first one are of the delta between the iterations named by the request, which is never
+  // replaced by the delta to the latest model, otherwise the chunks of different deltas are mixed.
+  int base_iter = get_model_req->base_iteration();
+  if (get_model_req->chunk_index() > 0 &&
+      (base_iter < 0 || iter_to_model.count(IntToSize(base_iter)) == 0 || iter_to_model.count(get_model_iter) == 0)) {
+    std::string reason = "The model delta from iteration " + std::to_string(base_iter) + " to iteration " +
+                         std::to_string(get_model_iter) + " is not stored any more, get it from the first chunk.";
+    BuildGetModelRsp(fbb, schema::ResponseCode_RequestError, reason, current_iter, feature_maps,
+                     std::to_string(next_req_time));
+    MS_LOG(WARNING) << reason;
+    return;
+  }
   // If this iteration is not finished yet, return ResponseCode_SucNotReady so that clients could get model later.
   if (current_iter == get_model_iter && latest_iter_num != current_iter) {
     std::string reason = "The model is not ready yet for iteration " + std::to_string(get_model_iter) +
@@ -103,14 +117,21 @@ void GetModelKernel::GetModel(const schema::RequestGetModel *get_model_req, cons
     return;
   }
 
+  size_t model_iter = get_model_iter;
   if (iter_to_model.count(get_model_iter) == 0) {
     // If the model of get_model_iter is not stored, return the latest version of model and current iteration number.
     MS_LOG(DEBUG) << "The iteration of GetModel request " << std::to_string(get_model_iter)
                   << " is invalid. Current iteration is " << std::to_string(current_iter);
-    feature_maps = ModelStore::GetInstance().GetModelByIterNum(latest_iter_num);
-  } else {
-    feature_maps = ModelStore::GetInstance().GetModelByIterNum(get_model_iter);
+    model_iter = latest_iter_num;
+  }
+
+  // The client holding a stored model gets the delta against it, otherwise it gets the whole model.
+  if (base_iter >= 0 && iter_to_model.count(IntToSize(base_iter)) != 0 &&
+      GetModelDelta(get_model_req, IntToSize(base_iter), model_iter, current_iter, std::to_string(next_req_time),
+                    fbb)) {
+    return;
   }
+  feature_maps = ModelStore::GetInstance().GetModelByIterNum(model_iter);
   IncreaseAcceptClientNum();
   MS_LOG(DEBUG) << "GetModel last iteratin is valid or not: " << Iteration::GetInstance().is_last_iteration_valid()
                 << ", next request time is " << next_req_time << ", current iteration is " << current_iter;
@@ -119,6 +140,68 @@ void GetModelKernel::GetModel(const schema::RequestGetModel *get_model_req, cons
   return;
 }
 
+bool GetModelKernel::GetModelDelta(const schema::RequestGetModel *get_model_req, size_t base_iter, size_t model_iter,
+                                   size_t current_iter, const std::string &timestamp,
+                                   const std::shared_ptr<FBBuilder> &fbb) {
+  MS_ERROR_IF_NULL_W_RET_VAL(get_model_req, false);
+  auto delta = ModelDistributor::GetInstance().GetModelDelta(base_iter, model_iter);
+  if (delta == nullptr) {
+    // The whole model can't take the place of the chunks after the first one.
+    if (get_model_req->chunk_index() > 0) {
+      std::string reason = "Encoding the model delta from iteration " + std::to_string(base_iter) + " to iteration " +
+                           std::to_string(model_iter) + " failed.";
+      BuildGetModelRsp(fbb, schema::ResponseCode_SystemError, reason, current_iter, {}, timestamp);
+      MS_LOG(ERROR) << reason;
+      return true;
+    }
+    return false;
+  }
+  size_t chunk_num = std::max<size_t>(1, (delta->size() + kModelDeltaChunkSize - 1) / kModelDeltaChunkSize);
+  if (get_model_req->chunk_index() < 0 || IntToSize(get_model_req->chunk_index()) >= chunk_num) {
+    std::string reason = "The chunk index " + std::to_string(get_model_req->chunk_index()) +
+                         " of GetModel request is out of the chunk number " + std::to_string(chunk_num);
+    BuildGetModelRsp(fbb, schema::ResponseCode_RequestError, reason, current_iter, {}, timestamp);
+    MS_LOG(WARNING) << reason;
+    return true;
+  }
+
+  // The client is accepted once when it gets the first chunk.
+  size_t chunk_index = IntToSize(get_model_req->chunk_index());
+  if (chunk_index == 0) {
+    IncreaseAcceptClientNum();
+  }
+  size_t offset = chunk_index * kModelDeltaChunkSize;
+  size_t chunk_size = std::min(kModelDeltaChunkSize, delta->size() - offset);
+  BuildGetModelDeltaRsp(fbb, model_iter, base_iter, reinterpret_cast<const uint8_t *>(delta->data()) + offset,
+                        chunk_size, chunk_index, chunk_num, timestamp);
+  return true;
+}
+
+void GetModelKernel::BuildGetModelDeltaRsp(const std::shared_ptr<FBBuilder> &fbb, size_t model_iter, size_t base_iter,
+                                           const uint8_t *chunk, size_t chunk_size, size_t chunk_index,
+                                           size_t chunk_num, const std::string &timestamp) {
+  if (fbb == nullptr) {
+    MS_LOG(ERROR) << "Input fbb is nullptr.";
+    return;
+  }
+  auto fbs_reason = fbb->CreateString("Get model delta from iteration " + std::to_string(base_iter));
+  auto fbs_timestamp = fbb->CreateString(timestamp);
+  auto fbs_model_delta = fbb->CreateVector(chunk, chunk_size);
+
+  schema::ResponseGetModelBuilder rsp_get_model_builder(*(fbb.get()));
+  rsp_get_model_builder.add_retcode(static_cast<int>(schema::ResponseCode_SUCCEED));
+  rsp_get_model_builder.add_reason(fbs_reason);
+  rsp_get_model_builder.add_iteration(static_cast<int>(model_iter));
+  rsp_get_model_builder.add_timestamp(fbs_timestamp);
+  rsp_get_model_builder.add_base_iteration(static_cast<int>(base_iter));
+  rsp_get_model_builder.add_model_delta(fbs_model_delta);
+  rsp_get_model_builder.add_chunk_index(static_cast<int>(chunk_index));
+  rsp_get_model_builder.add_chunk_num(static_cast<int>(chunk_num));
+  auto rsp_get_model = rsp_get_model_builder.Finish();
+  fbb->Finish(rsp_get_model);
+  return;
+}
+
 void GetModelKernel::BuildGetModelRsp(const std::shared_ptr<FBBuilder> &fbb, const schema::ResponseCode retcode,
                                       const std::string &reason, const size_t iter,
                                       const std::map<std::string, AddressPtr> &feature_maps,
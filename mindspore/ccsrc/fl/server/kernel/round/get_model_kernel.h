@@ -46,6 +46,15 @@ class GetModelKernel : public RoundKernel {
                         const std::string &reason, const size_t iter,
                         const std::map<std::string, AddressPtr> &feature_maps, const std::string &timestamp);
 
+  // Return the chunk of the delta from the model of base_iter to the model of model_iter. Return false if the delta
+  // of the first chunk can't be encoded, then the whole model is returned.
+  bool GetModelDelta(const schema::RequestGetModel *get_model_req, size_t base_iter, size_t model_iter,
+                     size_t current_iter, const std::string &timestamp, const std::shared_ptr<FBBuilder> &fbb);
+  // Build the response of the chunk, whose iteration is the model_iter which the delta targets.
+  void BuildGetModelDeltaRsp(const std::shared_ptr<FBBuilder> &fbb, size_t model_iter, size_t base_iter,
+                             const uint8_t *chunk, size_t chunk_size, size_t chunk_index, size_t chunk_num,
+                             const std::string &timestamp);
+
   // The executor is for getting model for getModel request.
   Executor *executor_;
 
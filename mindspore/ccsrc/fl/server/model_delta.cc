@@ -0,0 +1,244 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "fl/server/model_delta.h"
+
+#include <securec.h>
+#include <algorithm>
+#include "utils/log_adapter.h"
+
+namespace mindspore {
+namespace fl {
+namespace server {
+// The integers are written and read in place by the hosts, which are little endian.
+static_assert(__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__, "The model delta needs the little endian host.");
+
+namespace {
+constexpr size_t kWordSize = 4;
+// The zeros shorter than this are kept in the literal bytes, because a new run costs at least two bytes.
+constexpr size_t kMinZeroRun = 4;
+constexpr uint8_t kVarintMask = 0x7F;
+constexpr uint8_t kVarintContinue = 0x80;
+constexpr size_t kVarintShift = 7;
+constexpr size_t kMaxVarintShift = 63;
+
+// The position of the index-th byte of the planes in the weight.
+inline size_t PlaneOffset(size_t index, size_t word_num) {
+  if (index >= word_num * kWordSize) {
+    return index;
+  }
+  return (index % word_num) * kWordSize + index / word_num;
+}
+
+void AppendVarint(uint64_t value, std::string *data) {
+  while (value > kVarintMask) {
+    data->push_back(static_cast<char>((value & kVarintMask) | kVarintContinue));
+    value >>= kVarintShift;
+  }
+  data->push_back(static_cast<char>(value));
+}
+
+bool ReadVarint(const uint8_t **pos, const uint8_t *end, uint64_t *value) {
+  *value = 0;
+  for (size_t shift = 0; *pos < end && shift <= kMaxVarintShift; shift += kVarintShift) {
+    uint8_t byte = **pos;
+    ++(*pos);
+    *value |= static_cast<uint64_t>(byte & kVarintMask) << shift;
+    if ((byte & kVarintContinue) == 0) {
+      return true;
+    }
+  }
+  return false;
+}
+
+template <typename T>
+void AppendValue(const T &value, std::string *data) {
+  (void)data->append(reinterpret_cast<const char *>(&value), sizeof(T));
+}
+
+template <typename T>
+bool ReadValue(const uint8_t **pos, const uint8_t *end, T *value) {
+  if (static_cast<size_t>(end - *pos) < sizeof(T)) {
+    return false;
+  }
+  auto ret = memcpy_s(value, sizeof(T), *pos, sizeof(T));
+  if (ret != EOK) {
+    MS_LOG(ERROR) << "memcpy_s error, errorno(" << ret << ")";
+    return false;
+  }
+  *pos += sizeof(T);
+  return true;
+}
+
+// Encode the planes as the runs of zeros and literal bytes.
+void EncodeRuns(const std::vector<uint8_t> &planes, std::string *data) {
+  size_t size = planes.size();
+  size_t index = 0;
+  while (index < size) {
+    size_t zero_num = 0;
+    while (index < size && planes[index] == 0) {
+      ++zero_num;
+      ++index;
+    }
+    // The literal bytes end before the next zeros which are long enough for a new run.
+    size_t literal_start = index;
+    size_t zero_count = 0;
+    while (index < size) {
+      zero_count = planes[index] == 0 ? zero_count + 1 : 0;
+      ++index;
+      if (zero_count == kMinZeroRun) {
+        index -= kMinZeroRun;
+        break;
+      }
+    }
+    AppendVarint(zero_num, data);
+    AppendVarint(index - literal_start, data);
+    (void)data->append(reinterpret_cast<const char *>(planes.data() + literal_start), index - literal_start);
+  }
+}
+}  // namespace
+
+ModelDeltaEncoder::ModelDeltaEncoder(size_t base_iteration, size_t iteration)
+    : header_{kModelDeltaMagic, kModelDeltaVersion, 0, base_iteration, iteration, 0} {}
+
+void ModelDeltaEncoder::AddWeight(const std::string &name, const void *base, const void *weight, size_t size) {
+  if (weight == nullptr && size > 0) {
+    MS_LOG(EXCEPTION) << "The data of weight " << name << " is nullptr.";
+  }
+  auto base_bytes = reinterpret_cast<const uint8_t *>(base);
+  auto weight_bytes = reinterpret_cast<const uint8_t *>(weight);
+  size_t word_num = size / kWordSize;
+  planes_.resize(size);
+  for (size_t i = 0; i < size; ++i) {
+    size_t offset = PlaneOffset(i, word_num);
+    planes_[i] = base_bytes == nullptr ? weight_bytes[offset] : (weight_bytes[offset] ^ base_bytes[offset]);
+  }
+
+  AppendValue(static_cast<uint32_t>(name.size()), &data_);
+  (void)data_.append(name);
+  AppendValue(static_cast<uint64_t>(size), &data_);
+  // The size of the encoded delta is written after it is encoded.
+  size_t delta_size_pos = data_.size();
+  AppendValue(static_cast<uint64_t>(0), &data_);
+  size_t delta_start = data_.size();
+  EncodeRuns(planes_, &data_);
+  uint64_t delta_size = data_.size() - delta_start;
+  auto ret = memcpy_s(&data_[delta_size_pos], sizeof(delta_size), &delta_size, sizeof(delta_size));
+  if (ret != EOK) {
+    MS_LOG(EXCEPTION) << "memcpy_s error, errorno(" << ret << ")";
+  }
+  ++header_.weight_num;
+}
+
+std::string ModelDeltaEncoder::Finish() {
+  std::string delta;
+  delta.reserve(sizeof(header_) + data_.size());
+  AppendValue(header_, &delta);
+  (void)delta.append(data_);
+  return delta;
+}
+
+bool ModelDeltaDecoder::Parse(const void *data, size_t size) {
+  if (data == nullptr) {
+    MS_LOG(ERROR) << "The model delta is nullptr.";
+    return false;
+  }
+  auto pos = reinterpret_cast<const uint8_t *>(data);
+  auto end = pos + size;
+  ModelDeltaHeader header;
+  if (!ReadValue(&pos, end, &header) || header.magic != kModelDeltaMagic || header.version != kModelDeltaVersion) {
+    MS_LOG(ERROR) << "Invalid header of the model delta, size: " << size;
+    return false;
+  }
+
+  weights_.clear();
+  for (uint64_t i = 0; i < header.weight_num; ++i) {
+    uint32_t name_size = 0;
+    if (!ReadValue(&pos, end, &name_size) || name_size > static_cast<size_t>(end - pos)) {
+      MS_LOG(ERROR) << "Invalid name of the weight " << i << " in the model delta.";
+      return false;
+    }
+    ModelDeltaWeight weight;
+    weight.name.assign(reinterpret_cast<const char *>(pos), name_size);
+    pos += name_size;
+    uint64_t weight_size = 0;
+    uint64_t delta_size = 0;
+    if (!ReadValue(&pos, end, &weight_size) || !ReadValue(&pos, end, &delta_size) ||
+        delta_size > static_cast<size_t>(end - pos)) {
+      MS_LOG(ERROR) << "Invalid size of the weight " << weight.name << " in the model delta.";
+      return false;
+    }
+    weight.size = static_cast<size_t>(weight_size);
+    weight.delta = pos;
+    weight.delta_size = static_cast<size_t>(delta_size);
+    pos += delta_size;
+    weights_.push_back(weight);
+  }
+  if (pos != end) {
+    MS_LOG(ERROR) << "The model delta has " << (end - pos) << " bytes after the weights.";
+    return false;
+  }
+  base_iteration_ = static_cast<size_t>(header.base_iteration);
+  iteration_ = static_cast<size_t>(header.iteration);
+  return true;
+}
+
+bool ModelDeltaDecoder::DecodeWeight(const ModelDeltaWeight &weight, const void *base, void *output) {
+  if (weight.size == 0) {
+    return true;
+  }
+  if (output == nullptr) {
+    MS_LOG(ERROR) << "The output of weight " << weight.name << " is nullptr.";
+    return false;
+  }
+  auto output_bytes = reinterpret_cast<uint8_t *>(output);
+  auto ret = base == nullptr ? memset_s(output, weight.size, 0, weight.size)
+                             : memcpy_s(output, weight.size, base, weight.size);
+  if (ret != EOK) {
+    MS_LOG(ERROR) << "Initializing the output of weight " << weight.name << " failed, errorno(" << ret << ")";
+    return false;
+  }
+
+  size_t word_num = weight.size / kWordSize;
+  size_t index = 0;
+  const uint8_t *pos = weight.delta;
+  const uint8_t *end = weight.delta + weight.delta_size;
+  while (pos < end) {
+    uint64_t zero_num = 0;
+    uint64_t literal_num = 0;
+    if (!ReadVarint(&pos, end, &zero_num) || !ReadVarint(&pos, end, &literal_num) ||
+        zero_num > weight.size - index || literal_num > weight.size - index - zero_num ||
+        literal_num > static_cast<size_t>(end - pos)) {
+      MS_LOG(ERROR) << "Invalid run of weight " << weight.name << " at byte " << index;
+      return false;
+    }
+    index += zero_num;
+    for (size_t i = 0; i < literal_num; ++i) {
+      output_bytes[PlaneOffset(index + i, word_num)] ^= pos[i];
+    }
+    index += literal_num;
+    pos += literal_num;
+  }
+  if (index != weight.size) {
+    MS_LOG(ERROR) << "The delta of weight " << weight.name << " decodes " << index << " bytes, but the size is "
+                  << weight.size;
+    return false;
+  }
+  return true;
+}
+}  // namespace server
+}  // namespace fl
+}  // namespace mindspore
@@ -0,0 +1,101 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_FL_SERVER_MODEL_DELTA_H_
+#define MINDSPORE_CCSRC_FL_SERVER_MODEL_DELTA_H_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace mindspore {
+namespace fl {
+namespace server {
+constexpr uint32_t kModelDeltaMagic = 0x444C4D46;
+constexpr uint16_t kModelDeltaVersion = 1;
+
+// The model delta is this header followed by weight_num weights. Each weight is the uint32 length of its name, the
+// name, the uint64 size of its data in bytes, the uint64 size of its encoded delta and then the encoded delta. All the
+// integers are little endian.
+//
+// The encoded delta of one weight is the XOR of its bytes against the base model, in which the unchanged bytes are 0:
+// 1. The XOR of every 4-byte word is split into 4 byte planes, followed by the bytes of the tail which is shorter than
+//    one word. So the high bytes of the float32 values, which seldom change between iterations, are continuous zeros.
+// 2. The planes are encoded as the runs, each of which is the varint number of zeros, the varint number of literal
+//    bytes, and then the literal bytes.
+struct ModelDeltaHeader {
+  uint32_t magic;
+  uint16_t version;
+  uint16_t reserved;
+  uint64_t base_iteration;
+  uint64_t iteration;
+  uint64_t weight_num;
+};
+
+// Encode the delta from the model of base_iteration to the model of iteration.
+class ModelDeltaEncoder {
+ public:
+  ModelDeltaEncoder(size_t base_iteration, size_t iteration);
+  ~ModelDeltaEncoder() = default;
+
+  // Add the weight of size bytes. The base is the weight of the base model, and it is nullptr if the base model has no
+  // such weight, then the weight is encoded against zeros.
+  void AddWeight(const std::string &name, const void *base, const void *weight, size_t size);
+
+  // Return the model delta of all the weights added.
+  std::string Finish();
+
+ private:
+  ModelDeltaHeader header_;
+  std::string data_;
+  // The reused buffer of the byte planes.
+  std::vector<uint8_t> planes_;
+};
+
+// A weight in the model delta, whose encoded delta is referenced in place.
+struct ModelDeltaWeight {
+  std::string name;
+  size_t size;
+  const uint8_t *delta;
+  size_t delta_size;
+};
+
+// Read the model delta, which must outlive the decoder.
+class ModelDeltaDecoder {
+ public:
+  ModelDeltaDecoder() = default;
+  ~ModelDeltaDecoder() = default;
+
+  // Check the model delta and read its weights, return false if it is invalid.
+  bool Parse(const void *data, size_t size);
+
+  size_t base_iteration() const { return base_iteration_; }
+  size_t iteration() const { return iteration_; }
+  const std::vector<ModelDeltaWeight> &weights() const { return weights_; }
+
+  // Decode the weight into the output of weight.size bytes. The base is the weight of the base model, or nullptr if the
+  // base model has no such weight. Return false if the encoded delta is invalid.
+  static bool DecodeWeight(const ModelDeltaWeight &weight, const void *base, void *output);
+
+ private:
+  size_t base_iteration_{0};
+  size_t iteration_{0};
+  std::vector<ModelDeltaWeight> weights_;
+};
+}  // namespace server
+}  // namespace fl
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_FL_SERVER_MODEL_DELTA_H_
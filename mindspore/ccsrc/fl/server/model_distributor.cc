@@ -0,0 +1,96 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "fl/server/model_distributor.h"
+#include <map>
+#include <memory>
+#include <string>
+#include "fl/server/model_store.h"
+
+namespace mindspore {
+namespace fl {
+namespace server {
+std::shared_ptr<const std::string> ModelDistributor::GetModelDelta(size_t base_iteration, size_t iteration) {
+  IterationPair iterations = std::make_pair(base_iteration, iteration);
+  std::shared_ptr<CachedDelta> cached_delta = nullptr;
+  {
+    std::unique_lock<std::mutex> lock(cache_mtx_);
+    auto iter = iterations_to_delta_.find(iterations);
+    if (iter != iterations_to_delta_.end()) {
+      cached_delta = *(iter->second);
+      cached_deltas_.splice(cached_deltas_.begin(), cached_deltas_, iter->second);
+    } else {
+      cached_delta = std::make_shared<CachedDelta>();
+      cached_delta->iterations = iterations;
+      cached_deltas_.push_front(cached_delta);
+      iterations_to_delta_[iterations] = cached_deltas_.begin();
+      if (cached_deltas_.size() > kMaxCachedModelDeltaNum) {
+        (void)iterations_to_delta_.erase(cached_deltas_.back()->iterations);
+        cached_deltas_.pop_back();
+      }
+    }
+  }
+
+  std::unique_lock<std::mutex> delta_lock(cached_delta->delta_mtx);
+  if (cached_delta->delta == nullptr) {
+    cached_delta->delta = EncodeModelDelta(base_iteration, iteration);
+  }
+  return cached_delta->delta;
+}
+
+void ModelDistributor::Reset() {
+  std::unique_lock<std::mutex> lock(cache_mtx_);
+  cached_deltas_.clear();
+  iterations_to_delta_.clear();
+}
+
+std::shared_ptr<const std::string> ModelDistributor::EncodeModelDelta(size_t base_iteration, size_t iteration) {
+  // The models are encoded under the lock of ModelStore, which reuses the memory of the oldest model, usually the base
+  // model of the clients, for the newest one.
+  std::shared_ptr<const std::string> delta = nullptr;
+  auto encode = [&delta, base_iteration, iteration](const std::map<std::string, AddressPtr> &base_model,
+                                                    const std::map<std::string, AddressPtr> &model) -> bool {
+    if (base_model.empty() || model.empty()) {
+      return false;
+    }
+    ModelDeltaEncoder encoder(base_iteration, iteration);
+    for (const auto &weight : model) {
+      MS_ERROR_IF_NULL_W_RET_VAL(weight.second, false);
+      MS_ERROR_IF_NULL_W_RET_VAL(weight.second->addr, false);
+      // The weight whose shape is changed is encoded against zeros.
+      const void *base = nullptr;
+      auto base_weight = base_model.find(weight.first);
+      if (base_weight != base_model.end() && base_weight->second != nullptr &&
+          base_weight->second->size == weight.second->size) {
+        base = base_weight->second->addr;
+      }
+      encoder.AddWeight(weight.first, base, weight.second->addr, weight.second->size);
+    }
+    delta = std::make_shared<const std::string>(encoder.Finish());
+    return true;
+  };
+  if (!ModelStore::GetInstance().ReadModelsByIterNum(base_iteration, iteration, encode)) {
+    MS_LOG(WARNING) << "The model delta from iteration " << base_iteration << " to " << iteration
+                    << " can't be encoded, because the model is not stored.";
+    return nullptr;
+  }
+  MS_LOG(INFO) << "The model delta from iteration " << base_iteration << " to " << iteration << " is "
+               << delta->size() << " bytes, and the model size is " << ModelStore::GetInstance().model_size();
+  return delta;
+}
+}  // namespace server
+}  // namespace fl
+}  // namespace mindspore
@@ -0,0 +1,79 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_FL_SERVER_MODEL_DISTRIBUTOR_H_
+#define MINDSPORE_CCSRC_FL_SERVER_MODEL_DISTRIBUTOR_H_
+
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include "fl/server/model_delta.h"
+
+namespace mindspore {
+namespace fl {
+namespace server {
+// The max number of the model deltas cached by ModelDistributor.
+constexpr size_t kMaxCachedModelDeltaNum = 16;
+
+// The model delta is sent to the clients by the chunks of this size.
+constexpr size_t kModelDeltaChunkSize = 1024 * 1024;
+
+// ModelDistributor serves the clients the model of an iteration as the delta against the model of the base iteration
+// which they already hold, instead of the whole model. Both models must be stored in ModelStore. In one iteration,
+// almost all the clients ask for the same pair of iterations, so the deltas are cached by the pairs and each delta is
+// encoded only once.
+class ModelDistributor {
+ public:
+  static ModelDistributor &GetInstance() {
+    static ModelDistributor instance;
+    return instance;
+  }
+
+  // Get the delta from the model of base_iteration to the model of iteration, return nullptr if either model is not
+  // stored. The clients asking for the same pair wait for the delta encoded by the first one.
+  std::shared_ptr<const std::string> GetModelDelta(size_t base_iteration, size_t iteration);
+
+  // Clear the cached deltas. Called when ModelStore is reset, because the iteration numbers are reused.
+  void Reset();
+
+ private:
+  ModelDistributor() = default;
+  ~ModelDistributor() = default;
+  ModelDistributor(const ModelDistributor &) = delete;
+  ModelDistributor &operator=(const ModelDistributor &) = delete;
+
+  using IterationPair = std::pair<size_t, size_t>;
+  struct CachedDelta {
+    IterationPair iterations;
+    // The delta is encoded under this lock by the first client asking for it.
+    std::mutex delta_mtx;
+    std::shared_ptr<const std::string> delta;
+  };
+
+  std::shared_ptr<const std::string> EncodeModelDelta(size_t base_iteration, size_t iteration);
+
+  std::mutex cache_mtx_;
+  // The cached deltas in the order of their last use, the most recent is the first.
+  std::list<std::shared_ptr<CachedDelta>> cached_deltas_;
+  std::map<IterationPair, std::list<std::shared_ptr<CachedDelta>>::iterator> iterations_to_delta_;
+};
+}  // namespace server
+}  // namespace fl
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_FL_SERVER_MODEL_DISTRIBUTOR_H_
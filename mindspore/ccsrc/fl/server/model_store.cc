@@ -97,6 +97,19 @@ std::map<std::string, AddressPtr> ModelStore::GetModelByIterNum(size_t iteration
   return model;
 }
 
+bool ModelStore::ReadModelsByIterNum(size_t base_iteration, size_t iteration, const ModelReader &func) {
+  std::unique_lock<std::mutex> lock(model_mtx_);
+  auto base_model = iteration_to_model_.find(base_iteration);
+  auto model = iteration_to_model_.find(iteration);
+  if (base_model == iteration_to_model_.end() || model == iteration_to_model_.end()) {
+    MS_LOG(WARNING) << "Model for iteration " << base_iteration << " or " << iteration << " is not stored.";
+    return false;
+  }
+  MS_ERROR_IF_NULL_W_RET_VAL(base_model->second, false);
+  MS_ERROR_IF_NULL_W_RET_VAL(model->second, false);
+  return func(base_model->second->addresses(), model->second->addresses());
+}
+
 void ModelStore::Reset() {
   std::unique_lock<std::mutex> lock(model_mtx_);
   initial_model_ = iteration_to_model_.rbegin()->second;
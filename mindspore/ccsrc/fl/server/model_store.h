@@ -17,6 +17,7 @@
 #ifndef MINDSPORE_CCSRC_FL_SERVER_MODEL_STORE_H_
 #define MINDSPORE_CCSRC_FL_SERVER_MODEL_STORE_H_
 
+#include <functional>
 #include <map>
 #include <memory>
 #include <string>
@@ -52,6 +53,13 @@ class ModelStore {
   // Get model of the given iteration.
   std::map<std::string, AddressPtr> GetModelByIterNum(size_t iteration);
 
+  // Call func with the models of base_iteration and iteration under the lock of ModelStore, so the memory of neither
+  // model is reused by StoreModelByIterNum while func reads it. Return false if either model is not stored or func
+  // fails.
+  using ModelReader =
+    std::function<bool(const std::map<std::string, AddressPtr> &, const std::map<std::string, AddressPtr> &)>;
+  bool ReadModelsByIterNum(size_t base_iteration, size_t iteration, const ModelReader &func);
+
   // Reset the stored models. Called when federated learning job finishes.
   void Reset();
 
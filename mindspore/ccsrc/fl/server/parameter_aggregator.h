@@ -40,7 +40,8 @@ typedef struct {
 
 // ParameterAggregator includes methods for aggregating gradients and optimizing weights(launching aggregation and
 // optimizer kernels), getting weights, etc. It's not thread-safe, which means the caller must acquire lock before
-// calling ParameterAggregator methods concurrently.
+// calling ParameterAggregator methods concurrently. The only exception is AggregateUploadData if the aggregation
+// kernels support the concurrent aggregation.
 
 // Each ParameterAggregator is corresponding to one weight for now.
 
@@ -78,6 +79,13 @@ class ParameterAggregator {
   // Launch aggregators/optimizers of this ParameterAggregator in order.
   bool LaunchAggregators();
 
+  // Whether all the aggregation kernels support the concurrent aggregation. If so, the method AggregateUploadData could
+  // be called concurrently without the lock.
+  bool SupportConcurrentAggregation() const;
+
+  // Aggregate the upload data by the aggregation kernels directly, instead of UpdateData and LaunchAggregators.
+  bool AggregateUploadData(const UploadData &upload_data);
+
   // Different from the method Pull, this method simply returns the weight of this ParameterAggregator without causing
   // any change of status.
   AddressPtr GetWeight();
@@ -459,11 +459,23 @@ void AscendDeviceContext::AllocateGraphMemory(const NotNull<KernelGraphPtr> &roo
                << device::ascend::AscendMemoryPool::GetInstance().TotalUsedMemStatistics() / kMBToByte
                << "M, used peak size is "
                << device::ascend::AscendMemoryPool::GetInstance().UsedMemPeakStatistics() / kMBToByte << "M.";
+  const auto &fragmentation = device::ascend::AscendMemoryPool::GetInstance().FragmentationStatistics();
+  MS_LOG(INFO) << "The dynamic memory pool block counts is " << fragmentation.block_count_ << ", idle size is "
+               << fragmentation.idle_mem_size_ / kMBToByte << "M, largest idle buf size is "
+               << fragmentation.largest_idle_mem_buf_size_ / kMBToByte << "M, fragmentation ratio is "
+               << fragmentation.FragmentationRatio() << ".";
 
 #ifndef ENABLE_SECURITY
   if (MemoryProfiling::GetInstance().IsMemoryProfilingInitialized()) {
     uint64_t mem_size = runtime_instance_->GetMsUsedHbmSize();
     MemoryProfiling::GetInstance().SetDeviceMemSize(mem_size);
+    profiler::MemPoolProto mem_pool;
+    mem_pool.set_block_num(fragmentation.block_count_);
+    mem_pool.set_idle_block_num(fragmentation.idle_block_count_);
+    mem_pool.set_idle_mem(fragmentation.idle_mem_size_);
+    mem_pool.set_idle_buf_num(fragmentation.idle_mem_buf_count_);
+    mem_pool.set_largest_idle_buf(fragmentation.largest_idle_mem_buf_size_);
+    MemoryProfiling::GetInstance().SetMemPoolInfo(mem_pool);
     if (MemoryProfiling::GetInstance().NeedSaveMemoryProfiling()) {
       MemoryProfiling::GetInstance().SaveMemoryProfiling();
     }
@@ -20,6 +20,7 @@
 #include "plugin/device/cpu/hal/device/cpu_memory_manager.h"
 #include "plugin/device/cpu/kernel/akg/akg_cpu_kernel_build.h"
 #include "plugin/device/cpu/kernel/cpu_kernel_factory.h"
+#include "plugin/device/cpu/kernel/fused_elemwise_cpu_kernel.h"
 #include "kernel/kernel_build_info.h"
 #include "plugin/device/cpu/hal/device/kernel_select_cpu.h"
 #include "utils/trace_base.h"
@@ -32,6 +33,7 @@
 #include "backend/common/pass/replace_node_by_proxy.h"
 #include "backend/common/pass/erase_visit_attr.h"
 #include "common/graph_kernel/adapter/graph_kernel_optimization.h"
+#include "common/graph_kernel/adapter/cpu_native_fusion_optimization.h"
 #include "backend/common/session/anf_runtime_algorithm.h"
 #include "profiler/device/cpu/cpu_profiling.h"
 #if ((defined ENABLE_CPU) && (!defined _WIN32))
@@ -133,10 +135,14 @@ void CPUDeviceContext::OptimizeGraph(const KernelGraphPtr &graph) const {
   // Run final optimization.
   opt::CommonFinalOptimization(graph);
 
-#ifdef ENABLE_AKG
+#if defined(ENABLE_GRAPH_KERNEL) || defined(ENABLE_CPU_NATIVE_FUSION)
   // Run graph kernel fusion optimization
   if (graphkernel::GraphKernelFlags::GetInstance().IsEnableGraphKernel()) {
+#ifdef ENABLE_GRAPH_KERNEL
     graphkernel::GraphKernelOptimize(graph);
+#else
+    graphkernel::CpuNativeFusionOptimize(graph);
+#endif
     graph->SetExecOrderByDefault();
   }
 #endif
@@ -208,16 +214,21 @@ void CPUDeviceContext::CreateKernel(const std::vector<CNodePtr> &nodes) const {
     if (AnfAlgo::IsControlOpExecInBackend(node)) {
       continue;
     }
+    std::shared_ptr<kernel::NativeCpuKernelMod> cpu_kernel;
     if (session::AnfRuntimeAlgorithm::GetKernelType(node) == KernelType::AKG_KERNEL) {
-      if (!bin_map->initialized()) {
-        bin_map->Initialize();
+      // Elementwise clusters run natively, only the others need AKG code generation.
+      if (!kernel::FusedElemwiseCpuKernelMod::IsSupported(node)) {
+        if (!bin_map->initialized()) {
+          bin_map->Initialize();
+        }
+        akg_nodes.push_back(node);
+        continue;
       }
-      akg_nodes.push_back(node);
-      continue;
+      cpu_kernel = std::make_shared<kernel::FusedElemwiseCpuKernelMod>();
+    } else {
+      std::string kernel_name = AnfAlgo::GetCNodeName(node);
+      cpu_kernel = kernel::NativeCpuKernelModFactory::GetInstance().Create(kernel_name, node);
     }
-    std::string kernel_name = AnfAlgo::GetCNodeName(node);
-    std::shared_ptr<kernel::NativeCpuKernelMod> cpu_kernel =
-      kernel::NativeCpuKernelModFactory::GetInstance().Create(kernel_name, node);
     if (!cpu_kernel) {
       MS_LOG(EXCEPTION) << "Build cpu operator[" << node->fullname_with_scope() << "] failed";
     }
@@ -232,6 +243,11 @@ void CPUDeviceContext::CreateKernel(const std::vector<CNodePtr> &nodes) const {
 #ifdef ENABLE_AKG
   kernel::AkgCpuKernelBuilder akg_cpu_kernel_builder;
   (void)akg_cpu_kernel_builder.AkgKernelParallelBuild(akg_nodes);
+#else
+  if (!akg_nodes.empty()) {
+    MS_LOG(EXCEPTION) << "Graph kernel " << akg_nodes[0]->fullname_with_scope()
+                      << " needs AKG, but MindSpore is built without AKG.";
+  }
 #endif
 }
 
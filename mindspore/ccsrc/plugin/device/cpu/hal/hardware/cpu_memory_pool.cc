@@ -15,6 +15,7 @@
  */
 
 #include "plugin/device/cpu/hal/hardware/cpu_memory_pool.h"
+#include <algorithm>
 #include <string>
 #include "utils/log_adapter.h"
 #include "utils/convert_utils_base.h"
@@ -86,6 +87,12 @@ bool CPUMemoryPool::FreeDeviceMem(const DeviceMemPtr &addr) {
   return true;
 }
 
+bool CPUMemoryPool::ReleaseDeviceMem(const DeviceMemPtr &addr, size_t size) {
+  free(addr);
+  total_used_memory_ -= std::min(size, total_used_memory_);
+  return true;
+}
+
 size_t CPUMemoryPool::free_mem_size() { return GetSystemMemorySize("MemAvailable"); }
 }  // namespace cpu
 }  // namespace device
@@ -35,6 +35,7 @@ class CPUMemoryPool : public DynamicMemPoolBestFit {
 
   size_t AllocDeviceMem(size_t size, DeviceMemPtr *addr) override;
   bool FreeDeviceMem(const DeviceMemPtr &addr) override;
+  bool ReleaseDeviceMem(const DeviceMemPtr &addr, size_t size) override;
   size_t free_mem_size() override;
 
  private:
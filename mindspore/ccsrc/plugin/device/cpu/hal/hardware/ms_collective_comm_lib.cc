@@ -15,10 +15,23 @@
  */
 
 #include "plugin/device/cpu/hal/hardware/ms_collective_comm_lib.h"
+#include "base/float16.h"
+#include "ir/dtype/type.h"
 
 namespace mindspore {
 namespace device {
 namespace cpu {
+namespace {
+bool IsSupportedReduceType(CollectiveOpReduceType reduce_op) {
+  if (reduce_op != CollectiveOpReduceType::Reduce_Sum && reduce_op != CollectiveOpReduceType::Reduce_Max &&
+      reduce_op != CollectiveOpReduceType::Reduce_Min && reduce_op != CollectiveOpReduceType::Reduce_Prod) {
+    MS_LOG(ERROR) << "The reduce type " << reduce_op << " is not supported.";
+    return false;
+  }
+  return true;
+}
+}  // namespace
+
 MsCollectiveCommLib::MsCollectiveCommLib() {
   node_ = std::dynamic_pointer_cast<ps::core::AbstractNode>(ClusterContext::instance()->node());
   // Generate the global group name with node role.
@@ -79,19 +92,11 @@ bool MsCollectiveCommLib::Broadcast(const void *send_buff, void *recv_buff, size
   CHECK_IF_NULL(recv_buff);
   CHECK_IF_NULL(node_);
 
-  if (groups_.count(group_name) == 0) {
-    MS_LOG(ERROR) << "The group " << group_name << " does not exist.";
+  CommunicationGroupInfo group_info = {};
+  if (!GetGroupInfo(group_name, &group_info)) {
     return false;
   }
 
-  auto group = groups_[group_name];
-  CommunicationGroupInfo group_info = {};
-  group_info.size = group->group_size();
-  group_info.global_rank = global_rank_id_;
-  group_info.group_ranks = group->group_ranks();
-  group_info.global_to_group_ranks = group->global_to_group_ranks();
-  group_info.group_to_global_ranks = group->group_to_global_ranks();
-
   switch (data_type) {
     case TypeId::kNumberTypeInt8:
       return CollectiveOpsImpl::GetInstance().Broadcast<char>(send_buff, recv_buff, send_count, root_rank, node_,
@@ -112,6 +117,95 @@ bool MsCollectiveCommLib::Broadcast(const void *send_buff, void *recv_buff, size
   }
   return true;
 }
+
+bool MsCollectiveCommLib::AllReduce(const void *send_buff, void *recv_buff, size_t send_count, TypeId data_type,
+                                    CollectiveOpReduceType reduce_op, const std::string &group_name, void *) {
+  CHECK_IF_NULL(send_buff);
+  CHECK_IF_NULL(recv_buff);
+  CHECK_IF_NULL(node_);
+
+  CommunicationGroupInfo group_info = {};
+  if (!GetGroupInfo(group_name, &group_info) || !IsSupportedReduceType(reduce_op)) {
+    return false;
+  }
+
+  auto &collective_ops = CollectiveOpsImpl::GetInstance();
+  switch (data_type) {
+    case TypeId::kNumberTypeInt8:
+      return collective_ops.AllReduce<int8_t>(send_buff, recv_buff, send_count, reduce_op, node_, group_info);
+    case TypeId::kNumberTypeInt32:
+    case TypeId::kNumberTypeInt:
+      return collective_ops.AllReduce<int32_t>(send_buff, recv_buff, send_count, reduce_op, node_, group_info);
+    case TypeId::kNumberTypeInt64:
+      return collective_ops.AllReduce<int64_t>(send_buff, recv_buff, send_count, reduce_op, node_, group_info);
+    case TypeId::kNumberTypeUInt64:
+      return collective_ops.AllReduce<uint64_t>(send_buff, recv_buff, send_count, reduce_op, node_, group_info);
+    case TypeId::kNumberTypeFloat16:
+      return collective_ops.AllReduce<float16>(send_buff, recv_buff, send_count, reduce_op, node_, group_info);
+    case TypeId::kNumberTypeFloat32:
+    case TypeId::kNumberTypeFloat:
+      return collective_ops.AllReduce<float>(send_buff, recv_buff, send_count, reduce_op, node_, group_info);
+    case TypeId::kNumberTypeFloat64:
+      return collective_ops.AllReduce<double>(send_buff, recv_buff, send_count, reduce_op, node_, group_info);
+    default:
+      MS_LOG(ERROR) << "The data type " << TypeIdLabel(data_type) << " of AllReduce is not supported.";
+      return false;
+  }
+  return true;
+}
+
+bool MsCollectiveCommLib::ReduceScatter(const void *send_buff, void *recv_buff, size_t recv_count, TypeId data_type,
+                                        CollectiveOpReduceType reduce_op, const std::string &group_name, void *) {
+  CHECK_IF_NULL(send_buff);
+  CHECK_IF_NULL(recv_buff);
+  CHECK_IF_NULL(node_);
+
+  CommunicationGroupInfo group_info = {};
+  if (!GetGroupInfo(group_name, &group_info) || !IsSupportedReduceType(reduce_op)) {
+    return false;
+  }
+
+  auto &collective_ops = CollectiveOpsImpl::GetInstance();
+  switch (data_type) {
+    case TypeId::kNumberTypeInt8:
+      return collective_ops.ReduceScatter<int8_t>(send_buff, recv_buff, recv_count, reduce_op, node_, group_info);
+    case TypeId::kNumberTypeInt32:
+    case TypeId::kNumberTypeInt:
+      return collective_ops.ReduceScatter<int32_t>(send_buff, recv_buff, recv_count, reduce_op, node_, group_info);
+    case TypeId::kNumberTypeInt64:
+      return collective_ops.ReduceScatter<int64_t>(send_buff, recv_buff, recv_count, reduce_op, node_, group_info);
+    case TypeId::kNumberTypeUInt64:
+      return collective_ops.ReduceScatter<uint64_t>(send_buff, recv_buff, recv_count, reduce_op, node_, group_info);
+    case TypeId::kNumberTypeFloat16:
+      return collective_ops.ReduceScatter<float16>(send_buff, recv_buff, recv_count, reduce_op, node_, group_info);
+    case TypeId::kNumberTypeFloat32:
+    case TypeId::kNumberTypeFloat:
+      return collective_ops.ReduceScatter<float>(send_buff, recv_buff, recv_count, reduce_op, node_, group_info);
+    case TypeId::kNumberTypeFloat64:
+      return collective_ops.ReduceScatter<double>(send_buff, recv_buff, recv_count, reduce_op, node_, group_info);
+    default:
+      MS_LOG(ERROR) << "The data type " << TypeIdLabel(data_type) << " of ReduceScatter is not supported.";
+      return false;
+  }
+  return true;
+}
+
+bool MsCollectiveCommLib::GetGroupInfo(const std::string &group_name, CommunicationGroupInfo *group_info) {
+  CHECK_IF_NULL(group_info);
+  if (groups_.count(group_name) == 0) {
+    MS_LOG(ERROR) << "The group " << group_name << " does not exist.";
+    return false;
+  }
+
+  auto group = groups_[group_name];
+  CHECK_IF_NULL(group);
+  group_info->size = group->group_size();
+  group_info->global_rank = global_rank_id_;
+  group_info->group_ranks = group->group_ranks();
+  group_info->global_to_group_ranks = group->global_to_group_ranks();
+  group_info->group_to_global_ranks = group->group_to_global_ranks();
+  return true;
+}
 }  // namespace cpu
 }  // namespace device
 }  // namespace mindspore
@@ -0,0 +1,458 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "plugin/device/cpu/kernel/fused_elemwise_cpu_kernel.h"
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <numeric>
+#include <string>
+#include "kernel/common_utils.h"
+#include "nnacl/fp32/activation_fp32.h"
+#include "nnacl/fp32/add_fp32.h"
+#include "nnacl/fp32/arithmetic_fp32.h"
+#include "nnacl/fp32/arithmetic_self_fp32.h"
+#include "nnacl/fp32/div_fp32.h"
+#include "nnacl/fp32/mul_fp32.h"
+#include "nnacl/fp32/sub_fp32.h"
+
+namespace mindspore {
+namespace kernel {
+namespace {
+// Elements per tile, small enough for the live registers of a cluster to stay in the L2 cache.
+constexpr size_t kFusedElemwiseTile = 1024;
+constexpr size_t kFusedElemwiseMaxDims = 8;
+constexpr size_t kUnaryInputNum = 1;
+constexpr size_t kBinaryInputNum = 2;
+
+// Exp, Sigmoid and Tanh use the standard library so that the fused results match the unfused oneDNN kernels, the nnacl
+// approximations differ from them by up to 1e-4 relative.
+inline float ExpValue(float x) { return std::exp(x); }
+inline float SigmoidValue(float x) { return 1.0f / (1.0f + std::exp(-x)); }
+inline float TanhValue(float x) { return std::tanh(x); }
+
+template <typename Func>
+void UnaryLoop(const float *in, float *out, int size, Func func) {
+  for (int i = 0; i < size; ++i) {
+    out[i] = func(in[i]);
+  }
+}
+
+const std::unordered_map<std::string, FusedUnaryFunc> &UnaryFuncs() {
+  static const std::unordered_map<std::string, FusedUnaryFunc> funcs = {
+    {prim::kPrimAbs->name(), [](const float *in, float *out, int size) { (void)ElementAbs(in, out, size); }},
+    {prim::kPrimErf->name(), [](const float *in, float *out, int size) { (void)ElementErf(in, out, size); }},
+    {prim::kPrimExp->name(), [](const float *in, float *out, int size) { UnaryLoop(in, out, size, ExpValue); }},
+    {prim::kPrimLog->name(), [](const float *in, float *out, int size) { (void)ElementLog(in, out, size); }},
+    {prim::kPrimNeg->name(), [](const float *in, float *out, int size) { (void)ElementNegative(in, out, size); }},
+    {prim::kPrimReciprocal->name(),
+     [](const float *in, float *out, int size) { (void)ElementReciprocal(in, out, size); }},
+    {prim::kPrimRelu->name(), [](const float *in, float *out, int size) { (void)Fp32Relu(in, size, out); }},
+    {prim::kPrimRsqrt->name(), [](const float *in, float *out, int size) { (void)ElementRsqrt(in, out, size); }},
+    {prim::kPrimSigmoid->name(),
+     [](const float *in, float *out, int size) { UnaryLoop(in, out, size, SigmoidValue); }},
+    {prim::kPrimSqrt->name(), [](const float *in, float *out, int size) { (void)ElementSqrt(in, out, size); }},
+    {prim::kPrimSquare->name(), [](const float *in, float *out, int size) { (void)ElementSquare(in, out, size); }},
+    {prim::kPrimTanh->name(), [](const float *in, float *out, int size) { UnaryLoop(in, out, size, TanhValue); }}};
+  return funcs;
+}
+
+const std::unordered_map<std::string, FusedBinaryFunc> &BinaryFuncs() {
+  static const std::unordered_map<std::string, FusedBinaryFunc> funcs = {
+    {prim::kPrimAdd->name(),
+     [](const float *in0, const float *in1, float *out, int size) { (void)ElementAdd(in0, in1, out, size); }},
+    {prim::kPrimDiv->name(),
+     [](const float *in0, const float *in1, float *out, int size) { (void)ElementDiv(in0, in1, out, size); }},
+    {prim::kPrimMaximum->name(),
+     [](const float *in0, const float *in1, float *out, int size) { (void)ElementMaximum(in0, in1, out, size); }},
+    {prim::kPrimMinimum->name(),
+     [](const float *in0, const float *in1, float *out, int size) { (void)ElementMinimum(in0, in1, out, size); }},
+    {prim::kPrimMul->name(),
+     [](const float *in0, const float *in1, float *out, int size) { (void)ElementMul(in0, in1, out, size); }},
+    {prim::kPrimRealDiv->name(),
+     [](const float *in0, const float *in1, float *out, int size) { (void)ElementDiv(in0, in1, out, size); }},
+    {prim::kPrimSub->name(),
+     [](const float *in0, const float *in1, float *out, int size) { (void)ElementSub(in0, in1, out, size); }}};
+  return funcs;
+}
+
+size_t ElementNum(const std::vector<size_t> &shape) {
+  return std::accumulate(shape.begin(), shape.end(), size_t(1), std::multiplies<size_t>());
+}
+
+// Gets the shape of a fp32 value of the sub graph, constants must be tensors.
+bool GetFloatValueShape(const AnfNodePtr &node, std::vector<size_t> *shape) {
+  MS_EXCEPTION_IF_NULL(node);
+  MS_EXCEPTION_IF_NULL(shape);
+  if (node->isa<ValueNode>()) {
+    auto tensor = GetValueNode<tensor::TensorPtr>(node);
+    if (tensor == nullptr || tensor->data_type() != kNumberTypeFloat32) {
+      return false;
+    }
+    shape->clear();
+    (void)std::transform(tensor->shape().begin(), tensor->shape().end(), std::back_inserter(*shape), LongToSize);
+    return true;
+  }
+  if (!node->isa<Parameter>() && !node->isa<CNode>()) {
+    return false;
+  }
+  if (AnfAlgo::GetOutputInferDataType(node, 0) != kNumberTypeFloat32) {
+    return false;
+  }
+  *shape = AnfAlgo::GetOutputInferShape(node, 0);
+  return true;
+}
+
+bool IsBroadcastable(const std::vector<size_t> &shape, const std::vector<size_t> &output_shape) {
+  if (shape.size() > output_shape.size()) {
+    return false;
+  }
+  size_t offset = output_shape.size() - shape.size();
+  for (size_t i = 0; i < shape.size(); ++i) {
+    if (shape[i] != 1 && shape[i] != output_shape[i + offset]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Strides of a broadcast input in the coordinates of the output, zero on the broadcast axes.
+std::vector<size_t> BroadcastStrides(const std::vector<size_t> &shape, const std::vector<size_t> &output_shape) {
+  std::vector<size_t> strides(output_shape.size(), 0);
+  size_t offset = output_shape.size() - shape.size();
+  size_t stride = 1;
+  for (size_t i = shape.size(); i > 0; --i) {
+    if (shape[i - 1] != 1) {
+      strides[i - 1 + offset] = stride;
+    }
+    stride *= shape[i - 1];
+  }
+  return strides;
+}
+}  // namespace
+
+bool FusedElemwiseCpuKernelMod::IsSupported(const AnfNodePtr &node) {
+  MS_EXCEPTION_IF_NULL(node);
+  if (!AnfAlgo::IsGraphKernel(node) || AnfAlgo::IsDynamicShape(node)) {
+    return false;
+  }
+  auto func_graph = AnfAlgo::GetCNodeFuncGraphPtr(node);
+  MS_EXCEPTION_IF_NULL(func_graph);
+  std::vector<AnfNodePtr> node_list;
+  std::vector<AnfNodePtr> input_list;
+  std::vector<AnfNodePtr> output_list;
+  GetValidKernelNodes(func_graph, &node_list, &input_list, &output_list);
+  std::vector<size_t> output_shape;
+  if (output_list.empty() || !GetFloatValueShape(output_list[0], &output_shape) ||
+      output_shape.size() > kFusedElemwiseMaxDims) {
+    return false;
+  }
+  auto is_float_value = [&output_shape](const AnfNodePtr &value) {
+    std::vector<size_t> shape;
+    return GetFloatValueShape(value, &shape) && IsBroadcastable(shape, output_shape);
+  };
+  auto is_full_value = [&output_shape](const AnfNodePtr &value) {
+    std::vector<size_t> shape;
+    return GetFloatValueShape(value, &shape) && ElementNum(shape) == ElementNum(output_shape);
+  };
+  // The inputs are checked against the output shape where they are used, a reshape may make them broadcastable.
+  auto has_float_shape = [](const AnfNodePtr &value) {
+    std::vector<size_t> shape;
+    return GetFloatValueShape(value, &shape);
+  };
+  if (!std::all_of(input_list.begin(), input_list.end(), has_float_shape) ||
+      !std::all_of(output_list.begin(), output_list.end(), is_full_value)) {
+    return false;
+  }
+  for (const auto &kernel_node : node_list) {
+    auto cnode = kernel_node->cast<CNodePtr>();
+    MS_EXCEPTION_IF_NULL(cnode);
+    auto op_name = AnfAlgo::GetCNodeName(cnode);
+    size_t input_num = cnode->inputs().size() - 1;
+    if (op_name == prim::kPrimReshape->name()) {
+      // Only a reshape of a sub graph input or a constant, such as the bias of an expanded BiasAdd, is read in place.
+      const auto &reshape_input = cnode->input(kIndex1);
+      if (reshape_input->isa<CNode>() || !has_float_shape(reshape_input) || !is_float_value(cnode)) {
+        MS_LOG(INFO) << "Graph kernel " << node->fullname_with_scope() << " is left to AKG, the reshape "
+                     << cnode->fullname_with_scope() << " can not run in the fused elementwise kernel.";
+        return false;
+      }
+      continue;
+    }
+    bool known_op = (input_num == kUnaryInputNum && UnaryFuncs().count(op_name) > 0) ||
+                    (input_num == kBinaryInputNum && BinaryFuncs().count(op_name) > 0);
+    if (!known_op || !is_float_value(cnode) ||
+        !std::all_of(cnode->inputs().begin() + 1, cnode->inputs().end(), is_float_value)) {
+      MS_LOG(INFO) << "Graph kernel " << node->fullname_with_scope() << " is left to AKG, operator " << op_name
+                   << " can not run in the fused elementwise kernel.";
+      return false;
+    }
+  }
+  return true;
+}
+
+size_t FusedElemwiseCpuKernelMod::AddSource(const AnfNodePtr &node, RegisterKind kind, size_t index,
+                                            const std::vector<size_t> &shape) {
+  size_t id = registers_.size();
+  value_ids_[node] = id;
+  size_t element_num = ElementNum(shape);
+  if (element_num == output_size_) {
+    (void)registers_.emplace_back(Register{kind, index});
+    return id;
+  }
+  (void)registers_.emplace_back(Register{kRegScratch, 0});
+  BroadcastLoad load;
+  load.source_ = kind;
+  load.source_index_ = index;
+  load.value_ = id;
+  load.scalar_ = (element_num == 1);
+  load.strides_ = BroadcastStrides(shape, output_shape_);
+  (void)loads_.emplace_back(std::move(load));
+  return id;
+}
+
+void FusedElemwiseCpuKernelMod::AllocateSlots(const std::vector<size_t> &last_use) {
+  slot_num_ = 0;
+  std::vector<size_t> free_slots;
+  auto acquire = [this, &free_slots]() {
+    if (free_slots.empty()) {
+      return slot_num_++;
+    }
+    size_t slot = free_slots.back();
+    free_slots.pop_back();
+    return slot;
+  };
+  auto release = [this, &free_slots, &last_use](size_t value, size_t pos) {
+    if (last_use[value] == pos && registers_[value].kind_ == kRegScratch) {
+      free_slots.push_back(registers_[value].index_);
+    }
+  };
+  // Broadcast values are loaded at the start of every tile, so they hold their slots from the beginning.
+  for (const auto &load : loads_) {
+    registers_[load.value_].index_ = acquire();
+  }
+  for (size_t i = 0; i < instructions_.size(); ++i) {
+    const auto &instruction = instructions_[i];
+    // Inputs that die here are released first, the elementwise primitives can write in place.
+    release(instruction.in0_, i);
+    if (instruction.binary_ != nullptr && instruction.in1_ != instruction.in0_) {
+      release(instruction.in1_, i);
+    }
+    if (registers_[instruction.out_].kind_ == kRegScratch) {
+      registers_[instruction.out_].index_ = acquire();
+    }
+  }
+}
+
+void FusedElemwiseCpuKernelMod::InitKernel(const CNodePtr &kernel_node) {
+  MS_EXCEPTION_IF_NULL(kernel_node);
+  kernel_name_ = AnfAlgo::GetCNodeName(kernel_node);
+  if (!IsSupported(kernel_node)) {
+    MS_LOG(EXCEPTION) << "For '" << kernel_name_ << "', the graph kernel " << kernel_node->fullname_with_scope()
+                      << " contains operators that the fused elementwise kernel does not support.";
+  }
+  auto func_graph = AnfAlgo::GetCNodeFuncGraphPtr(kernel_node);
+  MS_EXCEPTION_IF_NULL(func_graph);
+  std::vector<AnfNodePtr> node_list;
+  std::vector<AnfNodePtr> input_list;
+  std::vector<AnfNodePtr> output_list;
+  GetValidKernelNodes(func_graph, &node_list, &input_list, &output_list);
+  (void)GetFloatValueShape(output_list[0], &output_shape_);
+  if (output_shape_.empty()) {
+    output_shape_.push_back(1);
+  }
+  output_size_ = ElementNum(output_shape_);
+  value_ids_.clear();
+  registers_.clear();
+  loads_.clear();
+  instructions_.clear();
+  output_copies_.clear();
+  constants_.clear();
+
+  std::unordered_map<AnfNodePtr, size_t> input_index;
+  for (size_t i = 0; i < input_list.size(); ++i) {
+    (void)input_index.emplace(input_list[i], i);
+  }
+  // Inputs and constants become sources when they are first used, value_node is the node the source is read as.
+  auto add_source = [this, &input_index](const AnfNodePtr &source, const AnfNodePtr &value_node) {
+    std::vector<size_t> shape;
+    (void)GetFloatValueShape(value_node, &shape);
+    auto iter = input_index.find(source);
+    if (iter != input_index.end()) {
+      return AddSource(value_node, kRegInput, iter->second, shape);
+    }
+    auto tensor = GetValueNode<tensor::TensorPtr>(source);
+    MS_EXCEPTION_IF_NULL(tensor);
+    size_t id = AddSource(value_node, kRegConstant, constants_.size(), shape);
+    (void)constants_.emplace_back(tensor);
+    return id;
+  };
+  // A value computed inside the cluster is written straight into the first output that returns it.
+  std::unordered_map<AnfNodePtr, size_t> output_binding;
+  for (size_t i = 0; i < output_list.size(); ++i) {
+    if (output_list[i]->isa<CNode>()) {
+      (void)output_binding.emplace(output_list[i], i);
+    }
+  }
+  for (const auto &node : node_list) {
+    auto cnode = node->cast<CNodePtr>();
+    MS_EXCEPTION_IF_NULL(cnode);
+    auto op_name = AnfAlgo::GetCNodeName(cnode);
+    if (op_name == prim::kPrimReshape->name()) {
+      // The reshaped input or constant is read from its own memory with the new shape.
+      (void)add_source(cnode->input(kIndex1), cnode);
+      continue;
+    }
+    for (size_t i = 1; i < cnode->inputs().size(); ++i) {
+      const auto &input = cnode->input(i);
+      if (value_ids_.count(input) == 0) {
+        (void)add_source(input, input);
+      }
+    }
+    Instruction instruction;
+    instruction.in0_ = value_ids_.at(cnode->input(kIndex1));
+    if (cnode->inputs().size() - 1 == kUnaryInputNum) {
+      instruction.unary_ = UnaryFuncs().at(op_name);
+    } else {
+      instruction.binary_ = BinaryFuncs().at(op_name);
+      instruction.in1_ = value_ids_.at(cnode->input(kIndex2));
+    }
+    instruction.out_ = registers_.size();
+    value_ids_[cnode] = instruction.out_;
+    auto iter = output_binding.find(cnode);
+    if (iter != output_binding.end()) {
+      (void)registers_.emplace_back(Register{kRegOutput, iter->second});
+    } else {
+      (void)registers_.emplace_back(Register{kRegScratch, 0});
+    }
+    (void)instructions_.emplace_back(instruction);
+  }
+
+  std::vector<size_t> last_use(registers_.size(), std::numeric_limits<size_t>::max());
+  for (size_t i = 0; i < instructions_.size(); ++i) {
+    last_use[instructions_[i].in0_] = i;
+    if (instructions_[i].binary_ != nullptr) {
+      last_use[instructions_[i].in1_] = i;
+    }
+  }
+  for (size_t i = 0; i < output_list.size(); ++i) {
+    if (value_ids_.count(output_list[i]) == 0) {
+      (void)add_source(output_list[i], output_list[i]);
+      last_use.push_back(std::numeric_limits<size_t>::max());
+    }
+    size_t value = value_ids_.at(output_list[i]);
+    if (registers_[value].kind_ != kRegOutput || registers_[value].index_ != i) {
+      (void)output_copies_.emplace_back(i, value);
+      last_use[value] = std::numeric_limits<size_t>::max();
+    }
+  }
+  AllocateSlots(last_use);
+}
+
+void FusedElemwiseCpuKernelMod::LoadBroadcast(const BroadcastLoad &load, const float *source, size_t start, size_t len,
+                                              float *dst) const {
+  if (load.scalar_) {
+    std::fill_n(dst, len, source[0]);
+    return;
+  }
+  size_t ndim = output_shape_.size();
+  size_t coord[kFusedElemwiseMaxDims];
+  size_t offset = 0;
+  size_t rest = start;
+  for (size_t d = ndim; d > 0; --d) {
+    coord[d - 1] = rest % output_shape_[d - 1];
+    rest /= output_shape_[d - 1];
+    offset += coord[d - 1] * load.strides_[d - 1];
+  }
+  // Copy or fill runs along the innermost axis, then carry the coordinates.
+  size_t last = ndim - 1;
+  size_t done = 0;
+  while (done < len) {
+    size_t run = std::min(output_shape_[last] - coord[last], len - done);
+    if (load.strides_[last] == 0) {
+      std::fill_n(dst + done, run, source[offset]);
+    } else {
+      std::copy_n(source + offset, run, dst + done);
+    }
+    done += run;
+    coord[last] += run;
+    offset += run * load.strides_[last];
+    for (size_t d = last; d > 0 && coord[d] == output_shape_[d]; --d) {
+      offset -= coord[d] * load.strides_[d];
+      coord[d] = 0;
+      ++coord[d - 1];
+      offset += load.strides_[d - 1];
+    }
+  }
+}
+
+void FusedElemwiseCpuKernelMod::RunTiles(const std::vector<AddressPtr> &inputs, const std::vector<AddressPtr> &outputs,
+                                         size_t tile_begin, size_t tile_end) const {
+  std::vector<float> scratch(slot_num_ * kFusedElemwiseTile);
+  std::vector<float *> values(registers_.size());
+  auto base = [this, &inputs, &outputs](RegisterKind kind, size_t index) {
+    if (kind == kRegInput) {
+      return reinterpret_cast<float *>(inputs[index]->addr);
+    }
+    if (kind == kRegConstant) {
+      return reinterpret_cast<float *>(constants_[index]->data_c());
+    }
+    return reinterpret_cast<float *>(outputs[index]->addr);
+  };
+  for (size_t tile = tile_begin; tile < tile_end; ++tile) {
+    size_t start = tile * kFusedElemwiseTile;
+    size_t len = std::min(kFusedElemwiseTile, output_size_ - start);
+    for (size_t i = 0; i < registers_.size(); ++i) {
+      const auto &reg = registers_[i];
+      values[i] = reg.kind_ == kRegScratch ? scratch.data() + reg.index_ * kFusedElemwiseTile
+                                           : base(reg.kind_, reg.index_) + start;
+    }
+    for (const auto &load : loads_) {
+      LoadBroadcast(load, base(load.source_, load.source_index_), start, len, values[load.value_]);
+    }
+    int size = SizeToInt(len);
+    for (const auto &instruction : instructions_) {
+      if (instruction.unary_ != nullptr) {
+        instruction.unary_(values[instruction.in0_], values[instruction.out_], size);
+      } else {
+        instruction.binary_(values[instruction.in0_], values[instruction.in1_], values[instruction.out_], size);
+      }
+    }
+    for (const auto &copy : output_copies_) {
+      float *output = base(kRegOutput, copy.first) + start;
+      if (output != values[copy.second]) {
+        std::copy_n(values[copy.second], len, output);
+      }
+    }
+  }
+}
+
+bool FusedElemwiseCpuKernelMod::Launch(const std::vector<kernel::AddressPtr> &inputs,
+                                       const std::vector<kernel::AddressPtr> &,
+                                       const std::vector<kernel::AddressPtr> &outputs) {
+  CHECK_KERNEL_INPUTS_NUM(inputs.size(), input_size_list_.size(), kernel_name_);
+  CHECK_KERNEL_OUTPUTS_NUM(outputs.size(), output_size_list_.size(), kernel_name_);
+  if (output_size_ == 0) {
+    return true;
+  }
+  size_t tile_num = (output_size_ + kFusedElemwiseTile - 1) / kFusedElemwiseTile;
+  auto task = [this, &inputs, &outputs](size_t start, size_t end) { RunTiles(inputs, outputs, start, end); };
+  ParallelLaunchAutoSearch(task, tile_num, this, &parallel_search_info_);
+  return true;
+}
+}  // namespace kernel
+}  // namespace mindspore
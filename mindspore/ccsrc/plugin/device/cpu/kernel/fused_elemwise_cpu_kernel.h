@@ -0,0 +1,89 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_BACKEND_KERNEL_COMPILER_CPU_FUSED_ELEMWISE_CPU_KERNEL_H_
+#define MINDSPORE_CCSRC_BACKEND_KERNEL_COMPILER_CPU_FUSED_ELEMWISE_CPU_KERNEL_H_
+
+#include <memory>
+#include <vector>
+#include <utility>
+#include <unordered_map>
+#include "ir/tensor.h"
+#include "plugin/device/cpu/kernel/cpu_kernel.h"
+
+namespace mindspore {
+namespace kernel {
+using FusedUnaryFunc = void (*)(const float *, float *, int);
+using FusedBinaryFunc = void (*)(const float *, const float *, float *, int);
+
+// Runs a graph kernel node made of fp32 elementwise and broadcast operators without AKG. The sub graph is translated
+// once into a register program over nnacl fp32 primitives, which is then run tile by tile over the output, so the
+// intermediate values stay in cache and the whole cluster makes a single pass over memory.
+class FusedElemwiseCpuKernelMod : public NativeCpuKernelMod {
+ public:
+  FusedElemwiseCpuKernelMod() = default;
+  ~FusedElemwiseCpuKernelMod() override = default;
+
+  // Whether every operator, input and output of the graph kernel node can be handled by this kernel.
+  static bool IsSupported(const AnfNodePtr &node);
+
+  void InitKernel(const CNodePtr &kernel_node) override;
+  bool Launch(const std::vector<AddressPtr> &inputs, const std::vector<AddressPtr> &workspace,
+              const std::vector<AddressPtr> &outputs) override;
+
+ private:
+  enum RegisterKind { kRegInput, kRegConstant, kRegOutput, kRegScratch };
+  // Where the tile of a value lives: read in place from an input, a constant or an output, or kept in a scratch slot.
+  struct Register {
+    RegisterKind kind_{kRegScratch};
+    size_t index_{0};
+  };
+  // An input or constant that does not cover the whole output, broadcast into a scratch slot for every tile.
+  struct BroadcastLoad {
+    RegisterKind source_{kRegInput};
+    size_t source_index_{0};
+    size_t value_{0};
+    bool scalar_{false};
+    std::vector<size_t> strides_;
+  };
+  struct Instruction {
+    FusedUnaryFunc unary_{nullptr};
+    FusedBinaryFunc binary_{nullptr};
+    size_t out_{0};
+    size_t in0_{0};
+    size_t in1_{0};
+  };
+
+  size_t AddSource(const AnfNodePtr &node, RegisterKind kind, size_t index, const std::vector<size_t> &shape);
+  void AllocateSlots(const std::vector<size_t> &last_use);
+  void LoadBroadcast(const BroadcastLoad &load, const float *source, size_t start, size_t len, float *dst) const;
+  void RunTiles(const std::vector<AddressPtr> &inputs, const std::vector<AddressPtr> &outputs, size_t tile_begin,
+                size_t tile_end) const;
+
+  std::vector<size_t> output_shape_;
+  size_t output_size_{0};
+  std::unordered_map<AnfNodePtr, size_t> value_ids_;
+  std::vector<Register> registers_;
+  std::vector<BroadcastLoad> loads_;
+  std::vector<Instruction> instructions_;
+  // Outputs whose value is not computed into the output memory directly: (output index, value id).
+  std::vector<std::pair<size_t, size_t>> output_copies_;
+  std::vector<tensor::TensorPtr> constants_;
+  size_t slot_num_{0};
+};
+}  // namespace kernel
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_BACKEND_KERNEL_COMPILER_CPU_FUSED_ELEMWISE_CPU_KERNEL_H_
@@ -71,10 +71,7 @@ void SparseApplyAdamPSKernelMod::InitKernel(
   if (AnfAlgo::HasNodeAttr(USE_NESTEROV, cnode)) {
     use_nesterov_ = AnfAlgo::GetNodeAttr<bool>(cnode, USE_NESTEROV);
   }
-  (void)workspace_size_list_.emplace_back(indices_size_ * var_outer_dim_size_ * sizeof(float) * worker_num_);
-  (void)workspace_size_list_.emplace_back(indices_size_ * sizeof(int) * worker_num_);
-  (void)workspace_size_list_.emplace_back(indices_size_ * var_outer_dim_size_ * sizeof(float) * worker_num_);
-  (void)workspace_size_list_.emplace_back(indices_size_ * sizeof(int) * worker_num_);
+  InitReduceAndComputeWorkspaceSize<int>(indices_size_ * worker_num_, var_outer_dim_size_, &workspace_size_list_);
   (void)workspace_size_list_.emplace_back(var_first_dim_size_ * var_outer_dim_size_ * sizeof(float) * worker_num_);
 }
 
@@ -84,8 +81,7 @@ void SparseApplyAdamPSKernelMod::ReInit(const std::vector<std::vector<size_t>> &
   }
   const std::vector<size_t> &indices_shape = shapes[0];
   indices_size_ = indices_shape[0];
-  workspace_size_list_[0] = indices_size_ * var_outer_dim_size_ * sizeof(float) * worker_num_;
-  workspace_size_list_[1] = indices_size_ * sizeof(int) * worker_num_;
+  InitReduceAndComputeWorkspaceSize<int>(indices_size_ * worker_num_, var_outer_dim_size_, &workspace_size_list_);
 }
 
 void SparseApplyAdamPSKernelMod::ReInit(const std::vector<AddressPtr> &inputs) {
@@ -95,8 +91,7 @@ void SparseApplyAdamPSKernelMod::ReInit(const std::vector<AddressPtr> &inputs) {
   }
   const auto &indices_addr = inputs[10];
   indices_size_ = indices_addr->size / sizeof(int);
-  workspace_size_list_[0] = indices_size_ * var_outer_dim_size_ * sizeof(float);
-  workspace_size_list_[1] = indices_size_ * sizeof(int);
+  InitReduceAndComputeWorkspaceSize<int>(indices_size_, var_outer_dim_size_, &workspace_size_list_);
 }
 
 bool SparseApplyAdamPSKernelMod::Execute(const std::vector<AddressPtr> &inputs,
@@ -83,10 +83,7 @@ void SparseApplyFtrlPSKernelMod::InitKernel(
   if (lr_power_ > 0) {
     MS_LOG(EXCEPTION) << "lr_power should be a non-positive scalar";
   }
-  (void)workspace_size_list_.emplace_back(indices_size_ * var_outer_dim_size_ * sizeof(float) * worker_num_);
-  (void)workspace_size_list_.emplace_back(indices_size_ * sizeof(int) * worker_num_);
-  (void)workspace_size_list_.emplace_back(indices_size_ * var_outer_dim_size_ * sizeof(float) * worker_num_);
-  (void)workspace_size_list_.emplace_back(indices_size_ * sizeof(int) * worker_num_);
+  InitReduceAndComputeWorkspaceSize<int>(indices_size_ * worker_num_, var_outer_dim_size_, &workspace_size_list_);
 }
 
 void SparseApplyFtrlPSKernelMod::ReInit(const std::vector<std::vector<size_t>> &shapes) {
@@ -95,8 +92,7 @@ void SparseApplyFtrlPSKernelMod::ReInit(const std::vector<std::vector<size_t>> &
   }
   const std::vector<size_t> &indices_shape = shapes[0];
   indices_size_ = indices_shape[0];
-  workspace_size_list_[0] = indices_size_ * var_outer_dim_size_ * sizeof(float) * worker_num_;
-  workspace_size_list_[1] = indices_size_ * sizeof(int) * worker_num_;
+  InitReduceAndComputeWorkspaceSize<int>(indices_size_ * worker_num_, var_outer_dim_size_, &workspace_size_list_);
 }
 
 void SparseApplyFtrlPSKernelMod::ReInit(const std::vector<AddressPtr> &inputs) {
@@ -106,8 +102,7 @@ void SparseApplyFtrlPSKernelMod::ReInit(const std::vector<AddressPtr> &inputs) {
   }
   const auto &indices_addr = inputs[4];
   indices_size_ = indices_addr->size / sizeof(int);
-  workspace_size_list_[0] = indices_size_ * var_outer_dim_size_ * sizeof(float) * worker_num_;
-  workspace_size_list_[1] = indices_size_ * sizeof(int) * worker_num_;
+  InitReduceAndComputeWorkspaceSize<int>(indices_size_ * worker_num_, var_outer_dim_size_, &workspace_size_list_);
 }
 
 bool SparseApplyFtrlPSKernelMod::Execute(const std::vector<AddressPtr> &inputs,
@@ -73,10 +73,7 @@ void SparseApplyLazyAdamPSKernelMod::InitKernel(
   if (AnfAlgo::HasNodeAttr(USE_NESTEROV, cnode)) {
     use_nesterov_ = AnfAlgo::GetNodeAttr<bool>(cnode, USE_NESTEROV);
   }
-  (void)workspace_size_list_.emplace_back(indices_size_ * var_outer_dim_size_ * sizeof(float) * worker_num_);
-  (void)workspace_size_list_.emplace_back(indices_size_ * sizeof(int) * worker_num_);
-  (void)workspace_size_list_.emplace_back(indices_size_ * var_outer_dim_size_ * sizeof(float) * worker_num_);
-  (void)workspace_size_list_.emplace_back(indices_size_ * sizeof(int) * worker_num_);
+  InitReduceAndComputeWorkspaceSize<int>(indices_size_ * worker_num_, var_outer_dim_size_, &workspace_size_list_);
 }
 
 void SparseApplyLazyAdamPSKernelMod::ReInit(const std::vector<std::vector<size_t>> &shapes) {
@@ -85,8 +82,7 @@ void SparseApplyLazyAdamPSKernelMod::ReInit(const std::vector<std::vector<size_t
   }
   const std::vector<size_t> &indices_shape = shapes[0];
   indices_size_ = indices_shape[0];
-  workspace_size_list_[0] = indices_size_ * var_outer_dim_size_ * sizeof(float) * worker_num_;
-  workspace_size_list_[1] = indices_size_ * sizeof(int) * worker_num_;
+  InitReduceAndComputeWorkspaceSize<int>(indices_size_ * worker_num_, var_outer_dim_size_, &workspace_size_list_);
 }
 
 void SparseApplyLazyAdamPSKernelMod::ReInit(const std::vector<AddressPtr> &inputs) {
@@ -96,8 +92,7 @@ void SparseApplyLazyAdamPSKernelMod::ReInit(const std::vector<AddressPtr> &input
   }
   const auto &indices_addr = inputs[10];
   indices_size_ = indices_addr->size / sizeof(int);
-  workspace_size_list_[0] = indices_size_ * var_outer_dim_size_ * sizeof(float) * worker_num_;
-  workspace_size_list_[1] = indices_size_ * sizeof(int) * worker_num_;
+  InitReduceAndComputeWorkspaceSize<int>(indices_size_ * worker_num_, var_outer_dim_size_, &workspace_size_list_);
 }
 
 bool SparseApplyLazyAdamPSKernelMod::Execute(const std::vector<AddressPtr> &inputs,
@@ -0,0 +1,503 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_BACKEND_KERNEL_COMPILER_CPU_RADIX_UNIQUE_H_
+#define MINDSPORE_CCSRC_BACKEND_KERNEL_COMPILER_CPU_RADIX_UNIQUE_H_
+
+#include <unistd.h>
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+#include "plugin/device/cpu/kernel/cpu_kernel.h"
+#include "common/thread_pool.h"
+
+namespace mindspore {
+namespace kernel {
+constexpr size_t kRadixUniqueDefaultL2CacheSize = 256 * 1024;
+constexpr size_t kRadixUniqueBitsPerPass = 8;
+constexpr size_t kRadixUniqueMaxBits = 24;
+constexpr size_t kRadixUniquePartitionsPerThread = 4;
+constexpr size_t kRadixUniqueMinGrainSize = 4096;
+constexpr size_t kRadixUniqueMinTableSize = 16;
+constexpr size_t kRadixUniqueAlignSize = 64;
+
+inline size_t RadixUniqueL2CacheSize() {
+#ifdef _SC_LEVEL2_CACHE_SIZE
+  static const size_t l2_cache_size = []() {
+    auto size = sysconf(_SC_LEVEL2_CACHE_SIZE);
+    return size > 0 ? static_cast<size_t>(size) : kRadixUniqueDefaultL2CacheSize;
+  }();
+  return l2_cache_size;
+#else
+  return kRadixUniqueDefaultL2CacheSize;
+#endif
+}
+
+inline size_t RadixUniqueCeilLog2(size_t value) {
+  size_t bits = 0;
+  while ((static_cast<size_t>(1) << bits) < value) {
+    ++bits;
+  }
+  return bits;
+}
+
+// The finalizer of MurmurHash3, the high bits select the partition and the low bits the hash table slot.
+template <typename T>
+inline uint64_t RadixUniqueHash(T value) {
+  uint64_t bits = 0;
+  if constexpr (std::is_floating_point<T>::value) {
+    // Fold -0.0 onto +0.0, they compare equal and must land in the same partition.
+    if (value == 0) {
+      value = 0;
+    }
+    (void)memcpy(&bits, &value, sizeof(T));
+  } else {
+    bits = static_cast<uint64_t>(value);
+  }
+  bits ^= bits >> 33;
+  bits *= 0xff51afd7ed558ccdULL;
+  bits ^= bits >> 33;
+  bits *= 0xc4ceb9fe1a85ec53ULL;
+  bits ^= bits >> 33;
+  return bits;
+}
+
+// Deduplicates a large array with radix partitioning: the values are scattered into partitions by the high bits of
+// their hash in one or more passes of at most 2^kRadixUniqueBitsPerPass partitions each, until every partition and its
+// open-addressing hash table fit into L2. Partitions are deduplicated in parallel and unique ids are then assigned in
+// first-occurrence order, so the result does not depend on the thread number. All the memory comes from the workspace
+// given by the caller, which is usually a kernel workspace of WorkspaceSize(input_size) bytes.
+template <typename DataType, typename IndexType>
+class RadixUnique {
+ public:
+  struct Item {
+    DataType key_;
+    IndexType pos_;
+  };
+
+  RadixUnique(void *workspace, size_t workspace_size)
+      : workspace_(static_cast<uint8_t *>(workspace)), workspace_size_(workspace_size) {
+    MS_EXCEPTION_IF_NULL(workspace_);
+  }
+  ~RadixUnique() = default;
+
+  // The workspace bytes Compute needs for input_size values with all the threads of the thread pool.
+  static size_t WorkspaceSize(size_t input_size) {
+    size_t thread_num = ThreadNum(input_size, common::ThreadPool::GetInstance().GetSyncRunThreadNum());
+    return Layout(input_size, thread_num, nullptr, nullptr);
+  }
+
+  // Skip values outside [0, max_value), their inverse index is set to -1. Only valid for integral data types.
+  void SetValueRange(size_t max_value) {
+    check_range_ = true;
+    max_value_ = max_value;
+  }
+
+  // On return inverse_idx[i] is the unique id of input[i] and first_pos[id] is the position where the unique value
+  // occurs first; ids are numbered in first-occurrence order. Both outputs need room for input_size elements.
+  // Returns the number of unique values.
+  size_t Compute(const DataType *input, size_t input_size, IndexType *inverse_idx, IndexType *first_pos) {
+    MS_EXCEPTION_IF_NULL(input);
+    MS_EXCEPTION_IF_NULL(inverse_idx);
+    MS_EXCEPTION_IF_NULL(first_pos);
+    input_size_ = input_size;
+    partition_num_ = 0;
+    if (input_size == 0) {
+      return 0;
+    }
+    // A workspace sized with fewer threads is still used, by fewer threads.
+    thread_num_ = ThreadNum(input_size, common::ThreadPool::GetInstance().GetSyncRunThreadNum());
+    while (thread_num_ > 1 && Layout(input_size, thread_num_, nullptr, nullptr) > workspace_size_) {
+      --thread_num_;
+    }
+    size_t required_size = Layout(input_size, thread_num_, workspace_, &buffers_);
+    if (required_size > workspace_size_) {
+      MS_LOG(EXCEPTION) << "For 'RadixUnique', the workspace should be at least " << required_size << " bytes for "
+                        << input_size << " values, but got " << workspace_size_;
+    }
+
+    size_t total_bits = TotalBits(input_size, thread_num_);
+    rank_ = buffers_.rank_;
+    size_t first_bits = std::min(total_bits, kRadixUniqueBitsPerPass);
+    FirstPass(input, inverse_idx, first_bits);
+    size_t used_bits = first_bits;
+    while (used_bits < total_bits) {
+      size_t bits = std::min(total_bits - used_bits, kRadixUniqueBitsPerPass);
+      RefinePass(used_bits, bits);
+      used_bits += bits;
+    }
+    Deduplicate(inverse_idx);
+    return AssignUniqueIds(inverse_idx, first_pos);
+  }
+
+  // The partitions of the last Compute, items inside a partition keep their input order.
+  size_t partition_num() const { return partition_num_; }
+  const Item *items() const { return items_; }
+  const size_t *partition_offsets() const { return offsets_; }
+  const size_t *partition_unique_sizes() const { return buffers_.unique_sizes_; }
+  size_t thread_num() const { return thread_num_; }
+
+ private:
+  // The buffers carved out of the workspace. Items and offsets are double buffered for the refine passes, and the
+  // spare item buffer is the scratch of the partitions deduplicated by sorting.
+  struct Buffers {
+    IndexType *rank_{nullptr};
+    Item *items_[2]{nullptr, nullptr};
+    size_t *offsets_[2]{nullptr, nullptr};
+    size_t *histogram_{nullptr};
+    size_t *unique_sizes_{nullptr};
+    Item *tables_{nullptr};
+    size_t table_size_{0};
+  };
+
+  static size_t ThreadNum(size_t input_size, size_t max_thread_num) {
+    return std::max<size_t>(1, std::min(max_thread_num, input_size / kRadixUniqueMinGrainSize));
+  }
+
+  static size_t TotalBits(size_t input_size, size_t thread_num) {
+    size_t bytes_per_item = sizeof(Item) + 2 * sizeof(Item);
+    size_t partition_num = (input_size * bytes_per_item + RadixUniqueL2CacheSize() - 1) / RadixUniqueL2CacheSize();
+    if (thread_num > 1) {
+      partition_num = std::max(partition_num, thread_num * kRadixUniquePartitionsPerThread);
+    }
+    return std::min(RadixUniqueCeilLog2(partition_num), kRadixUniqueMaxBits);
+  }
+
+  static size_t TableSize(size_t partition_size) {
+    return static_cast<size_t>(1) << RadixUniqueCeilLog2(std::max(2 * partition_size, kRadixUniqueMinTableSize));
+  }
+
+  // The hash table of every thread is capped at about L2, larger partitions are deduplicated by sorting.
+  static size_t MaxTableSize(size_t input_size) {
+    return std::min(TableSize(input_size), TableSize(RadixUniqueL2CacheSize() / sizeof(Item) / 2));
+  }
+
+  template <typename T>
+  static T *Carve(uint8_t *base, size_t count, size_t *offset) {
+    *offset = (*offset + kRadixUniqueAlignSize - 1) / kRadixUniqueAlignSize * kRadixUniqueAlignSize;
+    T *buffer = base == nullptr ? nullptr : reinterpret_cast<T *>(base + *offset);
+    *offset += count * sizeof(T);
+    return buffer;
+  }
+
+  // Returns the workspace bytes for input_size values and thread_num threads, and points buffers into base unless
+  // base is nullptr.
+  static size_t Layout(size_t input_size, size_t thread_num, uint8_t *base, Buffers *buffers) {
+    Buffers unused;
+    if (buffers == nullptr) {
+      buffers = &unused;
+    }
+    size_t total_bits = TotalBits(input_size, thread_num);
+    size_t first_fanout = static_cast<size_t>(1) << std::min(total_bits, kRadixUniqueBitsPerPass);
+    size_t max_partition_num = static_cast<size_t>(1) << total_bits;
+    size_t offset = 0;
+    buffers->rank_ = Carve<IndexType>(base, input_size, &offset);
+    for (size_t i = 0; i < 2; ++i) {
+      buffers->items_[i] = Carve<Item>(base, input_size, &offset);
+      buffers->offsets_[i] = Carve<size_t>(base, max_partition_num + 1, &offset);
+    }
+    buffers->histogram_ = Carve<size_t>(base, thread_num * first_fanout, &offset);
+    buffers->unique_sizes_ = Carve<size_t>(base, max_partition_num, &offset);
+    buffers->table_size_ = MaxTableSize(input_size);
+    buffers->tables_ = Carve<Item>(base, thread_num * buffers->table_size_, &offset);
+    return offset;
+  }
+
+  static size_t Digit(uint64_t hash, size_t used_bits, size_t bits) {
+    if (bits == 0) {
+      return 0;
+    }
+    return static_cast<size_t>((hash << used_bits) >> (64 - bits));
+  }
+
+  bool IsValid(DataType value) const {
+    if constexpr (std::is_integral<DataType>::value) {
+      if (check_range_) {
+        return value >= 0 && static_cast<size_t>(value) < max_value_;
+      }
+    }
+    return true;
+  }
+
+  void FirstPass(const DataType *input, IndexType *inverse_idx, size_t bits) {
+    size_t fanout = static_cast<size_t>(1) << bits;
+    size_t chunk_size = (input_size_ + thread_num_ - 1) / thread_num_;
+    auto *histogram = buffers_.histogram_;
+    items_ = buffers_.items_[0];
+    offsets_ = buffers_.offsets_[0];
+    std::vector<common::Task> tasks;
+    tasks.reserve(thread_num_);
+    for (size_t t = 0; t < thread_num_; ++t) {
+      auto task = [this, input, inverse_idx, histogram, fanout, chunk_size, bits, t]() {
+        size_t *counts = histogram + t * fanout;
+        std::fill(counts, counts + fanout, 0);
+        size_t end = std::min(input_size_, (t + 1) * chunk_size);
+        for (size_t i = t * chunk_size; i < end; ++i) {
+          if (!IsValid(input[i])) {
+            inverse_idx[i] = -1;
+            rank_[i] = 0;
+            continue;
+          }
+          ++counts[Digit(RadixUniqueHash(input[i]), 0, bits)];
+        }
+        return common::SUCCESS;
+      };
+      (void)tasks.emplace_back(task);
+    }
+    ParallelLaunch(tasks);
+
+    // Partition-major offsets keep every partition contiguous and in input order.
+    size_t offset = 0;
+    for (size_t p = 0; p < fanout; ++p) {
+      offsets_[p] = offset;
+      for (size_t t = 0; t < thread_num_; ++t) {
+        size_t count = histogram[t * fanout + p];
+        histogram[t * fanout + p] = offset;
+        offset += count;
+      }
+    }
+    offsets_[fanout] = offset;
+    partition_num_ = fanout;
+    in_swap_slot_ = false;
+
+    tasks.clear();
+    for (size_t t = 0; t < thread_num_; ++t) {
+      auto task = [this, input, histogram, fanout, chunk_size, bits, t]() {
+        size_t *cursors = histogram + t * fanout;
+        size_t end = std::min(input_size_, (t + 1) * chunk_size);
+        for (size_t i = t * chunk_size; i < end; ++i) {
+          if (!IsValid(input[i])) {
+            continue;
+          }
+          auto &item = items_[cursors[Digit(RadixUniqueHash(input[i]), 0, bits)]++];
+          item.key_ = input[i];
+          item.pos_ = static_cast<IndexType>(i);
+        }
+        return common::SUCCESS;
+      };
+      (void)tasks.emplace_back(task);
+    }
+    ParallelLaunch(tasks);
+  }
+
+  void RefinePass(size_t used_bits, size_t bits) {
+    size_t fanout = static_cast<size_t>(1) << bits;
+    size_t valid_size = offsets_[partition_num_];
+    bool swap = !in_swap_slot_;
+    auto *out_items = buffers_.items_[swap ? 1 : 0];
+    auto *out_offsets = buffers_.offsets_[swap ? 1 : 0];
+    std::vector<common::Task> tasks;
+    tasks.reserve(thread_num_);
+    for (size_t t = 0; t < thread_num_; ++t) {
+      auto task = [this, out_items, out_offsets, used_bits, bits, fanout, t]() {
+        std::array<size_t, (1 << kRadixUniqueBitsPerPass)> cursors;
+        for (size_t p = t; p < partition_num_; p += thread_num_) {
+          std::fill(cursors.begin(), cursors.begin() + fanout, 0);
+          for (size_t i = offsets_[p]; i < offsets_[p + 1]; ++i) {
+            ++cursors[Digit(RadixUniqueHash(items_[i].key_), used_bits, bits)];
+          }
+          size_t offset = offsets_[p];
+          for (size_t q = 0; q < fanout; ++q) {
+            out_offsets[p * fanout + q] = offset;
+            size_t count = cursors[q];
+            cursors[q] = offset;
+            offset += count;
+          }
+          for (size_t i = offsets_[p]; i < offsets_[p + 1]; ++i) {
+            out_items[cursors[Digit(RadixUniqueHash(items_[i].key_), used_bits, bits)]++] = items_[i];
+          }
+        }
+        return common::SUCCESS;
+      };
+      (void)tasks.emplace_back(task);
+    }
+    ParallelLaunch(tasks);
+    partition_num_ *= fanout;
+    out_offsets[partition_num_] = valid_size;
+    items_ = out_items;
+    offsets_ = out_offsets;
+    in_swap_slot_ = swap;
+  }
+
+  // Items arrive in input order, so the first occurrence of a value is the first of its items. Marks first occurrences
+  // in rank_ and points inverse_idx at the first position of each value. Every thread hashes its partitions into its
+  // own table, partitions too large for the table, e.g. of a value repeated many times, are sorted instead.
+  void Deduplicate(IndexType *inverse_idx) {
+    Item *scratch = buffers_.items_[in_swap_slot_ ? 0 : 1];
+    size_t max_table_size = buffers_.table_size_;
+    std::vector<common::Task> tasks;
+    tasks.reserve(thread_num_);
+    for (size_t t = 0; t < thread_num_; ++t) {
+      auto task = [this, inverse_idx, scratch, max_table_size, table = buffers_.tables_ + t * max_table_size, t]() {
+        for (size_t p = t; p < partition_num_; p += thread_num_) {
+          size_t partition_size = offsets_[p + 1] - offsets_[p];
+          if (partition_size == 0) {
+            buffers_.unique_sizes_[p] = 0;
+            continue;
+          }
+          size_t table_size = TableSize(partition_size);
+          if (table_size > max_table_size) {
+            buffers_.unique_sizes_[p] = SortDeduplicate(p, scratch, inverse_idx);
+          } else {
+            buffers_.unique_sizes_[p] = HashDeduplicate(p, table, table_size - 1, inverse_idx);
+          }
+        }
+        return common::SUCCESS;
+      };
+      (void)tasks.emplace_back(task);
+    }
+    ParallelLaunch(tasks);
+  }
+
+  void MarkFirst(const Item &item, IndexType *inverse_idx) {
+    rank_[item.pos_] = 1;
+    inverse_idx[item.pos_] = item.pos_;
+  }
+
+  void MarkRepeat(const Item &item, IndexType first, IndexType *inverse_idx) {
+    rank_[item.pos_] = 0;
+    inverse_idx[item.pos_] = first;
+  }
+
+  // Returns the number of unique values in partition p, as does SortDeduplicate.
+  size_t HashDeduplicate(size_t p, Item *table, size_t mask, IndexType *inverse_idx) {
+    size_t unique_size = 0;
+    for (size_t i = 0; i <= mask; ++i) {
+      table[i].pos_ = -1;
+    }
+    for (size_t i = offsets_[p]; i < offsets_[p + 1]; ++i) {
+      const auto &item = items_[i];
+      size_t slot = static_cast<size_t>(RadixUniqueHash(item.key_)) & mask;
+      while (table[slot].pos_ >= 0 && !(table[slot].key_ == item.key_)) {
+        slot = (slot + 1) & mask;
+      }
+      if (table[slot].pos_ < 0) {
+        table[slot] = item;
+        MarkFirst(item, inverse_idx);
+        ++unique_size;
+      } else {
+        MarkRepeat(item, table[slot].pos_, inverse_idx);
+      }
+    }
+    return unique_size;
+  }
+
+  // Sorts a copy of the partition in the spare item buffer by value and position, so the first item of every run of
+  // equal values is its first occurrence.
+  size_t SortDeduplicate(size_t p, Item *scratch, IndexType *inverse_idx) {
+    Item *begin = scratch + offsets_[p];
+    Item *end = scratch + offsets_[p + 1];
+    size_t unique_size = 0;
+    (void)std::copy(items_ + offsets_[p], items_ + offsets_[p + 1], begin);
+    if constexpr (std::is_floating_point<DataType>::value) {
+      // NaN never equals itself, every NaN is unique as in the hash table.
+      Item *nan_begin = std::partition(begin, end, [](const Item &item) { return item.key_ == item.key_; });
+      for (Item *it = nan_begin; it != end; ++it) {
+        MarkFirst(*it, inverse_idx);
+      }
+      unique_size += static_cast<size_t>(end - nan_begin);
+      end = nan_begin;
+    }
+    std::sort(begin, end, [](const Item &left, const Item &right) {
+      return left.key_ < right.key_ || (left.key_ == right.key_ && left.pos_ < right.pos_);
+    });
+    for (Item *it = begin; it != end;) {
+      const Item &first = *it;
+      MarkFirst(first, inverse_idx);
+      ++unique_size;
+      for (++it; it != end && it->key_ == first.key_; ++it) {
+        MarkRepeat(*it, first.pos_, inverse_idx);
+      }
+    }
+    return unique_size;
+  }
+
+  // Prefix sum over the first-occurrence flags turns them into unique ids.
+  size_t AssignUniqueIds(IndexType *inverse_idx, IndexType *first_pos) {
+    size_t chunk_size = (input_size_ + thread_num_ - 1) / thread_num_;
+    std::vector<size_t> chunk_base(thread_num_ + 1, 0);
+    std::vector<common::Task> tasks;
+    tasks.reserve(thread_num_);
+    for (size_t t = 0; t < thread_num_; ++t) {
+      auto task = [this, &chunk_base, chunk_size, t]() {
+        size_t end = std::min(input_size_, (t + 1) * chunk_size);
+        size_t count = 0;
+        for (size_t i = t * chunk_size; i < end; ++i) {
+          count += static_cast<size_t>(rank_[i]);
+        }
+        chunk_base[t + 1] = count;
+        return common::SUCCESS;
+      };
+      (void)tasks.emplace_back(task);
+    }
+    ParallelLaunch(tasks);
+    for (size_t t = 0; t < thread_num_; ++t) {
+      chunk_base[t + 1] += chunk_base[t];
+    }
+
+    tasks.clear();
+    for (size_t t = 0; t < thread_num_; ++t) {
+      auto task = [this, &chunk_base, first_pos, chunk_size, t]() {
+        size_t end = std::min(input_size_, (t + 1) * chunk_size);
+        size_t unique_id = chunk_base[t];
+        for (size_t i = t * chunk_size; i < end; ++i) {
+          bool is_first = rank_[i] != 0;
+          rank_[i] = static_cast<IndexType>(unique_id);
+          if (is_first) {
+            first_pos[unique_id++] = static_cast<IndexType>(i);
+          }
+        }
+        return common::SUCCESS;
+      };
+      (void)tasks.emplace_back(task);
+    }
+    ParallelLaunch(tasks);
+
+    tasks.clear();
+    for (size_t t = 0; t < thread_num_; ++t) {
+      auto task = [this, inverse_idx, chunk_size, t]() {
+        size_t end = std::min(input_size_, (t + 1) * chunk_size);
+        for (size_t i = t * chunk_size; i < end; ++i) {
+          if (inverse_idx[i] >= 0) {
+            inverse_idx[i] = rank_[inverse_idx[i]];
+          }
+        }
+        return common::SUCCESS;
+      };
+      (void)tasks.emplace_back(task);
+    }
+    ParallelLaunch(tasks);
+    return chunk_base[thread_num_];
+  }
+
+  uint8_t *workspace_{nullptr};
+  size_t workspace_size_{0};
+  Buffers buffers_;
+  bool check_range_{false};
+  size_t max_value_{0};
+  size_t input_size_{0};
+  size_t thread_num_{1};
+  size_t partition_num_{0};
+  bool in_swap_slot_{false};
+  Item *items_{nullptr};
+  size_t *offsets_{nullptr};
+  IndexType *rank_{nullptr};
+};
+}  // namespace kernel
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_BACKEND_KERNEL_COMPILER_CPU_RADIX_UNIQUE_H_
@@ -19,12 +19,10 @@
 #include <vector>
 #include <algorithm>
 #include <utility>
-#include "nnacl/fp32/reduce_fp32.h"
 
 namespace mindspore {
 namespace kernel {
 namespace {
-constexpr size_t kReduceSmallVectorSize = 200000;
 constexpr size_t kReduceInputsNum = 1;
 constexpr size_t kReduceOutputsNum = 1;
 }  // namespace
@@ -69,9 +67,11 @@ void ReduceCpuKernelMod<T>::InitKernel(const CNodePtr &kernel_node) {
   if constexpr (std::is_same<T, bool>::value) {
     if (kernel_name_ == prim::kPrimReduceAll->name()) {
       reduce_type_ = kReduceAll;
+      SetReduceEngine<ReduceAndOp>();
       reduce_func_ = [](const T *input, size_t pos, T *out) { *out &= input[pos]; };
     } else if (kernel_name_ == prim::kPrimReduceAny->name()) {
       reduce_type_ = kReduceAny;
+      SetReduceEngine<ReduceOrOp>();
       reduce_func_ = [](const T *input, size_t pos, T *out) { *out |= input[pos]; };
     } else {
       MS_LOG(EXCEPTION) << "For '" << kernel_name_ << "', unsupported reduce operation for bool.";
@@ -79,54 +79,58 @@ void ReduceCpuKernelMod<T>::InitKernel(const CNodePtr &kernel_node) {
   } else {
     if (kernel_name_ == prim::kPrimReduceMax->name()) {
       reduce_type_ = kReduceMax;
+      SetReduceEngine<ReduceMaxOp>();
       reduce_func_ = [](const T *input, size_t pos, T *out) { *out = std::max(input[pos], *out); };
     } else if (kernel_name_ == prim::kPrimReduceMin->name()) {
       reduce_type_ = kReduceMin;
+      SetReduceEngine<ReduceMinOp>();
       reduce_func_ = [](const T *input, size_t pos, T *out) { *out = std::min(input[pos], *out); };
     } else if (kernel_name_ == prim::kPrimReduceSum->name()) {
       reduce_type_ = kReduceSum;
+      SetReduceEngine<ReduceSumOp>();
       reduce_func_ = [](const T *input, size_t pos, T *out) { *out += input[pos]; };
     } else if (kernel_name_ == prim::kPrimReduceMean->name()) {
       reduce_type_ = kReduceMean;
+      SetReduceEngine<ReduceSumOp>();
       reduce_func_ = [](const T *input, size_t pos, T *out) { *out += input[pos]; };
     } else if (kernel_name == "ReduceProd") {
       reduce_type_ = kReduceProd;
+      SetReduceEngine<ReduceProdOp>();
       reduce_func_ = [](const T *input, size_t pos, T *out) { *out *= input[pos]; };
     } else {
       MS_LOG(EXCEPTION) << "For '" << kernel_name_ << "', unsupported reduce operation.";
     }
   }
 
-  // special accelerate for axis = 1 and input has 2 dims
-  if constexpr (std::is_same<T, float>::value) {
-    if ((reduce_type_ == kReduceMean || reduce_type_ == kReduceSum) && axis_.size() == 1 && axis_[0] == 1 &&
-        input_shape_.size() == 2) {
-      simple_execute_ = true;
-    }
+  // Scalars and vectors are always reduced as a whole.
+  if (input_shape_.size() <= 1) {
+    use_reduce_engine_ = CanonicalizeReduceAxes(input_shape_, {}, &layout_);
+  } else {
+    use_reduce_engine_ = CanonicalizeReduceAxes(input_shape_, axis_, &layout_);
   }
 }
 
+template <typename T>
+template <typename Op>
+void ReduceCpuKernelMod<T>::SetReduceEngine() {
+  reduce_engine_func_ = [this](const T *input, T *output) { ReduceEngine<T, Op>(layout_).Run(input, output); };
+}
+
 template <typename T>
 bool ReduceCpuKernelMod<T>::Launch(const std::vector<kernel::AddressPtr> &inputs,
                                    const std::vector<kernel::AddressPtr> &,
                                    const std::vector<kernel::AddressPtr> &outputs) {
   CHECK_KERNEL_INPUTS_NUM(inputs.size(), kReduceInputsNum, kernel_name_);
   CHECK_KERNEL_OUTPUTS_NUM(outputs.size(), kReduceOutputsNum, kernel_name_);
-  size_t input_size = inputs[0]->size / sizeof(T);
   auto *input_addr = reinterpret_cast<T *>(inputs[0]->addr);
   auto *output_addr = reinterpret_cast<T *>(outputs[0]->addr);
-  if (axis_.empty() || input_shape_.empty() || input_shape_.size() == 1) {
-    if (input_size < kReduceSmallVectorSize) {
-      // Get one ret
-      *output_addr = input_addr[0];
-      for (size_t i = 1; i < input_size; ++i) {
-        reduce_func_(input_addr, i, output_addr);
+  if (use_reduce_engine_) {
+    reduce_engine_func_(input_addr, output_addr);
+    if (reduce_type_ == kReduceMean) {
+      size_t output_size = layout_.outer_ * layout_.inner_;
+      for (size_t i = 0; i < output_size; ++i) {
+        output_addr[i] /= layout_.reduce_;
       }
-      if (reduce_type_ == kReduceMean) {
-        *output_addr /= input_size;
-      }
-    } else {
-      AccelerateLongVector(input_addr, output_addr, input_size);
     }
   } else {
     // Calculate transpose axes and stride
@@ -150,20 +154,6 @@ bool ReduceCpuKernelMod<T>::Launch(const std::vector<kernel::AddressPtr> &inputs
     }
 
     size_t output_size = outputs[0]->size / sizeof(T);
-    if constexpr (std::is_same<T, float>::value) {
-      if (simple_execute_) {
-        auto task = [&](size_t start, size_t end) {
-          for (size_t i = start; i < end; ++i) {
-            (void)ReduceSumDim2Axis1(stride, input_addr + i * stride, output_addr + i);
-            if (reduce_type_ == kReduceMean) {
-              output_addr[i] /= stride;
-            }
-          }
-        };
-        ParallelLaunchAutoSearch(task, output_size, this, &parallel_search_info_);
-        return true;
-      }
-    }
     // Calculate transpose shape
     std::vector<size_t> transpose_shape(input_shape_.size());
     for (int i = 0; i < dimension; ++i) {
@@ -189,34 +179,5 @@ bool ReduceCpuKernelMod<T>::Launch(const std::vector<kernel::AddressPtr> &inputs
   }
   return true;
 }
-
-template <typename T>
-void ReduceCpuKernelMod<T>::AccelerateLongVector(T *input_addr, T *output_addr, size_t input_size) {
-  // init output_addr
-  *output_addr = input_addr[0];
-  std::mutex task_mutex;
-  auto task = [this, input_addr, output_addr, &task_mutex](size_t start, size_t end) {
-    if (start == 0) {
-      ++start;
-    }
-    if (start == end) {
-      return;
-    }
-    auto block_output = input_addr[start];
-    size_t i = start + 1;
-    while (i < end) {
-      reduce_func_(input_addr, i, &block_output);
-      ++i;
-    }
-    {
-      std::lock_guard<std::mutex> task_lock(task_mutex);
-      reduce_func_(&block_output, 0, output_addr);
-    }
-  };
-  ParallelLaunchAutoSearch(task, input_size, this, &parallel_search_info_);
-  if (reduce_type_ == kReduceMean) {
-    *output_addr /= input_size;
-  }
-}
 }  // namespace kernel
 }  // namespace mindspore
@@ -23,6 +23,7 @@
 #include <functional>
 #include "plugin/device/cpu/kernel/cpu_kernel.h"
 #include "plugin/device/cpu/kernel/cpu_kernel_factory.h"
+#include "plugin/device/cpu/kernel/reduce_engine.h"
 
 namespace mindspore {
 namespace kernel {
@@ -36,14 +37,18 @@ class ReduceCpuKernelMod : public NativeCpuKernelMod {
               const std::vector<AddressPtr> &outputs) override;
 
  private:
-  void AccelerateLongVector(T *input_addr, T *output_addr, size_t input_size);
+  template <typename Op>
+  void SetReduceEngine();
 
   enum ReduceType { kReduceAll, kReduceAny, kReduceMax, kReduceMin, kReduceSum, kReduceMean, kReduceProd };
   std::vector<size_t> input_shape_;
   std::vector<int64_t> axis_;
   ReduceType reduce_type_{kReduceAll};
   std::function<void(const T *, size_t, T *)> reduce_func_;
-  bool simple_execute_{false};
+  // Used whenever the reduced axes merge into one contiguous block, reduce_func_ serves the remaining cases.
+  std::function<void(const T *, T *)> reduce_engine_func_;
+  ReduceLayout layout_;
+  bool use_reduce_engine_{false};
 };
 
 MS_REG_CPU_KERNEL_T(ReduceMean, KernelAttr(), ReduceCpuKernelMod, float);
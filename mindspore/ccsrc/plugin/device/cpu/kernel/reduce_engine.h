@@ -0,0 +1,287 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_BACKEND_KERNEL_COMPILER_CPU_REDUCE_ENGINE_H_
+#define MINDSPORE_CCSRC_BACKEND_KERNEL_COMPILER_CPU_REDUCE_ENGINE_H_
+
+#include <algorithm>
+#include <memory>
+#include <type_traits>
+#include <vector>
+#include "plugin/device/cpu/kernel/cpu_kernel.h"
+
+namespace mindspore {
+namespace kernel {
+constexpr size_t kReduceEngineLanes = 8;
+constexpr size_t kReduceEnginePairwiseBlock = 128;
+constexpr size_t kReduceEngineInnerTile = 256;
+constexpr size_t kReduceEngineMinTaskSize = 32768;
+
+struct ReduceSumOp {
+  template <typename T>
+  static T Apply(T a, T b) {
+    return static_cast<T>(a + b);
+  }
+  static constexpr bool kIsSum = true;
+};
+
+struct ReduceProdOp {
+  template <typename T>
+  static T Apply(T a, T b) {
+    return static_cast<T>(a * b);
+  }
+  static constexpr bool kIsSum = false;
+};
+
+struct ReduceMaxOp {
+  template <typename T>
+  static T Apply(T a, T b) {
+    return std::max(a, b);
+  }
+  static constexpr bool kIsSum = false;
+};
+
+struct ReduceMinOp {
+  template <typename T>
+  static T Apply(T a, T b) {
+    return std::min(a, b);
+  }
+  static constexpr bool kIsSum = false;
+};
+
+struct ReduceAndOp {
+  template <typename T>
+  static T Apply(T a, T b) {
+    return static_cast<T>(a && b);
+  }
+  static constexpr bool kIsSum = false;
+};
+
+struct ReduceOrOp {
+  template <typename T>
+  static T Apply(T a, T b) {
+    return static_cast<T>(a || b);
+  }
+  static constexpr bool kIsSum = false;
+};
+
+// A reduction seen as input[outer][reduce][inner] -> output[outer][inner].
+struct ReduceLayout {
+  size_t outer_{1};
+  size_t reduce_{1};
+  size_t inner_{1};
+};
+
+// Merges adjacent axes that are both reduced or both kept. Returns false when the reduced axes are still split into
+// several blocks, which the (outer, reduce, inner) form cannot express. sorted_axis must be sorted and unique; an empty
+// axis list reduces all axes.
+inline bool CanonicalizeReduceAxes(const std::vector<size_t> &shape, const std::vector<int64_t> &sorted_axis,
+                                   ReduceLayout *layout) {
+  MS_EXCEPTION_IF_NULL(layout);
+  *layout = ReduceLayout();
+  if (sorted_axis.empty()) {
+    for (auto dim : shape) {
+      layout->reduce_ *= dim;
+    }
+    return true;
+  }
+  size_t first = LongToSize(sorted_axis.front());
+  size_t last = LongToSize(sorted_axis.back());
+  // Size-1 axes can be treated as either kind, so only kept axes with more than one element split the block.
+  for (size_t i = first; i <= last && i < shape.size(); ++i) {
+    bool reduced = std::binary_search(sorted_axis.begin(), sorted_axis.end(), SizeToLong(i));
+    if (!reduced && shape[i] != 1) {
+      return false;
+    }
+  }
+  for (size_t i = 0; i < shape.size(); ++i) {
+    if (i < first) {
+      layout->outer_ *= shape[i];
+    } else if (i <= last) {
+      layout->reduce_ *= shape[i];
+    } else {
+      layout->inner_ *= shape[i];
+    }
+  }
+  return true;
+}
+
+// Reduces in the (outer, reduce, inner) form. Contiguous rows (inner == 1) use several independent accumulators so that
+// the loop vectorizes, and floating point sums are pairwise. Strided reductions (inner > 1) accumulate tiles of the
+// inner axis, vectorized along inner, with Kahan compensation for floating point sums. Work is split over the outputs
+// when there are enough of them, otherwise over the reduce axis with partial results merged in a fixed order, so the
+// result does not depend on scheduling.
+template <typename T, typename Op>
+class ReduceEngine {
+ public:
+  explicit ReduceEngine(const ReduceLayout &layout) : layout_(layout) {}
+  ~ReduceEngine() = default;
+
+  void Run(const T *input, T *output) const {
+    MS_EXCEPTION_IF_NULL(input);
+    MS_EXCEPTION_IF_NULL(output);
+    if (layout_.reduce_ == 0 || layout_.outer_ * layout_.inner_ == 0) {
+      return;
+    }
+    auto thread_pool = GetActorMgrInnerThreadPool();
+    MS_EXCEPTION_IF_NULL(thread_pool);
+    size_t thread_num = std::max<size_t>(1, thread_pool->GetKernelThreadNum());
+    size_t total_size = layout_.outer_ * layout_.reduce_ * layout_.inner_;
+    size_t reduce_chunk_num = std::min({thread_num, total_size / kReduceEngineMinTaskSize, layout_.reduce_});
+    if (OutputUnitNum() >= thread_num || reduce_chunk_num <= 1) {
+      RunOverOutputs(input, output);
+    } else {
+      RunOverReduce(input, output, reduce_chunk_num);
+    }
+  }
+
+ private:
+  static constexpr bool kCompensated = Op::kIsSum && std::is_floating_point<T>::value;
+
+  // Reduces a contiguous row, floating point sums split the row pairwise down to kReduceEnginePairwiseBlock.
+  static T ReduceRow(const T *input, size_t size) {
+    if constexpr (kCompensated) {
+      if (size > kReduceEnginePairwiseBlock) {
+        size_t half = size / 2;
+        half -= half % kReduceEngineLanes;
+        return ReduceRow(input, half) + ReduceRow(input + half, size - half);
+      }
+    }
+    if (size < kReduceEngineLanes) {
+      T result = input[0];
+      for (size_t i = 1; i < size; ++i) {
+        result = Op::Apply(result, input[i]);
+      }
+      return result;
+    }
+    T acc[kReduceEngineLanes];
+    for (size_t k = 0; k < kReduceEngineLanes; ++k) {
+      acc[k] = input[k];
+    }
+    size_t i = kReduceEngineLanes;
+    for (; i + kReduceEngineLanes <= size; i += kReduceEngineLanes) {
+      for (size_t k = 0; k < kReduceEngineLanes; ++k) {
+        acc[k] = Op::Apply(acc[k], input[i + k]);
+      }
+    }
+    for (; i < size; ++i) {
+      acc[0] = Op::Apply(acc[0], input[i]);
+    }
+    for (size_t width = kReduceEngineLanes / 2; width > 0; width /= 2) {
+      for (size_t k = 0; k < width; ++k) {
+        acc[k] = Op::Apply(acc[k], acc[k + width]);
+      }
+    }
+    return acc[0];
+  }
+
+  // Reduces rows [reduce_begin, reduce_end) of input[reduce][inner] for inner positions [inner_begin, inner_end).
+  void ReduceTile(const T *input, size_t reduce_begin, size_t reduce_end, size_t inner_begin, size_t inner_end,
+                  T *output) const {
+    size_t inner = layout_.inner_;
+    size_t width = inner_end - inner_begin;
+    T acc[kReduceEngineInnerTile];
+    const T *row = input + reduce_begin * inner + inner_begin;
+    for (size_t j = 0; j < width; ++j) {
+      acc[j] = row[j];
+    }
+    if constexpr (kCompensated) {
+      T compensation[kReduceEngineInnerTile] = {};
+      for (size_t r = reduce_begin + 1; r < reduce_end; ++r) {
+        row += inner;
+        for (size_t j = 0; j < width; ++j) {
+          T y = row[j] - compensation[j];
+          T t = acc[j] + y;
+          compensation[j] = (t - acc[j]) - y;
+          acc[j] = t;
+        }
+      }
+    } else {
+      for (size_t r = reduce_begin + 1; r < reduce_end; ++r) {
+        row += inner;
+        for (size_t j = 0; j < width; ++j) {
+          acc[j] = Op::Apply(acc[j], row[j]);
+        }
+      }
+    }
+    for (size_t j = 0; j < width; ++j) {
+      output[j] = acc[j];
+    }
+  }
+
+  // Outputs are handed out in units of one outer index and one tile of the inner axis.
+  size_t InnerTileNum() const { return (layout_.inner_ + kReduceEngineInnerTile - 1) / kReduceEngineInnerTile; }
+  size_t OutputUnitNum() const { return layout_.outer_ * InnerTileNum(); }
+
+  // Reduces rows [reduce_begin, reduce_end) for output units [unit_begin, unit_end) into output[outer][inner].
+  void ReduceUnits(const T *input, size_t unit_begin, size_t unit_end, size_t reduce_begin, size_t reduce_end,
+                   T *output) const {
+    size_t slice_size = layout_.reduce_ * layout_.inner_;
+    size_t tile_num = InnerTileNum();
+    for (size_t unit = unit_begin; unit < unit_end; ++unit) {
+      size_t o = unit / tile_num;
+      const T *slice = input + o * slice_size;
+      if (layout_.inner_ == 1) {
+        output[o] = ReduceRow(slice + reduce_begin, reduce_end - reduce_begin);
+        continue;
+      }
+      size_t inner_begin = (unit % tile_num) * kReduceEngineInnerTile;
+      size_t inner_end = std::min(layout_.inner_, inner_begin + kReduceEngineInnerTile);
+      ReduceTile(slice, reduce_begin, reduce_end, inner_begin, inner_end, output + o * layout_.inner_ + inner_begin);
+    }
+  }
+
+  void RunOverOutputs(const T *input, T *output) const {
+    size_t reduce = layout_.reduce_;
+    auto task = [this, input, output, reduce](size_t start, size_t end) {
+      ReduceUnits(input, start, end, 0, reduce, output);
+    };
+    size_t unit_size = reduce * std::min(layout_.inner_, kReduceEngineInnerTile);
+    float block_size = std::max(1.0f, static_cast<float>(kReduceEngineMinTaskSize) / unit_size);
+    ParallelLaunch(task, OutputUnitNum(), block_size);
+  }
+
+  void RunOverReduce(const T *input, T *output, size_t chunk_num) const {
+    size_t output_size = layout_.outer_ * layout_.inner_;
+    size_t chunk_size = (layout_.reduce_ + chunk_num - 1) / chunk_num;
+    chunk_num = (layout_.reduce_ + chunk_size - 1) / chunk_size;
+    // Not a std::vector, which is bit-packed for bool.
+    std::unique_ptr<T[]> partial = std::make_unique<T[]>(chunk_num * output_size);
+    std::vector<common::Task> tasks;
+    tasks.reserve(chunk_num);
+    for (size_t c = 0; c < chunk_num; ++c) {
+      auto task = [this, input, &partial, output_size, chunk_size, c]() {
+        size_t reduce_end = std::min(layout_.reduce_, (c + 1) * chunk_size);
+        ReduceUnits(input, 0, OutputUnitNum(), c * chunk_size, reduce_end, partial.get() + c * output_size);
+        return common::SUCCESS;
+      };
+      (void)tasks.emplace_back(task);
+    }
+    ParallelLaunch(tasks);
+    for (size_t i = 0; i < output_size; ++i) {
+      T result = partial[i];
+      for (size_t c = 1; c < chunk_num; ++c) {
+        result = Op::Apply(result, partial[c * output_size + i]);
+      }
+      output[i] = result;
+    }
+  }
+
+  ReduceLayout layout_;
+};
+}  // namespace kernel
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_BACKEND_KERNEL_COMPILER_CPU_REDUCE_ENGINE_H_
@@ -15,6 +15,7 @@
  */
 #include "plugin/device/cpu/kernel/sort_cpu_kernel.h"
 #include "common/thread_pool.h"
+#include "plugin/device/cpu/kernel/topk_select.h"
 
 namespace mindspore {
 namespace kernel {
@@ -50,8 +51,9 @@ template <typename T>
 void SortCpuKernelMod<T>::InitInputOutputSize(const CNodePtr &kernel_node) {
   NativeCpuKernelMod::InitInputOutputSize(kernel_node);
   size_t element_size = axisIterator_.OuterSize() * axisIterator_.InnerSize() * axisIterator_.AxisSize();
-  // id
-  (void)workspace_size_list_.emplace_back((sizeof(size_t) * element_size));
+  // ranks and the merge buffer
+  (void)workspace_size_list_.emplace_back((sizeof(uint64_t) * element_size));
+  (void)workspace_size_list_.emplace_back((sizeof(uint64_t) * element_size));
 }
 
 template <typename T>
@@ -69,7 +71,8 @@ bool SortCpuKernelMod<T>::Launch(const std::vector<AddressPtr> &inputs, const st
     MS_LOG(EXCEPTION) << "For '" << kernel_name_ << "', the memory size of inputs error.";
   }
   auto input = reinterpret_cast<T *>(inputs[0]->addr);
-  auto ids_addr = reinterpret_cast<size_t *>(workspace[0]->addr);
+  auto ranks = reinterpret_cast<uint64_t *>(workspace[0]->addr);
+  auto buffer = reinterpret_cast<uint64_t *>(workspace[1]->addr);
   auto output = reinterpret_cast<T *>(outputs[0]->addr);
   auto indices = reinterpret_cast<int *>(outputs[1]->addr);
 
@@ -80,40 +83,49 @@ bool SortCpuKernelMod<T>::Launch(const std::vector<AddressPtr> &inputs, const st
                       << outputs[0]->size << " and the memory size of input " << inputs[0]->size;
   }
 
-  std::function<bool(size_t, size_t)> comparator;
-  if (descending_) {
-    comparator = [&input](size_t index_1, size_t index_2) { return input[index_1] > input[index_2]; };
-  } else {
-    comparator = [&input](size_t index_1, size_t index_2) { return input[index_1] < input[index_2]; };
-  }
+  // Sorting packed (key, position) ranks keeps equal values in position order, as the stable sort did.
+  auto sort_column = [this, input, ranks, buffer, indices, output](size_t i, size_t j, size_t chunk_num) {
+    AxisIterator iter(axisIterator_);
+    iter.SetOffset(i, j);
+    size_t offset = (i * iter.InnerSize() + j) * iter.AxisSize();
+    uint64_t *column = ranks + offset;
+    for (size_t k = 0; k < iter.AxisSize(); ++k) {
+      T value = input[iter.GetPos(k)];
+      column[k] = descending_ ? DescendingRank(value, k) : AscendingRank(value, k);
+    }
+    uint64_t *sorted = ParallelSortRanks(column, buffer + offset, iter.AxisSize(), chunk_num);
+    for (size_t k = 0; k < iter.AxisSize(); ++k) {
+      const auto index = iter.GetPos(k);
+      size_t pos = RankPosition(sorted[k]);
+      indices[index] = SizeToInt(pos);
+      output[index] = input[iter.GetPos(pos)];
+    }
+  };
 
-  std::vector<common::Task> tasks;
-  tasks.reserve(axisIterator_.OuterSize() * axisIterator_.InnerSize());
+  auto thread_pool = GetActorMgrInnerThreadPool();
+  MS_EXCEPTION_IF_NULL(thread_pool);
+  size_t thread_num = thread_pool->GetKernelThreadNum();
+  size_t column_num = axisIterator_.OuterSize() * axisIterator_.InnerSize();
+  if (column_num >= thread_num || axisIterator_.AxisSize() < kTopKMinChunkSize * 2) {
+    std::vector<common::Task> tasks;
+    tasks.reserve(column_num);
+    for (size_t i = 0; i < axisIterator_.OuterSize(); ++i) {
+      for (size_t j = 0; j < axisIterator_.InnerSize(); ++j) {
+        (void)tasks.emplace_back([i, j, &sort_column]() {
+          sort_column(i, j, 1);
+          return common::SUCCESS;
+        });
+      }
+    }
+    ParallelLaunch(tasks);
+    return true;
+  }
+  // Few long columns: each one is sorted in chunks over the threads and merged.
   for (size_t i = 0; i < axisIterator_.OuterSize(); ++i) {
     for (size_t j = 0; j < axisIterator_.InnerSize(); ++j) {
-      auto task = [this, i, j, ids_addr, input, indices, output, &comparator]() {
-        AxisIterator iter(axisIterator_);
-        iter.SetOffset(i, j);
-
-        size_t offset = (i * iter.InnerSize() + j) * iter.AxisSize();
-        size_t *idx = ids_addr + offset;
-        for (size_t k = 0; k < iter.AxisSize(); ++k) {
-          idx[k] = iter.GetPos(k);
-        }
-
-        std::stable_sort(idx, idx + iter.AxisSize(), comparator);
-
-        for (size_t k = 0; k < iter.AxisSize(); ++k) {
-          const auto index = iter.GetPos(k);
-          indices[index] = SizeToInt(iter.RevertPos(idx[k]));
-          output[index] = input[idx[k]];
-        }
-        return common::SUCCESS;
-      };
-      (void)tasks.emplace_back(task);
+      sort_column(i, j, thread_num);
     }
   }
-  ParallelLaunch(tasks);
   return true;
 }
 }  // namespace kernel
@@ -22,7 +22,7 @@ namespace mindspore {
 namespace kernel {
 namespace {
 constexpr size_t kSparseApplyAdamInputsNum = 11;
-constexpr size_t kSparseApplyAdamWorkspaceSize = 5;
+constexpr size_t kSparseApplyAdamWorkspaceSize = kReduceAndComputeWorkspaceNum + 1;
 constexpr char kKernelName[] = "SparseApplyAdam";
 
 template <typename T>
@@ -85,10 +85,7 @@ void ComputeWeight(MultiThreadComputeParams<T> *input_params, size_t start, size
 
 template <typename T>
 void SparseApplyAdamCpuKernelMod::InitWorkspaceSize() {
-  (void)workspace_size_list_.emplace_back(indices_size_ * var_outer_dim_size_ * sizeof(float));
-  (void)workspace_size_list_.emplace_back(indices_size_ * sizeof(T));
-  (void)workspace_size_list_.emplace_back(indices_size_ * var_outer_dim_size_ * sizeof(float));
-  (void)workspace_size_list_.emplace_back(indices_size_ * sizeof(T));
+  InitReduceAndComputeWorkspaceSize<T>(indices_size_, var_outer_dim_size_, &workspace_size_list_);
   (void)workspace_size_list_.emplace_back(var_first_dim_size_ * var_outer_dim_size_ * sizeof(float));
 }
 
@@ -172,22 +169,9 @@ void SparseApplyAdamCpuKernelMod::LaunchKernel(const std::vector<kernel::Address
   auto epsilon = reinterpret_cast<float *>(inputs[8]->addr)[0];
   auto *grad = reinterpret_cast<float *>(inputs[9]->addr);
   auto *indices = reinterpret_cast<T *>(inputs[10]->addr);
-  auto *new_grad = reinterpret_cast<float *>(workspace[0]->addr);
-  auto *new_indices = reinterpret_cast<T *>(workspace[1]->addr);
-  auto *workspace_grad = reinterpret_cast<float *>(workspace[2]->addr);
-  auto *workspace_indices = reinterpret_cast<T *>(workspace[3]->addr);
-  auto *m_t = reinterpret_cast<float *>(workspace[4]->addr);
+  auto *m_t = reinterpret_cast<float *>(workspace[kReduceAndComputeWorkspaceNum]->addr);
 
-  SparseGradient<T> unique_sparse_grad({new_grad, new_indices, indices_size_});
-  SparseGradient<T> workspace_sparse_grad({workspace_grad, workspace_indices, indices_size_});
   SparseGradient<T> input_sparse_grad({grad, indices, indices_size_});
-  ReduceSparseGradientParam<T> param;
-  param.input_grad_ = &input_sparse_grad;
-  param.workspace_grad_ = &workspace_sparse_grad;
-  param.output_grad_ = &unique_sparse_grad;
-  param.max_index_ = var_first_dim_size_;
-  param.value_stride_ = var_outer_dim_size_;
-  BucketReduceSparseGradient(param);
 
   size_t total_dim_size = var_first_dim_size_ * var_outer_dim_size_;
   lr = lr * std::sqrt(1 - beta2_power) / (1 - beta1_power);
@@ -198,12 +182,11 @@ void SparseApplyAdamCpuKernelMod::LaunchKernel(const std::vector<kernel::Address
   input_params.beta1_ = beta1;
   input_params.beta2_ = beta2;
   MultiThreadCompute<T>(ComputeMomentum<T>, &input_params, total_dim_size);
-  input_params.m_t_ = m_t;
+  input_params.m_t_ = use_nesterov_ ? m_t : nullptr;
   input_params.use_nesterov_ = use_nesterov_;
-  input_params.sparse_grad_ = unique_sparse_grad;
   input_params.var_first_dim_size_ = var_first_dim_size_;
   input_params.var_outer_dim_size_ = var_outer_dim_size_;
-  MultiThreadCompute<T>(ComputeAdam<T>, &input_params, unique_sparse_grad.indices_size_);
+  MultiThreadReduceAndCompute<T>(ComputeAdam<T>, &input_params, input_sparse_grad, workspace);
 
   if (use_nesterov_) {
     input_params.m_ = input_params.m_t_;
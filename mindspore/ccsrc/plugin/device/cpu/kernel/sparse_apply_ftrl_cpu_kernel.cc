@@ -22,7 +22,7 @@ namespace mindspore {
 namespace kernel {
 namespace {
 constexpr size_t kSparseApplyFtrlInputsNum = 5;
-constexpr size_t kSparseApplyFtrlWorkspaceSize = 4;
+constexpr size_t kSparseApplyFtrlWorkspaceSize = kReduceAndComputeWorkspaceNum;
 constexpr char kKernelName[] = "SparseApplyFtrl";
 
 template <typename T>
@@ -68,10 +68,7 @@ void ComputeFtrl(MultiThreadComputeParams<T> *input_params, size_t start, size_t
 
 template <typename T>
 void SparseApplyFtrlCpuKernelMod::InitWorkspaceSize() {
-  (void)workspace_size_list_.emplace_back(indices_size_ * var_outer_dim_size_ * sizeof(float));
-  (void)workspace_size_list_.emplace_back(indices_size_ * sizeof(T));
-  (void)workspace_size_list_.emplace_back(indices_size_ * var_outer_dim_size_ * sizeof(float));
-  (void)workspace_size_list_.emplace_back(indices_size_ * sizeof(T));
+  InitReduceAndComputeWorkspaceSize<T>(indices_size_, var_outer_dim_size_, &workspace_size_list_);
 }
 
 void SparseApplyFtrlCpuKernelMod::InitInputOutputSize(const CNodePtr &kernel_node) {
@@ -164,21 +161,8 @@ void SparseApplyFtrlCpuKernelMod::LaunchKernel(const std::vector<kernel::Address
   auto *linear = reinterpret_cast<float *>(inputs[2]->addr);
   auto *grad = reinterpret_cast<float *>(inputs[3]->addr);
   auto *indices = reinterpret_cast<T *>(inputs[4]->addr);
-  auto *new_grad = reinterpret_cast<float *>(workspace[0]->addr);
-  auto *new_indices = reinterpret_cast<T *>(workspace[1]->addr);
-  auto *workspace_grad = reinterpret_cast<float *>(workspace[2]->addr);
-  auto *workspace_indices = reinterpret_cast<T *>(workspace[3]->addr);
 
-  SparseGradient<T> unique_sparse_grad({new_grad, new_indices, indices_size_});
-  SparseGradient<T> workspace_sparse_grad({workspace_grad, workspace_indices, indices_size_});
   SparseGradient<T> input_sparse_grad({grad, indices, indices_size_});
-  ReduceSparseGradientParam<T> param;
-  param.input_grad_ = &input_sparse_grad;
-  param.workspace_grad_ = &workspace_sparse_grad;
-  param.output_grad_ = &unique_sparse_grad;
-  param.max_index_ = var_first_dim_size_;
-  param.value_stride_ = var_outer_dim_size_;
-  BucketReduceSparseGradient(param);
 
   MultiThreadComputeParams<T> input_params;
   input_params.var_ = var;
@@ -188,10 +172,9 @@ void SparseApplyFtrlCpuKernelMod::LaunchKernel(const std::vector<kernel::Address
   input_params.l1_ = l1_;
   input_params.l2_ = l2_;
   input_params.lr_power_ = lr_power_;
-  input_params.sparse_grad_ = unique_sparse_grad;
   input_params.var_first_dim_size_ = var_first_dim_size_;
   input_params.var_outer_dim_size_ = var_outer_dim_size_;
-  MultiThreadCompute<T>(ComputeFtrl<T>, &input_params, unique_sparse_grad.indices_size_);
+  MultiThreadReduceAndCompute<T>(ComputeFtrl<T>, &input_params, input_sparse_grad, workspace);
 }
 
 bool SparseApplyFtrlCpuKernelMod::Launch(const std::vector<kernel::AddressPtr> &inputs,
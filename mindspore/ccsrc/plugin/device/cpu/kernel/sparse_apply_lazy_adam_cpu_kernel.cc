@@ -22,7 +22,7 @@ namespace mindspore {
 namespace kernel {
 namespace {
 constexpr size_t kSparseApplyLazyAdamInputsNum = 11;
-constexpr size_t kSparseApplyLazyAdamWorkspaceSize = 4;
+constexpr size_t kSparseApplyLazyAdamWorkspaceSize = kReduceAndComputeWorkspaceNum;
 constexpr char kKernelName[] = "SparseApplyLazyAdam";
 
 template <typename T>
@@ -63,10 +63,7 @@ void ComputeLazyAdam(MultiThreadComputeParams<T> *input_params, size_t start, si
 
 template <typename T>
 void SparseApplyLazyAdamCpuKernelMod::InitWorkspaceSize() {
-  (void)workspace_size_list_.emplace_back(indices_size_ * var_outer_dim_size_ * sizeof(float));
-  (void)workspace_size_list_.emplace_back(indices_size_ * sizeof(T));
-  (void)workspace_size_list_.emplace_back(indices_size_ * var_outer_dim_size_ * sizeof(float));
-  (void)workspace_size_list_.emplace_back(indices_size_ * sizeof(T));
+  InitReduceAndComputeWorkspaceSize<T>(indices_size_, var_outer_dim_size_, &workspace_size_list_);
 }
 
 void SparseApplyLazyAdamCpuKernelMod::InitInputOutputSize(const CNodePtr &kernel_node) {
@@ -153,21 +150,8 @@ void SparseApplyLazyAdamCpuKernelMod::LaunchKernel(const std::vector<kernel::Add
   auto epsilon = reinterpret_cast<float *>(inputs[8]->addr)[0];
   auto *grad = reinterpret_cast<float *>(inputs[9]->addr);
   auto *indices = reinterpret_cast<T *>(inputs[10]->addr);
-  auto *new_grad = reinterpret_cast<float *>(workspace[0]->addr);
-  auto *new_indices = reinterpret_cast<T *>(workspace[1]->addr);
-  auto *workspace_grad = reinterpret_cast<float *>(workspace[2]->addr);
-  auto *workspace_indices = reinterpret_cast<T *>(workspace[3]->addr);
 
-  SparseGradient<T> unique_sparse_grad({new_grad, new_indices, indices_size_});
-  SparseGradient<T> workspace_sparse_grad({workspace_grad, workspace_indices, indices_size_});
   SparseGradient<T> input_sparse_grad({grad, indices, indices_size_});
-  ReduceSparseGradientParam<T> param;
-  param.input_grad_ = &input_sparse_grad;
-  param.workspace_grad_ = &workspace_sparse_grad;
-  param.output_grad_ = &unique_sparse_grad;
-  param.max_index_ = var_first_dim_size_;
-  param.value_stride_ = var_outer_dim_size_;
-  BucketReduceSparseGradient(param);
 
   lr = lr * std::sqrt(1 - beta2_power) / (1 - beta1_power);
   MultiThreadComputeParams<T> input_params;
@@ -179,10 +163,9 @@ void SparseApplyLazyAdamCpuKernelMod::LaunchKernel(const std::vector<kernel::Add
   input_params.beta2_ = beta2;
   input_params.epsilon_ = epsilon;
   input_params.use_nesterov_ = use_nesterov_;
-  input_params.sparse_grad_ = unique_sparse_grad;
   input_params.var_first_dim_size_ = var_first_dim_size_;
   input_params.var_outer_dim_size_ = var_outer_dim_size_;
-  MultiThreadCompute<T>(ComputeLazyAdam<T>, &input_params, unique_sparse_grad.indices_size_);
+  MultiThreadReduceAndCompute<T>(ComputeLazyAdam<T>, &input_params, input_sparse_grad, workspace);
 }
 
 bool SparseApplyLazyAdamCpuKernelMod::Launch(const std::vector<kernel::AddressPtr> &inputs,
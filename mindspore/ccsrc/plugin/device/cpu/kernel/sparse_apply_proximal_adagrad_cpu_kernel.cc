@@ -22,7 +22,7 @@ namespace mindspore {
 namespace kernel {
 namespace {
 constexpr size_t kSparseApplyProximalAdagradInputsNum = 7;
-constexpr size_t kSparseApplyProximalAdagradWorkspaceSize = 4;
+constexpr size_t kSparseApplyProximalAdagradWorkspaceSize = kReduceAndComputeWorkspaceNum;
 constexpr char kKernelName[] = "SparseApplyProximalAdagrad";
 
 template <typename T>
@@ -63,10 +63,7 @@ void ComputeProximalAdagrad(MultiThreadComputeParams<T> *input_params, size_t st
 
 template <typename T>
 void SparseApplyProximalAdagradCpuKernelMod::InitWorkspaceSize() {
-  (void)workspace_size_list_.emplace_back(indices_size_ * var_outer_dim_size_ * sizeof(float));
-  (void)workspace_size_list_.emplace_back(indices_size_ * sizeof(T));
-  (void)workspace_size_list_.emplace_back(indices_size_ * var_outer_dim_size_ * sizeof(float));
-  (void)workspace_size_list_.emplace_back(indices_size_ * sizeof(T));
+  InitReduceAndComputeWorkspaceSize<T>(indices_size_, var_outer_dim_size_, &workspace_size_list_);
 }
 
 void SparseApplyProximalAdagradCpuKernelMod::InitInputOutputSize(const CNodePtr &kernel_node) {
@@ -155,21 +152,8 @@ void SparseApplyProximalAdagradCpuKernelMod::LaunchKernel(const std::vector<kern
   auto l2 = reinterpret_cast<float *>(inputs[4]->addr)[0];
   auto grad = reinterpret_cast<float *>(inputs[5]->addr);
   auto indices = reinterpret_cast<T *>(inputs[6]->addr);
-  auto new_grad = reinterpret_cast<float *>(workspace[0]->addr);
-  auto new_indices = reinterpret_cast<T *>(workspace[1]->addr);
-  auto workspace_grad = reinterpret_cast<float *>(workspace[2]->addr);
-  auto workspace_indices = reinterpret_cast<T *>(workspace[3]->addr);
 
-  SparseGradient<T> unique_sparse_grad({new_grad, new_indices, indices_size_});
-  SparseGradient<T> workspace_sparse_grad({workspace_grad, workspace_indices, indices_size_});
   SparseGradient<T> input_sparse_grad({grad, indices, indices_size_});
-  ReduceSparseGradientParam<T> param;
-  param.input_grad_ = &input_sparse_grad;
-  param.workspace_grad_ = &workspace_sparse_grad;
-  param.output_grad_ = &unique_sparse_grad;
-  param.max_index_ = var_first_dim_size_;
-  param.value_stride_ = var_outer_dim_size_;
-  BucketReduceSparseGradient(param);
 
   MultiThreadComputeParams<T> input_params;
   input_params.var_ = var;
@@ -177,10 +161,9 @@ void SparseApplyProximalAdagradCpuKernelMod::LaunchKernel(const std::vector<kern
   input_params.lr_ = lr;
   input_params.l1_ = l1;
   input_params.l2_ = l2;
-  input_params.sparse_grad_ = unique_sparse_grad;
   input_params.var_first_dim_size_ = var_first_dim_size_;
   input_params.var_outer_dim_size_ = var_outer_dim_size_;
-  MultiThreadCompute<T>(ComputeProximalAdagrad<T>, &input_params, unique_sparse_grad.indices_size_);
+  MultiThreadReduceAndCompute<T>(ComputeProximalAdagrad<T>, &input_params, input_sparse_grad, workspace);
 }
 
 bool SparseApplyProximalAdagradCpuKernelMod::Launch(const std::vector<kernel::AddressPtr> &inputs,
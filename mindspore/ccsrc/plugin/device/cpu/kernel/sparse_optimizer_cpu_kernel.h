@@ -24,6 +24,7 @@
 #include <utility>
 #include "plugin/device/cpu/kernel/cpu_kernel.h"
 #include "plugin/device/cpu/kernel/cpu_kernel_factory.h"
+#include "plugin/device/cpu/kernel/radix_unique.h"
 #include "common/thread_pool.h"
 namespace mindspore {
 namespace kernel {
@@ -42,6 +43,10 @@ struct ReduceSparseGradientParam {
   size_t max_index_{0};
   size_t value_stride_{0};
   bool use_sort_reduce_{false};
+  // The radix reduction workspaces, of input_grad_->indices_size_ elements and RadixUnique<T, T>::WorkspaceSize bytes.
+  T *inverse_indices_{nullptr};
+  void *radix_workspace_{nullptr};
+  size_t radix_workspace_size_{0};
 };
 
 template <typename T>
@@ -87,6 +92,16 @@ struct MultiThreadReduceSparseGradientParam {
   bool use_sort_reduce_{false};
 };
 
+// The workspaces of MultiThreadReduceAndCompute, they lead the workspace list of the sparse optimizers.
+enum ReduceAndComputeWorkspace : size_t {
+  kReduceFirstPosWorkspace = 0,
+  kReduceInverseIndicesWorkspace,
+  kReduceRadixUniqueWorkspace,
+  kReduceIndicesWorkspace,
+  kReduceValuesWorkspace,
+  kReduceAndComputeWorkspaceNum
+};
+
 class SparseOptimizerCpuKernelMod : public NativeCpuKernelMod {
  public:
   SparseOptimizerCpuKernelMod() = default;
@@ -96,6 +111,11 @@ class SparseOptimizerCpuKernelMod : public NativeCpuKernelMod {
   static void BucketReduceSparseGradient(const ReduceSparseGradientParam<T> &param) {
     MS_LOG(DEBUG) << "Start";
     MS_EXCEPTION_IF_NULL(param.input_grad_);
+    if (!param.use_sort_reduce_) {
+      RadixReduceSparseGradient(param);
+      MS_LOG(DEBUG) << "End";
+      return;
+    }
     size_t thread_num = common::ThreadPool::GetInstance().GetSyncRunThreadNum();
     if (param.input_grad_->indices_size_ < thread_num) {
       thread_num = param.input_grad_->indices_size_;
@@ -138,7 +158,190 @@ class SparseOptimizerCpuKernelMod : public NativeCpuKernelMod {
     ParallelLaunch(tasks);
   }
 
+  // Sets the sizes of the leading ReduceAndComputeWorkspace entries of the workspace list for indices_size indices of
+  // value_stride floats. The reduced rows never outnumber the unique indices, so they take at most the gradient size.
+  template <typename T>
+  static void InitReduceAndComputeWorkspaceSize(size_t indices_size, size_t value_stride,
+                                                std::vector<size_t> *workspace_size_list) {
+    MS_EXCEPTION_IF_NULL(workspace_size_list);
+    if (workspace_size_list->size() < kReduceAndComputeWorkspaceNum) {
+      workspace_size_list->resize(kReduceAndComputeWorkspaceNum);
+    }
+    auto &sizes = *workspace_size_list;
+    sizes[kReduceFirstPosWorkspace] = indices_size * sizeof(T);
+    sizes[kReduceInverseIndicesWorkspace] = indices_size * sizeof(T);
+    sizes[kReduceRadixUniqueWorkspace] = RadixUnique<T, T>::WorkspaceSize(indices_size);
+    sizes[kReduceIndicesWorkspace] = indices_size * sizeof(T);
+    sizes[kReduceValuesWorkspace] = indices_size * value_stride * sizeof(float);
+  }
+
+  // Deduplicates the raw sparse gradient and runs func on every radix partition as soon as its rows are reduced.
+  // A partition's reduced rows fit into L2 and the parameter rows they update are prefetched while reducing, so the
+  // reduced gradient does not round-trip through workspace memory. The workspace list starts with the
+  // ReduceAndComputeWorkspace entries sized by InitReduceAndComputeWorkspaceSize.
+  template <typename T>
+  void MultiThreadReduceAndCompute(const MultiThreadComputeFunc<T> &func, MultiThreadComputeParams<T> *params,
+                                   const SparseGradient<T> &input_grad,
+                                   const std::vector<AddressPtr> &workspace) const {
+    MS_EXCEPTION_IF_NULL(params);
+    MS_EXCEPTION_IF_NULL(input_grad.value_);
+    MS_EXCEPTION_IF_NULL(input_grad.indices_);
+    if (workspace.size() < kReduceAndComputeWorkspaceNum) {
+      MS_LOG(EXCEPTION) << "For 'SparseOptimizer', the number of workspaces should be at least "
+                        << kReduceAndComputeWorkspaceNum << ", but got " << workspace.size();
+    }
+    auto *first_pos = reinterpret_cast<T *>(workspace[kReduceFirstPosWorkspace]->addr);
+    auto *inverse_indices = reinterpret_cast<T *>(workspace[kReduceInverseIndicesWorkspace]->addr);
+    const auto &radix_workspace = workspace[kReduceRadixUniqueWorkspace];
+    RadixUnique<T, T> radix_unique(radix_workspace->addr, radix_workspace->size);
+    radix_unique.SetValueRange(params->var_first_dim_size_);
+    size_t unique_size =
+      radix_unique.Compute(input_grad.indices_, input_grad.indices_size_, inverse_indices, first_pos);
+    size_t value_stride = params->var_outer_dim_size_;
+    size_t thread_num = radix_unique.thread_num();
+    size_t partition_num = radix_unique.partition_num();
+    const auto *items = radix_unique.items();
+    const auto *offsets = radix_unique.partition_offsets();
+    const auto *unique_sizes = radix_unique.partition_unique_sizes();
+    // Every thread reduces its partitions one by one into its own rows, as many as its largest partition has unique
+    // indices, so all the rows together never outnumber the unique indices however skewed the indices are.
+    std::vector<size_t> row_offsets(thread_num + 1, 0);
+    for (size_t t = 0; t < thread_num; ++t) {
+      size_t row_num = 0;
+      for (size_t p = t; p < partition_num; p += thread_num) {
+        row_num = std::max(row_num, unique_sizes[p]);
+      }
+      row_offsets[t + 1] = row_offsets[t] + row_num;
+    }
+    if (row_offsets[thread_num] > unique_size) {
+      MS_LOG(EXCEPTION) << "For 'SparseOptimizer', the reduced rows " << row_offsets[thread_num]
+                        << " should not be more than the unique indices " << unique_size;
+    }
+    auto *local_indices = reinterpret_cast<T *>(workspace[kReduceIndicesWorkspace]->addr);
+    auto *local_values = reinterpret_cast<float *>(workspace[kReduceValuesWorkspace]->addr);
+    MS_EXCEPTION_IF_NULL(local_indices);
+    MS_EXCEPTION_IF_NULL(local_values);
+    std::vector<float *> prefetch_rows{params->var_, params->accum_, params->linear_,
+                                       params->m_,   params->v_,     params->m_t_};
+
+    std::vector<common::Task> tasks;
+    tasks.reserve(thread_num);
+    for (size_t t = 0; t < thread_num; ++t) {
+      auto task = [&, t]() {
+        MultiThreadComputeParams<T> local_params = *params;
+        size_t row_num = row_offsets[t + 1] - row_offsets[t];
+        T *reduced_indices = local_indices + row_offsets[t];
+        float *reduced_values = local_values + row_offsets[t] * value_stride;
+        for (size_t p = t; p < partition_num; p += thread_num) {
+          size_t reduced_size = 0;
+          for (size_t i = offsets[p]; i < offsets[p + 1]; ++i) {
+            T pos = items[i].pos_;
+            const float *src = input_grad.value_ + static_cast<size_t>(pos) * value_stride;
+            T first = first_pos[inverse_indices[pos]];
+            if (first == pos) {
+              // The inverse index of a first occurrence is no longer needed, it keeps the row the value reduces to.
+              inverse_indices[pos] = static_cast<T>(reduced_size);
+              reduced_indices[reduced_size] = items[i].key_;
+              PrefetchRows(prefetch_rows, static_cast<size_t>(items[i].key_) * value_stride, value_stride);
+              auto ret_code = memcpy_s(reduced_values + reduced_size * value_stride,
+                                       (row_num - reduced_size) * value_stride * sizeof(float), src,
+                                       value_stride * sizeof(float));
+              if (ret_code != EOK) {
+                MS_LOG(EXCEPTION) << "For 'SparseOptimizer', failed to copy data. Error no: " << ret_code;
+              }
+              ++reduced_size;
+            } else {
+              float *dst = reduced_values + static_cast<size_t>(inverse_indices[first]) * value_stride;
+              for (size_t j = 0; j < value_stride; ++j) {
+                dst[j] += src[j];
+              }
+            }
+          }
+          local_params.sparse_grad_ = SparseGradient<T>({reduced_values, reduced_indices, reduced_size});
+          func(&local_params, 0, reduced_size);
+        }
+        return common::SUCCESS;
+      };
+      (void)tasks.emplace_back(task);
+    }
+    ParallelLaunch(tasks);
+  }
+
  private:
+  // Reduces the gradient rows of equal indices with the radix partitioned unique. The unique indices are output in
+  // first-occurrence order, and every partition owns its unique rows, so rows are summed without synchronization.
+  template <typename T>
+  static void RadixReduceSparseGradient(const ReduceSparseGradientParam<T> &param) {
+    MS_EXCEPTION_IF_NULL(param.input_grad_);
+    MS_EXCEPTION_IF_NULL(param.input_grad_->value_);
+    MS_EXCEPTION_IF_NULL(param.input_grad_->indices_);
+    MS_EXCEPTION_IF_NULL(param.workspace_grad_);
+    MS_EXCEPTION_IF_NULL(param.workspace_grad_->indices_);
+    MS_EXCEPTION_IF_NULL(param.output_grad_);
+    MS_EXCEPTION_IF_NULL(param.output_grad_->value_);
+    MS_EXCEPTION_IF_NULL(param.output_grad_->indices_);
+    auto input_grad = param.input_grad_;
+    auto output_grad = param.output_grad_;
+    size_t indices_size = input_grad->indices_size_;
+    MS_EXCEPTION_IF_NULL(param.inverse_indices_);
+    MS_EXCEPTION_IF_NULL(param.radix_workspace_);
+    T *first_pos = param.workspace_grad_->indices_;
+    T *inverse_idx = param.inverse_indices_;
+    RadixUnique<T, T> radix_unique(param.radix_workspace_, param.radix_workspace_size_);
+    radix_unique.SetValueRange(param.max_index_);
+    size_t unique_size = radix_unique.Compute(input_grad->indices_, indices_size, inverse_idx, first_pos);
+
+    size_t value_stride = param.value_stride_;
+    size_t stride_data_size = value_stride * sizeof(float);
+    size_t max_length = output_grad->indices_size_ * value_stride;
+    size_t thread_num = radix_unique.thread_num();
+    size_t partition_num = radix_unique.partition_num();
+    const auto *items = radix_unique.items();
+    const auto *offsets = radix_unique.partition_offsets();
+    std::vector<common::Task> tasks;
+    tasks.reserve(thread_num);
+    for (size_t t = 0; t < thread_num; ++t) {
+      auto task = [&, t]() {
+        for (size_t p = t; p < partition_num; p += thread_num) {
+          for (size_t i = offsets[p]; i < offsets[p + 1]; ++i) {
+            T pos = items[i].pos_;
+            T unique_id = inverse_idx[pos];
+            size_t dst_offset = static_cast<size_t>(unique_id) * value_stride;
+            float *dst = output_grad->value_ + dst_offset;
+            const float *src = input_grad->value_ + static_cast<size_t>(pos) * value_stride;
+            if (first_pos[unique_id] == pos) {
+              output_grad->indices_[unique_id] = items[i].key_;
+              auto ret_code = memcpy_s(dst, (max_length - dst_offset) * sizeof(float), src, stride_data_size);
+              if (ret_code != EOK) {
+                MS_LOG(EXCEPTION) << "For 'SparseOptimizer', failed to copy data. Error no: " << ret_code;
+              }
+            } else {
+              for (size_t j = 0; j < value_stride; ++j) {
+                dst[j] += src[j];
+              }
+            }
+          }
+        }
+        return common::SUCCESS;
+      };
+      (void)tasks.emplace_back(task);
+    }
+    ParallelLaunch(tasks);
+    output_grad->indices_size_ = unique_size;
+  }
+
+  static void PrefetchRows(const std::vector<float *> &bases, size_t offset, size_t size) {
+    constexpr size_t kCacheLineFloats = 16;
+    for (auto base : bases) {
+      if (base == nullptr) {
+        continue;
+      }
+      for (size_t i = 0; i < size; i += kCacheLineFloats) {
+        __builtin_prefetch(base + offset + i, 1);
+      }
+    }
+  }
+
   template <typename T>
   static void CalculateEachBucketSize(const std::shared_ptr<SparseGradient<T>> &sparse_grad, size_t max_index,
                                       std::vector<size_t> *each_bucket_size) {
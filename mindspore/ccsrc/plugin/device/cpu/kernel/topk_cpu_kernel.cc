@@ -18,6 +18,7 @@
 #include <algorithm>
 #include "plugin/device/cpu/hal/device/cpu_device_address.h"
 #include "common/thread_pool.h"
+#include "plugin/device/cpu/kernel/topk_select.h"
 
 namespace mindspore {
 namespace kernel {
@@ -41,7 +42,7 @@ void TopKCpuKernelMod::LaunchKernel(const std::vector<AddressPtr> &inputs, const
   }
   auto input = reinterpret_cast<T *>(inputs[0]->addr);
   int k = reinterpret_cast<int *>(inputs[1]->addr)[0];
-  auto workspace = reinterpret_cast<size_t *>(workspaces[0]->addr);
+  auto ranks = reinterpret_cast<uint64_t *>(workspaces[0]->addr);
   auto output = reinterpret_cast<T *>(outputs[0]->addr);
   auto indices = reinterpret_cast<int *>(outputs[1]->addr);
   if (k < 1) {
@@ -52,41 +53,27 @@ void TopKCpuKernelMod::LaunchKernel(const std::vector<AddressPtr> &inputs, const
     MS_LOG(EXCEPTION) << "For '" << kernel_name_ << "', address size of output error.";
   }
 
-  const std::function<bool(size_t, size_t)> comparator = [input](size_t index_1, size_t index_2) {
-    return input[index_1] > input[index_2];
-  };
-
-  std::vector<common::Task> tasks;
-  tasks.reserve(outer_size_);
+  auto thread_pool = GetActorMgrInnerThreadPool();
+  MS_EXCEPTION_IF_NULL(thread_pool);
+  size_t thread_num = thread_pool->GetKernelThreadNum();
+  TopKSelector<T> selector(inner_size_, k_num, sorted_);
+  if (outer_size_ >= thread_num || inner_size_ < kTopKMinChunkSize * 2) {
+    std::vector<common::Task> tasks;
+    tasks.reserve(outer_size_);
+    for (size_t i = 0; i < outer_size_; ++i) {
+      (void)tasks.emplace_back([this, i, k_num, &selector, input, ranks, indices, output]() {
+        selector.Select(input + i * inner_size_, 1, ranks + i * inner_size_, output + i * k_num, indices + i * k_num);
+        return common::SUCCESS;
+      });
+    }
+    ParallelLaunch(tasks);
+    return;
+  }
+  // Few long rows, as in candidate retrieval: every row is split over the threads instead.
   for (size_t i = 0; i < outer_size_; ++i) {
-    (void)tasks.emplace_back([this, i, k_num, &comparator, input, workspace, indices, output]() {
-      size_t *idx = workspace + i * inner_size_;
-      auto base_input = i * inner_size_;
-      std::iota(idx, idx + inner_size_, base_input);
-
-      if (sorted_) {
-        constexpr float fraction = 0.5;
-        const size_t threshold = inner_size_ * fraction;
-        // fall back to stable_sort
-        if (k_num > threshold) {
-          std::stable_sort(idx, idx + inner_size_, comparator);
-        } else {
-          std::nth_element(idx, idx + SizeToLong(k_num), idx + inner_size_, comparator);
-          std::stable_sort(idx, idx + SizeToLong(k_num), comparator);
-        }
-      } else {
-        std::nth_element(idx, idx + SizeToLong(k_num), idx + inner_size_, comparator);
-      }
-
-      auto base_output = i * k_num;
-      for (size_t j = 0; j < k_num; ++j) {
-        indices[base_output + j] = SizeToInt(idx[j]) - SizeToInt(base_input);
-        output[base_output + j] = input[idx[j]];
-      }
-      return common::SUCCESS;
-    });
+    selector.Select(input + i * inner_size_, thread_num, ranks + i * inner_size_, output + i * k_num,
+                    indices + i * k_num);
   }
-  ParallelLaunch(tasks);
 }
 
 void TopKCpuKernelMod::InitKernel(const CNodePtr &kernel_node) {
@@ -108,7 +95,8 @@ void TopKCpuKernelMod::InitKernel(const CNodePtr &kernel_node) {
 void TopKCpuKernelMod::InitInputOutputSize(const CNodePtr &kernel_node) {
   NativeCpuKernelMod::InitInputOutputSize(kernel_node);
   size_t element_size = outer_size_ * inner_size_;
-  (void)workspace_size_list_.emplace_back((sizeof(size_t) * element_size));
+  // Ranks of the selected elements, k per row at most.
+  (void)workspace_size_list_.emplace_back((sizeof(uint64_t) * element_size));
 }
 
 bool TopKCpuKernelMod::Launch(const std::vector<kernel::AddressPtr> &inputs,
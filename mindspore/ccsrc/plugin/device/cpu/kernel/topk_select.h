@@ -0,0 +1,292 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_BACKEND_KERNEL_COMPILER_CPU_TOPK_SELECT_H_
+#define MINDSPORE_CCSRC_BACKEND_KERNEL_COMPILER_CPU_TOPK_SELECT_H_
+
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <vector>
+#include "base/float16.h"
+#include "plugin/device/cpu/kernel/cpu_kernel.h"
+
+namespace mindspore {
+namespace kernel {
+constexpr size_t kTopKHeapMaxK = 128;
+constexpr size_t kTopKMinChunkSize = 16384;
+constexpr size_t kTopKRadixBits = 11;
+constexpr size_t kTopKIndexBits = 32;
+constexpr uint64_t kTopKIndexMask = 0xFFFFFFFFULL;
+
+// Order preserving integer keys: a larger value gets a larger key, and -0.0 gets the key of +0.0.
+template <typename T>
+struct SelectKeyTraits;
+
+template <>
+struct SelectKeyTraits<float> {
+  using KeyType = uint32_t;
+  static KeyType ToKey(float value) {
+    KeyType bits;
+    (void)memcpy(&bits, &value, sizeof(bits));
+    constexpr KeyType kSignBit = 0x80000000U;
+    if (bits == kSignBit) {
+      bits = 0;
+    }
+    return (bits & kSignBit) != 0 ? ~bits : (bits | kSignBit);
+  }
+};
+
+template <>
+struct SelectKeyTraits<float16> {
+  using KeyType = uint16_t;
+  static KeyType ToKey(float16 value) {
+    static_assert(sizeof(float16) == sizeof(KeyType), "float16 should be 2 bytes");
+    KeyType bits;
+    (void)memcpy(&bits, &value, sizeof(bits));
+    constexpr KeyType kSignBit = 0x8000U;
+    if (bits == kSignBit) {
+      bits = 0;
+    }
+    return (bits & kSignBit) != 0 ? static_cast<KeyType>(~bits) : static_cast<KeyType>(bits | kSignBit);
+  }
+};
+
+// A rank packs an order preserving key above the position. Sorting ranks ascending orders by key and then by
+// position, which is the order a stable sort gives; the descending rank inverts the key only.
+template <typename T>
+inline uint64_t AscendingRank(T value, size_t pos) {
+  return (static_cast<uint64_t>(SelectKeyTraits<T>::ToKey(value)) << kTopKIndexBits) | pos;
+}
+
+template <typename T>
+inline uint64_t DescendingRank(T value, size_t pos) {
+  using KeyType = typename SelectKeyTraits<T>::KeyType;
+  auto key = static_cast<KeyType>(~SelectKeyTraits<T>::ToKey(value));
+  return (static_cast<uint64_t>(key) << kTopKIndexBits) | pos;
+}
+
+inline size_t RankPosition(uint64_t rank) { return static_cast<size_t>(rank & kTopKIndexMask); }
+
+// Sorts data[0, size) ascending with up to chunk_num threads: chunks are sorted in parallel and then merged pairwise,
+// ping-ponging with buffer. Returns whichever of data and buffer holds the result.
+inline uint64_t *ParallelSortRanks(uint64_t *data, uint64_t *buffer, size_t size, size_t chunk_num) {
+  chunk_num = std::max<size_t>(1, std::min(chunk_num, size / kTopKMinChunkSize));
+  if (chunk_num == 1) {
+    std::sort(data, data + size);
+    return data;
+  }
+  size_t chunk_size = (size + chunk_num - 1) / chunk_num;
+  std::vector<common::Task> tasks;
+  for (size_t begin = 0; begin < size; begin += chunk_size) {
+    size_t end = std::min(size, begin + chunk_size);
+    (void)tasks.emplace_back([data, begin, end]() {
+      std::sort(data + begin, data + end);
+      return common::SUCCESS;
+    });
+  }
+  ParallelLaunch(tasks);
+  for (size_t width = chunk_size; width < size; width *= 2) {
+    tasks.clear();
+    for (size_t begin = 0; begin < size; begin += 2 * width) {
+      size_t mid = std::min(size, begin + width);
+      size_t end = std::min(size, begin + 2 * width);
+      (void)tasks.emplace_back([data, buffer, begin, mid, end]() {
+        (void)std::merge(data + begin, data + mid, data + mid, data + end, buffer + begin);
+        return common::SUCCESS;
+      });
+    }
+    ParallelLaunch(tasks);
+    std::swap(data, buffer);
+  }
+  return data;
+}
+
+// Selects the k largest elements of a row. Small k keeps a bounded min-heap of ranks per chunk and merges the chunk
+// candidates; large k finds the k-th largest key by radix select over per-chunk histograms and then gathers the
+// selected elements in position order. Chunks of one row run in parallel, and among equal values the lower positions
+// are selected first, as a stable sort would.
+template <typename T>
+class TopKSelector {
+ public:
+  using KeyType = typename SelectKeyTraits<T>::KeyType;
+
+  TopKSelector(size_t size, size_t k, bool sorted) : size_(size), k_(std::min(size, k)), sorted_(sorted) {}
+  ~TopKSelector() = default;
+
+  // ranks must hold k elements. Values come out in descending order when sorted, in position order otherwise.
+  void Select(const T *row, size_t chunk_num, uint64_t *ranks, T *values, int *indices) const {
+    MS_EXCEPTION_IF_NULL(row);
+    MS_EXCEPTION_IF_NULL(ranks);
+    if (k_ == 0) {
+      return;
+    }
+    chunk_num = std::max<size_t>(1, std::min(chunk_num, size_ / kTopKMinChunkSize));
+    if (k_ <= kTopKHeapMaxK) {
+      HeapSelect(row, chunk_num, ranks);
+    } else {
+      RadixSelect(row, chunk_num, ranks);
+      if (sorted_) {
+        std::sort(ranks, ranks + k_, [](uint64_t a, uint64_t b) {
+          uint64_t key_a = a >> kTopKIndexBits;
+          uint64_t key_b = b >> kTopKIndexBits;
+          return key_a != key_b ? key_a > key_b : a < b;
+        });
+      }
+    }
+    for (size_t i = 0; i < k_; ++i) {
+      size_t pos = RankPosition(ranks[i]);
+      values[i] = row[pos];
+      indices[i] = SizeToInt(pos);
+    }
+  }
+
+ private:
+  // The heap path orders by (key, inverted position), so that the heap minimum is the element to drop first.
+  static uint64_t HeapRank(T value, size_t pos) {
+    return (static_cast<uint64_t>(SelectKeyTraits<T>::ToKey(value)) << kTopKIndexBits) | (kTopKIndexMask - pos);
+  }
+
+  void HeapChunk(const T *row, size_t begin, size_t end, std::vector<uint64_t> *heap) const {
+    heap->clear();
+    heap->reserve(k_);
+    auto greater = std::greater<uint64_t>();
+    for (size_t i = begin; i < end; ++i) {
+      uint64_t rank = HeapRank(row[i], i);
+      if (heap->size() < k_) {
+        heap->push_back(rank);
+        std::push_heap(heap->begin(), heap->end(), greater);
+      } else if (rank > heap->front()) {
+        std::pop_heap(heap->begin(), heap->end(), greater);
+        heap->back() = rank;
+        std::push_heap(heap->begin(), heap->end(), greater);
+      }
+    }
+  }
+
+  void HeapSelect(const T *row, size_t chunk_num, uint64_t *ranks) const {
+    std::vector<std::vector<uint64_t>> heaps(chunk_num);
+    ForEachChunk(chunk_num, [this, row, &heaps](size_t c, size_t begin, size_t end) {
+      HeapChunk(row, begin, end, &heaps[c]);
+    });
+    std::vector<uint64_t> candidates;
+    for (const auto &heap : heaps) {
+      candidates.insert(candidates.end(), heap.begin(), heap.end());
+    }
+    // The heap path is only taken for small k, so the result is always sorted.
+    std::nth_element(candidates.begin(), candidates.begin() + k_ - 1, candidates.end(), std::greater<uint64_t>());
+    std::sort(candidates.begin(), candidates.begin() + k_, std::greater<uint64_t>());
+    for (size_t i = 0; i < k_; ++i) {
+      ranks[i] = (candidates[i] & ~kTopKIndexMask) | (kTopKIndexMask - RankPosition(candidates[i]));
+    }
+  }
+
+  // Runs func(chunk, begin, end) over the chunks of the row.
+  template <typename Func>
+  void ForEachChunk(size_t chunk_num, const Func &func) const {
+    size_t chunk_size = (size_ + chunk_num - 1) / chunk_num;
+    if (chunk_num == 1) {
+      func(0, 0, size_);
+      return;
+    }
+    std::vector<common::Task> tasks;
+    for (size_t c = 0; c < chunk_num; ++c) {
+      (void)tasks.emplace_back([this, &func, chunk_size, c]() {
+        func(c, c * chunk_size, std::min(size_, (c + 1) * chunk_size));
+        return common::SUCCESS;
+      });
+    }
+    ParallelLaunch(tasks);
+  }
+
+  void RadixSelect(const T *row, size_t chunk_num, uint64_t *ranks) const {
+    constexpr size_t kKeyBits = sizeof(KeyType) * 8;
+    constexpr size_t kBins = static_cast<size_t>(1) << kTopKRadixBits;
+    std::vector<size_t> histograms(chunk_num * kBins);
+    KeyType prefix = 0;
+    KeyType prefix_mask = 0;
+    // Number of elements still to take among those matching the prefix.
+    size_t remaining = k_;
+    for (size_t consumed = 0; consumed < kKeyBits;) {
+      size_t width = std::min(kTopKRadixBits, kKeyBits - consumed);
+      size_t shift = kKeyBits - consumed - width;
+      auto digit_mask = static_cast<KeyType>((static_cast<size_t>(1) << width) - 1);
+      std::fill(histograms.begin(), histograms.end(), 0);
+      ForEachChunk(chunk_num, [row, &histograms, prefix, prefix_mask, shift, digit_mask](size_t c, size_t begin,
+                                                                                           size_t end) {
+        size_t *histogram = histograms.data() + c * kBins;
+        for (size_t i = begin; i < end; ++i) {
+          KeyType key = SelectKeyTraits<T>::ToKey(row[i]);
+          if ((key & prefix_mask) == prefix) {
+            ++histogram[(key >> shift) & digit_mask];
+          }
+        }
+      });
+      // Walk the digits from the largest, everything above the digit holding the k-th element is taken.
+      size_t digit = digit_mask;
+      for (;; --digit) {
+        size_t count = 0;
+        for (size_t c = 0; c < chunk_num; ++c) {
+          count += histograms[c * kBins + digit];
+        }
+        if (count >= remaining || digit == 0) {
+          break;
+        }
+        remaining -= count;
+      }
+      prefix = static_cast<KeyType>(prefix | (digit << shift));
+      prefix_mask = static_cast<KeyType>(prefix_mask | (static_cast<size_t>(digit_mask) << shift));
+      consumed += width;
+    }
+    // The threshold key is the prefix now: keys above it are selected, and the first `remaining` keys equal to it.
+    std::vector<size_t> equal_counts(chunk_num);
+    std::vector<size_t> greater_counts(chunk_num);
+    ForEachChunk(chunk_num, [row, prefix, &equal_counts, &greater_counts](size_t c, size_t begin, size_t end) {
+      for (size_t i = begin; i < end; ++i) {
+        KeyType key = SelectKeyTraits<T>::ToKey(row[i]);
+        greater_counts[c] += static_cast<size_t>(key > prefix);
+        equal_counts[c] += static_cast<size_t>(key == prefix);
+      }
+    });
+    std::vector<size_t> equal_takes(chunk_num);
+    std::vector<size_t> offsets(chunk_num);
+    size_t offset = 0;
+    for (size_t c = 0; c < chunk_num; ++c) {
+      equal_takes[c] = std::min(equal_counts[c], remaining);
+      remaining -= equal_takes[c];
+      offsets[c] = offset;
+      offset += greater_counts[c] + equal_takes[c];
+    }
+    ForEachChunk(chunk_num, [row, prefix, ranks, &equal_takes, &offsets](size_t c, size_t begin, size_t end) {
+      uint64_t *out = ranks + offsets[c];
+      size_t equal_left = equal_takes[c];
+      for (size_t i = begin; i < end; ++i) {
+        KeyType key = SelectKeyTraits<T>::ToKey(row[i]);
+        if (key > prefix || (key == prefix && equal_left > 0)) {
+          equal_left -= static_cast<size_t>(key == prefix);
+          *out++ = (static_cast<uint64_t>(key) << kTopKIndexBits) | i;
+        }
+      }
+    });
+  }
+
+  size_t size_;
+  size_t k_;
+  bool sorted_;
+};
+}  // namespace kernel
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_BACKEND_KERNEL_COMPILER_CPU_TOPK_SELECT_H_
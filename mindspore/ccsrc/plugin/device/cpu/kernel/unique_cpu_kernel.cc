@@ -19,7 +19,7 @@
 
 namespace mindspore {
 namespace kernel {
-constexpr size_t kBucketSortThreshold = 100000;
+constexpr size_t kRadixUniqueThreshold = 100000;
 void UniqueCpuKernelMod::InitKernel(const CNodePtr &kernel_node) {
   MS_EXCEPTION_IF_NULL(kernel_node);
   kernel_name_ = AnfAlgo::GetCNodeName(kernel_node);
@@ -41,6 +41,13 @@ void UniqueCpuKernelMod::InitInputOutputSize(const CNodePtr &kernel_node) {
   (void)workspace_size_list_.emplace_back(input_size_ * sizeof(int64_t));
   (void)workspace_size_list_.emplace_back(input_size_ * sizeof(int64_t));
   (void)workspace_size_list_.emplace_back(input_size_ * sizeof(int64_t));
+  if (dtype_ == kNumberTypeInt32) {
+    (void)workspace_size_list_.emplace_back(RadixUnique<int, int>::WorkspaceSize(input_size_));
+  } else if (dtype_ == kNumberTypeInt64) {
+    (void)workspace_size_list_.emplace_back(RadixUnique<int64_t, int64_t>::WorkspaceSize(input_size_));
+  } else {
+    (void)workspace_size_list_.emplace_back(RadixUnique<float, int>::WorkspaceSize(input_size_));
+  }
 }
 
 bool UniqueCpuKernelMod::Launch(const std::vector<kernel::AddressPtr> &inputs,
@@ -84,9 +91,9 @@ void UniqueCpuKernelMod::LaunchKernel(const std::vector<AddressPtr> &inputs, con
     MS_LOG(EXCEPTION) << "For '" << kernel_name_
                       << "', the number of inputs should be greater than 0, but got: " << inputs.size();
   }
-  if (workspace.size() < 3) {
+  if (workspace.size() < 4) {
     MS_LOG(EXCEPTION) << "For '" << kernel_name_
-                      << "', the number of workspaces should be greater than 2, but got: " << workspace.size();
+                      << "', the number of workspaces should be greater than 3, but got: " << workspace.size();
   }
   if (outputs.size() < 2) {
     MS_LOG(EXCEPTION) << "For '" << kernel_name_
@@ -97,22 +104,19 @@ void UniqueCpuKernelMod::LaunchKernel(const std::vector<AddressPtr> &inputs, con
   params->input_idx_ = reinterpret_cast<IndexType *>(workspace[0]->addr);
   params->workspace_ = reinterpret_cast<DataType *>(workspace[1]->addr);
   params->workspace_idx_ = reinterpret_cast<IndexType *>(workspace[2]->addr);
+  params->radix_workspace_ = workspace[3]->addr;
+  params->radix_workspace_size_ = workspace[3]->size;
   params->output_ = reinterpret_cast<DataType *>(outputs[0]->addr);
   params->inverse_idx_ = reinterpret_cast<IndexType *>(outputs[1]->addr);
   params->input_size_ = static_cast<IndexType>(input_size_);
   params->output_size_ = 0;
 
   params->thread_num_ = common::ThreadPool::GetInstance().GetSyncRunThreadNum();
-  if (sorted_) {
-    params->need_sort_ = true;
-    if (input_size_ < kBucketSortThreshold) {
-      Unique(params);
-    } else {
-      BucketUnique(params);
-    }
-  } else {
-    params->need_sort_ = false;
+  params->need_sort_ = sorted_;
+  if (input_size_ < kRadixUniqueThreshold) {
     Unique(params);
+  } else {
+    RadixUniqueImpl(params);
   }
   output_size_ = static_cast<size_t>(params->output_size_);
 }
@@ -106,6 +106,16 @@ size_t GPUMemoryAllocator::AllocDeviceMem(size_t size, DeviceMemPtr *addr) {
 
 bool GPUMemoryAllocator::FreeDeviceMem(const DeviceMemPtr &addr) { return CudaDriver::FreeDeviceMem(addr); }
 
+bool GPUMemoryAllocator::ReleaseDeviceMem(const DeviceMemPtr &addr, size_t size) {
+  if (!CudaDriver::FreeDeviceMem(addr)) {
+    MS_LOG(ERROR) << "Free device memory[" << addr << "] failed.";
+    return false;
+  }
+  total_used_device_memory_ -= std::min(size, total_used_device_memory_);
+  available_device_memory_ += size;
+  return true;
+}
+
 size_t GPUMemoryAllocator::free_mem_size() { return std::min(CudaDriver::free_mem_size(), available_device_memory_); }
 }  // namespace gpu
 }  // namespace device
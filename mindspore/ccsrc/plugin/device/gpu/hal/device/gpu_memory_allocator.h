@@ -34,6 +34,7 @@ class GPUMemoryAllocator : public DynamicMemPoolBestFit {
 
   size_t AllocDeviceMem(size_t size, DeviceMemPtr *addr) override;
   bool FreeDeviceMem(const DeviceMemPtr &addr) override;
+  bool ReleaseDeviceMem(const DeviceMemPtr &addr, size_t size) override;
   size_t free_mem_size() override;
 
   static GPUMemoryAllocator &GetInstance() {
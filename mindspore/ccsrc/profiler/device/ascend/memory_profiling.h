@@ -110,6 +110,7 @@ class MemoryProfiling {
   std::shared_ptr<GraphMemory> AddGraphMemoryNode(uint32_t graph_id);
   std::shared_ptr<GraphMemory> GetGraphMemoryNode(uint32_t graph_id) const;
   void SetDeviceMemSize(uint64_t size) { device_mem_size_ = size; }
+  void SetMemPoolInfo(const MemPoolProto &mem_pool) { *memory_proto_.mutable_mem_pool() = mem_pool; }
   bool MemoryToPB();
   void SaveMemoryProfiling();
   bool IsMemoryProfilingInitialized() const { return is_initialized_; }
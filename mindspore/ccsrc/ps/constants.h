@@ -81,6 +81,11 @@ constexpr int64_t kEmbeddingLookupCmd = 30;
 constexpr int64_t kFinalizeCmd = 40;
 constexpr int64_t kPushCmd = 50;
 constexpr int64_t kPullCmd = 51;
+// The push and pull requests in the raw kv frame instead of KVMessage.
+constexpr int64_t kPushRawCmd = 52;
+constexpr int64_t kPullRawCmd = 53;
+// The push request of the compressed dense gradient.
+constexpr int64_t kPushCompressedCmd = 54;
 
 constexpr size_t kInvalidKey = UINT64_MAX;
 constexpr int64_t kInvalidID = -1;
@@ -98,7 +98,8 @@ class AbstractNode : public Node {
   bool Send(const NodeRole &node_role, const std::vector<uint32_t> &rank_ids, const std::vector<std::string> &msgs,
             int command, std::vector<VectorPtr> *output = nullptr, const uint32_t &timeout = kCommTimeoutInSeconds);
 
-  uint64_t CollectiveSendAsync(const NodeRole &node_role, const uint32_t &rank_id, const void *data, size_t size);
+  virtual uint64_t CollectiveSendAsync(const NodeRole &node_role, const uint32_t &rank_id, const void *data,
+                                       size_t size);
   std::pair<uint32_t, uint64_t> CollectiveReceiveAsync(const NodeRole &node_role, const uint32_t &rank_id,
                                                        VectorPtr *output);
   bool CollectiveWait(const std::pair<uint32_t, uint64_t> &request_id, const uint32_t &timeout = kCommTimeoutInSeconds);
@@ -129,6 +130,9 @@ class AbstractNode : public Node {
   uint16_t scheduler_port() const;
   void set_scheduler_port(const uint16_t &scheduler_port);
 
+  // Get the ip of the node by its role and rank id, return an empty string if the node is unknown.
+  std::string GetNodeIp(const NodeRole &node_role, const uint32_t &rank_id);
+
   ClusterState cluster_state() const;
 
   void set_handler(const RequestHandler &handler);
@@ -0,0 +1,265 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ps/gradient_compressor.h"
+
+#include <securec.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+#include <numeric>
+
+#include "utils/log_adapter.h"
+
+namespace mindspore {
+namespace ps {
+namespace {
+constexpr char kCompressionNone[] = "none";
+constexpr char kCompressionTopK[] = "topk";
+constexpr char kCompressionRandomK[] = "randomk";
+constexpr char kCompressionInt8[] = "int8";
+constexpr char kCompressionOneBit[] = "1bit";
+constexpr float kInt8MaxValue = 127.0;
+constexpr size_t kBitsPerByte = 8;
+
+// The payload size of the compressed gradient, or 0 if the type is invalid.
+size_t PayloadSize(GradientCompressionType type, uint64_t len, uint64_t num) {
+  switch (type) {
+    case GradientCompressionType::kTopK:
+    case GradientCompressionType::kRandomK:
+      return static_cast<size_t>(num) * (sizeof(uint32_t) + sizeof(float));
+    case GradientCompressionType::kInt8:
+      return static_cast<size_t>(len) * sizeof(int8_t);
+    case GradientCompressionType::kOneBit:
+      return (static_cast<size_t>(len) + kBitsPerByte - 1) / kBitsPerByte;
+    default:
+      return 0;
+  }
+}
+}  // namespace
+
+bool ParseGradientCompression(const std::string &method, GradientCompressionConfig *config) {
+  MS_EXCEPTION_IF_NULL(config);
+  std::string name = method;
+  std::string ratio;
+  auto pos = method.find(':');
+  if (pos != std::string::npos) {
+    name = method.substr(0, pos);
+    ratio = method.substr(pos + 1);
+  }
+
+  if (name == kCompressionTopK || name == kCompressionRandomK) {
+    config->type = name == kCompressionTopK ? GradientCompressionType::kTopK : GradientCompressionType::kRandomK;
+    char *end = nullptr;
+    config->ratio = std::strtof(ratio.c_str(), &end);
+    if (ratio.empty() || end == nullptr || *end != '\0' || !(config->ratio > 0 && config->ratio <= 1)) {
+      MS_LOG(ERROR) << "The ratio of gradient compression " << method << " should be in (0, 1].";
+      return false;
+    }
+    return true;
+  }
+  if (pos != std::string::npos) {
+    MS_LOG(ERROR) << "The gradient compression " << name << " doesn't need the ratio.";
+    return false;
+  }
+  config->ratio = 1.0;
+  if (name == kCompressionNone) {
+    config->type = GradientCompressionType::kNone;
+  } else if (name == kCompressionInt8) {
+    config->type = GradientCompressionType::kInt8;
+  } else if (name == kCompressionOneBit) {
+    config->type = GradientCompressionType::kOneBit;
+  } else {
+    MS_LOG(ERROR) << "Invalid gradient compression " << method << ", it should be none, topk:<ratio>, "
+                  << "randomk:<ratio>, int8 or 1bit.";
+    return false;
+  }
+  return true;
+}
+
+GradientCompressor::GradientCompressor(const GradientCompressionConfig &config, uint32_t seed)
+    : config_(config), random_engine_(seed) {
+  if (PayloadSize(config.type, 1, 1) == 0) {
+    MS_LOG(EXCEPTION) << "Invalid gradient compression type " << static_cast<int>(config.type);
+  }
+}
+
+size_t GradientCompressor::SelectIndices(size_t len) {
+  if (len > std::numeric_limits<uint32_t>::max()) {
+    MS_LOG(EXCEPTION) << "The gradient of " << len << " values is too large for the sparse compression.";
+  }
+  size_t num = std::min(len, std::max<size_t>(1, static_cast<size_t>(std::ceil(config_.ratio * len))));
+  indices_.resize(len);
+  std::iota(indices_.begin(), indices_.end(), 0);
+  if (config_.type == GradientCompressionType::kTopK) {
+    std::nth_element(indices_.begin(), indices_.begin() + num, indices_.end(), [this](uint32_t lhs, uint32_t rhs) {
+      return std::fabs(residual_[lhs]) > std::fabs(residual_[rhs]);
+    });
+  } else {
+    // The partial Fisher-Yates shuffle selects num indices without replacement.
+    for (size_t i = 0; i < num; ++i) {
+      std::uniform_int_distribution<size_t> distribution(i, len - 1);
+      std::swap(indices_[i], indices_[distribution(random_engine_)]);
+    }
+  }
+  // The sorted indices are added to the destination sequentially by the receiver.
+  std::sort(indices_.begin(), indices_.begin() + num);
+  return num;
+}
+
+std::string GradientCompressor::Compress(const float *grad, size_t len) {
+  if (len > 0) {
+    MS_EXCEPTION_IF_NULL(grad);
+  }
+  if (residual_.size() != len) {
+    residual_.assign(len, 0);
+  }
+  // The residual becomes the gradient to be compressed, and then what is not sent is left in it.
+  for (size_t i = 0; i < len; ++i) {
+    residual_[i] += grad[i];
+  }
+
+  CompressedGradientHeader header{static_cast<uint8_t>(config_.type), {0, 0, 0}, 0, len, len};
+  std::string data;
+  if (config_.type == GradientCompressionType::kTopK || config_.type == GradientCompressionType::kRandomK) {
+    size_t num = len == 0 ? 0 : SelectIndices(len);
+    header.num = num;
+    data.resize(sizeof(header) + PayloadSize(config_.type, len, num));
+    auto indices = reinterpret_cast<uint32_t *>(&data[sizeof(header)]);
+    auto values = reinterpret_cast<float *>(&data[sizeof(header) + num * sizeof(uint32_t)]);
+    for (size_t i = 0; i < num; ++i) {
+      uint32_t index = indices_[i];
+      indices[i] = index;
+      values[i] = residual_[index];
+      residual_[index] = 0;
+    }
+  } else if (config_.type == GradientCompressionType::kInt8) {
+    float max_abs = 0;
+    for (size_t i = 0; i < len; ++i) {
+      max_abs = std::max(max_abs, std::fabs(residual_[i]));
+    }
+    header.scale = max_abs / kInt8MaxValue;
+    data.resize(sizeof(header) + PayloadSize(config_.type, len, len));
+    auto values = reinterpret_cast<int8_t *>(&data[sizeof(header)]);
+    for (size_t i = 0; i < len; ++i) {
+      float quantized =
+        header.scale > 0 ? std::max(-kInt8MaxValue, std::min(kInt8MaxValue, std::round(residual_[i] / header.scale)))
+                         : 0;
+      values[i] = static_cast<int8_t>(quantized);
+      residual_[i] -= quantized * header.scale;
+    }
+  } else {
+    double sum_abs = 0;
+    for (size_t i = 0; i < len; ++i) {
+      sum_abs += std::fabs(residual_[i]);
+    }
+    header.scale = len == 0 ? 0 : static_cast<float>(sum_abs / len);
+    data.resize(sizeof(header) + PayloadSize(config_.type, len, len));
+    auto bits = reinterpret_cast<uint8_t *>(&data[sizeof(header)]);
+    for (size_t i = 0; i < len; ++i) {
+      if (residual_[i] >= 0) {
+        bits[i / kBitsPerByte] |= static_cast<uint8_t>(1U << (i % kBitsPerByte));
+        residual_[i] -= header.scale;
+      } else {
+        residual_[i] += header.scale;
+      }
+    }
+  }
+
+  auto ret = memcpy_s(&data[0], data.size(), &header, sizeof(header));
+  if (ret != EOK) {
+    MS_LOG(EXCEPTION) << "memcpy_s error, errorno(" << ret << ")";
+  }
+  return data;
+}
+
+bool GradientCompressor::ParseHeader(const void *data, size_t size, CompressedGradientHeader *header) {
+  MS_EXCEPTION_IF_NULL(header);
+  if (data == nullptr || size < sizeof(CompressedGradientHeader)) {
+    MS_LOG(ERROR) << "The compressed gradient size " << size << " is smaller than the header.";
+    return false;
+  }
+  // The payload is read in place as the float and uint32 arrays.
+  if (reinterpret_cast<uintptr_t>(data) % alignof(float) != 0) {
+    MS_LOG(ERROR) << "The compressed gradient is not aligned.";
+    return false;
+  }
+  auto ret = memcpy_s(header, sizeof(CompressedGradientHeader), data, sizeof(CompressedGradientHeader));
+  if (ret != EOK) {
+    MS_LOG(ERROR) << "memcpy_s error, errorno(" << ret << ")";
+    return false;
+  }
+
+  auto type = static_cast<GradientCompressionType>(header->type);
+  size_t payload_size = size - sizeof(CompressedGradientHeader);
+  bool valid = std::isfinite(header->scale);
+  if (type == GradientCompressionType::kTopK || type == GradientCompressionType::kRandomK) {
+    valid = valid && header->num <= header->len && header->num <= payload_size / (sizeof(uint32_t) + sizeof(float));
+  } else {
+    valid = valid && header->num == header->len && header->len / kBitsPerByte <= payload_size;
+  }
+  if (!valid || PayloadSize(type, header->len, header->num) != payload_size) {
+    MS_LOG(ERROR) << "Invalid compressed gradient, type: " << static_cast<int>(header->type)
+                  << ", len: " << header->len << ", num: " << header->num << ", size: " << size;
+    return false;
+  }
+  return true;
+}
+
+bool GradientCompressor::DecompressAccumulate(const void *data, size_t size, float *dst, size_t len) {
+  CompressedGradientHeader header;
+  if (!ParseHeader(data, size, &header)) {
+    return false;
+  }
+  if (header.len != len) {
+    MS_LOG(ERROR) << "The compressed gradient of " << header.len << " values doesn't match the destination of " << len
+                  << " values.";
+    return false;
+  }
+  if (len == 0) {
+    return true;
+  }
+  MS_EXCEPTION_IF_NULL(dst);
+
+  auto payload = reinterpret_cast<const uint8_t *>(data) + sizeof(CompressedGradientHeader);
+  auto type = static_cast<GradientCompressionType>(header.type);
+  if (type == GradientCompressionType::kTopK || type == GradientCompressionType::kRandomK) {
+    size_t num = static_cast<size_t>(header.num);
+    auto indices = reinterpret_cast<const uint32_t *>(payload);
+    auto values = reinterpret_cast<const float *>(payload + num * sizeof(uint32_t));
+    for (size_t i = 0; i < num; ++i) {
+      if (indices[i] >= len) {
+        MS_LOG(ERROR) << "The index " << indices[i] << " of compressed gradient is out of range " << len;
+        return false;
+      }
+      dst[indices[i]] += values[i];
+    }
+  } else if (type == GradientCompressionType::kInt8) {
+    auto values = reinterpret_cast<const int8_t *>(payload);
+    for (size_t i = 0; i < len; ++i) {
+      dst[i] += values[i] * header.scale;
+    }
+  } else {
+    for (size_t i = 0; i < len; ++i) {
+      bool positive = (payload[i / kBitsPerByte] >> (i % kBitsPerByte)) & 1U;
+      dst[i] += positive ? header.scale : -header.scale;
+    }
+  }
+  return true;
+}
+}  // namespace ps
+}  // namespace mindspore
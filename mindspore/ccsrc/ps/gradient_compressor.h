@@ -0,0 +1,95 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_PS_GRADIENT_COMPRESSOR_H_
+#define MINDSPORE_CCSRC_PS_GRADIENT_COMPRESSOR_H_
+
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace mindspore {
+namespace ps {
+// The compression methods of the dense gradients:
+// kTopK: send the ratio of values with the largest magnitudes and their indices.
+// kRandomK: send the ratio of values at random indices and their indices.
+// kInt8: quantize each value to 8 bits with the scale of max magnitude.
+// kOneBit: quantize each value to its sign with the scale of mean magnitude.
+enum class GradientCompressionType : uint8_t { kNone = 0, kTopK = 1, kRandomK = 2, kInt8 = 3, kOneBit = 4 };
+
+struct GradientCompressionConfig {
+  GradientCompressionType type{GradientCompressionType::kNone};
+  // The ratio of the values sent by kTopK and kRandomK, in (0, 1].
+  float ratio{1.0};
+};
+
+// Parse the compression method in the format of "none", "topk:<ratio>", "randomk:<ratio>", "int8" or "1bit". Return
+// false if it is invalid.
+bool ParseGradientCompression(const std::string &method, GradientCompressionConfig *config);
+
+// The compressed gradient is this header followed by the payload:
+// kTopK and kRandomK: num uint32 indices and then num float values.
+// kInt8: len int8 values, each of which is multiplied by the scale.
+// kOneBit: (len + 7) / 8 bytes of the sign bits, the bit 1 is the scale and the bit 0 is the negative scale.
+struct CompressedGradientHeader {
+  uint8_t type;
+  uint8_t reserved[3];
+  float scale;
+  // The number of values of the decompressed gradient.
+  uint64_t len;
+  // The number of values in the payload.
+  uint64_t num;
+};
+
+// The push request of the compressed gradient is this header, the raw kv frame of the optimizer inputs in which the
+// gradient entry has no values, and then the compressed gradient.
+struct CompressedPushHeader {
+  uint64_t frame_size;
+  // The index of the gradient entry in the raw kv frame.
+  uint64_t grad_index;
+};
+
+// The GradientCompressor compresses the gradients of one parameter with the error feedback: the part of the gradient
+// lost by the compression is kept as the residual, which is added to the gradient of next step before compressing.
+class GradientCompressor {
+ public:
+  GradientCompressor(const GradientCompressionConfig &config, uint32_t seed);
+  ~GradientCompressor() = default;
+
+  // Compress the gradient of len values added with the residual, and update the residual.
+  std::string Compress(const float *grad, size_t len);
+
+  // Check the compressed gradient and get its header, return false if it is invalid.
+  static bool ParseHeader(const void *data, size_t size, CompressedGradientHeader *header);
+
+  // Decompress the gradient and add it to the dst of len values in one pass, return false if it is invalid.
+  static bool DecompressAccumulate(const void *data, size_t size, float *dst, size_t len);
+
+  const std::vector<float> &residual() const { return residual_; }
+
+ private:
+  // Select the indices of the sparse methods into indices_, and return the number of them.
+  size_t SelectIndices(size_t len);
+
+  GradientCompressionConfig config_;
+  std::vector<float> residual_;
+  std::vector<uint32_t> indices_;
+  std::mt19937 random_engine_;
+};
+}  // namespace ps
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_PS_GRADIENT_COMPRESSOR_H_
@@ -15,6 +15,7 @@
  */
 
 #include "ps/optimizer_info.h"
+#include <algorithm>
 #include <map>
 #include <memory>
 #include <string>
@@ -99,19 +100,31 @@ void DenseOptimInfo::Accumulate(const Values &values, const Lengths &lengths) {
 }
 
 void DenseOptimInfo::ComputeMean(const std::vector<std::vector<size_t>> &, size_t n, size_t, size_t) {
+  ComputeMean(n, 0, gradient()->size / sizeof(float));
+}
+
+void DenseOptimInfo::Reset() { Reset(0, gradient()->size / sizeof(float)); }
+
+void DenseOptimInfo::ComputeMean(size_t n, size_t begin, size_t end) {
   if (n > 1) {
     MS_EXCEPTION_IF_NULL(gradient()->addr);
     float *accum_grad_data = reinterpret_cast<float *>(gradient()->addr);
     size_t size = gradient()->size / sizeof(float);
-    for (size_t i = 0; i < size; i++) {
+    for (size_t i = begin; i < std::min(end, size); i++) {
       accum_grad_data[i] /= n;
     }
   }
 }
 
-void DenseOptimInfo::Reset() {
+void DenseOptimInfo::Reset(size_t begin, size_t end) {
   MS_EXCEPTION_IF_NULL(gradient()->addr);
-  int64_t ret = memset_s(gradient()->addr, gradient()->size, 0x00, gradient()->size);
+  size_t size = gradient()->size / sizeof(float);
+  end = std::min(end, size);
+  if (begin >= end) {
+    return;
+  }
+  float *accum_grad_data = reinterpret_cast<float *>(gradient()->addr);
+  int64_t ret = memset_s(accum_grad_data + begin, (size - begin) * sizeof(float), 0x00, (end - begin) * sizeof(float));
   if (ret != 0) {
     MS_LOG(EXCEPTION) << "memset_s error, errorno(" << ret << ")";
     return;
@@ -229,7 +242,7 @@ void SparseOptimInfo::ComputeMean(const std::vector<std::vector<size_t>> &shapes
   }
 
   Util::ReduceSparseGradient(grad_data, indices_data, indices_size, segment_size, first_dim_size, outer_dim_size,
-                             &unique_sparse_grad);
+                             &unique_sparse_grad, &reduce_workspace_);
 
   size_t reduced_grad_size = unique_sparse_grad.indices_size_ * segment_size * sizeof(float);
   MS_EXCEPTION_IF_NULL(unique_sparse_grad.value_);
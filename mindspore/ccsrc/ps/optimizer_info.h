@@ -21,6 +21,7 @@
 #include <string>
 #include "kernel/kernel.h"
 #include "ps/constants.h"
+#include "ps/util.h"
 
 namespace mindspore {
 namespace ps {
@@ -66,6 +67,11 @@ class DenseOptimInfo : public OptimizerInfo {
   void ComputeMean(const std::vector<std::vector<size_t>> &shapes, size_t n, size_t server_num,
                    size_t rank_id) override;
   void Reset() override;
+
+  // Compute the mean and reset the gradient elements in [begin, end), so that the ranges of one gradient can be
+  // processed by multiple threads.
+  void ComputeMean(size_t n, size_t begin, size_t end);
+  void Reset(size_t begin, size_t end);
 };
 
 class SparseOptimInfo : public OptimizerInfo {
@@ -83,6 +89,7 @@ class SparseOptimInfo : public OptimizerInfo {
   size_t grads_offset_{0};
   size_t indices_offset_{0};
   bool sharded_{true};
+  ReduceSparseGradientWorkspace reduce_workspace_;
 };
 
 class MomentumOptimInfo : public DenseOptimInfo {
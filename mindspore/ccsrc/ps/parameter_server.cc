@@ -18,13 +18,22 @@
 #include <algorithm>
 #include <thread>
 #include <set>
+#include <tuple>
 
 #include "utils/file_utils.h"
+#include "utils/ms_exception.h"
+#include "common/thread_pool.h"
 
 namespace mindspore {
 namespace ps {
 static const uint32_t kMaxThreadNum = 16;
 static const uint32_t kCPUCoreNum = std::thread::hardware_concurrency();
+// The push requests larger than this are handled by the push executor, the small ones are cheaper to be handled in the
+// event loop directly than to be copied and dispatched.
+static const size_t kAsyncPushSizeThreshold = 64 * 1024;
+// The dense gradients larger than the average load of the threads are split into the ranges of at least this number of
+// elements, which are applied by different threads.
+static const size_t kMinDenseRangeSize = 64 * 1024;
 
 void ParameterServer::Run(const FuncGraphPtr &func_graph) {
   MS_EXCEPTION_IF_NULL(func_graph);
@@ -67,6 +76,7 @@ bool ParameterServer::Init(const FuncGraphPtr &func_graph) {
   recover_handler_ = std::make_unique<RecoverHandler>(this);
 
   InitOptimInfoBuilders();
+  push_executor_ = std::make_unique<core::TaskExecutor>(std::max(std::min(kMaxThreadNum, kCPUCoreNum), 1U));
   server_node_->set_handler(*handler_);
   server_node_->RegisterEventCallback(core::ClusterEvent::SCHEDULER_TIMEOUT, [this]() {
     MS_LOG(ERROR) << "Trigger timeout event: SCHEDULER_TIMEOUT begin to exit the system!";
@@ -403,39 +413,31 @@ void ParameterServer::UpdateWeights() {
       break;
     }
 
+    // The sparse optimizers are applied one by one, because their kernels already split the rows among the threads.
+    std::vector<Key> dense_keys;
+    std::vector<Key> sparse_keys;
     for (auto iter = weights_.begin(); iter != weights_.end(); iter++) {
       Key key = iter->first;
-      WeightPtr weight_ptr = iter->second;
-
-      std::shared_ptr<PServerKernel> optimizer = nullptr;
-      if (weight_key_to_optims_.count(key) > 0) {
-        optimizer = optimizers_[key];
+      if (weight_key_to_optims_.count(key) == 0 || optimizers_[key] == nullptr) {
+        MS_LOG(EXCEPTION) << "No optimizer found for key " << key;
       }
-      MS_EXCEPTION_IF_NULL(optimizer);
-
       std::shared_ptr<OptimizerInfo> optim_info = optim_infos_[key];
-      if (optim_info != nullptr) {
-        const std::vector<kernel::AddressPtr> &inputs = optim_info->inputs();
-        const std::vector<kernel::AddressPtr> &workspaces = optim_info->workspaces();
-        const std::vector<kernel::AddressPtr> &outputs = optim_info->outputs();
-
-        std::vector<std::vector<size_t>> shapes = {};
-        std::vector<size_t> indices_shape = {};
-        indices_shape.emplace_back(optim_info->indice_size());
-        shapes.push_back(indices_shape);
-
-        if (original_optim_inputs_shape_.count(key) != 0) {
-          std::transform((*(original_optim_inputs_shape_[key])).begin(), (*(original_optim_inputs_shape_[key])).end(),
-                         std::back_inserter(shapes),
-                         [](const std::shared_ptr<std::vector<size_t>> &input_shapes) -> std::vector<size_t> {
-                           return *input_shapes;
-                         });
-        }
-        optimizer->ReInit(shapes);
-        optim_info->ComputeMean(shapes, worker_num_, pserver_num_, server_node_->rank_id());
-        optimizer->Execute(inputs, workspaces, outputs);
-        optim_info->Reset();
+      if (optim_info == nullptr) {
+        continue;
       }
+      if (std::dynamic_pointer_cast<DenseOptimInfo>(optim_info) != nullptr) {
+        dense_keys.push_back(key);
+      } else {
+        sparse_keys.push_back(key);
+      }
+    }
+    ApplyDenseOptimizers(dense_keys);
+    for (const auto &key : sparse_keys) {
+      ApplyOptimizer(key);
+    }
+
+    for (auto iter = weights_.begin(); iter != weights_.end(); iter++) {
+      Key key = iter->first;
       if (!is_embedding_[key]) {
         tokens_[key] = worker_num_;
       }
@@ -444,24 +446,148 @@ void ParameterServer::UpdateWeights() {
   }
 }
 
+std::vector<std::vector<size_t>> ParameterServer::ReInitOptimizer(const Key &key) {
+  // Only the lookups of the maps are done here, because it may be called by multiple threads.
+  const std::shared_ptr<PServerKernel> &optimizer = optimizers_.at(key);
+  MS_EXCEPTION_IF_NULL(optimizer);
+  const std::shared_ptr<OptimizerInfo> &optim_info = optim_infos_.at(key);
+  MS_EXCEPTION_IF_NULL(optim_info);
+
+  std::vector<std::vector<size_t>> shapes = {};
+  std::vector<size_t> indices_shape = {};
+  indices_shape.emplace_back(optim_info->indice_size());
+  shapes.push_back(indices_shape);
+
+  auto original_inputs_shape = original_optim_inputs_shape_.find(key);
+  if (original_inputs_shape != original_optim_inputs_shape_.end()) {
+    MS_EXCEPTION_IF_NULL(original_inputs_shape->second);
+    std::transform(original_inputs_shape->second->begin(), original_inputs_shape->second->end(),
+                   std::back_inserter(shapes),
+                   [](const std::shared_ptr<std::vector<size_t>> &input_shapes) -> std::vector<size_t> {
+                     return *input_shapes;
+                   });
+  }
+  optimizer->ReInit(shapes);
+  return shapes;
+}
+
+void ParameterServer::ApplyOptimizer(const Key &key) {
+  const std::vector<std::vector<size_t>> &shapes = ReInitOptimizer(key);
+  const std::shared_ptr<PServerKernel> &optimizer = optimizers_.at(key);
+  const std::shared_ptr<OptimizerInfo> &optim_info = optim_infos_.at(key);
+  optim_info->ComputeMean(shapes, worker_num_, pserver_num_, server_node_->rank_id());
+  optimizer->Execute(optim_info->inputs(), optim_info->workspaces(), optim_info->outputs());
+  optim_info->Reset();
+}
+
+void ParameterServer::ApplyDenseOptimizer(const Key &key, size_t begin, size_t end) {
+  const std::shared_ptr<PServerKernel> &optimizer = optimizers_.at(key);
+  MS_EXCEPTION_IF_NULL(optimizer);
+  auto optim_info = std::dynamic_pointer_cast<DenseOptimInfo>(optim_infos_.at(key));
+  MS_EXCEPTION_IF_NULL(optim_info);
+  size_t grad_size = optim_info->gradient()->size;
+  optim_info->ComputeMean(worker_num_, begin, end);
+  // The dense optimizers are element-wise, so the inputs of the same size as the gradient are sliced, and the other
+  // inputs such as the learning rate are shared by the ranges.
+  std::vector<kernel::AddressPtr> inputs;
+  for (const auto &input : optim_info->inputs()) {
+    MS_EXCEPTION_IF_NULL(input);
+    if (input->size == grad_size) {
+      (void)inputs.emplace_back(
+        std::make_shared<kernel::Address>(reinterpret_cast<float *>(input->addr) + begin, (end - begin) * sizeof(float)));
+    } else {
+      (void)inputs.emplace_back(input);
+    }
+  }
+  optimizer->Execute(inputs, optim_info->workspaces(), optim_info->outputs());
+  optim_info->Reset(begin, end);
+}
+
+void ParameterServer::ApplyDenseOptimizers(const std::vector<Key> &keys) {
+  size_t task_num = std::min(keys.size(), common::ThreadPool::GetInstance().GetSyncRunThreadNum());
+  if (task_num <= 1) {
+    for (const auto &key : keys) {
+      ApplyOptimizer(key);
+    }
+    return;
+  }
+
+  // The gradient larger than the average load is split into the ranges of elements, so that one large key doesn't keep
+  // the other threads waiting. The optimizers are reinitialized before the ranges are applied concurrently.
+  size_t total_size = 0;
+  for (const auto &key : keys) {
+    (void)ReInitOptimizer(key);
+    const AddressPtr &gradient = optim_infos_.at(key)->gradient();
+    MS_EXCEPTION_IF_NULL(gradient);
+    total_size += gradient->size / sizeof(float);
+  }
+  size_t range_size = std::max(kMinDenseRangeSize, (total_size + task_num - 1) / task_num);
+  // The ranges are (size, key, begin), and the largest range is assigned to the least loaded task.
+  std::vector<std::tuple<size_t, Key, size_t>> ranges;
+  for (const auto &key : keys) {
+    size_t grad_size = optim_infos_.at(key)->gradient()->size / sizeof(float);
+    for (size_t begin = 0; begin < grad_size; begin += range_size) {
+      (void)ranges.emplace_back(std::min(range_size, grad_size - begin), key, begin);
+    }
+  }
+  std::sort(ranges.begin(), ranges.end(), std::greater<std::tuple<size_t, Key, size_t>>());
+  std::vector<std::vector<std::tuple<size_t, Key, size_t>>> task_ranges(task_num);
+  std::vector<size_t> task_loads(task_num, 0);
+  for (const auto &range : ranges) {
+    size_t index = LongToSize(std::min_element(task_loads.begin(), task_loads.end()) - task_loads.begin());
+    task_ranges[index].push_back(range);
+    task_loads[index] += std::get<0>(range);
+  }
+
+  std::vector<common::Task> tasks;
+  for (const auto &ranges_of_task : task_ranges) {
+    (void)tasks.emplace_back([this, &ranges_of_task]() {
+      for (const auto &range : ranges_of_task) {
+        size_t begin = std::get<2>(range);
+        ApplyDenseOptimizer(std::get<1>(range), begin, begin + std::get<0>(range));
+      }
+      return common::SUCCESS;
+    });
+  }
+  (void)common::ThreadPool::GetInstance().SyncRun(tasks);
+  MsException::Instance().CheckException();
+}
+
 void ParameterServer::AccumGrad(const Keys &keys, const Values &values, const Lengths &lengths) {
-  std::unique_lock<std::mutex> lock(mutex_);
   const Key &key = keys[0];
   bool no_sparse_grad = values.size() == 1 && values[0] == kGradValue;
   if (!no_sparse_grad) {
-    std::shared_ptr<OptimizerInfo> optim_info = optim_infos_[key];
+    // The gradients of the key are accumulated under the key's lock, and the mutex_ is only held to access the maps.
+    std::unique_lock<std::mutex> key_lock(key_mutex(key));
+    std::shared_ptr<OptimizerInfo> optim_info = nullptr;
+    std::shared_ptr<OptimizerInfoBuilder> builder = nullptr;
+    std::shared_ptr<kernel::ps::PServerKernel> pserver_kernel = nullptr;
+    WeightPtr weight_ptr = nullptr;
+    InputsShapePtr inputs_shape = nullptr;
+    bool is_embedding = false;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      optim_info = optim_infos_[key];
+      if (optim_info == nullptr) {
+        builder = optim_info_builders_[weight_key_to_optims_[key]];
+        pserver_kernel = optimizers_[key];
+        if (pserver_kernel == nullptr) {
+          MS_LOG(EXCEPTION) << "no optimizer found for key " << key << " optim name " << weight_key_to_optims_[key];
+        }
+        weight_ptr = weights_[key];
+        inputs_shape = optim_inputs_shape_[key];
+        is_embedding = is_embedding_[key];
+      }
+    }
 
     // Create or update the optimizer info
     if (optim_info == nullptr) {
-      const std::shared_ptr<OptimizerInfoBuilder> &builder = optim_info_builders_[weight_key_to_optims_[key]];
-      std::shared_ptr<kernel::ps::PServerKernel> pserver_kernel = optimizers_[key];
-      if (pserver_kernel == nullptr) {
-        MS_LOG(EXCEPTION) << "no optimizer found for key " << key << " optim name " << weight_key_to_optims_[key];
-      }
+      MS_EXCEPTION_IF_NULL(builder);
       MS_EXCEPTION_IF_NULL(pserver_kernel);
-      OptimizerInfo *optim = builder->Build(pserver_kernel, weights_[key], keys, values, lengths,
-                                            optim_inputs_shape_[key], worker_num_, is_embedding_[key]);
+      OptimizerInfo *optim = builder->Build(pserver_kernel, weight_ptr, keys, values, lengths, inputs_shape,
+                                            worker_num_, is_embedding);
       optim_info.reset(optim);
+      std::unique_lock<std::mutex> lock(mutex_);
       optim_infos_[key] = optim_info;
     } else {
       optim_info->Update(values, lengths);
@@ -469,6 +595,7 @@ void ParameterServer::AccumGrad(const Keys &keys, const Values &values, const Le
     }
   }
 
+  std::unique_lock<std::mutex> lock(mutex_);
   grads_accum_counter_[key] += 1;
   if (grads_accum_counter_[key] == worker_num_) {
     grad_accum_count_++;
@@ -639,6 +766,8 @@ const CNodePtr ParameterServer::GetCNode(const std::string &name) const {
 
 inline std::mutex &ParameterServer::mutex() { return mutex_; }
 
+inline std::mutex &ParameterServer::key_mutex(const Key &key) { return key_mutexes_[key % kKeyMutexNum]; }
+
 void ParameterServer::GetEmbeddingTableParamPtr() {
   if (ps::PsDataPrefetch::GetInstance().cache_enable()) {
     return;
@@ -879,6 +1008,9 @@ void ParameterServer::ServerHandler::Init() {
   handlers_[kFinalizeCmd] = &ServerHandler::HandleFinalize;
   handlers_[kPushCmd] = &ServerHandler::HandlePushReq;
   handlers_[kPullCmd] = &ServerHandler::HandlePullReq;
+  handlers_[kPushRawCmd] = &ServerHandler::HandlePushRawReq;
+  handlers_[kPullRawCmd] = &ServerHandler::HandlePullRawReq;
+  handlers_[kPushCompressedCmd] = &ServerHandler::HandlePushCompressedReq;
   commands_[kInitWeightsCmd] = "kInitWeightsCmd";
   commands_[kInitWeightToOptimIdCmd] = "kInitWeightToOptimIdCmd";
   commands_[kInitOptimInputsShapeCmd] = "kInitOptimInputsShapeCmd";
@@ -890,19 +1022,42 @@ void ParameterServer::ServerHandler::Init() {
   commands_[kFinalizeCmd] = "kFinalizeCmd";
   commands_[kPushCmd] = "kPushCmd";
   commands_[kPullCmd] = "kPullCmd";
+  commands_[kPushRawCmd] = "kPushRawCmd";
+  commands_[kPullRawCmd] = "kPullRawCmd";
+  commands_[kPushCompressedCmd] = "kPushCompressedCmd";
 }
 
 void ParameterServer::ServerHandler::operator()(const std::shared_ptr<core::TcpConnection> &conn,
                                                 const std::shared_ptr<core::MessageMeta> &meta, const void *data,
                                                 size_t size) {
   MS_EXCEPTION_IF_NULL(data);
-  auto output = std::make_shared<std::vector<unsigned char>>();
+  MS_EXCEPTION_IF_NULL(meta);
   if (commands_.count(meta->user_cmd()) == 0) {
     MS_LOG(EXCEPTION) << "The command:" << meta->user_cmd() << " is not supported!";
   }
   MS_LOG(INFO) << "The command is:" << commands_[meta->user_cmd()];
 
-  auto &handler_ptr = handlers_[meta->user_cmd()];
+  // The large push requests are handled by the push executor, so the gradients of different keys are accumulated
+  // concurrently. The data is copied because it is released after this callback returns.
+  bool is_push =
+    meta->user_cmd() == kPushCmd || meta->user_cmd() == kPushRawCmd || meta->user_cmd() == kPushCompressedCmd;
+  if (is_push && size >= kAsyncPushSizeThreshold && ps_->push_executor_ != nullptr) {
+    auto push_data = std::make_shared<std::vector<unsigned char>>(size);
+    CopyTensorData(push_data->data(), size, data);
+    if (!ps_->push_executor_->Submit(
+          [this, conn, meta, push_data]() { HandleRequest(conn, meta, push_data->data(), push_data->size()); })) {
+      MS_LOG(EXCEPTION) << "Submit the push request failed.";
+    }
+    return;
+  }
+  HandleRequest(conn, meta, data, size);
+}
+
+void ParameterServer::ServerHandler::HandleRequest(const std::shared_ptr<core::TcpConnection> &conn,
+                                                   const std::shared_ptr<core::MessageMeta> &meta, const void *data,
+                                                   size_t size) {
+  auto output = std::make_shared<std::vector<unsigned char>>();
+  const auto &handler_ptr = handlers_.at(meta->user_cmd());
   (this->*handler_ptr)(data, size, output);
   MS_LOG(DEBUG) << "The output size is:" << output->size();
 
@@ -953,6 +1108,110 @@ void ParameterServer::ServerHandler::HandlePullReq(const void *data, size_t size
   }
 }
 
+void ParameterServer::ServerHandler::HandlePushRawReq(const void *data, size_t size, const VectorPtr &res) {
+  MS_EXCEPTION_IF_NULL(data);
+  MS_EXCEPTION_IF_NULL(res);
+  RawKVFrameReader input;
+  if (!input.Parse(data, size) || input.key_num() == 0) {
+    MS_LOG(EXCEPTION) << "Invalid raw kv frame of push request, size: " << size;
+  }
+  Keys keys(input.key_num());
+  Lengths lens(input.key_num());
+  for (size_t i = 0; i < input.key_num(); ++i) {
+    keys[i] = input.key(i);
+    lens[i] = SizeToInt(input.len(i));
+  }
+  // The values are copied from the frame directly, or decompressed if they are compressed by the worker.
+  Values values(input.value_num());
+  if (!input.CopyValues(values.data(), values.size())) {
+    MS_LOG(EXCEPTION) << "Failed to copy the values of push request.";
+  }
+  ps_->AccumGrad(keys, values, lens);
+}
+
+void ParameterServer::ServerHandler::HandlePullRawReq(const void *data, size_t size, const VectorPtr &res) {
+  MS_EXCEPTION_IF_NULL(data);
+  MS_EXCEPTION_IF_NULL(res);
+  RawKVFrameReader input;
+  if (!input.Parse(data, size) || input.key_num() == 0) {
+    MS_LOG(EXCEPTION) << "Invalid raw kv frame of pull request, size: " << size;
+  }
+  // The weight is always responded in float32, so the workers don't train on the rounded weight.
+  Key key = input.key(0);
+  auto weight = ps_->weight(key);
+  auto weight_data = weight->MutableData();
+  MS_EXCEPTION_IF_NULL(weight_data);
+  RawKVFrameBuilder res_data(RawKVDataType::kFloat32);
+  res_data.Add(key, weight_data->data(), weight_data->size());
+  res->resize(res_data.FrameSize());
+  res_data.BuildTo(res->data(), res->size());
+}
+
+void ParameterServer::ServerHandler::HandlePushCompressedReq(const void *data, size_t size, const VectorPtr &res) {
+  MS_EXCEPTION_IF_NULL(data);
+  MS_EXCEPTION_IF_NULL(res);
+  CompressedPushHeader header;
+  if (size < sizeof(header)) {
+    MS_LOG(EXCEPTION) << "Invalid compressed push request, size: " << size;
+  }
+  int ret = memcpy_s(&header, sizeof(header), data, sizeof(header));
+  if (ret != 0) {
+    MS_LOG(EXCEPTION) << "The memcpy_s error, errorno(" << ret << ")";
+  }
+  auto frame_data = reinterpret_cast<const uint8_t *>(data) + sizeof(header);
+  RawKVFrameReader input;
+  if (header.frame_size > size - sizeof(header) || !input.Parse(frame_data, header.frame_size) ||
+      header.grad_index >= input.key_num()) {
+    MS_LOG(EXCEPTION) << "Invalid raw kv frame of compressed push request, size: " << size;
+  }
+
+  // The compressed gradient is read in place, so it is copied if it is not aligned in the request.
+  const uint8_t *grad_data = frame_data + header.frame_size;
+  size_t grad_size = size - sizeof(header) - header.frame_size;
+  std::vector<float> aligned_grad_data;
+  if (reinterpret_cast<uintptr_t>(grad_data) % alignof(float) != 0) {
+    aligned_grad_data.resize(grad_size / sizeof(float) + 1);
+    ret = memcpy_s(aligned_grad_data.data(), aligned_grad_data.size() * sizeof(float), grad_data, grad_size);
+    if (ret != 0) {
+      MS_LOG(EXCEPTION) << "The memcpy_s error, errorno(" << ret << ")";
+    }
+    grad_data = reinterpret_cast<const uint8_t *>(aligned_grad_data.data());
+  }
+  CompressedGradientHeader grad_header;
+  if (!GradientCompressor::ParseHeader(grad_data, grad_size, &grad_header)) {
+    MS_LOG(EXCEPTION) << "Invalid compressed gradient of push request, size: " << grad_size;
+  }
+
+  size_t key_num = input.key_num();
+  Keys keys(key_num);
+  Lengths lens(key_num);
+  for (size_t i = 0; i < key_num; ++i) {
+    keys[i] = input.key(i);
+    lens[i] = SizeToInt(i == header.grad_index ? static_cast<size_t>(grad_header.len) : input.len(i));
+  }
+  Values inputs(input.value_num());
+  if (!input.CopyValues(inputs.data(), inputs.size())) {
+    MS_LOG(EXCEPTION) << "Failed to copy the values of compressed push request.";
+  }
+  // The gradient is decompressed into the values directly, and the other inputs are copied.
+  Values values(input.value_num() + grad_header.len, 0);
+  size_t offset = 0;
+  size_t input_offset = 0;
+  for (size_t i = 0; i < key_num; ++i) {
+    size_t len = IntToSize(lens[i]);
+    if (i == header.grad_index) {
+      if (!GradientCompressor::DecompressAccumulate(grad_data, grad_size, values.data() + offset, len)) {
+        MS_LOG(EXCEPTION) << "Failed to decompress the gradient of key " << keys[i];
+      }
+    } else {
+      (void)std::copy(inputs.begin() + input_offset, inputs.begin() + input_offset + len, values.begin() + offset);
+      input_offset += len;
+    }
+    offset += len;
+  }
+  ps_->AccumGrad(keys, values, lens);
+}
+
 void ParameterServer::ServerHandler::HandleInitWeights(const void *data, size_t size, const VectorPtr &res) {
   std::unique_lock<std::mutex> lock(ps_->mutex());
   MS_EXCEPTION_IF_NULL(data);
@@ -32,6 +32,7 @@
 #include <map>
 #include <functional>
 #include <algorithm>
+#include <array>
 
 #include "utils/hash_map.h"
 #include "ir/func_graph.h"
@@ -58,11 +59,14 @@
 #include "ps/constants.h"
 #include "ps/util.h"
 #include "ps/embedding_table_shard_metadata.h"
+#include "ps/raw_kv_frame.h"
+#include "ps/gradient_compressor.h"
 #include "utils/log_adapter.h"
 #include "proto/comm.pb.h"
 #include "proto/ps.pb.h"
 #include "ps/core/ps_server_node.h"
 #include "ps/core/node.h"
+#include "ps/core/communicator/task_executor.h"
 
 namespace mindspore {
 namespace ps {
@@ -100,6 +104,9 @@ class ParameterServer {
                     const void *data, size_t size);
     void HandlePushReq(const void *data, size_t size, const VectorPtr &res);
     void HandlePullReq(const void *data, size_t size, const VectorPtr &res);
+    void HandlePushRawReq(const void *data, size_t size, const VectorPtr &res);
+    void HandlePullRawReq(const void *data, size_t size, const VectorPtr &res);
+    void HandlePushCompressedReq(const void *data, size_t size, const VectorPtr &res);
     void HandleInitWeights(const void *data, size_t size, const VectorPtr &res);
     void HandleInitWeightToOptimId(const void *data, size_t size, const VectorPtr &res);
     void HandleInitInputsShape(const void *data, size_t size, const VectorPtr &res);
@@ -111,6 +118,9 @@ class ParameterServer {
     void HandleFinalize(const void *data, size_t size, const VectorPtr &res);
 
    private:
+    void HandleRequest(const std::shared_ptr<core::TcpConnection> &conn, const std::shared_ptr<core::MessageMeta> &meta,
+                       const void *data, size_t size);
+
     ParameterServer *ps_;
     typedef void (ServerHandler::*RequestHandler)(const void *data, size_t size, const VectorPtr &res);
     mindspore::HashMap<int, RequestHandler> handlers_;
@@ -157,6 +167,15 @@ class ParameterServer {
   bool HasWeight(const Key &key);
   void Finalize();
   void UpdateWeights();
+  // Reinitialize the optimizer of the key by the shapes of its inputs, which are returned.
+  std::vector<std::vector<size_t>> ReInitOptimizer(const Key &key);
+  // Apply the optimizer of the key with the accumulated gradients.
+  void ApplyOptimizer(const Key &key);
+  // Apply the reinitialized dense optimizer of the key on the gradient elements in [begin, end).
+  void ApplyDenseOptimizer(const Key &key, size_t begin, size_t end);
+  // Apply the optimizers of the dense keys in parallel, the large gradients are split into the ranges of elements, and
+  // the ranges are balanced among the threads by the size.
+  void ApplyDenseOptimizers(const std::vector<Key> &keys);
   void AccumGrad(const Keys &key, const Values &values, const Lengths &lengths);
   WeightPtr weight(const Key &key);
   void DoEmbeddingLookup(Key key, const LookupIds &lookup_ids, KVMessage *res);
@@ -167,6 +186,8 @@ class ParameterServer {
   inline void ResetGradAccumCount();
   const CNodePtr GetCNode(const std::string &name) const;
   inline std::mutex &mutex();
+  // The lock of the key, which protects the accumulation of the key's gradients.
+  inline std::mutex &key_mutex(const Key &key);
   void GetEmbeddingTableParamPtr();
   void SyncEmbeddingTables();
   // Cache embedding table parameter by map, key: parameter name, value: parameter node pointer
@@ -235,6 +256,13 @@ class ParameterServer {
   std::mutex mutex_;
   std::condition_variable apply_grads_cv_;
 
+  // The keys are striped to these locks, so the gradients of different keys are accumulated concurrently, while the
+  // mutex_ only protects the maps and the counters.
+  static constexpr size_t kKeyMutexNum = 64;
+  std::array<std::mutex, kKeyMutexNum> key_mutexes_;
+  // Handle the large push requests out of the server's event loop.
+  std::unique_ptr<core::TaskExecutor> push_executor_;
+
   std::mutex access_weight_mutex_;
   std::unique_ptr<std::thread> thread_;
   std::unique_ptr<std::thread> persist_thread_;
@@ -15,6 +15,7 @@
  */
 
 #include "ps/ps_context.h"
+#include "ps/gradient_compressor.h"
 #include "utils/log_adapter.h"
 #include "utils/ms_utils.h"
 #include "kernel/kernel.h"
@@ -546,5 +547,45 @@ void PSContext::set_global_iteration_time_window(const uint64_t &global_iteratio
 }
 
 uint64_t PSContext::global_iteration_time_window() const { return global_iteration_time_window_; }
+
+void PSContext::set_gradient_compression(const std::string &gradient_compression) {
+  std::map<std::string, std::string> param_to_gradient_compression;
+  size_t begin = 0;
+  while (begin < gradient_compression.size()) {
+    size_t end = gradient_compression.find(';', begin);
+    if (end == std::string::npos) {
+      end = gradient_compression.size();
+    }
+    std::string item = gradient_compression.substr(begin, end - begin);
+    begin = end + 1;
+    if (item.empty()) {
+      continue;
+    }
+    std::string param_name;
+    std::string method = item;
+    auto pos = item.find('=');
+    if (pos != std::string::npos) {
+      param_name = item.substr(0, pos);
+      method = item.substr(pos + 1);
+    }
+    GradientCompressionConfig config;
+    if (!ParseGradientCompression(method, &config)) {
+      MS_LOG(EXCEPTION) << "Invalid gradient compression: " << item;
+    }
+    param_to_gradient_compression[param_name] = method;
+  }
+  gradient_compression_ = gradient_compression;
+  param_to_gradient_compression_ = param_to_gradient_compression;
+}
+
+const std::string &PSContext::gradient_compression() const { return gradient_compression_; }
+
+std::string PSContext::param_gradient_compression(const std::string &param_name) const {
+  auto iter = param_to_gradient_compression_.find(param_name);
+  if (iter == param_to_gradient_compression_.end()) {
+    iter = param_to_gradient_compression_.find("");
+  }
+  return iter == param_to_gradient_compression_.end() ? "none" : iter->second;
+}
 }  // namespace ps
 }  // namespace mindspore
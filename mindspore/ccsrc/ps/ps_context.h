@@ -230,6 +230,13 @@ class PSContext {
   void set_global_iteration_time_window(const uint64_t &global_iteration_time_window);
   uint64_t global_iteration_time_window() const;
 
+  // The gradient compression is in the format of "[param_name=]method;...", the method without the parameter name is
+  // the default of all the parameters. Refer to ParseGradientCompression for the methods.
+  void set_gradient_compression(const std::string &gradient_compression);
+  const std::string &gradient_compression() const;
+  // Get the gradient compression method of the parameter, "none" if it is not compressed.
+  std::string param_gradient_compression(const std::string &param_name) const;
+
  private:
   PSContext()
       : ps_enabled_(false),
@@ -282,7 +289,8 @@ class PSContext {
         client_password_(""),
         server_password_(""),
         http_url_prefix_(""),
-        global_iteration_time_window_(21600000) {}
+        global_iteration_time_window_(21600000),
+        gradient_compression_("") {}
   bool ps_enabled_;
   bool is_worker_;
   bool is_pserver_;
@@ -415,6 +423,11 @@ class PSContext {
 
   // The time window of startFLJob round in millisecond.
   uint64_t global_iteration_time_window_;
+
+  // The gradient compression of the dense gradients pushed to the parameter server, and the methods of the parameters
+  // parsed from it, whose key is empty for the default method.
+  std::string gradient_compression_;
+  std::map<std::string, std::string> param_to_gradient_compression_;
 };
 }  // namespace ps
 }  // namespace mindspore
@@ -0,0 +1,277 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ps/raw_kv_frame.h"
+
+#include <securec.h>
+#include <algorithm>
+#include <cmath>
+
+#include "base/float16.h"
+#include "utils/log_adapter.h"
+#include "utils/ms_utils.h"
+
+namespace mindspore {
+namespace ps {
+// The frame is written and read in place by the hosts, which are little endian.
+static_assert(__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__, "The raw kv frame needs the little endian host.");
+
+namespace {
+constexpr char kEnvRawKVFrame[] = "MS_DEV_PS_RAW_KV_FRAME";
+constexpr uint32_t kBFloat16Shift = 16;
+constexpr uint32_t kBFloat16RoundingBias = 0x7FFF;
+constexpr uint16_t kBFloat16NaN = 0x7FC0;
+
+// Round to the nearest even, and keep the NaN quiet.
+uint16_t FloatToBFloat16(float value) {
+  if (std::isnan(value)) {
+    return kBFloat16NaN;
+  }
+  uint32_t bits = 0;
+  (void)memcpy_s(&bits, sizeof(bits), &value, sizeof(value));
+  bits += kBFloat16RoundingBias + ((bits >> kBFloat16Shift) & 1);
+  return static_cast<uint16_t>(bits >> kBFloat16Shift);
+}
+
+float BFloat16ToFloat(uint16_t value) {
+  uint32_t bits = static_cast<uint32_t>(value) << kBFloat16Shift;
+  float result = 0;
+  (void)memcpy_s(&result, sizeof(result), &bits, sizeof(bits));
+  return result;
+}
+
+void CompressValues(const float *src, size_t num, RawKVDataType data_type, uint8_t *dst) {
+  if (data_type == RawKVDataType::kFloat16) {
+    for (size_t i = 0; i < num; ++i) {
+      float16 value = static_cast<float16>(src[i]);
+      (void)memcpy_s(dst + i * sizeof(value), sizeof(value), &value, sizeof(value));
+    }
+  } else {
+    for (size_t i = 0; i < num; ++i) {
+      uint16_t value = FloatToBFloat16(src[i]);
+      (void)memcpy_s(dst + i * sizeof(value), sizeof(value), &value, sizeof(value));
+    }
+  }
+}
+
+void DecompressValues(const uint8_t *src, size_t num, RawKVDataType data_type, float *dst) {
+  if (data_type == RawKVDataType::kFloat16) {
+    for (size_t i = 0; i < num; ++i) {
+      float16 value;
+      (void)memcpy_s(&value, sizeof(value), src + i * sizeof(value), sizeof(value));
+      dst[i] = static_cast<float>(value);
+    }
+  } else {
+    for (size_t i = 0; i < num; ++i) {
+      uint16_t value = 0;
+      (void)memcpy_s(&value, sizeof(value), src + i * sizeof(value), sizeof(value));
+      dst[i] = BFloat16ToFloat(value);
+    }
+  }
+}
+
+// Copy the large buffer by the chunks, which are limited by the max length of memcpy_s.
+void CopyBytes(void *dst, const void *src, size_t size) {
+  constexpr size_t kMaxCopySize = 1UL << 30;
+  auto dst_addr = reinterpret_cast<uint8_t *>(dst);
+  auto src_addr = reinterpret_cast<const uint8_t *>(src);
+  for (size_t offset = 0; offset < size; offset += kMaxCopySize) {
+    size_t copy_size = std::min(kMaxCopySize, size - offset);
+    auto ret = memcpy_s(dst_addr + offset, copy_size, src_addr + offset, copy_size);
+    if (ret != EOK) {
+      MS_LOG(EXCEPTION) << "memcpy_s error, errorno(" << ret << ")";
+    }
+  }
+}
+}  // namespace
+
+size_t RawKVDataTypeSize(RawKVDataType data_type) {
+  switch (data_type) {
+    case RawKVDataType::kFloat32:
+      return sizeof(float);
+    case RawKVDataType::kFloat16:
+    case RawKVDataType::kBFloat16:
+      return sizeof(uint16_t);
+    default:
+      return 0;
+  }
+}
+
+bool GetRawKVFrameDataType(RawKVDataType *data_type) {
+  MS_EXCEPTION_IF_NULL(data_type);
+  std::string env = common::GetEnv(kEnvRawKVFrame);
+  if (env.empty()) {
+    return false;
+  }
+  if (env == "fp32") {
+    *data_type = RawKVDataType::kFloat32;
+  } else if (env == "fp16") {
+    *data_type = RawKVDataType::kFloat16;
+  } else if (env == "bf16") {
+    *data_type = RawKVDataType::kBFloat16;
+  } else {
+    MS_LOG(EXCEPTION) << "Invalid " << kEnvRawKVFrame << ": " << env << ", it should be fp32, fp16 or bf16.";
+  }
+  return true;
+}
+
+void RawKVFrameBuilder::Add(Key key, const float *values, size_t len) { Add(key, values, len, data_type_); }
+
+void RawKVFrameBuilder::Add(Key key, const float *values, size_t len, RawKVDataType data_type) {
+  if (values == nullptr && len > 0) {
+    MS_LOG(EXCEPTION) << "The values of key " << key << " is null.";
+  }
+  size_t element_size = RawKVDataTypeSize(data_type);
+  if (element_size == 0) {
+    MS_LOG(EXCEPTION) << "Invalid data type " << static_cast<int>(data_type) << " of key " << key;
+  }
+  RawKVFrameEntry entry{static_cast<uint64_t>(key), static_cast<uint64_t>(len), static_cast<uint16_t>(data_type), {}};
+  (void)entries_.emplace_back(entry, values);
+  value_num_ += len;
+  value_size_ += len * element_size;
+}
+
+size_t RawKVFrameBuilder::FrameSize() const {
+  return sizeof(RawKVFrameHeader) + entries_.size() * sizeof(RawKVFrameEntry) + value_size_;
+}
+
+void RawKVFrameBuilder::BuildTo(void *buffer, size_t size) const {
+  MS_EXCEPTION_IF_NULL(buffer);
+  if (size < FrameSize()) {
+    MS_LOG(EXCEPTION) << "The buffer size " << size << " is smaller than the raw kv frame size " << FrameSize();
+  }
+  auto addr = reinterpret_cast<uint8_t *>(buffer);
+  RawKVFrameHeader header{kRawKVFrameMagic, kRawKVFrameVersion, static_cast<uint16_t>(data_type_),
+                          static_cast<uint64_t>(entries_.size()), static_cast<uint64_t>(value_num_)};
+  CopyBytes(addr, &header, sizeof(header));
+  addr += sizeof(header);
+  for (const auto &entry : entries_) {
+    CopyBytes(addr, &entry.first, sizeof(entry.first));
+    addr += sizeof(entry.first);
+  }
+
+  for (const auto &entry : entries_) {
+    size_t len = static_cast<size_t>(entry.first.len);
+    auto data_type = static_cast<RawKVDataType>(entry.first.data_type);
+    if (data_type == RawKVDataType::kFloat32) {
+      CopyBytes(addr, entry.second, len * sizeof(float));
+    } else {
+      CompressValues(entry.second, len, data_type, addr);
+    }
+    addr += len * RawKVDataTypeSize(data_type);
+  }
+}
+
+std::string RawKVFrameBuilder::Build() const {
+  std::string frame;
+  frame.resize(FrameSize());
+  BuildTo(&frame[0], frame.size());
+  return frame;
+}
+
+bool RawKVFrameReader::Parse(const void *data, size_t size) {
+  if (data == nullptr || size < sizeof(RawKVFrameHeader)) {
+    MS_LOG(ERROR) << "The raw kv frame size " << size << " is smaller than the header.";
+    return false;
+  }
+  RawKVFrameHeader header;
+  CopyBytes(&header, data, sizeof(header));
+  if (header.magic != kRawKVFrameMagic || header.version != kRawKVFrameVersion) {
+    MS_LOG(ERROR) << "Invalid raw kv frame, magic: " << header.magic << ", version: " << header.version;
+    return false;
+  }
+  auto data_type = static_cast<RawKVDataType>(header.data_type);
+  if (RawKVDataTypeSize(data_type) == 0) {
+    MS_LOG(ERROR) << "Invalid data type of raw kv frame: " << header.data_type;
+    return false;
+  }
+
+  // Check the sizes without overflow before reading the key table.
+  size_t rest_size = size - sizeof(RawKVFrameHeader);
+  if (header.key_num > rest_size / sizeof(RawKVFrameEntry)) {
+    MS_LOG(ERROR) << "The key number " << header.key_num << " exceeds the raw kv frame size " << size;
+    return false;
+  }
+  rest_size -= header.key_num * sizeof(RawKVFrameEntry);
+
+  entries_ = reinterpret_cast<const uint8_t *>(data) + sizeof(RawKVFrameHeader);
+  values_ = entries_ + header.key_num * sizeof(RawKVFrameEntry);
+  data_type_ = data_type;
+  key_num_ = static_cast<size_t>(header.key_num);
+  value_num_ = static_cast<size_t>(header.value_num);
+
+  // The values of each key are checked in its own data type.
+  uint64_t total_len = 0;
+  size_t total_size = 0;
+  for (size_t i = 0; i < key_num_; ++i) {
+    auto entry = Entry(i);
+    size_t element_size = RawKVDataTypeSize(static_cast<RawKVDataType>(entry.data_type));
+    if (element_size == 0) {
+      MS_LOG(ERROR) << "Invalid data type " << entry.data_type << " of key " << entry.key;
+      return false;
+    }
+    if (entry.len > value_num_ - total_len || entry.len > (rest_size - total_size) / element_size) {
+      MS_LOG(ERROR) << "The value length of key " << entry.key << " exceeds the value number " << value_num_
+                    << " or the raw kv frame size " << size;
+      return false;
+    }
+    total_len += entry.len;
+    total_size += entry.len * element_size;
+  }
+  if (total_len != value_num_ || total_size != rest_size) {
+    MS_LOG(ERROR) << "The total value length " << total_len << " doesn't match the value number " << value_num_
+                  << " or the raw kv frame size " << size;
+    return false;
+  }
+  return true;
+}
+
+RawKVFrameEntry RawKVFrameReader::Entry(size_t index) const {
+  if (index >= key_num_) {
+    MS_LOG(EXCEPTION) << "The index " << index << " is out of the key number " << key_num_;
+  }
+  // The frame may be not aligned in the receive buffer.
+  RawKVFrameEntry entry;
+  CopyBytes(&entry, entries_ + index * sizeof(RawKVFrameEntry), sizeof(entry));
+  return entry;
+}
+
+bool RawKVFrameReader::CopyValues(float *dst, size_t dst_num) const {
+  if (dst_num < value_num_) {
+    MS_LOG(ERROR) << "The buffer of " << dst_num << " values is smaller than the value number " << value_num_;
+    return false;
+  }
+  if (value_num_ == 0) {
+    return true;
+  }
+  MS_EXCEPTION_IF_NULL(dst);
+  const uint8_t *src = values_;
+  for (size_t i = 0; i < key_num_; ++i) {
+    auto entry = Entry(i);
+    size_t len = static_cast<size_t>(entry.len);
+    auto data_type = static_cast<RawKVDataType>(entry.data_type);
+    if (data_type == RawKVDataType::kFloat32) {
+      CopyBytes(dst, src, len * sizeof(float));
+    } else {
+      DecompressValues(src, len, data_type, dst);
+    }
+    src += len * RawKVDataTypeSize(data_type);
+    dst += len;
+  }
+  return true;
+}
+}  // namespace ps
+}  // namespace mindspore
@@ -0,0 +1,116 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_PS_RAW_KV_FRAME_H_
+#define MINDSPORE_CCSRC_PS_RAW_KV_FRAME_H_
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "ps/constants.h"
+
+namespace mindspore {
+namespace ps {
+// The data type of the values in the raw kv frame, the float16 and bfloat16 values are compressed from the float32
+// values by the sender and decompressed by the receiver.
+enum class RawKVDataType : uint16_t { kFloat32 = 0, kFloat16 = 1, kBFloat16 = 2 };
+
+constexpr uint32_t kRawKVFrameMagic = 0x564B534D;
+constexpr uint16_t kRawKVFrameVersion = 2;
+
+// The raw kv frame is the header, followed by the key table of key_num entries and the value_num values of all the keys
+// in the order of the key table. All the fields are little endian, and the key table and the first values are 8 bytes
+// aligned in the frame. The data_type is the default data type of the keys.
+struct RawKVFrameHeader {
+  uint32_t magic;
+  uint16_t version;
+  uint16_t data_type;
+  uint64_t key_num;
+  uint64_t value_num;
+};
+
+// The len is the number of values of the key. The values of each key are in its own data type, so that only the
+// gradient is compressed and the other optimizer inputs are kept in float32.
+struct RawKVFrameEntry {
+  uint64_t key;
+  uint64_t len;
+  uint16_t data_type;
+  uint16_t reserved[3];
+};
+
+// The element size of the data type, return 0 if the data type is invalid.
+size_t RawKVDataTypeSize(RawKVDataType data_type);
+
+// The raw kv frame is enabled by the environment variable MS_DEV_PS_RAW_KV_FRAME, whose value is the data type of the
+// pushed gradients on the wire: fp32, fp16 or bf16. Return false if it is not enabled.
+bool GetRawKVFrameDataType(RawKVDataType *data_type);
+
+// Build the raw kv frame from the float32 values of the keys, which are referenced until the frame is built.
+class RawKVFrameBuilder {
+ public:
+  explicit RawKVFrameBuilder(RawKVDataType data_type) : data_type_(data_type) {}
+  ~RawKVFrameBuilder() = default;
+
+  // Add the values of the key in the default data type of the builder, or in the specified data type.
+  void Add(Key key, const float *values, size_t len);
+  void Add(Key key, const float *values, size_t len, RawKVDataType data_type);
+  bool empty() const { return entries_.empty(); }
+
+  size_t FrameSize() const;
+  // Write the frame into the buffer whose size is not smaller than the frame size.
+  void BuildTo(void *buffer, size_t size) const;
+  std::string Build() const;
+
+ private:
+  RawKVDataType data_type_;
+  std::vector<std::pair<RawKVFrameEntry, const float *>> entries_;
+  size_t value_num_{0};
+  size_t value_size_{0};
+};
+
+// Read the raw kv frame in place, the frame must outlive the reader.
+class RawKVFrameReader {
+ public:
+  RawKVFrameReader() = default;
+  ~RawKVFrameReader() = default;
+
+  // Check the frame, return false if it is invalid.
+  bool Parse(const void *data, size_t size);
+
+  RawKVDataType data_type() const { return data_type_; }
+  size_t key_num() const { return key_num_; }
+  size_t value_num() const { return value_num_; }
+  Key key(size_t index) const { return static_cast<Key>(Entry(index).key); }
+  size_t len(size_t index) const { return static_cast<size_t>(Entry(index).len); }
+  RawKVDataType data_type(size_t index) const { return static_cast<RawKVDataType>(Entry(index).data_type); }
+
+  // Copy the values of all the keys into the float32 buffer, the compressed values are decompressed.
+  bool CopyValues(float *dst, size_t dst_num) const;
+
+ private:
+  RawKVFrameEntry Entry(size_t index) const;
+
+  const uint8_t *entries_{nullptr};
+  const uint8_t *values_{nullptr};
+  RawKVDataType data_type_{RawKVDataType::kFloat32};
+  size_t key_num_{0};
+  size_t value_num_{0};
+};
+}  // namespace ps
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_PS_RAW_KV_FRAME_H_
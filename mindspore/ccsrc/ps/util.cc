@@ -108,16 +108,26 @@ std::map<int64_t, int64_t> Util::AllRankLocalShard(int64_t first_dim, int64_t ra
 
 void Util::ReduceSparseGradient(float *gradients, int *indices, const size_t indices_size, size_t segment_size,
                                 const size_t first_dim_size, const size_t outer_dim_size,
-                                mindspore::kernel::SparseGradient<int> *unique_sparse_grad) {
-  size_t slice_segment_size = indices_size * segment_size;
-  std::vector<float> workspace_grad(slice_segment_size);
-  std::vector<int> workspace_indices(indices_size);
-
+                                mindspore::kernel::SparseGradient<int> *unique_sparse_grad,
+                                ReduceSparseGradientWorkspace *workspace) {
   MS_EXCEPTION_IF_NULL(gradients);
   MS_EXCEPTION_IF_NULL(indices);
+  MS_EXCEPTION_IF_NULL(workspace);
+  size_t slice_segment_size = indices_size * segment_size;
+  size_t radix_workspace_size = mindspore::kernel::RadixUnique<int, int>::WorkspaceSize(indices_size);
+  if (workspace->grad_.size() < slice_segment_size) {
+    workspace->grad_.resize(slice_segment_size);
+  }
+  if (workspace->first_pos_.size() < indices_size) {
+    workspace->first_pos_.resize(indices_size);
+    workspace->inverse_indices_.resize(indices_size);
+  }
+  if (workspace->radix_unique_.size() < radix_workspace_size) {
+    workspace->radix_unique_.resize(radix_workspace_size);
+  }
 
   mindspore::kernel::SparseGradient<int> workspace_sparse_grad(
-    {workspace_grad.data(), workspace_indices.data(), indices_size});
+    {workspace->grad_.data(), workspace->first_pos_.data(), indices_size});
   mindspore::kernel::SparseGradient<int> input_sparse_grad({gradients, indices, indices_size});
   mindspore::kernel::ReduceSparseGradientParam<int> param;
   param.input_grad_ = &input_sparse_grad;
@@ -125,6 +135,9 @@ void Util::ReduceSparseGradient(float *gradients, int *indices, const size_t ind
   param.output_grad_ = unique_sparse_grad;
   param.max_index_ = first_dim_size;
   param.value_stride_ = outer_dim_size;
+  param.inverse_indices_ = workspace->inverse_indices_.data();
+  param.radix_workspace_ = workspace->radix_unique_.data();
+  param.radix_workspace_size_ = workspace->radix_unique_.size();
 
   mindspore::kernel::SparseOptimizerCpuKernelMod::BucketReduceSparseGradient(param);
 }
@@ -40,6 +40,14 @@ struct ParamInitInfo {
   float init_val_{0};
 };
 
+// The buffers ReduceSparseGradient reuses across calls, they only grow.
+struct ReduceSparseGradientWorkspace {
+  std::vector<float> grad_;
+  std::vector<int> first_pos_;
+  std::vector<int> inverse_indices_;
+  std::vector<uint8_t> radix_unique_;
+};
+
 constexpr size_t kNodeInputWeightNameOffset = 1;
 constexpr size_t kNodeInputWeightIndexOffset = 2;
 
@@ -55,7 +63,8 @@ class Util {
   static std::map<int64_t, int64_t> AllRankLocalShard(int64_t first_dim, int64_t rank_id, int64_t server_num);
   static void ReduceSparseGradient(float *gradients, int *indices, const size_t indices_size, size_t segment_size,
                                    const size_t first_dim_size, const size_t outer_dim_size,
-                                   mindspore::kernel::SparseGradient<int> *unique_sparse_grad);
+                                   mindspore::kernel::SparseGradient<int> *unique_sparse_grad,
+                                   ReduceSparseGradientWorkspace *workspace);
   static bool FuseServerCommOps(const pipeline::ResourcePtr &res);
   static WeightPtr MakeWeightPtr(const std::shared_ptr<std::vector<float>> &data, bool enable_recovery,
                                  const std::shared_ptr<std::vector<int>> &shape = nullptr);
@@ -83,6 +83,25 @@ void Worker::Push(const std::vector<size_t> &keys, std::vector<uintptr_t> addrs,
     indice_index = 1;
   }
 
+  if (!is_sparse && embedding_table_ranges_.count(key) == 0) {
+    auto compressor = GetGradientCompressor(key);
+    if (compressor != nullptr) {
+      while (running_ && (!IsReadyForPush(keys[0]))) {
+        continue;
+      }
+      PushCompressedData(keys, addrs, sizes, compressor);
+      return;
+    }
+  }
+
+  if (raw_kv_frame_enabled_ && !is_sparse && embedding_table_ranges_.count(key) == 0) {
+    while (running_ && (!IsReadyForPush(keys[0]))) {
+      continue;
+    }
+    PushRawData(keys, addrs, sizes);
+    return;
+  }
+
   size_t total_size = std::accumulate(sizes.begin(), sizes.end(), 0, std::plus<int64_t>());
   std::vector<float> total_buffer(total_size, 0);
   size_t offset = 0;
@@ -125,10 +144,14 @@ void Worker::Push(const std::vector<size_t> &keys, std::vector<uintptr_t> addrs,
 
 void Worker::Pull(const size_t key, void *dev_addr, const size_t size) {
   MS_EXCEPTION_IF_NULL(dev_addr);
-  std::vector<float> variables(size / sizeof(float), 0);
   while (running_ && (!IsReadyForPull(key))) {
     continue;
   }
+  if (raw_kv_frame_enabled_ && embedding_table_ranges_.count(key) == 0) {
+    PullRawData(key, dev_addr, size);
+    return;
+  }
+  std::vector<float> variables(size / sizeof(float), 0);
   PullData({key}, &variables, nullptr, kPullCmd);
   MS_LOG(DEBUG) << "The variables:" << variables << " the size is:" << size;
   size_t dst_size = size;
@@ -408,6 +431,9 @@ void Worker::Finalize() {
 }
 
 void Worker::Initialize() {
+  raw_kv_frame_enabled_ = GetRawKVFrameDataType(&raw_kv_frame_data_type_);
+  MS_LOG(INFO) << "The raw kv frame is enabled: " << raw_kv_frame_enabled_
+               << ", data type: " << static_cast<int>(raw_kv_frame_data_type_);
   lookup_partitioner_ = [this](auto &&send, auto &&partition, auto &&attrs) {
     LookupIdPartitioner(send, partition, attrs);
   };
@@ -666,6 +692,140 @@ void Worker::PullData(const std::vector<Key> &keys, std::vector<float> *const va
   }
 }
 
+void Worker::PushRawData(const std::vector<Key> &keys, const std::vector<uintptr_t> &addrs,
+                         const ShapeVector &sizes) {
+  if (keys.size() != addrs.size() || keys.size() != sizes.size()) {
+    MS_LOG(EXCEPTION) << "The key size " << keys.size() << ", address size " << addrs.size() << " and size number "
+                      << sizes.size() << " are not equal.";
+  }
+  // Only the gradient is compressed, and the other optimizer inputs such as the learning rate and the momentum are
+  // sent in float32, because they are used by the optimizer as they are instead of being accumulated.
+  size_t grad_index = keys.size();
+  if (raw_kv_frame_data_type_ != RawKVDataType::kFloat32) {
+    grad_index = GetGradIndex(keys);
+  }
+  // The keys are partitioned to the servers as the round robin partitioner does.
+  std::vector<RawKVFrameBuilder> frames(LongToSize(server_num_), RawKVFrameBuilder(RawKVDataType::kFloat32));
+  for (size_t i = 0; i < keys.size(); i++) {
+    size_t server_id = LongToSize(key_to_server_id_[keys[i]]);
+    frames.at(server_id).Add(keys[i], reinterpret_cast<const float *>(addrs[i]), LongToSize(sizes[i]),
+                             i == grad_index ? raw_kv_frame_data_type_ : RawKVDataType::kFloat32);
+  }
+  std::vector<uint32_t> rank_ids;
+  std::vector<std::string> data_strs;
+  for (size_t i = 0; i < frames.size(); i++) {
+    if (!frames[i].empty()) {
+      rank_ids.push_back(SizeToUint(i));
+      data_strs.emplace_back(frames[i].Build());
+    }
+  }
+  worker_node_.Send(core::NodeRole::SERVER, rank_ids, data_strs, kPushRawCmd);
+}
+
+void Worker::PullRawData(const Key &key, void *dev_addr, size_t size) {
+  MS_EXCEPTION_IF_NULL(dev_addr);
+  // The weight is pulled in float32 even if the gradient is pushed in float16 or bfloat16, so the worker trains on the
+  // exact weight of the server.
+  RawKVFrameBuilder request(RawKVDataType::kFloat32);
+  request.Add(key, nullptr, 0);
+  const std::string &request_data = request.Build();
+  VectorPtr resp = nullptr;
+  uint32_t server_id = SizeToUint(LongToSize(key_to_server_id_[key]));
+  if (!worker_node_.Send(core::NodeRole::SERVER, server_id, request_data.data(), request_data.size(), kPullRawCmd,
+                         &resp) ||
+      resp == nullptr) {
+    MS_LOG(EXCEPTION) << "Failed to pull the weight of key " << key << " from server " << server_id;
+  }
+
+  RawKVFrameReader reader;
+  if (!reader.Parse(resp->data(), resp->size()) || reader.value_num() * sizeof(float) != size) {
+    MS_LOG(EXCEPTION) << "Invalid raw kv frame of pull response for key " << key << ", the expected size: " << size;
+  }
+  if (!reader.CopyValues(reinterpret_cast<float *>(dev_addr), size / sizeof(float))) {
+    MS_LOG(EXCEPTION) << "Failed to copy the weight of key " << key;
+  }
+}
+
+std::shared_ptr<GradientCompressor> Worker::GetGradientCompressor(const Key &key) {
+  std::lock_guard<std::mutex> lock(compressor_mutex_);
+  auto iter = key_to_compressor_.find(key);
+  if (iter != key_to_compressor_.end()) {
+    return iter->second;
+  }
+
+  std::shared_ptr<GradientCompressor> compressor = nullptr;
+  auto param = std::find_if(param_to_key_.begin(), param_to_key_.end(),
+                            [&key](const std::pair<std::string, size_t> &item) { return item.second == key; });
+  if (param != param_to_key_.end()) {
+    const std::string &method = PSContext::instance()->param_gradient_compression(param->first);
+    GradientCompressionConfig config;
+    if (!ParseGradientCompression(method, &config)) {
+      MS_LOG(EXCEPTION) << "Invalid gradient compression " << method << " of parameter " << param->first;
+    }
+    if (config.type != GradientCompressionType::kNone) {
+      MS_LOG(INFO) << "The gradient of parameter " << param->first << " is compressed by " << method;
+      compressor = std::make_shared<GradientCompressor>(config, static_cast<uint32_t>(key + worker_node_.rank_id()));
+    }
+  }
+  key_to_compressor_[key] = compressor;
+  return compressor;
+}
+
+size_t Worker::GetGradIndex(const std::vector<Key> &keys) {
+  if (keys.empty()) {
+    MS_LOG(EXCEPTION) << "The keys of the optimizer inputs are empty.";
+  }
+  Key key = keys[0];
+  const std::string &optim_name = Util::optimizer_name(key_to_optimId_[key]);
+  auto send_index = kOptimToPSSendIdx.find(optim_name);
+  if (send_index == kOptimToPSSendIdx.end() || send_index->second.count("grad") == 0 ||
+      send_index->second.at("grad") >= keys.size()) {
+    MS_LOG(EXCEPTION) << "Can not find the gradient index of optimizer " << optim_name << " for key " << key;
+  }
+  return send_index->second.at("grad");
+}
+
+void Worker::PushCompressedData(const std::vector<Key> &keys, const std::vector<uintptr_t> &addrs,
+                                const ShapeVector &sizes, const std::shared_ptr<GradientCompressor> &compressor) {
+  MS_EXCEPTION_IF_NULL(compressor);
+  if (keys.size() != addrs.size() || keys.size() != sizes.size()) {
+    MS_LOG(EXCEPTION) << "The key size " << keys.size() << ", address size " << addrs.size() << " and size number "
+                      << sizes.size() << " are not equal.";
+  }
+  Key key = keys[0];
+  size_t grad_index = GetGradIndex(keys);
+
+  // The gradient entry of the frame has no values, which are compressed after the frame.
+  RawKVFrameBuilder frame(RawKVDataType::kFloat32);
+  for (size_t i = 0; i < keys.size(); i++) {
+    if (i == grad_index) {
+      frame.Add(keys[i], nullptr, 0);
+    } else {
+      frame.Add(keys[i], reinterpret_cast<const float *>(addrs[i]), LongToSize(sizes[i]));
+    }
+  }
+  const std::string &grad_data =
+    compressor->Compress(reinterpret_cast<const float *>(addrs[grad_index]), LongToSize(sizes[grad_index]));
+
+  CompressedPushHeader header{frame.FrameSize(), grad_index};
+  std::string data;
+  data.resize(sizeof(header) + header.frame_size + grad_data.size());
+  auto ret = memcpy_s(&data[0], data.size(), &header, sizeof(header));
+  if (ret != 0) {
+    MS_LOG(EXCEPTION) << "memcpy_s error, errorno(" << ret << ")";
+  }
+  frame.BuildTo(&data[sizeof(header)], header.frame_size);
+  ret = memcpy_s(&data[sizeof(header) + header.frame_size], grad_data.size(), grad_data.data(), grad_data.size());
+  if (ret != 0) {
+    MS_LOG(EXCEPTION) << "memcpy_s error, errorno(" << ret << ")";
+  }
+
+  uint32_t server_id = SizeToUint(LongToSize(key_to_server_id_[key]));
+  if (!worker_node_.Send(core::NodeRole::SERVER, server_id, data, kPushCompressedCmd)) {
+    MS_LOG(ERROR) << "Failed to push the compressed gradient of key " << key << " to server " << server_id;
+  }
+}
+
 void Worker::LookupIdPartitioner(const EmbeddingTableLookup &send, PartitionEmbeddingMessages *partition,
                                  const std::map<int64_t, int64_t> &) {
   MS_EXCEPTION_IF_NULL(partition);
@@ -782,8 +942,11 @@ void Worker::SparsePartitioner(const KVMessage &send, PartitionKVMessages *parti
       std::vector<float> new_grad(partition_segment_size);
       std::vector<int> new_indices(indices_size);
       mindspore::kernel::SparseGradient<int> unique_sparse_grad({new_grad.data(), new_indices.data(), indices_size});
-      Util::ReduceSparseGradient(src_grad_data.data(), src_indice_data.data(), indices_size, segment_size,
-                                 first_dim_size, outer_dim_size, &unique_sparse_grad);
+      {
+        std::lock_guard<std::mutex> lock(reduce_workspace_mutex_);
+        Util::ReduceSparseGradient(src_grad_data.data(), src_indice_data.data(), indices_size, segment_size,
+                                   first_dim_size, outer_dim_size, &unique_sparse_grad, &reduce_workspace_);
+      }
 
       // Update the length of reduce sparse gradient and indice
       std::vector<int> reduced_lens = {kvs.len().begin(), kvs.len().end()};
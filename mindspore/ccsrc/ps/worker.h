@@ -37,6 +37,8 @@
 #include "ps/ps_cache/ps_data/ps_data_prefetch.h"
 #include "ps/core/ps_worker_node.h"
 #include "ps/embedding_table_shard_metadata.h"
+#include "ps/raw_kv_frame.h"
+#include "ps/gradient_compressor.h"
 #include "proto/comm.pb.h"
 #include "proto/ps.pb.h"
 #include "ps/ps_context.h"
@@ -81,7 +83,12 @@ class Worker {
   void Finalize();
 
  private:
-  Worker() : server_num_(-1), running_(false), key_cnt_(0) {}
+  Worker()
+      : server_num_(-1),
+        running_(false),
+        key_cnt_(0),
+        raw_kv_frame_enabled_(false),
+        raw_kv_frame_data_type_(RawKVDataType::kFloat32) {}
   ~Worker() = default;
   Worker(const Worker &) = delete;
   Worker &operator=(const Worker &) = delete;
@@ -107,6 +114,18 @@ class Worker {
                       size_t grad_index, size_t indice_index, size_t first_dim_size, size_t outer_dim_size);
   void PullData(const std::vector<Key> &keys, std::vector<float> *const vals, std::vector<int> *lens = nullptr,
                 int cmd = 0, int64_t priority = 0);
+  // Push the dense gradients in the raw kv frames, which are built from the gradient addresses directly. Only the
+  // gradient is in the data type of MS_DEV_PS_RAW_KV_FRAME, the other optimizer inputs are in float32.
+  void PushRawData(const std::vector<Key> &keys, const std::vector<uintptr_t> &addrs, const ShapeVector &sizes);
+  // Pull the dense weight in the raw kv frame, which is copied into the device address directly.
+  void PullRawData(const Key &key, void *dev_addr, size_t size);
+  // Get the index of the gradient in the optimizer inputs of the keys.
+  size_t GetGradIndex(const std::vector<Key> &keys);
+  // Get the gradient compressor of the parameter's key, return nullptr if its gradient is not compressed.
+  std::shared_ptr<GradientCompressor> GetGradientCompressor(const Key &key);
+  // Push the dense gradient compressed by the compressor, and the other optimizer inputs in the raw kv frame.
+  void PushCompressedData(const std::vector<Key> &keys, const std::vector<uintptr_t> &addrs, const ShapeVector &sizes,
+                          const std::shared_ptr<GradientCompressor> &compressor);
 
   void LookupIdPartitioner(const EmbeddingTableLookup &send, PartitionEmbeddingMessages *partition,
                            const std::map<int64_t, int64_t> &attrs);
@@ -147,6 +166,18 @@ class Worker {
   mindspore::HashMap<Key, size_t> embedding_row_cnt_;
 
   mindspore::HashMap<Key, std::shared_ptr<std::vector<EmbeddingTableShardMetadata>>> embedding_table_ranges_;
+
+  // The dense push and pull are sent in the raw kv frames instead of KVMessage if enabled.
+  bool raw_kv_frame_enabled_;
+  RawKVDataType raw_kv_frame_data_type_;
+
+  // The gradient compressors of the keys, which keep the residuals of the keys' gradients.
+  std::mutex compressor_mutex_;
+  std::map<Key, std::shared_ptr<GradientCompressor>> key_to_compressor_;
+
+  // The workspace of reducing the sparse gradients to push, shared by the pushes of all the keys.
+  std::mutex reduce_workspace_mutex_;
+  ReduceSparseGradientWorkspace reduce_workspace_;
 };
 }  // namespace ps
 }  // namespace mindspore
@@ -19,9 +19,8 @@
 #include <memory>
 #include <utility>
 #include <vector>
-#include <map>
-#include <queue>
 #include "common/mem_reuse/mem_reuse.h"
+#include "common/mem_reuse/host_mem_pool.h"
 #include "backend/common/somas/somas.h"
 #include "runtime/device/memory_scheduler.h"
 namespace mindspore {
@@ -71,31 +70,17 @@ class MemoryManager : public MemHandler {
     MS_EXCEPTION_IF_NULL(ptr);
     FreeMemFromMemPool(ptr);
   }
+  // The host memory is allocated from the host memory pool shared by all the memory managers, and not initialized.
   void *MallocHost(size_t mem_size) override {
-    auto &mem_que = cached_host_mem_[mem_size];
-    if (!mem_que.empty()) {
-      auto ret = mem_que.front();
-      mem_que.pop();
-      return ret;
-    }
-    auto block = std::make_shared<std::vector<uint8_t>>();
-    try {
-      block->resize(mem_size, 0);
-      auto ptr = block->data();
-      host_mem_block_map_[ptr] = block;
-      return ptr;
-    } catch (const std::exception &e) {
+    auto ptr = HostMemPool::GetInstance().AllocHostMem(mem_size);
+    if (ptr == nullptr) {
       MS_LOG(EXCEPTION) << "Malloc memory failed: size " << mem_size;
     }
+    return ptr;
   }
   void FreeHost(void *ptr) override {
     MS_EXCEPTION_IF_NULL(ptr);
-    auto iter = host_mem_block_map_.find(ptr);
-    if (iter == host_mem_block_map_.end()) {
-      MS_LOG(ERROR) << "Free ptr not be created from manager!";
-    }
-    auto mem_size = iter->second->size();
-    cached_host_mem_[mem_size].emplace(iter->first);
+    HostMemPool::GetInstance().FreeHostMem(ptr);
   }
   void SwapIn(const void *host_ptr, void *device_ptr, size_t mem_size, void *stream) override {
     MS_LOG(INFO) << "Call default swap in " << host_ptr << "," << device_ptr << "," << mem_size << "," << stream;
@@ -112,8 +97,6 @@ class MemoryManager : public MemHandler {
   virtual uint8_t *MallocStaticMem(size_t size, bool communication_mem, uint32_t graph_id = kInvalidGraphId) = 0;
   virtual uint8_t *MallocDynamicMem(size_t size, bool communication_mem);
   SomasPtr somas_reuse_util_ptr_{nullptr};
-  std::map<size_t, std::queue<void *>> cached_host_mem_;
-  std::map<void *, std::shared_ptr<std::vector<uint8_t>>> host_mem_block_map_;
 };
 }  // namespace device
 }  // namespace mindspore
@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 #include "runtime/device/memory_offload_strategy.h"
+#include <algorithm>
 #include <vector>
 #include <map>
 #include <memory>
@@ -46,6 +47,7 @@ void MemOffloadStrategy::Execute() {
   if (need_swap_) {
     GenEventSpan();
     GenSwapEventSet();
+    GenSwapInStep();
   }
   GenComputeMemEvents();
 }
@@ -145,17 +147,24 @@ void MemOffloadStrategy::GenSwapEventSet() {
   swap_events_.clear();
   // manual offload strategy
   if (!manual_offload_keys_.empty()) {
+    swap_mem_used_.assign(min_mem_used_.begin(), min_mem_used_.end());
     for (const auto &iter : event_span_) {
       auto &event = iter.second.first;
       if (manual_offload_keys_.find(event->key) != manual_offload_keys_.end()) {
         (void)swap_events_.emplace(event);
+        continue;
+      }
+      auto span = iter.second.second;
+      for (size_t i = 1; i < span; ++i) {
+        swap_mem_used_[(event->index + total_step_ - i) % total_step_] += event->mem_size;
       }
     }
     return;
   }
 
   // greedy span filter
-  std::vector<size_t> cur_mem_used(min_mem_used_.begin(), min_mem_used_.end());
+  auto &cur_mem_used = swap_mem_used_;
+  cur_mem_used.assign(min_mem_used_.begin(), min_mem_used_.end());
   for (const auto &iter : event_span_) {
     auto span = iter.second.second;
     auto &event = iter.second.first;
@@ -186,6 +195,43 @@ void MemOffloadStrategy::GenSwapEventSet() {
   }
 }
 
+void MemOffloadStrategy::GenSwapInStep() {
+  swap_in_step_.clear();
+  if (copy_bandwidth_ <= 0 || compute_time_.size() != total_step_ || swap_mem_used_.size() != total_step_) {
+    return;
+  }
+  for (const auto &iter : event_span_) {
+    auto span = iter.second.second;
+    auto &event = iter.second.first;
+    if (swap_events_.find(event) == swap_events_.end()) {
+      continue;
+    }
+    // The swap in can't be earlier than the swap out after the previous step, and the span across the iterations is
+    // not scheduled ahead.
+    auto pre_index = (event->index + total_step_ - span) % total_step_;
+    if (pre_index >= event->index) {
+      continue;
+    }
+    const double copy_time = event->mem_size / copy_bandwidth_;
+    double overlap_time = 0;
+    size_t swap_in_index = event->index;
+    while (swap_in_index > pre_index + 1 && overlap_time < copy_time) {
+      const auto ahead_index = swap_in_index - 1;
+      if (swap_mem_used_[ahead_index] + event->mem_size > mem_size_) {
+        break;
+      }
+      swap_mem_used_[ahead_index] += event->mem_size;
+      overlap_time += compute_time_[ahead_index];
+      swap_in_index = ahead_index;
+    }
+    if (swap_in_index != event->index) {
+      swap_in_step_[event] = swap_in_index;
+    }
+  }
+  MS_LOG(INFO) << "Schedule " << swap_in_step_.size() << " swap in events ahead in " << swap_events_.size()
+               << " swap events, copy bandwidth: " << copy_bandwidth_;
+}
+
 void MemOffloadStrategy::GenComputeMemEvents() {
   pre_compute_events_.clear();
   post_compute_events_.clear();
@@ -229,10 +275,13 @@ void MemOffloadStrategy::GenComputeMemEvents() {
         post_compute_events_[pre_index].emplace_back(free_or_swap_out_event);
         // avoid swap-in-event follow init-event
         if (i != kFirstGetMemEventIndex || first_event->type != kInit) {
-          auto swap_in_event = std::make_shared<MemEvent>(kSwapIn, event->index);
+          const auto &swap_in_step_iter = swap_in_step_.find(event);
+          const auto swap_in_index =
+            (swap_in_step_iter != swap_in_step_.end()) ? swap_in_step_iter->second : event->index;
+          auto swap_in_event = std::make_shared<MemEvent>(kSwapIn, swap_in_index);
           swap_in_event->key = item.first;
           swap_in_event->mem_size = first_event->mem_size;
-          (void)pre_compute_events_[event->index].emplace_back(swap_in_event);
+          (void)pre_compute_events_[swap_in_index].emplace_back(swap_in_event);
         }
       }
       if (event->index < pre_compute_events_.size()) {
@@ -288,5 +337,61 @@ std::set<size_t> MemOffloadStrategy::GetSwapOutEventIndex(const void *key,
   }
   return swap_out_event_index;
 }
+
+MemOffloadSimulateResult MemOffloadSimulator::Simulate(MemOffloadStrategy *const strategy) const {
+  MS_EXCEPTION_IF_NULL(strategy);
+  MemOffloadSimulateResult result;
+  if (copy_bandwidth_ <= 0) {
+    MS_LOG(EXCEPTION) << "The copy bandwidth should be positive, but got " << copy_bandwidth_;
+  }
+  double compute_end_time = 0;
+  double copy_end_time = 0;
+  // The time when the memory is ready in the device, and the time when the memory is copied to the host.
+  std::map<const void *, double> device_ready_time;
+  std::map<const void *, double> host_ready_time;
+  auto copy = [&copy_end_time, this](double issue_time, size_t mem_size) {
+    copy_end_time = std::max(copy_end_time, issue_time) + mem_size / copy_bandwidth_;
+    return copy_end_time;
+  };
+  auto copy_to_device = [&](const void *key, size_t mem_size) {
+    const auto &host_iter = host_ready_time.find(key);
+    const double issue_time = host_iter == host_ready_time.end() ? compute_end_time
+                                                                 : std::max(compute_end_time, host_iter->second);
+    device_ready_time[key] = copy(issue_time, mem_size);
+    result.swap_in_size += mem_size;
+  };
+  for (size_t step = 0; step < compute_time_.size(); ++step) {
+    double ready_time = compute_end_time;
+    for (const auto &event : strategy->GetPreComputeEvents(step)) {
+      MS_EXCEPTION_IF_NULL(event);
+      const bool in_device = device_ready_time.find(event->key) != device_ready_time.end();
+      if (event->type == kMalloc && !in_device) {
+        device_ready_time[event->key] = compute_end_time;
+      } else if ((event->type == kInit || event->type == kSwapIn) && !in_device) {
+        copy_to_device(event->key, event->mem_size);
+      } else if (event->type == kGet) {
+        // The memory which is not in the device is swapped in when the step gets it.
+        if (!in_device) {
+          copy_to_device(event->key, event->mem_size);
+        }
+        ready_time = std::max(ready_time, device_ready_time[event->key]);
+      }
+    }
+    result.stall_time += ready_time - compute_end_time;
+    compute_end_time = ready_time + compute_time_[step];
+    for (const auto &event : strategy->GetPostComputeEvents(step)) {
+      MS_EXCEPTION_IF_NULL(event);
+      if (event->type == kSwapOut) {
+        host_ready_time[event->key] = copy(compute_end_time, event->mem_size);
+        result.swap_out_size += event->mem_size;
+      }
+      if (event->type == kSwapOut || event->type == kFree) {
+        (void)device_ready_time.erase(event->key);
+      }
+    }
+  }
+  result.total_time = compute_end_time;
+  return result;
+}
 }  // namespace device
 }  // namespace mindspore
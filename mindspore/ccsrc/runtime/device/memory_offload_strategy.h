@@ -55,6 +55,10 @@ class MemOffloadStrategy {
 
   void SetComputeTime(const std::vector<double> &compute_time) { compute_time_ = compute_time; }
 
+  // The bandwidth of the copy between host and device in bytes per microsecond, the unit of time is the same as the
+  // compute time. The swap in events are scheduled ahead to overlap with the compute when both are set.
+  void SetCopyBandwidth(double copy_bandwidth) { copy_bandwidth_ = copy_bandwidth; }
+
   std::vector<std::shared_ptr<MemEvent>> &GetPreComputeEvents(size_t step);
 
   std::vector<std::shared_ptr<MemEvent>> &GetPostComputeEvents(size_t step);
@@ -74,6 +78,10 @@ class MemOffloadStrategy {
 
   void GenSwapEventSet();
 
+  // Move the swap in event ahead of the step which gets the memory, until the copy time is covered by the compute time
+  // of the steps between them or the memory is not enough.
+  void GenSwapInStep();
+
   void GenComputeMemEvents();
 
   void GenFreeEvent(const std::shared_ptr<MemEvent> &last_event);
@@ -96,10 +104,42 @@ class MemOffloadStrategy {
   bool need_swap_{false};
   std::multimap<size_t, std::pair<std::shared_ptr<MemEvent>, size_t>> event_span_;
   std::set<std::shared_ptr<MemEvent>> swap_events_;
+  // The memory used of each step after the swap events are chosen.
+  std::vector<size_t> swap_mem_used_;
+  double copy_bandwidth_{0};
+  // The step of the swap in event of the get event which is scheduled ahead.
+  std::map<std::shared_ptr<MemEvent>, size_t> swap_in_step_;
   std::vector<size_t> min_mem_used_;
   size_t mem_used_without_swap_{0};
   size_t min_mem_needed_{0};
 };
+
+struct MemOffloadSimulateResult {
+  // The time from the start of the first step to the end of the last step.
+  double total_time{0};
+  // The time that the compute waits for the copy.
+  double stall_time{0};
+  size_t swap_in_size{0};
+  size_t swap_out_size{0};
+};
+
+// The offline simulator replays the compute events of the offload strategy in one iteration, the kernels run on the
+// compute stream in the compute time of the steps, and the copies between host and device run on one copy stream in
+// the copy bandwidth. The events of the step are issued before the compute of the step, and the step waits for the
+// memory it gets to be copied into the device. It doesn't need any device, so the offload policies can be compared by
+// the stall time in the unit tests.
+class MemOffloadSimulator {
+ public:
+  MemOffloadSimulator(const std::vector<double> &compute_time, double copy_bandwidth)
+      : compute_time_(compute_time), copy_bandwidth_(copy_bandwidth) {}
+  ~MemOffloadSimulator() = default;
+
+  MemOffloadSimulateResult Simulate(MemOffloadStrategy *const strategy) const;
+
+ private:
+  std::vector<double> compute_time_;
+  double copy_bandwidth_;
+};
 }  // namespace device
 }  // namespace mindspore
 #endif  // MINDSPORE_CCSRC_RUNTIME_DEVICE_MEMORY_OFFLOAD_STRATEGY_H_
@@ -16,7 +16,6 @@
 
 #include "runtime/device/memory_scheduler.h"
 #include <algorithm>
-#include <queue>
 #ifdef _MSC_VER
 #include <time.h>
 #else
@@ -134,7 +133,7 @@ bool MemScheduler::PreComputeInit(const std::shared_ptr<MemEvent> &event, void *
     MS_LOG(DEBUG) << "Init input data from host, key: " << event->key;
     auto host_ptr = init_host_ptr_[event->key];
     MS_EXCEPTION_IF_NULL(host_ptr);
-    mem_handler_->SwapIn(host_ptr, device_ptr, event->mem_size, stream);
+    SwapIn(host_ptr, device_ptr, event->mem_size, stream);
   }
   mem_result_[event->key] = device_ptr;
   return true;
@@ -165,7 +164,7 @@ bool MemScheduler::PreComputeSwapIn(const std::shared_ptr<MemEvent> &event, void
     return false;
   }
   MS_EXCEPTION_IF_NULL(host_ptr);
-  mem_handler_->SwapIn(host_ptr, device_ptr, event->mem_size, stream);
+  SwapIn(host_ptr, device_ptr, event->mem_size, stream);
   mem_result_[event->key] = device_ptr;
   if (!from_init) {
     mem_handler_->FreeHost(host_ptr);
@@ -193,7 +192,7 @@ bool MemScheduler::PreComputeGet(const std::shared_ptr<MemEvent> &event, void *s
     return false;
   }
   auto device_ptr = MallocDevice(mem_size, stream);
-  mem_handler_->SwapIn(host_ptr, device_ptr, mem_size, stream);
+  SwapIn(host_ptr, device_ptr, mem_size, stream);
   if (!from_init) {
     swap_host_ptr_.erase(host_ptr);
     mem_handler_->FreeHost(host_ptr);
@@ -351,33 +350,21 @@ void *MemScheduler::MallocDevice(size_t mem_size, void *stream) {
   if (device_ptr != nullptr || !optimized_) {
     return device_ptr;
   }
-  auto iter = mem_result_.begin();
-  using KeySizePair = std::pair<const void *, size_t>;
-  auto less = [](const KeySizePair &a, const KeySizePair &b) -> bool { return a.second < b.second; };
-  std::priority_queue<KeySizePair, std::vector<KeySizePair>, decltype(less)> mem_can_swap(less);
-  while (iter != mem_result_.end()) {
-    const auto key = iter->first;
-    if (no_reuse_key.count(key) != 0) {
-      ++iter;
-      continue;
-    }
-    const auto device_mem_size = GetMemSize(key);
-    mem_can_swap.push({key, device_mem_size});
-    if (device_mem_size >= mem_size) {
-      SwapOutAndFreeDevice(key, iter->second, device_mem_size, stream);
-      device_ptr = mem_handler_->MallocDevice(mem_size);
-      return device_ptr;
+  // Evict the memory whose next use is the furthest in the future firstly (Belady), until the memory alloc succeeds.
+  using KeyStepPair = std::pair<const void *, size_t>;
+  std::vector<KeyStepPair> mem_can_swap;
+  for (const auto &item : mem_result_) {
+    if (no_reuse_key.count(item.first) == 0) {
+      (void)mem_can_swap.emplace_back(item.first, GetNextUseStep(item.first));
     }
-    ++iter;
   }
-  while (!mem_can_swap.empty()) {
-    const auto &max_mem_in_device = mem_can_swap.top();
-    mem_can_swap.pop();
-    const auto key = max_mem_in_device.first;
-    const auto swap_mem_size = max_mem_in_device.second;
+  std::sort(mem_can_swap.begin(), mem_can_swap.end(),
+            [](const KeyStepPair &a, const KeyStepPair &b) { return a.second > b.second; });
+  for (const auto &item : mem_can_swap) {
+    const auto key = item.first;
     auto swap_device_ptr = mem_result_[key];
     MS_EXCEPTION_IF_NULL(swap_device_ptr);
-    SwapOutAndFreeDevice(key, swap_device_ptr, swap_mem_size, stream);
+    SwapOutAndFreeDevice(key, swap_device_ptr, GetMemSize(key), stream);
     device_ptr = mem_handler_->MallocDevice(mem_size);
     if (device_ptr != nullptr) {
       return device_ptr;
@@ -389,7 +376,7 @@ void *MemScheduler::MallocDevice(size_t mem_size, void *stream) {
 void MemScheduler::SwapOutAndFreeDevice(const void *key, void *device_ptr, size_t mem_size, void *stream) {
   auto host_ptr = GetOrMallocHostPtr(key, mem_size);
   MS_EXCEPTION_IF_NULL(host_ptr);
-  mem_handler_->SwapOut(device_ptr, host_ptr, mem_size, stream);
+  SwapOut(device_ptr, host_ptr, mem_size, stream);
   mem_handler_->FreeDevice(device_ptr);
   (void)mem_result_.erase(key);
 }
@@ -402,6 +389,44 @@ size_t MemScheduler::GetMemSize(const void *key) {
   return iter->second[0]->mem_size;
 }
 
+size_t MemScheduler::GetNextUseStep(const void *key) const {
+  const auto &iter = mem_events_.find(key);
+  if (iter == mem_events_.end()) {
+    return SIZE_MAX;
+  }
+  size_t first_use_step = SIZE_MAX;
+  for (const auto &event : iter->second) {
+    MS_EXCEPTION_IF_NULL(event);
+    if (event->type != kGet) {
+      continue;
+    }
+    if (event->index > current_step_) {
+      return event->index;
+    }
+    first_use_step = std::min(first_use_step, event->index);
+  }
+  // The memory is not used in the rest steps, so it is used in the next iteration.
+  return first_use_step == SIZE_MAX ? SIZE_MAX : first_use_step + total_step_;
+}
+
+void MemScheduler::SwapIn(const void *host_ptr, void *device_ptr, size_t mem_size, void *stream) {
+  const auto start_time = stream == nullptr ? GetCurrentTime() : 0;
+  mem_handler_->SwapIn(host_ptr, device_ptr, mem_size, stream);
+  if (stream == nullptr) {
+    sync_copy_time_ += GetCurrentTime() - start_time;
+    sync_copy_size_ += mem_size;
+  }
+}
+
+void MemScheduler::SwapOut(const void *device_ptr, void *host_ptr, size_t mem_size, void *stream) {
+  const auto start_time = stream == nullptr ? GetCurrentTime() : 0;
+  mem_handler_->SwapOut(device_ptr, host_ptr, mem_size, stream);
+  if (stream == nullptr) {
+    sync_copy_time_ += GetCurrentTime() - start_time;
+    sync_copy_size_ += mem_size;
+  }
+}
+
 void *MemScheduler::GetOrMallocHostPtr(const void *key, size_t mem_size) {
   void *host_ptr = nullptr;
   bool from_init = false;
@@ -447,6 +472,11 @@ void MemScheduler::Update() {
   }
 
   strategy_->SetComputeTime(compute_time_);
+  // The copy bandwidth is estimated by the synchronous copies in the mock, and the swap in events are not scheduled
+  // ahead without the estimation.
+  if (sync_copy_time_ > 0) {
+    strategy_->SetCopyBandwidth(sync_copy_size_ / sync_copy_time_);
+  }
   strategy_->Execute();
   updated_ = true;
 }
@@ -101,6 +101,14 @@ class MemScheduler {
 
   size_t GetMemSize(const void *key);
 
+  // The step of the next get event of the memory after the current step, which may be in the next iteration.
+  size_t GetNextUseStep(const void *key) const;
+
+  // The copies without the stream are synchronous, and they are timed to estimate the copy bandwidth.
+  void SwapIn(const void *host_ptr, void *device_ptr, size_t mem_size, void *stream);
+
+  void SwapOut(const void *device_ptr, void *host_ptr, size_t mem_size, void *stream);
+
   void *GetOrMallocHostPtr(const void *key, size_t mem_size);
 
   void GetHostPtr(const void *key, void **host_ptr, bool *from_init);
@@ -129,6 +137,8 @@ class MemScheduler {
   double compute_start_time_{0};
   std::vector<double> compute_time_;
   bool record_compute_time_{false};
+  size_t sync_copy_size_{0};
+  double sync_copy_time_{0};
   bool updated_{false};
   std::shared_ptr<MemHandler> mem_handler_{nullptr};
   std::shared_ptr<MemOffloadStrategy> strategy_{nullptr};
@@ -104,19 +104,23 @@ void AbstractActor::SendOutput(OpContext<DeviceTensor> *const context) {
       (type_ < KernelTransformType::kSwitchActor)) {
     SET_OPCONTEXT_FAIL_RET_WITH_ERROR((*context), "The size of output data arrows is not equal to the output data.");
   }
+  if (!output_actors_fetched_) {
+    FetchOutputActors();
+  }
   size_t output_data_arrow_index = 0;
   for (auto &output_data : output_data_) {
     MS_EXCEPTION_IF_NULL(output_data);
     UpdateOutputData(output_data.get(), output_data_arrows_[output_data_arrow_index],
                      output_data_nodes_[output_data_arrow_index], context);
+    auto to_actor = output_data_actors_[output_data_arrow_index];
     if (output_data->op_id_.Name().find(kStackActorNameSuffix) != std::string::npos) {
       // Create a new op data for stack actor.
       auto to_stack_data =
         std::make_shared<OpData<DeviceTensor>>(output_data->op_id_, output_data->data_, output_data->index_);
       to_stack_data_.emplace_back(to_stack_data);
-      ActorDispatcher::Send(output_data->op_id_, &OpActor::RunOpData, to_stack_data.get(), context);
+      ActorDispatcher::Send(to_actor, &OpActor::RunOpData, to_stack_data.get(), context);
     } else {
-      ActorDispatcher::Send(output_data->op_id_, &OpActor::RunOpData, output_data.get(), context);
+      ActorDispatcher::Send(to_actor, &OpActor::RunOpData, output_data.get(), context);
     }
     ++output_data_arrow_index;
   }
@@ -124,8 +128,8 @@ void AbstractActor::SendOutput(OpContext<DeviceTensor> *const context) {
   // 2.Send output control.
   if (output_control_arrows_.size() > 0) {
     auto from_aid = const_cast<AID *>(&GetAID());
-    for (auto &output_control : output_control_arrows_) {
-      ActorDispatcher::Send(output_control, &OpActor::RunOpControl, from_aid, context);
+    for (auto to_actor : output_control_actors_) {
+      ActorDispatcher::Send(to_actor, &OpActor::RunOpControl, from_aid, context);
     }
   }
 
@@ -138,5 +142,35 @@ void AbstractActor::SendOutput(OpContext<DeviceTensor> *const context) {
     SET_OPCONTEXT_SUCCESS_RET((*context));
   }
 }
+
+void AbstractActor::FetchOutputActors() {
+  auto actor_manager = ActorMgr::GetActorMgrRef();
+  MS_EXCEPTION_IF_NULL(actor_manager);
+  output_data_actors_.clear();
+  for (auto &output_data : output_data_) {
+    MS_EXCEPTION_IF_NULL(output_data);
+    auto to_actor = actor_manager->GetActor(output_data->op_id_);
+    if (to_actor == nullptr) {
+      MS_LOG(EXCEPTION) << "Can't find the output actor: " << output_data->op_id_.Name() << " of " << GetAID().Name();
+    }
+    (void)output_data_actors_.emplace_back(to_actor.get());
+  }
+
+  output_control_actors_.clear();
+  for (auto &output_control : output_control_arrows_) {
+    auto to_actor = actor_manager->GetActor(output_control);
+    if (to_actor == nullptr) {
+      MS_LOG(EXCEPTION) << "Can't find the output actor: " << output_control.Name() << " of " << GetAID().Name();
+    }
+    (void)output_control_actors_.emplace_back(to_actor.get());
+  }
+  output_actors_fetched_ = true;
+}
+
+void AbstractActor::ResetOutputActors() {
+  output_data_actors_.clear();
+  output_control_actors_.clear();
+  output_actors_fetched_ = false;
+}
 }  // namespace runtime
 }  // namespace mindspore
@@ -42,7 +42,8 @@ class AbstractActor : public OpActor<DeviceTensor> {
         recorder_aid_(recorder_aid),
         input_datas_num_(0),
         input_controls_num_(0),
-        running_dependent_msg_num_(0) {}
+        running_dependent_msg_num_(0),
+        output_actors_fetched_(false) {}
   virtual ~AbstractActor() = default;
 
   bool IsActive(int msg_num) override { return msg_num >= running_dependent_msg_num_ ? true : false; }
@@ -84,6 +85,11 @@ class AbstractActor : public OpActor<DeviceTensor> {
   virtual void SendOutput(OpContext<DeviceTensor> *const context);
   // Send recorder info to recorder actor.
   virtual void SendRecorderInfo(OpContext<DeviceTensor> *const context) const {}
+  // Resolve the output actors by the output data and output control arrows.
+  void FetchOutputActors();
+  // Drop the resolved output actors when the output arrows or output data change, they are resolved again at the next
+  // sending.
+  void ResetOutputActors();
 
   KernelTransformType type_;
 
@@ -101,6 +107,10 @@ class AbstractActor : public OpActor<DeviceTensor> {
   // the channel. In order to prevent old data from being overwritten, it is necessary to allocate a new op data,
   // and these op data will be uniformly cleared by the scheduler after the step ends.
   std::vector<OpDataPtr<DeviceTensor>> to_stack_data_;
+  // The output actors corresponding to the output_data_ and output_control_arrows_ one by one, which are resolved at
+  // the first sending and skip the name lookup of actor manager in the later sending.
+  std::vector<ActorBase *> output_data_actors_;
+  std::vector<ActorBase *> output_control_actors_;
 
   // The dependent device tensor stores, the dependent expression is pair<index, AnfNode>.
   // Index is the input position, AnfNode is the key of the device tensor store.
@@ -117,6 +127,9 @@ class AbstractActor : public OpActor<DeviceTensor> {
 
   // The dependent messages number of actor running.
   int running_dependent_msg_num_;
+
+  // Whether output_data_actors_ and output_control_actors_ are resolved from the current output arrows.
+  bool output_actors_fetched_;
 };
 
 using AbstractActorPtr = std::shared_ptr<AbstractActor>;
@@ -20,7 +20,7 @@
 
 namespace mindspore {
 namespace runtime {
-bool ActorDispatcher::is_multi_thread_execution_ = true;
+thread_local bool ActorDispatcher::is_multi_thread_execution_ = true;
 
 void ComputeThreadNums(size_t *actor_thread_num, size_t *actor_and_kernel_thread_num) {
   MS_EXCEPTION_IF_NULL(actor_thread_num);
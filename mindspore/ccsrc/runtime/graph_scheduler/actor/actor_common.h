@@ -56,6 +56,8 @@ enum class KernelTransformType {
   kCustomActor,
   // Super kernel actor represents the sink executing of graph which is the combination of kernels.
   kSuperKernelActor,
+  // Fusion actor represents the linear chain of kernel actors which are launched back to back in one actor.
+  kFusionActor,
   kCopyActor,
   kLoopCountActor,
   kOutputActor,
@@ -149,6 +151,19 @@ class ActorDispatcher {
     }
   }
 
+  // Send to the actor resolved by ActorMgr::GetActor in advance, which skips the name lookup of actor manager.
+  template <typename T, typename... Args0, typename... Args1>
+  static void Send(ActorBase *to_actor, void (T::*method)(Args0...), Args1 &&... args) {
+    MS_EXCEPTION_IF_NULL(to_actor);
+    if (is_multi_thread_execution_) {
+      Async(to_actor, method, std::forward<Args1>(args)...);
+    } else {
+      // The single thread execution doesn't need to switch threads and calls function directly.
+      T *actor = static_cast<T *>(to_actor);
+      (actor->*method)(std::forward<Args1>(args)...);
+    }
+  }
+
   static void is_multi_thread_execution(bool is_multi_thread_execution) {
     is_multi_thread_execution_ = is_multi_thread_execution;
   }
@@ -170,8 +185,9 @@ class ActorDispatcher {
 
   // Decide whether use the multi thread to execute actors.
   // There are scenarios with small network and data, and the performance of multi thread execution is not as good as
-  // that of single thread, so single thread execution is required at this time.
-  static bool is_multi_thread_execution_;
+  // that of single thread, so single thread execution is required at this time. It is thread local, because the actor
+  // sets may run concurrently in the different threads, and the single thread execution only runs in the caller thread.
+  static thread_local bool is_multi_thread_execution_;
 };
 
 void ComputeThreadNums(size_t *actor_thread_num, size_t *actor_and_kernel_thread_num);
@@ -188,6 +188,18 @@ void DumpSuperKernelActor(const SuperKernelActor *actor, std::ofstream &ofs) {
   ofs << "\n";
 }
 
+void DumpFusionActor(const FusionActor *actor, std::ofstream &ofs) {
+  MS_EXCEPTION_IF_NULL(actor);
+  ofs << "\tactor_name:" << actor->GetAID().Name() << "\tkernel_actors_num:" << actor->kernel_actors().size() << "\n";
+  for (const auto &kernel_actor : actor->kernel_actors()) {
+    MS_EXCEPTION_IF_NULL(kernel_actor);
+    ofs << "\t\tkernel_actor_name:" << kernel_actor->GetAID().Name() << "\n";
+  }
+
+  DumpAbstractActor(actor, ofs);
+  ofs << "\n";
+}
+
 void DumpCopyActor(const CopyActor *actor, std::ofstream &ofs) {
   MS_EXCEPTION_IF_NULL(actor);
   ofs << "\tactor_name:" << actor->GetAID().Name() << "\n";
@@ -495,6 +507,13 @@ void DumpSuperKernelActors(const std::vector<SuperKernelActorPtr> &actors, std::
   }
 }
 
+void DumpFusionActors(const std::vector<FusionActorPtr> &actors, std::ofstream &ofs) {
+  ofs << "\n\n[Fusion actors:" << actors.size() << "]\n";
+  for (const auto &fusion_actor : actors) {
+    DumpFusionActor(fusion_actor.get(), ofs);
+  }
+}
+
 void DumpNoInputKernelActors(const std::vector<AbstractActorPtr> &actors, std::ofstream &ofs) {
   ofs << "\n\n[No input kernel actors:" << actors.size() << "]\n";
   for (const auto &actor : actors) {
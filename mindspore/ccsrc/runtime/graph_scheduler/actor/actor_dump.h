@@ -28,6 +28,7 @@
 #include "runtime/graph_scheduler/actor/loop_count_actor.h"
 #include "runtime/graph_scheduler/actor/kernel_actor.h"
 #include "runtime/graph_scheduler/actor/super_kernel_actor.h"
+#include "runtime/graph_scheduler/actor/fusion_actor.h"
 #include "runtime/graph_scheduler/actor/output_actor.h"
 #include "runtime/graph_scheduler/actor/copy_actor.h"
 #include "runtime/graph_scheduler/actor/custom_actor.h"
@@ -47,6 +48,7 @@ void DumpOutputActor(const OutputActorPtr &actor, std::ofstream &ofs);
 void DumpDSActors(const std::vector<DataSourceActorPtr> &actors, std::ofstream &ofs);
 void DumpKernelActors(const std::vector<KernelActorPtr> &actors, std::ofstream &ofs);
 void DumpSuperKernelActors(const std::vector<SuperKernelActorPtr> &actors, std::ofstream &ofs);
+void DumpFusionActors(const std::vector<FusionActorPtr> &actors, std::ofstream &ofs);
 void DumpNoInputKernelActors(const std::vector<AbstractActorPtr> &actors, std::ofstream &ofs);
 void DumpCopyActors(const std::vector<CopyActorPtr> &actors, std::ofstream &ofs);
 void DumpControlActors(const ControlActorSetPtr &control_actor_set, std::ofstream &ofs);
@@ -33,6 +33,7 @@
 #include "runtime/graph_scheduler/actor/rpc/send_actor.h"
 #include "runtime/graph_scheduler/actor/rpc/recv_actor.h"
 #include "runtime/graph_scheduler/actor/super_kernel_actor.h"
+#include "runtime/graph_scheduler/actor/fusion_actor.h"
 #include "runtime/graph_scheduler/actor/output_actor.h"
 #include "runtime/graph_scheduler/actor/copy_actor.h"
 #include "runtime/graph_scheduler/actor/control_flow/switch_actor.h"
@@ -80,6 +81,7 @@ using RpcActorSetPtr = std::shared_ptr<RpcActorSet>;
 // The data source actor is used to obtain data and process them into device tensors, and send them to kernel actor.
 // The kernel actor is used to receive the device tensors to luanch kernel.
 // The Super kernel actor is used to represent the sink executing of graph which is the combination of kernels.
+// The fusion actor is used to launch the linear chain of kernel actors back to back in one actor.
 // The no input kernel actor means that this actor has no input arrow and needs to be triggered externally.
 // The copy actor is used to convert the device tensor between the different device kernel.
 // The loop count actor is used to receive the control of tail kernel actor to represent the end of one step
@@ -92,6 +94,7 @@ struct ActorSet {
   std::vector<KernelActorPtr> kernel_actors_;
   std::vector<CustomActorPtr> custom_actors_;
   std::vector<SuperKernelActorPtr> super_kernel_actors_;
+  std::vector<FusionActorPtr> fusion_actors_;
   // No input kernel actors need be triggered specifically.
   std::vector<AbstractActorPtr> no_input_kernel_actors_;
   std::vector<CopyActorPtr> copy_actors_;
@@ -29,6 +29,7 @@ ControlActor::ControlActor(const std::string &name, KernelTransformType type, co
 }
 
 void ControlActor::Init() {
+  ResetOutputActors();
   output_data_by_output_index_.resize(formal_parameters_.size());
   for (auto &data_arrow : output_data_arrows_) {
     MS_EXCEPTION_IF_NULL(data_arrow);
@@ -34,6 +34,7 @@ SwitchActor::SwitchActor(const std::string &name, const AID &memory_manager_aid,
 
 void SwitchActor::Init() {
   // Init output data.
+  ResetOutputActors();
   for (const auto &data_arrow : output_data_arrows_) {
     if (data_arrow->from_output_index_ != 0) {
       MS_LOG(EXCEPTION) << "Invalid from index:" << data_arrow->from_output_index_ << " for actor:" << GetAID().Name();
@@ -35,6 +35,7 @@ void CopyActor::Init() {
   output_device_tensor_.resize(kDeviceTensorNum);
 
   // Init output data.
+  ResetOutputActors();
   for (auto &data_arrow : output_data_arrows_) {
     MS_EXCEPTION_IF_NULL(data_arrow);
     if (IntToSize(data_arrow->from_output_index_) != 0) {
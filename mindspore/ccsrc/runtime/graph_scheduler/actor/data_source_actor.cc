@@ -32,6 +32,7 @@ void DataSourceActor::Init() {
   }
 
   // Init output data.
+  ResetOutputActors();
   for (auto &data_arrow : output_data_arrows_) {
     MS_EXCEPTION_IF_NULL(data_arrow);
     auto data = std::make_unique<OpData<DeviceTensor>>(data_arrow->to_op_id_, nullptr, data_arrow->to_input_index_);
@@ -85,6 +86,7 @@ void DeviceQueueDataSourceActor::Init() {
   }
 
   // Init output data.
+  ResetOutputActors();
   for (auto &data_arrow : output_data_arrows_) {
     MS_EXCEPTION_IF_NULL(data_arrow);
     auto data = std::make_unique<OpData<DeviceTensor>>(data_arrow->to_op_id_, nullptr, data_arrow->to_input_index_);
@@ -0,0 +1,163 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "runtime/graph_scheduler/actor/fusion_actor.h"
+#include <algorithm>
+#include "runtime/graph_scheduler/actor/memory_manager_actor.h"
+#include "mindrt/include/async/async.h"
+#include "utils/log_adapter.h"
+
+namespace mindspore {
+namespace runtime {
+void FusionActor::Init() {
+  // Check device contexts number.
+  if (device_contexts_.size() != device::kDeviceContextsNumOne) {
+    MS_LOG(EXCEPTION) << "The device contexts number is wrong.";
+  }
+  if (kernel_actors_.empty()) {
+    MS_LOG(EXCEPTION) << "The kernel actors of " << GetAID().Name() << " are empty.";
+  }
+
+  // Set the number of actor running dependent messages.
+  running_dependent_msg_num_ = SizeToInt(input_datas_num_ + input_controls_num_);
+
+  // The kernel actors of chain are not spawned, so need init them here.
+  size_t memory_alloc_num = 0;
+  size_t memory_free_num = 0;
+  for (auto &kernel_actor : kernel_actors_) {
+    MS_EXCEPTION_IF_NULL(kernel_actor);
+    kernel_actor->Init();
+    memory_alloc_num += kernel_actor->memory_alloc_list_.size();
+    memory_free_num += kernel_actor->memory_free_list_.size();
+  }
+  memory_alloc_list_.resize(memory_alloc_num);
+  memory_free_list_.resize(memory_free_num);
+
+  // The output data arrows of fusion actor are shared with the tail kernel actor, so take over the output data of tail
+  // kernel actor, which are still refreshed by the tail kernel actor when the output device tensors change.
+  auto &tail_kernel_actor = kernel_actors_.back();
+  if (tail_kernel_actor->output_data_.size() != output_data_arrows_.size()) {
+    MS_LOG(EXCEPTION) << "The output data num of " << tail_kernel_actor->GetAID().Name()
+                      << " is not equal to the output data arrows num of " << GetAID().Name();
+  }
+  output_data_.swap(tail_kernel_actor->output_data_);
+  ResetOutputActors();
+}
+
+void FusionActor::Run(OpContext<DeviceTensor> *const context) {
+  MS_EXCEPTION_IF_NULL(context);
+  size_t memory_alloc_index = 0;
+  for (auto &kernel_actor : kernel_actors_) {
+    kernel_actor->FetchOutputDeviceTensor(context);
+    const auto &memory_alloc_list = kernel_actor->memory_alloc_list_;
+    (void)std::copy(memory_alloc_list.begin(), memory_alloc_list.end(),
+                    memory_alloc_list_.begin() + SizeToLong(memory_alloc_index));
+    memory_alloc_index += memory_alloc_list.size();
+  }
+
+  if (memory_alloc_list_.size() > 0) {
+    SendMemoryAllocReq(context);
+  } else {
+    OnMemoryAllocFinish(context);
+  }
+}
+
+void FusionActor::SendMemoryAllocReq(OpContext<DeviceTensor> *const context) {
+  running_dependent_msg_num_ = 1;
+  ActorDispatcher::Send(memory_manager_aid_, &MemoryManagerActor::AllocateMemory, &memory_alloc_list_,
+                        device_contexts_[0], context, GetAID());
+}
+
+void FusionActor::SendMemoryFreeReq(OpContext<DeviceTensor> *const context) {
+  MS_EXCEPTION_IF_NULL(device_contexts_[0]);
+  size_t memory_free_index = 0;
+  for (auto &kernel_actor : kernel_actors_) {
+    const auto &memory_free_list = kernel_actor->memory_free_list_;
+    (void)std::copy(memory_free_list.begin(), memory_free_list.end(),
+                    memory_free_list_.begin() + SizeToLong(memory_free_index));
+    memory_free_index += memory_free_list.size();
+  }
+  if (memory_free_list_.size() > 0) {
+    ActorDispatcher::Send(memory_manager_aid_, &MemoryManagerActor::FreeMemory, &memory_free_list_, device_contexts_[0],
+                          context, GetAID());
+  }
+
+  // Free the address that is the temp store for kernel input copy.
+  for (auto &kernel_actor : kernel_actors_) {
+    for (auto &copy_input_device_tensor : kernel_actor->copy_input_device_tensors_) {
+      if ((copy_input_device_tensor != nullptr) && (copy_input_device_tensor->GetPtr() != nullptr)) {
+        device_contexts_[0]->FreeMemory(copy_input_device_tensor.get());
+      }
+    }
+  }
+}
+
+void FusionActor::OnMemoryAllocFinish(OpContext<DeviceTensor> *const context) {
+  MS_EXCEPTION_IF_NULL(context);
+  MS_EXCEPTION_IF_NULL(device_contexts_[0]);
+  const auto &sequential_num = context->sequential_num_;
+  for (size_t i = 0; i < kernel_actors_.size(); ++i) {
+    auto &kernel_actor = kernel_actors_[i];
+    // The head kernel actor receives the input data of fusion actor, and the others receive the output data of the
+    // previous kernel actor directly instead of the message.
+    if (i == 0) {
+      const auto &data_iter = input_op_datas_.find(sequential_num);
+      if (data_iter != input_op_datas_.end()) {
+        kernel_actor->input_op_datas_[sequential_num] = data_iter->second;
+      }
+    } else {
+      auto &input_datas = kernel_actor->input_op_datas_[sequential_num];
+      for (auto &output_data : kernel_actors_[i - 1]->output_data_) {
+        (void)input_datas.emplace_back(output_data.get());
+      }
+    }
+    kernel_actor->FetchInputDeviceTensor(context);
+    (void)kernel_actor->input_op_datas_.erase(sequential_num);
+    kernel_actor->PreLaunchKernel(context);
+
+    const auto &kernel = kernel_actor->kernel_;
+    MS_EXCEPTION_IF_NULL(kernel);
+    const auto &launch_info = kernel_actor->launch_info_;
+    try {
+      auto ret = device_contexts_[0]->LaunchKernel(kernel, launch_info.inputs_, launch_info.workspaces_,
+                                                   launch_info.outputs_, false);
+      if (!ret) {
+        std::string error_info = "Launch kernel failed: " + kernel->fullname_with_scope();
+        SET_OPCONTEXT_FAIL_RET_WITH_ERROR((*context), error_info);
+      }
+    } catch (const std::exception &e) {
+      MsException::Instance().SetException();
+      std::string error_info = "Launch kernel exception: " + kernel->fullname_with_scope();
+      SET_OPCONTEXT_FAIL_RET_WITH_ERROR((*context), error_info);
+    }
+
+    if ((kernel_actor->modifiable_ref_input_indexes_.size() != 0) ||
+        (kernel_actor->modifiable_ref_output_indexes_.size() != 0)) {
+      kernel_actor->RefreshDeviceTensorCopyStore(context);
+    }
+  }
+
+  running_dependent_msg_num_ = SizeToInt(input_datas_num_ + input_controls_num_);
+  PostRun(context);
+}
+
+void FusionActor::SendRecorderInfo(OpContext<DeviceTensor> *const context) const {
+  for (auto &kernel_actor : kernel_actors_) {
+    kernel_actor->SendRecorderInfo(context);
+  }
+}
+}  // namespace runtime
+}  // namespace mindspore
@@ -0,0 +1,80 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_RUNTIME_FRAMEWORK_ACTOR_FUSION_ACTOR_H_
+#define MINDSPORE_CCSRC_RUNTIME_FRAMEWORK_ACTOR_FUSION_ACTOR_H_
+
+#include <vector>
+#include <string>
+#include <memory>
+#include "runtime/graph_scheduler/actor/actor_common.h"
+#include "runtime/graph_scheduler/actor/memory_aware_actor.h"
+#include "runtime/graph_scheduler/actor/kernel_actor.h"
+#include "runtime/hardware/device_context.h"
+
+namespace mindspore {
+namespace runtime {
+using mindspore::device::DeviceContext;
+
+// The fusion actor is used to launch a linear chain of kernel actors back to back in one actor, in which every kernel
+// actor except the tail has the next one as the only user and every kernel actor except the head has the previous one
+// as the only source. The kernel actors of chain are not spawned, the fusion actor receives the inputs of head kernel
+// actor and sends the outputs of tail kernel actor, and the memory of all the kernels is allocated before the head
+// launch and freed after the tail launch. The processing flow is RunOpData/RunOpControl -> CheckRunningCondition ->
+// SendMemoryAllocReq -> OnMemoryAllocFinish -> LaunchKernel of each kernel actor -> SendMemoryFreeReq -> SendOutput.
+class FusionActor : public MemoryAwareActor {
+ public:
+  FusionActor(const std::string &name, const std::vector<KernelActorPtr> &kernel_actors, const AID &memory_manager_aid,
+              const AID *recorder_aid)
+      : MemoryAwareActor(name, KernelTransformType::kFusionActor, recorder_aid, memory_manager_aid),
+        kernel_actors_(kernel_actors) {
+    if (!kernel_actors_.empty() && (kernel_actors_[0] != nullptr)) {
+      device_contexts_ = kernel_actors_[0]->device_contexts();
+    }
+  }
+  ~FusionActor() override = default;
+
+  // The memory related operation interface.
+  void SendMemoryAllocReq(OpContext<DeviceTensor> *const context) override;
+  void SendMemoryFreeReq(OpContext<DeviceTensor> *const context) override;
+  // The callback after memory alloc finished.
+  void OnMemoryAllocFinish(OpContext<DeviceTensor> *const context) override;
+
+  const std::vector<KernelActorPtr> &kernel_actors() const { return kernel_actors_; }
+
+ protected:
+  void Init() override;
+  void Run(OpContext<DeviceTensor> *const context) override;
+  void SendRecorderInfo(OpContext<DeviceTensor> *const context) const override;
+
+ private:
+  friend class GraphScheduler;
+
+  // The kernel actors of chain in the execution order.
+  std::vector<KernelActorPtr> kernel_actors_;
+
+  // The device tensors for memory alloc and free, which are the combination of the lists of all the kernel actors. The
+  // sizes are fixed in the init and the elements are refreshed in place, because the memory manager actor reads the
+  // lists asynchronously.
+  std::vector<DeviceTensor *> memory_alloc_list_;
+  std::vector<DeviceTensor *> memory_free_list_;
+};
+
+using FusionActorPtr = std::shared_ptr<FusionActor>;
+}  // namespace runtime
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_RUNTIME_FRAMEWORK_ACTOR_FUSION_ACTOR_H_
@@ -19,11 +19,28 @@
 #include "runtime/graph_scheduler/actor/output_actor.h"
 #include "runtime/graph_scheduler/actor/recorder_actor.h"
 #include "runtime/graph_scheduler/actor/debug_actor.h"
+#include "runtime/graph_scheduler/step_memory_planner.h"
 #include "mindrt/include/async/async.h"
 #include "utils/log_adapter.h"
+#include "utils/ms_utils.h"
 
 namespace mindspore {
 namespace runtime {
+namespace {
+// The maximum total size of memory that the kernel actor allocates directly, which is fetched from the size-classed
+// cache of memory pool mostly.
+constexpr size_t kMaxDirectMemoryAllocSize = 64 << 10;
+
+// The kernel actor allocates the small memory directly when MS_DEV_ENABLE_DIRECT_MEMORY_ALLOC is set to 1. The direct
+// allocation doesn't queue behind the memory free requests of the previous actors, which may raise the peak memory.
+// The step memory replay needs all the memory allocations through the memory manager actor.
+bool EnableDirectMemoryAlloc() {
+  static const bool enable_direct_memory_alloc =
+    (common::GetEnv("MS_DEV_ENABLE_DIRECT_MEMORY_ALLOC") == "1") && (!StepMemoryPlanner::IsEnabled());
+  return enable_direct_memory_alloc;
+}
+}  // namespace
+
 void KernelActor::Init() {
   // Check device contexts number.
   if (device_contexts_.size() != device::kDeviceContextsNumOne) {
@@ -64,7 +81,17 @@ void KernelActor::Init() {
     (void)memory_free_list_.emplace_back(external_reference_tensor);
   }
 
+  // The small memory of static shape kernel is allocated directly in the pipeline mode, without the message round trip
+  // of memory manager actor.
+  size_t memory_alloc_size = 0;
+  for (auto &device_tensor : memory_alloc_list_) {
+    memory_alloc_size += device_tensor->GetSize();
+  }
+  enable_direct_memory_alloc_ = EnableDirectMemoryAlloc() && (strategy_ == GraphExecutionStrategy::kPipeline) &&
+                                (!is_dynamic_shape_) && (memory_alloc_size <= kMaxDirectMemoryAllocSize);
+
   // Init the output data.
+  ResetOutputActors();
   output_data_by_output_index_.resize(output_device_tensors_.size());
   for (auto &data_arrow : output_data_arrows_) {
     MS_EXCEPTION_IF_NULL(data_arrow);
@@ -146,6 +173,25 @@ void AllocateMemory(const std::vector<DeviceTensor *> &alloc_list, const DeviceC
   }
 }
 
+// Return false when any allocation fails, then the memory manager actor allocates the rest and handles the failure.
+bool AllocateMemoryDirectly(const std::vector<DeviceTensor *> &alloc_list, const DeviceContext *device_context) {
+  MS_EXCEPTION_IF_NULL(device_context);
+  for (auto &device_tensor : alloc_list) {
+    MS_EXCEPTION_IF_NULL(device_tensor);
+    if ((device_tensor->GetPtr() != nullptr) || (device_tensor->GetSize() == 0)) {
+      continue;
+    }
+    try {
+      if (!device_context->AllocateMemory(device_tensor, device_tensor->GetSize())) {
+        return false;
+      }
+    } catch (const std::exception &e) {
+      return false;
+    }
+  }
+  return true;
+}
+
 void FreeMemory(const std::vector<DeviceTensor *> &free_list, const DeviceContext *device_context) {
   MS_EXCEPTION_IF_NULL(device_context);
   for (auto &device_tensor : free_list) {
@@ -168,7 +214,9 @@ void FreeMemory(const std::vector<DeviceTensor *> &free_list, const DeviceContex
 
 void KernelActor::SendMemoryAllocReq(OpContext<DeviceTensor> *const context) {
   running_dependent_msg_num_ = 1;
-  if (strategy_ == GraphExecutionStrategy::kPipeline) {
+  if (enable_direct_memory_alloc_ && AllocateMemoryDirectly(memory_alloc_list_, device_contexts_[0])) {
+    OnMemoryAllocFinish(context);
+  } else if (strategy_ == GraphExecutionStrategy::kPipeline) {
     ActorDispatcher::Send(memory_manager_aid_, &MemoryManagerActor::AllocateMemory, &memory_alloc_list_,
                           device_contexts_[0], context, GetAID());
   } else {
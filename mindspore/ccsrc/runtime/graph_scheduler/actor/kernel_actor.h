@@ -88,6 +88,7 @@ class KernelActor : public DebugAwareActor {
  private:
   friend class GraphScheduler;
   friend class ControlNodeScheduler;
+  friend class FusionActor;
 
   // Fetch the device tensor for launch.
   void FetchInputDeviceTensor(OpContext<DeviceTensor> *const context);
@@ -136,6 +137,9 @@ class KernelActor : public DebugAwareActor {
   std::vector<DeviceTensor *> memory_free_list_;
   // The device tensor of external reference is not the real data of this kernel, but need add to the memory_free_list_.
   std::vector<DeviceTensor *> external_reference_tensors_;
+  // Allocate the small memory through the device context directly instead of the memory manager actor. The memory free
+  // is still sent to the memory manager actor, which serializes the reference count decrease of the device tensors.
+  bool enable_direct_memory_alloc_{false};
 
   // The kernel launch info is fetched by the device tensors.
   KernelLaunchInfo launch_info_;
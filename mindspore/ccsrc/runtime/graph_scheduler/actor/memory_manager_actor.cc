@@ -24,8 +24,13 @@
 namespace mindspore {
 namespace runtime {
 namespace {
-void FreeMemoryInner(DeviceTensor *const device_tensor, const DeviceContext *device_context) {
+void FreeMemoryInner(DeviceTensor *const device_tensor, const DeviceContext *device_context,
+                     StepMemoryPlanner *const step_memory_planner) {
   MS_EXCEPTION_IF_NULL(device_tensor);
+  MS_EXCEPTION_IF_NULL(step_memory_planner);
+  if (step_memory_planner->Free(device_tensor)) {
+    return;
+  }
   // The device context may be not accurate in the control flow scene, so need fetch by device name and device id.
   if ((device_context == nullptr) || (device_context->GetDeviceAddressType() != device_tensor->DeviceType())) {
     const auto &new_device_context = device::DeviceContextManager::GetInstance().GetOrCreateDeviceContext(
@@ -38,14 +43,15 @@ void FreeMemoryInner(DeviceTensor *const device_tensor, const DeviceContext *dev
 }
 
 // Only one of the static and dynamic reference counts will take effect.
-void FreeMemoryByRefCount(DeviceTensor *const device_tensor, const DeviceContext *device_context, const AID &from_aid) {
+void FreeMemoryByRefCount(DeviceTensor *const device_tensor, const DeviceContext *device_context, const AID &from_aid,
+                          StepMemoryPlanner *const step_memory_planner) {
   MS_EXCEPTION_IF_NULL(device_tensor);
   if (device_tensor->original_ref_count() != SIZE_MAX) {
     // The static reference count is decremented to zero to free memory, and reset to the original count.
     device_tensor->DecreaseRefCount();
     if (device_tensor->ref_count() == 0) {
       if (device_tensor->GetPtr() != nullptr) {
-        FreeMemoryInner(device_tensor, device_context);
+        FreeMemoryInner(device_tensor, device_context, step_memory_planner);
       }
       device_tensor->ResetRefCount();
     }
@@ -54,7 +60,7 @@ void FreeMemoryByRefCount(DeviceTensor *const device_tensor, const DeviceContext
     device_tensor->DecreaseDynamicRefCount(from_aid.Name());
     if ((device_tensor->dynamic_ref_count() == 0) && (device_tensor->GetPtr() != nullptr)) {
       MS_LOG(DEBUG) << "Free memory by the dynamic reference count, device address" << device_tensor->GetPtr();
-      FreeMemoryInner(device_tensor, device_context);
+      FreeMemoryInner(device_tensor, device_context, step_memory_planner);
     }
   }
 }
@@ -69,7 +75,8 @@ void MemoryManagerActor::AllocateMemory(const std::vector<DeviceTensor *> *alloc
 
   for (auto &device_tensor : *alloc_list) {
     MS_EXCEPTION_IF_NULL(device_tensor);
-    if (device_tensor->GetPtr() != nullptr) {
+    if ((device_tensor->GetPtr() != nullptr) ||
+        step_memory_planner_.Allocate(device_tensor, device_context, op_context->sequential_num_)) {
       continue;
     }
     try {
@@ -138,7 +145,8 @@ void MemoryManagerActor::AllocateBatchMemory(const std::vector<DeviceTensor *> *
     auto &device_context = (*device_contexts)[i];
     MS_EXCEPTION_IF_NULL(device_tensor);
     MS_EXCEPTION_IF_NULL(device_context);
-    if (device_tensor->GetPtr() != nullptr) {
+    if ((device_tensor->GetPtr() != nullptr) ||
+        step_memory_planner_.Allocate(device_tensor, device_context, op_context->sequential_num_)) {
       continue;
     }
 
@@ -162,7 +170,7 @@ void MemoryManagerActor::FreeMemory(const std::vector<DeviceTensor *> *free_list
                                     OpContext<DeviceTensor> *, const AID &from_aid) {
   MS_EXCEPTION_IF_NULL(free_list);
   for (auto &device_tensor : *free_list) {
-    FreeMemoryByRefCount(device_tensor, device_context, from_aid);
+    FreeMemoryByRefCount(device_tensor, device_context, from_aid, &step_memory_planner_);
   }
 }
 
@@ -180,7 +188,7 @@ void MemoryManagerActor::FreeBatchMemory(const std::vector<DeviceTensor *> *free
   for (size_t i = 0; i < (*free_list).size(); ++i) {
     auto &device_tensor = (*free_list)[i];
     auto &device_context = (*device_contexts)[i];
-    FreeMemoryByRefCount(device_tensor, device_context, from_aid);
+    FreeMemoryByRefCount(device_tensor, device_context, from_aid, &step_memory_planner_);
   }
 }
 
@@ -24,6 +24,7 @@
 #include "utils/hash_map.h"
 #include "runtime/graph_scheduler/actor/actor_common.h"
 #include "runtime/graph_scheduler/device_tensor_store.h"
+#include "runtime/graph_scheduler/step_memory_planner.h"
 #include "runtime/hardware/device_context.h"
 
 namespace mindspore {
@@ -71,6 +72,9 @@ class MemoryManagerActor : public ActorBase {
   // will set fail message info OpContext, major thread will destroy the OpContext object, subsequent actor can not set
   // fail message again, so we record allocating memory fail event by the uuid of the batch, which is key of the set.
   std::set<int> mem_alloc_failed_step_ids_;
+
+  // Replay the memory plan of the recorded runs for the static shape graphs.
+  StepMemoryPlanner step_memory_planner_;
 };
 }  // namespace runtime
 }  // namespace mindspore
@@ -37,6 +37,7 @@ void SuperKernelActor::Init() {
     MS_LOG(EXCEPTION) << "The size of output data arrows is not equal to the output data nodes.";
   }
   // Init the output data.
+  ResetOutputActors();
   for (size_t i = 0; i < output_data_arrows_.size(); ++i) {
     auto &data_arrow = output_data_arrows_[i];
     auto &output_node = output_data_nodes_[i];
@@ -517,29 +517,45 @@ void ControlNodeScheduler::ClearActorData(const ControlActorSet *control_actor_s
     return;
   }
 
+  // The formal parameter device tensors of ref node are the keys of DeviceTensorCopyStore inserted by the control
+  // actors, remove them only, because the store is shared by the actor sets running concurrently.
+  const auto &remove_copy_store = [](const ControlActor *control_actor) {
+    for (const auto &device_tensors : control_actor->ref_node_formal_parameter_device_tensors()) {
+      for (const auto &device_tensor : device_tensors.second) {
+        MS_EXCEPTION_IF_NULL(device_tensor);
+        DeviceTensorCopyStore::GetInstance().Remove(device_tensor.get());
+      }
+    }
+  };
+
   for (auto &switch_actor : control_actor_set->switch_actors_) {
     MS_EXCEPTION_IF_NULL(switch_actor);
     switch_actor->memory_free_lists_ = std::queue<std::vector<DeviceTensor *>>();
+    remove_copy_store(switch_actor.get());
   }
 
   for (auto &gather_actor : control_actor_set->gather_actors_) {
     MS_EXCEPTION_IF_NULL(gather_actor);
     gather_actor->memory_free_lists_ = std::queue<std::vector<DeviceTensor *>>();
+    remove_copy_store(gather_actor.get());
   }
 
   for (auto &entrance_actor : control_actor_set->entrance_actors_) {
     MS_EXCEPTION_IF_NULL(entrance_actor);
     entrance_actor->memory_free_lists_ = std::queue<std::vector<DeviceTensor *>>();
+    remove_copy_store(entrance_actor.get());
   }
 
   for (auto &stack_actor : control_actor_set->stack_actors_) {
     MS_EXCEPTION_IF_NULL(stack_actor);
     stack_actor->memory_free_lists_ = std::queue<std::vector<DeviceTensor *>>();
+    remove_copy_store(stack_actor.get());
   }
 
   for (auto &exit_actor : control_actor_set->exit_actors_) {
     MS_EXCEPTION_IF_NULL(exit_actor);
     exit_actor->memory_free_lists_ = std::queue<std::vector<DeviceTensor *>>();
+    remove_copy_store(exit_actor.get());
     exit_actor->created_device_tensors_.clear();
   }
 }
@@ -1420,6 +1436,7 @@ void ControlNodeScheduler::LinkDataArrow(AbstractActor *const from_actor, Abstra
   auto data_arrow = std::make_shared<DataArrow>(from_index, to_actor->GetAID(), to_index);
   (void)from_actor->output_data_arrows_.emplace_back(data_arrow);
   (void)from_actor->output_data_nodes_.emplace_back(from_kernel);
+  from_actor->ResetOutputActors();
   to_actor->input_datas_num_++;
   (void)to_actor->input_data_arrow_aids_.emplace_back(from_actor->GetAID());
 }
@@ -1428,6 +1445,7 @@ void ControlNodeScheduler::LinkControlArrow(AbstractActor *const from_actor, Abs
   MS_EXCEPTION_IF_NULL(from_actor);
   MS_EXCEPTION_IF_NULL(to_actor);
   (void)from_actor->output_control_arrows_.emplace_back(to_actor->GetAID());
+  from_actor->ResetOutputActors();
   to_actor->input_controls_num_++;
   (void)to_actor->input_control_arrow_aids_.emplace_back(from_actor->GetAID());
 }
@@ -1436,6 +1454,7 @@ void ControlNodeScheduler::LinkLoopBodyControlArrow(AbstractActor *from_actor, E
   MS_EXCEPTION_IF_NULL(from_actor);
   MS_EXCEPTION_IF_NULL(to_actor);
   (void)from_actor->output_control_arrows_.emplace_back(to_actor->GetAID());
+  from_actor->ResetOutputActors();
   to_actor->loop_body_input_controls_nums_++;
   (void)to_actor->loop_body_input_control_arrow_aids_.emplace_back(from_actor->GetAID());
 }
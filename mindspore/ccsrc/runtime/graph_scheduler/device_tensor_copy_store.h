@@ -19,6 +19,7 @@
 
 #include <memory>
 #include <set>
+#include <mutex>
 #include "utils/hash_map.h"
 #include "utils/ms_utils.h"
 #include "runtime/device/device_address.h"
@@ -41,11 +42,13 @@ class DeviceTensorCopyStore {
   void Insert(DeviceTensor *const key, DeviceTensor *const value) {
     MS_EXCEPTION_IF_NULL(key);
     MS_EXCEPTION_IF_NULL(value);
+    std::lock_guard<std::mutex> locker(lock_);
     (void)copy_device_tensors_[key].insert(value);
   }
 
   std::set<DeviceTensor *> Fetch(DeviceTensor *const key) const {
     MS_EXCEPTION_IF_NULL(key);
+    std::lock_guard<std::mutex> locker(lock_);
     const auto &iter = copy_device_tensors_.find(key);
     if (iter != copy_device_tensors_.end()) {
       return iter->second;
@@ -54,7 +57,16 @@ class DeviceTensorCopyStore {
     }
   }
 
-  void Clear() { copy_device_tensors_.clear(); }
+  void Remove(DeviceTensor *const key) {
+    MS_EXCEPTION_IF_NULL(key);
+    std::lock_guard<std::mutex> locker(lock_);
+    (void)copy_device_tensors_.erase(key);
+  }
+
+  void Clear() {
+    std::lock_guard<std::mutex> locker(lock_);
+    copy_device_tensors_.clear();
+  }
 
  private:
   DeviceTensorCopyStore() = default;
@@ -65,6 +77,8 @@ class DeviceTensorCopyStore {
   // It is created and removed dynamically in the running.
   // Key is the dest device tensor, value is the source device tensors which provide copy data to dest device tensor.
   mindspore::HashMap<DeviceTensor *, std::set<DeviceTensor *>> copy_device_tensors_;
+  // The actors of the actor sets running concurrently access the store in the different threads.
+  mutable std::mutex lock_;
 };
 }  // namespace runtime
 }  // namespace mindspore
@@ -16,7 +16,9 @@
 
 #include "runtime/graph_scheduler/graph_scheduler.h"
 #include <queue>
+#include <sstream>
 #include "runtime/graph_scheduler/actor/memory_manager_actor.h"
+#include "runtime/graph_scheduler/step_memory_planner.h"
 #include "runtime/graph_scheduler/actor/debug_actor.h"
 #include "runtime/graph_scheduler/actor/recorder_actor.h"
 #include "runtime/hardware/device_context_manager.h"
@@ -29,6 +31,7 @@
 #include "utils/log_adapter.h"
 #include "utils/convert_utils.h"
 #include "utils/ms_context.h"
+#include "utils/ms_utils.h"
 #include "utils/profile.h"
 #if !defined(_WIN32) && !defined(_WIN64)
 #include "utils/signal_util.h"
@@ -65,6 +68,85 @@ inline bool IsSingleOpActorSet(const ActorSet *actor_set) {
   return actor_set->kernel_actors_.size() == 1;
 }
 
+// The actors run by the priority of upward rank when MS_DEV_ENABLE_ACTOR_PRIORITY is set to 1.
+bool EnableActorPriority() {
+  static bool enable_actor_priority = common::GetEnv("MS_DEV_ENABLE_ACTOR_PRIORITY") == "1";
+  return enable_actor_priority;
+}
+
+// The step memory replay traces the memory of all the actor sets by the run order in the global memory manager actor,
+// and the direct memory alloc of kernel actor bypasses the memory manager actor, neither of them supports the actor
+// sets running concurrently on the thread partitions.
+void CheckThreadPartitionSupported(const std::string &partition_info) {
+  if (StepMemoryPlanner::IsEnabled()) {
+    MS_LOG(EXCEPTION) << "The actor thread partition: " << partition_info
+                      << " can't be used with MS_DEV_ENABLE_STEP_MEMORY_REPLAY=1.";
+  }
+  if (common::GetEnv("MS_DEV_ENABLE_DIRECT_MEMORY_ALLOC") == "1") {
+    MS_LOG(EXCEPTION) << "The actor thread partition: " << partition_info
+                      << " can't be used with MS_DEV_ENABLE_DIRECT_MEMORY_ALLOC=1.";
+  }
+}
+
+// The linear chains of kernel actors are fused when MS_DEV_ENABLE_ACTOR_FUSION is set to 1.
+bool EnableActorFusion() {
+  static bool enable_actor_fusion = common::GetEnv("MS_DEV_ENABLE_ACTOR_FUSION") == "1";
+  return enable_actor_fusion;
+}
+
+// The kernel actor of dynamic shape infers the output shape by the input before the memory alloc, which can't be
+// allocated at the head of chain.
+bool IsFusibleKernelActor(const AbstractActor *actor) {
+  if ((actor == nullptr) || (actor->type() != KernelTransformType::kKernelActor)) {
+    return false;
+  }
+  const auto kernel_actor = dynamic_cast<const KernelActor *>(actor);
+  MS_EXCEPTION_IF_NULL(kernel_actor);
+  return !AnfAlgo::IsDynamicShape(kernel_actor->kernel());
+}
+
+// The launch overhead of kernel counted in bytes, so that the chains of small kernels still weigh on the path cost.
+constexpr int64_t kKernelLaunchCost = 4096;
+
+// Estimate the running cost of kernel by the bytes that the kernel reads and writes.
+int64_t EstimateKernelCost(const CNodePtr &kernel) {
+  auto kernel_mod = AnfAlgo::GetKernelMod(kernel);
+  if (kernel_mod == nullptr) {
+    return kKernelLaunchCost;
+  }
+  int64_t cost = kKernelLaunchCost;
+  for (auto size : kernel_mod->GetInputSizeList()) {
+    cost += SizeToLong(size);
+  }
+  for (auto size : kernel_mod->GetOutputSizeList()) {
+    cost += SizeToLong(size);
+  }
+  return cost;
+}
+
+int64_t EstimateActorCost(const AbstractActor *actor) {
+  MS_EXCEPTION_IF_NULL(actor);
+  if ((actor->type() == KernelTransformType::kCopyActor) || (actor->type() == KernelTransformType::kCustomActor)) {
+    return kKernelLaunchCost;
+  }
+  if (actor->type() == KernelTransformType::kKernelActor) {
+    const auto kernel_actor = dynamic_cast<const KernelActor *>(actor);
+    MS_EXCEPTION_IF_NULL(kernel_actor);
+    return EstimateKernelCost(kernel_actor->kernel());
+  }
+  if (actor->type() == KernelTransformType::kFusionActor) {
+    const auto fusion_actor = dynamic_cast<const FusionActor *>(actor);
+    MS_EXCEPTION_IF_NULL(fusion_actor);
+    int64_t cost = 0;
+    for (const auto &kernel_actor : fusion_actor->kernel_actors()) {
+      MS_EXCEPTION_IF_NULL(kernel_actor);
+      cost += EstimateKernelCost(kernel_actor->kernel());
+    }
+    return cost;
+  }
+  return 0;
+}
+
 // Convert the actors vector by the actor set.
 std::vector<AbstractActorPtr> CollectActors(const ActorSet *actor_set) {
   MS_EXCEPTION_IF_NULL(actor_set);
@@ -89,6 +171,10 @@ std::vector<AbstractActorPtr> CollectActors(const ActorSet *actor_set) {
     MS_EXCEPTION_IF_NULL(super_kernel_actor);
     (void)actors.emplace_back(static_cast<AbstractActorPtr>(super_kernel_actor));
   }
+  for (auto &fusion_actor : actor_set->fusion_actors_) {
+    MS_EXCEPTION_IF_NULL(fusion_actor);
+    (void)actors.emplace_back(static_cast<AbstractActorPtr>(fusion_actor));
+  }
   for (auto &copy_actor : actor_set->copy_actors_) {
     MS_EXCEPTION_IF_NULL(copy_actor);
     (void)actors.emplace_back(static_cast<AbstractActorPtr>(copy_actor));
@@ -199,6 +285,13 @@ void GraphScheduler::Clear(const ActorInfo &actor_info, const std::vector<Kernel
       actor_manager->Terminate(base_actor->GetAID());
     }
   }
+  // The dedicated thread pool is destroyed after all the actors running on it are terminated.
+  (void)actor_set_thread_pools_.erase(actor_info);
+  (void)thread_partitions_.erase(actor_info);
+  // The remaining actor sets run on the shared actor thread pool, and can use the single thread execution again.
+  if (actor_set_thread_pools_.empty()) {
+    enable_concurrent_run_ = false;
+  }
 
   // Clear device tensor and device tensor store.
   for (auto &graph : graphs) {
@@ -230,9 +323,13 @@ void GraphScheduler::Clear() {
   auto actor_manager = ActorMgr::GetActorMgrRef();
   MS_EXCEPTION_IF_NULL(actor_manager);
   actor_manager->Finalize();
+  actor_set_thread_pools_.clear();
+  thread_partitions_.clear();
+  enable_concurrent_run_ = false;
 
-  // Clear the member of DeviceTensorStore.
+  // Clear the member of DeviceTensorStore and DeviceTensorCopyStore.
   DeviceTensorStore::GetInstance().Clear();
+  DeviceTensorCopyStore::GetInstance().Clear();
 
   // Clear global maps.
   actors_.clear();
@@ -242,8 +339,16 @@ void GraphScheduler::Clear() {
 void GraphScheduler::ClearActorData(const ActorSet *actor_set) {
   MS_EXCEPTION_IF_NULL(actor_set);
 
-  // Clear the member of DeviceTensorCopyStore.
-  DeviceTensorCopyStore::GetInstance().Clear();
+  // Remove the members of DeviceTensorCopyStore inserted by this actor set only, because the store is shared by the
+  // actor sets running concurrently. The copy device tensors of kernel actor are the keys of this actor set.
+  for (auto &kernel_actor : actor_set->kernel_actors_) {
+    MS_EXCEPTION_IF_NULL(kernel_actor);
+    for (auto &copy_input_device_tensor : kernel_actor->copy_input_device_tensors_) {
+      if (copy_input_device_tensor != nullptr) {
+        DeviceTensorCopyStore::GetInstance().Remove(copy_input_device_tensor.get());
+      }
+    }
+  }
 
   for (auto &super_kernel_actor : actor_set->super_kernel_actors_) {
     MS_EXCEPTION_IF_NULL(super_kernel_actor);
@@ -296,9 +401,85 @@ void GraphScheduler::Initialize() {
   MS_LOG(INFO) << "The actor thread number: " << actor_thread_num
                << ", the kernel thread number: " << (actor_and_kernel_thread_num - actor_thread_num);
 
+  ParseThreadPartitions();
   BuildAndScheduleGlobalActor();
 }
 
+void GraphScheduler::ParseThreadPartitions() {
+  const auto &env_thread_partitions = common::GetEnv("MS_DEV_ACTOR_THREAD_PARTITION");
+  if (env_thread_partitions.empty()) {
+    return;
+  }
+  CheckThreadPartitionSupported("MS_DEV_ACTOR_THREAD_PARTITION=" + env_thread_partitions);
+
+  std::stringstream partitions_stream(env_thread_partitions);
+  std::string partition;
+  while (std::getline(partitions_stream, partition, ';')) {
+    ActorThreadPartition thread_partition;
+    auto pos = partition.find(':');
+    try {
+      thread_partition.thread_num_ = std::stoul(partition.substr(0, pos));
+      if (pos != std::string::npos) {
+        std::stringstream cores_stream(partition.substr(pos + 1));
+        std::string core;
+        while (std::getline(cores_stream, core, ',')) {
+          (void)thread_partition.core_list_.emplace_back(std::stoi(core));
+        }
+      }
+    } catch (const std::exception &) {
+      thread_partition.thread_num_ = 0;
+    }
+    if (thread_partition.thread_num_ == 0) {
+      MS_LOG(EXCEPTION) << "Invalid thread partition: " << partition
+                        << " in MS_DEV_ACTOR_THREAD_PARTITION: " << env_thread_partitions;
+    }
+    (void)env_thread_partitions_.emplace_back(thread_partition);
+  }
+  MS_LOG(INFO) << "The number of actor thread partitions: " << env_thread_partitions_.size();
+}
+
+void GraphScheduler::SetThreadPartition(const ActorInfo &actor_info, const ActorThreadPartition &thread_partition) {
+  if (thread_partition.thread_num_ == 0) {
+    MS_LOG(EXCEPTION) << "The thread number of thread partition is zero, actor info: " << actor_info;
+  }
+  CheckThreadPartitionSupported("actor info: " + actor_info);
+  if (actor_set_thread_pools_.count(actor_info) > 0) {
+    MS_LOG(EXCEPTION) << "The actor set has been scheduled, can't set the thread partition, actor info: " << actor_info;
+  }
+  thread_partitions_[actor_info] = thread_partition;
+}
+
+ActorThreadPool *GraphScheduler::CreateActorSetThreadPool(const ActorSet *actor_set) {
+  MS_EXCEPTION_IF_NULL(actor_set);
+  const auto &partition_iter = thread_partitions_.find(actor_set->name_);
+  if (partition_iter == thread_partitions_.end()) {
+    return nullptr;
+  }
+  const auto &pool_iter = actor_set_thread_pools_.find(actor_set->name_);
+  if (pool_iter != actor_set_thread_pools_.end()) {
+    return pool_iter->second.get();
+  }
+
+  const auto &thread_partition = partition_iter->second;
+  auto thread_num = thread_partition.thread_num_;
+  auto thread_pool = thread_partition.core_list_.empty()
+                       ? ActorThreadPool::CreateThreadPool(thread_num)
+                       : ActorThreadPool::CreateThreadPool(thread_num, thread_num, thread_partition.core_list_);
+  if (thread_pool == nullptr) {
+    MS_LOG(EXCEPTION) << "Create the actor thread pool failed, thread number: " << thread_num
+                      << ", actor info: " << actor_set->name_;
+  }
+  thread_pool->SetMaxSpinCount(kDefaultSpinCount);
+  thread_pool->SetSpinCountMaxValue();
+  (void)actor_set_thread_pools_.emplace(actor_set->name_, std::unique_ptr<ActorThreadPool>(thread_pool));
+  // The single thread execution runs the actors in the caller thread and calls the global actors directly, which
+  // can't run concurrently with the other actor sets.
+  enable_concurrent_run_ = true;
+  MS_LOG(INFO) << "Create the actor thread pool of thread number: " << thread_num
+               << ", bound core number: " << thread_partition.core_list_.size() << ", actor info: " << actor_set->name_;
+  return thread_pool;
+}
+
 void GraphScheduler::BuildAndScheduleGlobalActor() {
   auto actor_manager = ActorMgr::GetActorMgrRef();
   MS_EXCEPTION_IF_NULL(actor_manager);
@@ -371,7 +552,14 @@ ActorSet *GraphScheduler::Transform(const GraphCompilerInfo &graph_compiler_info
 
   DumpActor(actor_set.get(), graph_compiler_info);
   if (graph_compiler_info.strategy_ == GraphExecutionStrategy::kPipeline) {
+    if ((env_thread_partition_index_ < env_thread_partitions_.size()) &&
+        (thread_partitions_.count(actor_set->name_) == 0)) {
+      thread_partitions_[actor_set->name_] = env_thread_partitions_[env_thread_partition_index_++];
+    }
     CheckActorValid(actor_set.get());
+    if (EnableActorPriority()) {
+      SetActorPriority(actor_set.get());
+    }
   }
   MS_LOG(INFO) << "Graph(" << graph_compiler_info.name_ << ") transforms actor end.";
 
@@ -381,10 +569,16 @@ ActorSet *GraphScheduler::Transform(const GraphCompilerInfo &graph_compiler_info
 void GraphScheduler::Schedule(const ActorSet *actor_set) {
   MS_EXCEPTION_IF_NULL(actor_set);
   auto actors = CollectActors(actor_set);
+  // The actors of partitioned actor set run on the dedicated thread pool.
+  auto thread_pool = CreateActorSetThreadPool(actor_set);
   // Schedule actors.
   auto actor_manager = ActorMgr::GetActorMgrRef();
   MS_EXCEPTION_IF_NULL(actor_manager);
   for (auto actor : actors) {
+    MS_EXCEPTION_IF_NULL(actor);
+    if (thread_pool != nullptr) {
+      actor->set_thread_pool(thread_pool);
+    }
     (void)actor_manager->Spawn(actor);
   }
 }
@@ -397,7 +591,6 @@ void GraphScheduler::Run(ActorSet *const actor_set, const std::vector<DeviceCont
 #if !defined(_WIN32) && !defined(_WIN64)
   SignalGuard sg(IntHandler);
 #endif
-
   // Construct OpContext.
   OpContext<DeviceTensor> op_context;
   std::vector<Promise<int>> result(1);
@@ -415,6 +608,9 @@ void GraphScheduler::Run(ActorSet *const actor_set, const std::vector<DeviceCont
   MS_EXCEPTION_IF_NULL(ActorMgr::GetActorMgrRef());
   auto thread_pool = ActorMgr::GetActorMgrRef()->GetActorThreadPool();
   MS_EXCEPTION_IF_NULL(thread_pool);
+  if (enable_concurrent_run_) {
+    actor_set->is_multi_thread_execution_ = true;
+  }
   ActorDispatcher::is_multi_thread_execution(actor_set->is_multi_thread_execution_);
   double start_time = GetTime();
   ActorDispatcher::Send(actor_set->data_prepare_actor_->GetAID(), &DataPrepareActor::PrepareData, input_tensors,
@@ -469,15 +665,16 @@ void GraphScheduler::SetActorExecutionStrategy(ActorSet *const actor_set, GraphE
   return;
 #endif
 
-  // The step mode uses the default multi thread.
-  if (strategy == GraphExecutionStrategy::kStep) {
+  // The step mode uses the default multi thread, and so do the actor sets which run concurrently.
+  if ((strategy == GraphExecutionStrategy::kStep) || enable_concurrent_run_) {
     return;
   }
 
   // The constraint condition of not supporting the single thread execution.
   if ((actor_set->control_actors_ != nullptr) || (actor_set->copy_actors_.size() > 0) ||
       (actor_set->super_kernel_actors_.size() > 0) || (actor_set->loop_count_actor_->loop_count() > 1) ||
-      (actor_set->kernel_actors_.size() > ActorDispatcher::kSingleThreadExecutionActorMaxNum)) {
+      (actor_set->kernel_actors_.size() + actor_set->fusion_actors_.size() >
+       ActorDispatcher::kSingleThreadExecutionActorMaxNum)) {
     return;
   }
 
@@ -613,6 +810,11 @@ void GraphScheduler::Link(ActorSet *actor_set, const GraphCompilerInfo &graph_co
       graph_compiler_info.control_node_parser_ != nullptr && graph_compiler_info.control_node_parser_->IsInited()) {
     control_node_scheduler_.Link(actor_set, graph_compiler_info);
   }
+
+  // Fuse the linear chains of kernel actors after all the arrows are linked.
+  if ((graph_compiler_info.strategy_ == GraphExecutionStrategy::kPipeline) && EnableActorFusion()) {
+    FuseKernelActors(actor_set);
+  }
 }
 
 std::vector<DataSourceActorPtr> GraphScheduler::BuildDataSourceActor(const GraphCompilerInfo &graph_compiler_info,
@@ -1785,8 +1987,10 @@ void GraphScheduler::LinkDeviceTensorStoreForAutoMonadActor(const std::vector<Ab
       for (auto &output_contorl : auto_monad_actor->output_control_arrows_) {
         (void)copy_actor->output_control_arrows_.emplace_back(output_contorl);
       }
+      copy_actor->ResetOutputActors();
       // Move the control arrows from auto monad actor to auto monad actor users.
       auto_monad_actor->output_control_arrows_.clear();
+      auto_monad_actor->ResetOutputActors();
 
       // Link from auto monad actor to copy actor.
       AddControlArrow(auto_monad_actor, copy_actor.get());
@@ -1808,6 +2012,7 @@ void GraphScheduler::AddDataArrow(AbstractActor *const from_actor, AbstractActor
   auto data_arrow = std::make_shared<DataArrow>(from_output_index, to_actor->GetAID(), to_input_index);
   (void)from_actor->output_data_arrows_.emplace_back(data_arrow);
   (void)from_actor->output_data_nodes_.emplace_back(from_kernel);
+  from_actor->ResetOutputActors();
   to_actor->input_datas_num_++;
   (void)to_actor->input_data_arrow_aids_.emplace_back(from_actor->GetAID());
 
@@ -1833,6 +2038,7 @@ void GraphScheduler::AddResultArrow(AbstractActor *const from_actor, OutputActor
   auto result_arrow = std::make_shared<DataArrow>(from_output_index, to_actor->GetAID(), output_position);
   (void)from_actor->output_data_arrows_.insert(from_actor->output_data_arrows_.begin(), result_arrow);
   (void)from_actor->output_data_nodes_.insert(from_actor->output_data_nodes_.begin(), from_kernel);
+  from_actor->ResetOutputActors();
   to_actor->input_datas_num_++;
   (void)to_actor->input_data_arrow_aids_.emplace_back(from_actor->GetAID());
 
@@ -1849,10 +2055,248 @@ void GraphScheduler::AddControlArrow(AbstractActor *const from_actor, AbstractAc
   MS_EXCEPTION_IF_NULL(from_actor);
   MS_EXCEPTION_IF_NULL(to_actor);
   (void)from_actor->output_control_arrows_.emplace_back(to_actor->GetAID());
+  from_actor->ResetOutputActors();
   to_actor->input_controls_num_++;
   (void)to_actor->input_control_arrow_aids_.emplace_back(from_actor->GetAID());
 }
 
+void GraphScheduler::FuseKernelActors(ActorSet *const actor_set) {
+  MS_EXCEPTION_IF_NULL(actor_set);
+  // The debug actor and control flow actors work with the kernel actors one by one, so the chains are not fused.
+  if ((debug_aid_ != nullptr) || (actor_set->control_actors_ != nullptr)) {
+    return;
+  }
+
+  auto &kernel_actors = actor_set->kernel_actors_;
+  mindspore::HashMap<const AbstractActor *, size_t> kernel_actor_indexes;
+  for (size_t i = 0; i < kernel_actors.size(); ++i) {
+    if (IsFusibleKernelActor(kernel_actors[i].get())) {
+      kernel_actor_indexes[kernel_actors[i].get()] = i;
+    }
+  }
+
+  // The next kernel actor in the chain is the only user of the kernel actor, and has the kernel actor as the only
+  // source on the same device.
+  std::vector<size_t> next_indexes(kernel_actors.size(), SIZE_MAX);
+  std::vector<bool> has_previous(kernel_actors.size(), false);
+  for (const auto &iter : kernel_actor_indexes) {
+    const auto &kernel_actor = kernel_actors[iter.second];
+    if ((kernel_actor->output_data_arrows_.size() != 1) || (kernel_actor->output_control_arrows_.size() != 0)) {
+      continue;
+    }
+    MS_EXCEPTION_IF_NULL(kernel_actor->output_data_arrows_[0]);
+    const auto &to_actor_name = kernel_actor->output_data_arrows_[0]->to_op_id_.Name();
+    const auto &next_iter = kernel_actor_indexes.find(FetchActor(to_actor_name));
+    if (next_iter == kernel_actor_indexes.end()) {
+      continue;
+    }
+    const auto &next_kernel_actor = kernel_actors[next_iter->second];
+    if ((next_kernel_actor->input_datas_num_ != 1) || (next_kernel_actor->input_controls_num_ != 0) ||
+        (next_kernel_actor->device_contexts_ != kernel_actor->device_contexts_)) {
+      continue;
+    }
+    next_indexes[iter.second] = next_iter->second;
+    has_previous[next_iter->second] = true;
+  }
+
+  // Fuse the chains from the heads which have no previous kernel actor.
+  mindspore::HashMap<const AbstractActor *, AbstractActorPtr> head_to_fusion_actors;
+  std::set<const KernelActor *> fused_kernel_actors;
+  for (size_t i = 0; i < kernel_actors.size(); ++i) {
+    if (has_previous[i] || (next_indexes[i] == SIZE_MAX)) {
+      continue;
+    }
+    std::vector<KernelActorPtr> chain;
+    for (size_t index = i; index != SIZE_MAX; index = next_indexes[index]) {
+      (void)chain.emplace_back(kernel_actors[index]);
+      if ((chain.size() < kMaxFusionKernelActorNum) && (next_indexes[index] != SIZE_MAX)) {
+        continue;
+      }
+      if (chain.size() > 1) {
+        auto actor_name = chain.front()->GetAID().Name() + "_FusionActor";
+        auto fusion_actor = std::make_shared<FusionActor>(actor_name, chain, memory_manager_aid_, recorder_aid_);
+        MS_EXCEPTION_IF_NULL(fusion_actor);
+        InsertActor(fusion_actor.get());
+        RelinkFusionActor(fusion_actor.get());
+        for (const auto &kernel_actor : chain) {
+          (void)fused_kernel_actors.insert(kernel_actor.get());
+        }
+        head_to_fusion_actors[chain.front().get()] = fusion_actor;
+        (void)actor_set->fusion_actors_.emplace_back(fusion_actor);
+      }
+      chain.clear();
+    }
+  }
+  if (fused_kernel_actors.empty()) {
+    return;
+  }
+
+  // The fused kernel actors are taken over by the fusion actors.
+  (void)kernel_actors.erase(std::remove_if(kernel_actors.begin(), kernel_actors.end(),
+                                           [&fused_kernel_actors](const KernelActorPtr &kernel_actor) {
+                                             return fused_kernel_actors.count(kernel_actor.get()) > 0;
+                                           }),
+                            kernel_actors.end());
+  for (auto &no_input_kernel_actor : actor_set->no_input_kernel_actors_) {
+    const auto &iter = head_to_fusion_actors.find(no_input_kernel_actor.get());
+    if (iter != head_to_fusion_actors.end()) {
+      no_input_kernel_actor = iter->second;
+    }
+  }
+  MS_LOG(INFO) << "Actor set: " << actor_set->name_ << " fuses " << fused_kernel_actors.size()
+               << " kernel actors into " << actor_set->fusion_actors_.size() << " fusion actors.";
+}
+
+void GraphScheduler::RelinkFusionActor(FusionActor *const fusion_actor) {
+  MS_EXCEPTION_IF_NULL(fusion_actor);
+  const auto &head_actor = fusion_actor->kernel_actors_.front();
+  const auto &tail_actor = fusion_actor->kernel_actors_.back();
+  MS_EXCEPTION_IF_NULL(head_actor);
+  MS_EXCEPTION_IF_NULL(tail_actor);
+  const auto &fusion_aid = fusion_actor->GetAID();
+
+  // The source actors of head kernel actor send the inputs to the fusion actor.
+  const auto &head_name = head_actor->GetAID().Name();
+  auto relink_source_actor = [&head_name, &fusion_aid](const AID &from_aid) {
+    auto from_actor = FetchActor(from_aid.Name());
+    if (from_actor == nullptr) {
+      MS_LOG(EXCEPTION) << "Can't find the source actor: " << from_aid.Name() << " of " << head_name;
+    }
+    for (auto &data_arrow : from_actor->output_data_arrows_) {
+      MS_EXCEPTION_IF_NULL(data_arrow);
+      if (data_arrow->to_op_id_.Name() == head_name) {
+        data_arrow->to_op_id_ = fusion_aid;
+      }
+    }
+    for (auto &control_arrow : from_actor->output_control_arrows_) {
+      if (control_arrow.Name() == head_name) {
+        control_arrow = fusion_aid;
+      }
+    }
+    from_actor->ResetOutputActors();
+  };
+  for (const auto &from_aid : head_actor->input_data_arrow_aids_) {
+    relink_source_actor(from_aid);
+  }
+  for (const auto &from_aid : head_actor->input_control_arrow_aids_) {
+    relink_source_actor(from_aid);
+  }
+  fusion_actor->input_datas_num_ = head_actor->input_datas_num_;
+  fusion_actor->input_controls_num_ = head_actor->input_controls_num_;
+  fusion_actor->input_data_arrow_aids_.swap(head_actor->input_data_arrow_aids_);
+  fusion_actor->input_control_arrow_aids_.swap(head_actor->input_control_arrow_aids_);
+  head_actor->input_datas_num_ = 0;
+  head_actor->input_controls_num_ = 0;
+
+  // The output arrows of tail kernel actor are shared with the fusion actor, and the user actors receive the outputs
+  // from the fusion actor.
+  const auto &tail_name = tail_actor->GetAID().Name();
+  auto relink_user_actor = [&tail_name, &fusion_aid](const AID &to_aid, bool is_data_arrow) {
+    auto to_actor = FetchActor(to_aid.Name());
+    if (to_actor == nullptr) {
+      MS_LOG(EXCEPTION) << "Can't find the user actor: " << to_aid.Name() << " of " << tail_name;
+    }
+    auto &input_aids = is_data_arrow ? to_actor->input_data_arrow_aids_ : to_actor->input_control_arrow_aids_;
+    for (auto &input_aid : input_aids) {
+      if (input_aid.Name() == tail_name) {
+        input_aid = fusion_aid;
+      }
+    }
+  };
+  for (const auto &data_arrow : tail_actor->output_data_arrows_) {
+    MS_EXCEPTION_IF_NULL(data_arrow);
+    relink_user_actor(data_arrow->to_op_id_, true);
+  }
+  for (const auto &control_arrow : tail_actor->output_control_arrows_) {
+    relink_user_actor(control_arrow, false);
+  }
+  fusion_actor->output_data_arrows_ = tail_actor->output_data_arrows_;
+  fusion_actor->output_data_nodes_ = tail_actor->output_data_nodes_;
+  fusion_actor->output_control_arrows_ = tail_actor->output_control_arrows_;
+  fusion_actor->ResetOutputActors();
+
+  // The kernel actors of chain are not spawned and can't be fetched by name.
+  for (const auto &kernel_actor : fusion_actor->kernel_actors_) {
+    MS_EXCEPTION_IF_NULL(kernel_actor);
+    EraseActor(kernel_actor->GetAID().Name());
+  }
+}
+
+void GraphScheduler::SetActorPriority(const ActorSet *actor_set) const {
+  MS_EXCEPTION_IF_NULL(actor_set);
+  auto actors = CollectActors(actor_set);
+  mindspore::HashMap<std::string, size_t> actor_indices;
+  for (size_t i = 0; i < actors.size(); ++i) {
+    actor_indices[actors[i]->GetAID().Name()] = i;
+  }
+
+  // The output actors of each actor in the actor set by the data arrows and control arrows.
+  std::vector<std::vector<size_t>> output_actors(actors.size());
+  for (size_t i = 0; i < actors.size(); ++i) {
+    const auto &actor = actors[i];
+    for (const auto &data_arrow : actor->output_data_arrows_) {
+      MS_EXCEPTION_IF_NULL(data_arrow);
+      const auto &iter = actor_indices.find(data_arrow->to_op_id_.Name());
+      if (iter != actor_indices.end()) {
+        (void)output_actors[i].emplace_back(iter->second);
+      }
+    }
+    for (const auto &control_arrow : actor->output_control_arrows_) {
+      const auto &iter = actor_indices.find(control_arrow.Name());
+      if (iter != actor_indices.end()) {
+        (void)output_actors[i].emplace_back(iter->second);
+      }
+    }
+  }
+
+  // The upward rank of actor is its cost plus the max rank of its output actors, which is computed in the post order of
+  // an iterative depth first search. The arrows back to the actor on the search path close a loop, such as the control
+  // arrow from the loop count actor to the data prepare actor, and are skipped.
+  enum VisitState { kUnvisited, kVisiting, kVisited };
+  std::vector<VisitState> states(actors.size(), kUnvisited);
+  std::vector<int64_t> ranks(actors.size(), 0);
+  // The pair is the actor index and the position of the next output actor to visit.
+  std::vector<std::pair<size_t, size_t>> search_path;
+  for (size_t root = 0; root < actors.size(); ++root) {
+    if (states[root] != kUnvisited) {
+      continue;
+    }
+    states[root] = kVisiting;
+    (void)search_path.emplace_back(root, 0);
+    while (!search_path.empty()) {
+      size_t index = search_path.back().first;
+      size_t position = search_path.back().second;
+      if (position < output_actors[index].size()) {
+        ++search_path.back().second;
+        size_t output_index = output_actors[index][position];
+        if (states[output_index] == kUnvisited) {
+          states[output_index] = kVisiting;
+          (void)search_path.emplace_back(output_index, 0);
+        }
+        continue;
+      }
+
+      int64_t max_output_rank = 0;
+      for (auto output_index : output_actors[index]) {
+        if (states[output_index] == kVisited) {
+          max_output_rank = std::max(max_output_rank, ranks[output_index]);
+        }
+      }
+      ranks[index] = EstimateActorCost(actors[index].get()) + max_output_rank;
+      states[index] = kVisited;
+      search_path.pop_back();
+    }
+  }
+
+  int64_t max_rank = 0;
+  for (size_t i = 0; i < actors.size(); ++i) {
+    actors[i]->set_priority(ranks[i]);
+    max_rank = std::max(max_rank, ranks[i]);
+  }
+  MS_LOG(INFO) << "Actor set: " << actor_set->name_ << " sets the priority of " << actors.size()
+               << " actors, the critical path cost: " << max_rank;
+}
+
 void GraphScheduler::CheckActorValid(const ActorSet *actor_set) const {
   MS_EXCEPTION_IF_NULL(actor_set);
   auto actors = CollectActors(actor_set);
@@ -2050,6 +2494,7 @@ void GraphScheduler::DumpActor(const ActorSet *actor_set, const GraphCompilerInf
   DumpDSActors(actor_set->data_source_actors_, ofs);
   DumpKernelActors(actor_set->kernel_actors_, ofs);
   DumpSuperKernelActors(actor_set->super_kernel_actors_, ofs);
+  DumpFusionActors(actor_set->fusion_actors_, ofs);
   // The on input kernel actors are taken over by control actor in the control flow scene.
   if ((graph_compiler_info.control_node_parser_ == nullptr) ||
       (!graph_compiler_info.control_node_parser_->IsInited())) {
@@ -25,6 +25,7 @@
 #include <set>
 #include <algorithm>
 #include <fstream>
+#include <atomic>
 #include "utils/hash_map.h"
 #include "utils/hash_set.h"
 #include "runtime/graph_scheduler/control_node_scheduler.h"
@@ -43,6 +44,18 @@ using mindspore::session::KernelWithIndex;
 // output node.
 using GraphOutputPair = std::pair<AbstractActor *, KernelWithIndex>;
 
+// The thread partition of actor set. The actors of the partitioned actor set run on the dedicated actor threads instead
+// of the shared actor thread pool, and the threads are bound to the cores in the core list if it is not empty, so the
+// actor sets run concurrently without contending for the actor threads.
+struct ActorThreadPartition {
+  size_t thread_num_{0};
+  std::vector<int> core_list_;
+};
+
+// The max number of kernel actors in one fusion actor. The memory of all the kernels in the chain is allocated before
+// the chain runs, so the long chain is split to bound the memory.
+constexpr size_t kMaxFusionKernelActorNum = 16;
+
 class GraphScheduler {
  public:
   static GraphScheduler &GetInstance() noexcept {
@@ -65,11 +78,19 @@ class GraphScheduler {
   // Transform graph to actor DAG, contains build and link.
   ActorSet *Transform(const GraphCompilerInfo &graph_compiler_info);
 
+  // Set the thread partition of actor set, which must be called before the actor set is scheduled. The thread
+  // partitions can also be set by the environment variable MS_DEV_ACTOR_THREAD_PARTITION, such as "4:0,1,2,3;2", whose
+  // partitions are separated by ';' and assigned to the graph mode actor sets in the transform order, and each
+  // partition is the thread number optionally followed by ':' and the bound cores separated by ','. The thread partition
+  // can't be used with the step memory replay or the direct memory alloc.
+  void SetThreadPartition(const ActorInfo &actor_info, const ActorThreadPartition &thread_partition);
+
   // Schedule actors in the actor runtime. Single machine scheduling is supported currently, and distributed scheduling
   // will be supported in the future.
   void Schedule(const ActorSet *actor_set);
 
-  // The processing entry of actors running. The fourth parameter is used only in the step execution strategy.
+  // The processing entry of actors running. The fourth parameter is used only in the step execution strategy. The actor
+  // sets can run concurrently in the different threads.
   void Run(ActorSet *constactor_set, const std::vector<DeviceContext *> &device_contexts,
            const std::vector<std::vector<TensorPtr>> &input_tensors,
            const std::vector<TensorPtr> &input_tensors_with_value_node = {},
@@ -89,6 +110,12 @@ class GraphScheduler {
   // The Global actors contain memory manager actor, recorder actor and debug actor.
   void BuildAndScheduleGlobalActor();
 
+  // Parse the thread partitions of the environment variable MS_DEV_ACTOR_THREAD_PARTITION.
+  void ParseThreadPartitions();
+  // Create the dedicated actor thread pool of actor set by the thread partition, return nullptr if the actor set has no
+  // thread partition and runs on the shared actor thread pool.
+  ActorThreadPool *CreateActorSetThreadPool(const ActorSet *actor_set);
+
   // Transform the nodes of graph to actors.
   ActorSetPtr Build(const GraphCompilerInfo &graph_compiler_info);
   // Link actors to DAG through the edge connection of graph and graph execution strategy.
@@ -168,6 +195,12 @@ class GraphScheduler {
   // 3. The processing of linking output result arrows.
   void LinkOutputResultArrowForOutputActor(OutputActor *to_actor, const GraphCompilerInfo &graph_compiler_info);
 
+  // 4. Fuse the linear chains of kernel actors into the fusion actors, which launch the kernels back to back without
+  // the messages between them.
+  void FuseKernelActors(ActorSet *const actor_set);
+  // Replace the head and tail kernel actors of chain by the fusion actor in the arrows of the source and user actors.
+  void RelinkFusionActor(FusionActor *const fusion_actor);
+
   void AddDeviceTensorStore(const AnfNode *anf_node, const DeviceTensorPtr &device_tensor);
   // Add the arrow between from actor and to actor.
   void AddDataArrow(AbstractActor *const from_actor, AbstractActor *const to_actor, const AnfNodePtr &from_kernel,
@@ -178,6 +211,9 @@ class GraphScheduler {
 
   // Check whether the actor set is valid.
   void CheckActorValid(const ActorSet *actor_set) const;
+  // Set the priority of actors by the upward rank, which is the estimated cost of the longest path from the actor to
+  // the end of step, so that the thread pool runs the ready actors on the critical path first.
+  void SetActorPriority(const ActorSet *actor_set) const;
 
   // Persist device tensors of graph's some nodes(such as weights and value nodes).
   void PersistDeviceTensor(const GraphCompilerInfo &graph_compiler_info);
@@ -198,6 +234,15 @@ class GraphScheduler {
   // into the actor set after link.
   std::vector<CopyActorPtr> copy_actors_;
 
+  // The thread partitions of actor sets and the dedicated actor thread pools created by them.
+  mindspore::HashMap<ActorInfo, ActorThreadPartition> thread_partitions_;
+  mindspore::HashMap<ActorInfo, std::unique_ptr<ActorThreadPool>> actor_set_thread_pools_;
+  // The thread partitions of environment variable which are not assigned to the actor sets yet.
+  std::vector<ActorThreadPartition> env_thread_partitions_;
+  size_t env_thread_partition_index_{0};
+  // Whether any actor set runs on the dedicated thread pool, and then the actor sets are able to run concurrently.
+  std::atomic<bool> enable_concurrent_run_{false};
+
   // In the control flow, used to build and link control actor.
   ControlNodeScheduler control_node_scheduler_;
 
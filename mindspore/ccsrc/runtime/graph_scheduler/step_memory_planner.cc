@@ -0,0 +1,262 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "runtime/graph_scheduler/step_memory_planner.h"
+#include <algorithm>
+#include <iterator>
+#include <memory>
+#include <utility>
+#include "backend/common/somas/somas_solver_core.h"
+#include "backend/common/somas/somas_solver_pre.h"
+#include "common/mem_reuse/mem_dynamic_allocator.h"
+#include "utils/convert_utils_base.h"
+#include "utils/log_adapter.h"
+#include "utils/ms_utils.h"
+
+namespace mindspore {
+namespace runtime {
+namespace {
+// The number of runs recorded before solving the plan.
+constexpr size_t kRecordRunNum = 2;
+// The maximum number of solving the plan, the replay is disabled when the sizes keep changing.
+constexpr size_t kMaxReplanNum = 3;
+// The planned device tensors start after the guard, so the device address in the arena is never the start address of
+// the memory buf in the memory pool, and the memory pool ignores it when it is freed by the device context by mistake.
+constexpr size_t kArenaGuardSize = device::DYNAMIC_MEM_ALIGN_SIZE;
+
+size_t AlignArenaSize(size_t size) {
+  return ((size + device::DYNAMIC_MEM_ALIGN_SIZE - 1) / device::DYNAMIC_MEM_ALIGN_SIZE) *
+         device::DYNAMIC_MEM_ALIGN_SIZE;
+}
+}  // namespace
+
+StepMemoryPlanner::StepMemoryPlanner() {
+  if (IsEnabled()) {
+    state_ = PlanState::kRecording;
+  }
+}
+
+bool StepMemoryPlanner::IsEnabled() {
+  static const bool enable_step_memory_replay = (common::GetEnv("MS_DEV_ENABLE_STEP_MEMORY_REPLAY") == "1");
+  return enable_step_memory_replay;
+}
+
+bool StepMemoryPlanner::Allocate(DeviceTensor *const device_tensor, const DeviceContext *device_context, int run_id) {
+  MS_EXCEPTION_IF_NULL(device_tensor);
+  if (state_ == PlanState::kRecording) {
+    RecordAllocate(device_tensor, device_context, run_id);
+  }
+  if (state_ != PlanState::kReplaying) {
+    return false;
+  }
+
+  const auto &iter = planned_tensors_.find(device_tensor);
+  if ((iter == planned_tensors_.end()) || (device_context != device_context_)) {
+    return false;
+  }
+  const auto &planned_tensor = iter->second;
+  // The shape is changed, so the plan is invalid and the arena will be released after all the using is finished.
+  if (device_tensor->GetSize() > planned_tensor.size_) {
+    MS_LOG(INFO) << "The size of device tensor is changed from " << planned_tensor.size_ << " to "
+                 << device_tensor->GetSize() << ", the step memory plan is invalid.";
+    state_ = PlanState::kInvalid;
+    if (live_tensors_.empty()) {
+      Reset();
+    }
+    return false;
+  }
+  // The device ptr of live device tensor may be taken away by others, so it can't be reused until freed.
+  if (live_tensors_.count(device_tensor) > 0) {
+    return false;
+  }
+  // Check the overlap with the live ranges.
+  auto end = planned_tensor.offset_ + planned_tensor.size_;
+  const auto &range_iter = live_ranges_.lower_bound(planned_tensor.offset_);
+  if ((range_iter != live_ranges_.end()) && (range_iter->first < end)) {
+    return false;
+  }
+  if ((range_iter != live_ranges_.begin()) && (std::prev(range_iter)->second > planned_tensor.offset_)) {
+    return false;
+  }
+
+  device_tensor->set_ptr(AddressOffset(arena_, kArenaGuardSize + planned_tensor.offset_));
+  device_tensor->set_from_mem_pool(false);
+  (void)live_tensors_.emplace(device_tensor, planned_tensor.offset_);
+  (void)live_ranges_.emplace(planned_tensor.offset_, end);
+  return true;
+}
+
+bool StepMemoryPlanner::Free(DeviceTensor *const device_tensor) {
+  MS_EXCEPTION_IF_NULL(device_tensor);
+  if (state_ == PlanState::kRecording) {
+    RecordFree(device_tensor);
+    return false;
+  }
+
+  const auto &iter = live_tensors_.find(device_tensor);
+  if (iter == live_tensors_.end()) {
+    return false;
+  }
+  auto offset = iter->second;
+  // The device ptr is taken away by others, so keep the range live.
+  if (device_tensor->GetPtr() != AddressOffset(arena_, kArenaGuardSize + offset)) {
+    return false;
+  }
+  device_tensor->set_ptr(nullptr);
+  (void)live_tensors_.erase(iter);
+  (void)live_ranges_.erase(offset);
+  if ((state_ == PlanState::kInvalid) && live_tensors_.empty()) {
+    Reset();
+  }
+  return true;
+}
+
+void StepMemoryPlanner::RecordAllocate(DeviceTensor *const device_tensor, const DeviceContext *device_context,
+                                       int run_id) {
+  if ((event_time_ == 0) || (run_id != run_id_)) {
+    if (event_time_ != 0) {
+      CloseRun();
+    }
+    if (recorded_run_num_ >= kRecordRunNum) {
+      Solve();
+      return;
+    }
+    run_id_ = run_id;
+  }
+  if (device_context_ == nullptr) {
+    device_context_ = device_context;
+  }
+
+  auto &recorded_tensor = recorded_tensors_[device_tensor];
+  // Only the device tensors of one device context are planned in one arena.
+  if ((device_context != device_context_) || (running_tensors_.count(device_tensor) > 0) ||
+      ((recorded_tensor.size_ != 0) && (recorded_tensor.size_ != device_tensor->GetSize()))) {
+    recorded_tensor.plannable_ = false;
+  }
+  recorded_tensor.size_ = device_tensor->GetSize();
+  running_tensors_[device_tensor] = event_time_++;
+}
+
+void StepMemoryPlanner::RecordFree(DeviceTensor *const device_tensor) {
+  const auto &iter = running_tensors_.find(device_tensor);
+  if (iter == running_tensors_.end()) {
+    // The device tensor is allocated in the previous run.
+    const auto &recorded_iter = recorded_tensors_.find(device_tensor);
+    if (recorded_iter != recorded_tensors_.end()) {
+      recorded_iter->second.plannable_ = false;
+    }
+    return;
+  }
+  (void)recorded_tensors_[device_tensor].lifetimes_.emplace_back(TensorLifetime{iter->second, event_time_++});
+  (void)running_tensors_.erase(iter);
+}
+
+void StepMemoryPlanner::CloseRun() {
+  for (auto &running_tensor : running_tensors_) {
+    recorded_tensors_[running_tensor.first].plannable_ = false;
+  }
+  running_tensors_.clear();
+  ++recorded_run_num_;
+}
+
+void StepMemoryPlanner::Solve() {
+  std::vector<DeviceTensor *> plannable_tensors;
+  for (auto &recorded_tensor : recorded_tensors_) {
+    if (recorded_tensor.second.plannable_ && (recorded_tensor.second.size_ > 0) &&
+        (!recorded_tensor.second.lifetimes_.empty())) {
+      (void)plannable_tensors.emplace_back(recorded_tensor.first);
+    }
+  }
+  if (plannable_tensors.empty() || (device_context_ == nullptr)) {
+    MS_LOG(INFO) << "No device tensor can be planned, the step memory replay is disabled.";
+    state_ = PlanState::kDisabled;
+    recorded_tensors_.clear();
+    return;
+  }
+
+  // The tensors can reuse the memory each other only when none of their lifetimes overlap, and the lifetimes of all the
+  // runs are in one timeline, so sweep the lifetimes sorted by the start time to find the overlaps.
+  size_t tensor_num = plannable_tensors.size();
+  std::vector<std::pair<TensorLifetime, size_t>> lifetimes;
+  for (size_t i = 0; i < tensor_num; ++i) {
+    for (auto &lifetime : recorded_tensors_[plannable_tensors[i]].lifetimes_) {
+      (void)lifetimes.emplace_back(lifetime, i);
+    }
+  }
+  std::sort(lifetimes.begin(), lifetimes.end(),
+            [](const auto &a, const auto &b) { return a.first.start_ < b.first.start_; });
+  std::vector<somas::DynamicBitSet> reuse_matrix(tensor_num, somas::DynamicBitSet(tensor_num));
+  for (auto &reuse_bits : reuse_matrix) {
+    std::fill(reuse_bits.bit_.begin(), reuse_bits.bit_.end(), UINT64_MAX);
+  }
+  std::multimap<size_t, size_t> active_lifetimes;
+  for (auto &lifetime : lifetimes) {
+    (void)active_lifetimes.erase(active_lifetimes.begin(), active_lifetimes.lower_bound(lifetime.first.start_));
+    for (auto &active_lifetime : active_lifetimes) {
+      reuse_matrix[lifetime.second].SetBitFalse(active_lifetime.second);
+      reuse_matrix[active_lifetime.second].SetBitFalse(lifetime.second);
+    }
+    (void)active_lifetimes.emplace(lifetime.first.end_, lifetime.second);
+  }
+
+  somas::TensorsDescMap tensor_descs;
+  for (size_t i = 0; i < tensor_num; ++i) {
+    auto size = AlignArenaSize(recorded_tensors_[plannable_tensors[i]].size_);
+    tensor_descs[i] = std::make_shared<somas::SomasSolverTensorDesc>(i, size, 0, false);
+  }
+  somas::SomasSolverCore solver(tensor_descs, &reuse_matrix, 0, false);
+  if (solver.MemoryAllocationSolver() != somas::SUCCESS) {
+    MS_LOG(WARNING) << "Solve the step memory plan failed, the step memory replay is disabled.";
+    state_ = PlanState::kDisabled;
+    recorded_tensors_.clear();
+    return;
+  }
+
+  auto arena_size = solver.GetUpperbound();
+  arena_ = device_context_->AllocateMemory(kArenaGuardSize + arena_size);
+  if (arena_ == nullptr) {
+    MS_LOG(WARNING) << "Allocate the arena of step memory plan failed, size: " << arena_size
+                    << ", the step memory replay is disabled.";
+    state_ = PlanState::kDisabled;
+    recorded_tensors_.clear();
+    return;
+  }
+  for (size_t i = 0; i < tensor_num; ++i) {
+    const auto &tensor_desc = tensor_descs[i];
+    planned_tensors_[plannable_tensors[i]] = PlannedTensor{tensor_desc->offset_, tensor_desc->size_};
+  }
+  MS_LOG(INFO) << "Solve the step memory plan of " << tensor_num << " device tensors in " << recorded_run_num_
+               << " runs, the arena size: " << arena_size;
+  recorded_tensors_.clear();
+  state_ = PlanState::kReplaying;
+}
+
+void StepMemoryPlanner::Reset() {
+  if (arena_ != nullptr) {
+    MS_EXCEPTION_IF_NULL(device_context_);
+    device_context_->FreeMemory(arena_);
+    arena_ = nullptr;
+  }
+  planned_tensors_.clear();
+  live_tensors_.clear();
+  live_ranges_.clear();
+  device_context_ = nullptr;
+  recorded_run_num_ = 0;
+  event_time_ = 0;
+  state_ = (++replan_num_ < kMaxReplanNum) ? PlanState::kRecording : PlanState::kDisabled;
+}
+}  // namespace runtime
+}  // namespace mindspore
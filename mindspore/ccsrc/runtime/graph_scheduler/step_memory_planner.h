@@ -0,0 +1,99 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_RUNTIME_FRAMEWORK_STEP_MEMORY_PLANNER_H_
+#define MINDSPORE_CCSRC_RUNTIME_FRAMEWORK_STEP_MEMORY_PLANNER_H_
+
+#include <map>
+#include <vector>
+#include "utils/hash_map.h"
+#include "runtime/graph_scheduler/device_tensor_store.h"
+#include "runtime/hardware/device_context.h"
+
+namespace mindspore {
+namespace runtime {
+using mindspore::device::DeviceContext;
+
+// The step memory planner records the memory alloc and free trace of the first runs in the memory manager actor, solves
+// the offsets of the traced device tensors in one arena by the somas solver, and then serves the later runs by the
+// offsets instead of the memory pool. The device tensors whose lifetimes don't close in one run are not planned, and
+// the plan is discarded and recorded again when the size of planned device tensor changes. All the interfaces must be
+// called in the memory manager actor thread.
+class StepMemoryPlanner {
+ public:
+  StepMemoryPlanner();
+  ~StepMemoryPlanner() = default;
+
+  // The step memory replay is enabled by the environment variable MS_DEV_ENABLE_STEP_MEMORY_REPLAY=1.
+  static bool IsEnabled();
+
+  // Return true if the memory of device tensor is allocated from the arena, otherwise the caller allocates the memory
+  // from the memory pool.
+  bool Allocate(DeviceTensor *const device_tensor, const DeviceContext *device_context, int run_id);
+  // Return true if the memory of device tensor is freed to the arena, otherwise the caller frees the memory to the
+  // memory pool.
+  bool Free(DeviceTensor *const device_tensor);
+
+ private:
+  enum class PlanState { kDisabled, kRecording, kReplaying, kInvalid };
+
+  struct TensorLifetime {
+    size_t start_;
+    size_t end_;
+  };
+  struct RecordedTensor {
+    size_t size_{0};
+    bool plannable_{true};
+    std::vector<TensorLifetime> lifetimes_;
+  };
+  struct PlannedTensor {
+    size_t offset_{0};
+    size_t size_{0};
+  };
+
+  void RecordAllocate(DeviceTensor *const device_tensor, const DeviceContext *device_context, int run_id);
+  void RecordFree(DeviceTensor *const device_tensor);
+  // The device tensors which are not freed in the run can't be planned.
+  void CloseRun();
+  // Solve the offsets of the plannable device tensors and allocate the arena.
+  void Solve();
+  // Release the arena and record the trace again.
+  void Reset();
+
+  PlanState state_{PlanState::kDisabled};
+  const DeviceContext *device_context_{nullptr};
+  size_t replan_num_{0};
+
+  // The info of recording.
+  int run_id_{0};
+  size_t recorded_run_num_{0};
+  size_t event_time_{0};
+  mindspore::HashMap<DeviceTensor *, RecordedTensor> recorded_tensors_;
+  // The allocated time of device tensors which are not freed in the current run.
+  mindspore::HashMap<DeviceTensor *, size_t> running_tensors_;
+
+  // The info of replaying.
+  void *arena_{nullptr};
+  mindspore::HashMap<DeviceTensor *, PlannedTensor> planned_tensors_;
+  // The device tensors which use the arena currently and their ranges in the arena, the ranges are used to check the
+  // overlap before the allocation, because the execution order of later runs may be different from the recorded runs.
+  mindspore::HashMap<DeviceTensor *, size_t> live_tensors_;
+  std::map<size_t, size_t> live_ranges_;
+};
+}  // namespace runtime
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_RUNTIME_FRAMEWORK_STEP_MEMORY_PLANNER_H_
@@ -183,8 +183,14 @@ void GraphKernelFlags::CheckSupport() const {
     }
 #ifndef USE_LLVM
     auto is_cpu = (context->get_param<std::string>(MS_CTX_DEVICE_TARGET) == kCPUDevice);
-    if (is_cpu) {
-      MS_LOG(WARNING) << "GraphKernel is not usable without LLVM on cpu platform.";
+#ifdef ENABLE_CPU_NATIVE_FUSION
+    bool native_fusion = enable_cpu_native_fusion;
+#else
+    bool native_fusion = false;
+#endif
+    if (is_cpu && !native_fusion) {
+      MS_LOG(WARNING) << "GraphKernel is not usable without LLVM on cpu platform, unless MindSpore is built with "
+                      << "ENABLE_CPU_NATIVE_FUSION and \"enable_cpu_native_fusion\" is set.";
       const_cast<GraphKernelFlags *>(this)->opt_level = OptLevel_0;
       return;
     }
@@ -221,10 +227,17 @@ void GraphKernelFlags::Refresh() {
 void GraphKernelFlags::RegisterFlags(std::map<std::string, std::string> *flag_map) {
   FlagRegister reg(flag_map);
   bool is_ascend{false};
+  bool is_cpu{false};
 #ifndef MSLITE_ENABLE_GRAPH_KERNEL
   auto context_ptr = MsContext::GetInstance();
   MS_EXCEPTION_IF_NULL(context_ptr);
   is_ascend = (context_ptr->get_param<std::string>(MS_CTX_DEVICE_TARGET) == kAscendDevice);
+  is_cpu = (context_ptr->get_param<std::string>(MS_CTX_DEVICE_TARGET) == kCPUDevice);
+#endif
+#if defined(ENABLE_CPU_NATIVE_FUSION) && !(defined(ENABLE_AKG) && defined(USE_LLVM))
+  bool native_fusion_default = is_cpu;
+#else
+  bool native_fusion_default = false;
 #endif
 
   // Set opt_level first, some flags' default value depends on it.
@@ -242,6 +255,7 @@ void GraphKernelFlags::RegisterFlags(std::map<std::string, std::string> *flag_ma
   reg.AddFlag("enable_parallel_fusion", &enable_parallel_fusion, opt_level == OptLevel_3);
   reg.AddFlag("enable_low_precision", &enable_low_precision);
   reg.AddFlag("enable_trans_op_optimize", &enable_trans_op_optimize);
+  reg.AddFlag("enable_cpu_native_fusion", &enable_cpu_native_fusion, native_fusion_default);
 
   // Integer flags
   reg.AddFlag("online_tuning", &online_tuning);
@@ -275,6 +289,7 @@ std::string GraphKernelFlags::DumpAllFlags() const {
   json["enable_parallel_fusion"] = enable_parallel_fusion;
   json["enable_low_precision"] = enable_low_precision;
   json["enable_trans_op_optimize"] = enable_trans_op_optimize;
+  json["enable_cpu_native_fusion"] = enable_cpu_native_fusion;
 
   json["opt_level"] = opt_level;
   json["fusion_ops_level"] = fusion_ops_level;
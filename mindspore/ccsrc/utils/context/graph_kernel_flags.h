@@ -112,6 +112,14 @@ class GraphKernelFlags {
    */
   bool enable_trans_op_optimize{false};
 
+  /**
+   * Expand and cluster only the fp32 elementwise operators that run natively on cpu, so no AKG code generation is
+   * needed for the fused kernels.
+   *
+   * Only for cpu builds with ENABLE_CPU_NATIVE_FUSION, enabled by default when AKG with LLVM is not built.
+   */
+  bool enable_cpu_native_fusion{false};
+
   /**
    * Optimization level, value from 0 to 3.
    * 0: Disable GraphKernel
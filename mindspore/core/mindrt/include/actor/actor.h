@@ -34,6 +34,8 @@ class ActorThreadPool;
 
 // should be at least greater than 1
 constexpr uint32_t MAX_ACTOR_RECORD_SIZE = 3;
+// the max number of messages taken in one run of the actor with the MpscMailBox
+constexpr size_t MAX_MSG_NUM_PER_RUN = 64;
 
 class MS_CORE_API ActorBase {
  public:
@@ -80,6 +82,10 @@ class MS_CORE_API ActorBase {
 
   void set_thread_pool(ActorThreadPool *pool) { pool_ = pool; }
 
+  // When several actors are ready in the thread pool, the one with the higher priority runs first.
+  void set_priority(int64_t priority) { priority_ = priority; }
+  int64_t priority() const { return priority_; }
+
   // Judge if actor running by the received message number, the default is true.
   virtual bool IsActive(int msg_num) { return true; }
 
@@ -210,6 +216,7 @@ class MS_CORE_API ActorBase {
   uint32_t recordNextPoint = 0;
 
   ActorThreadPool *pool_{nullptr};
+  int64_t priority_{0};
 };
 using ActorReference = std::shared_ptr<ActorBase>;
 };  // namespace mindspore
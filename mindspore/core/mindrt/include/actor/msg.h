@@ -17,6 +17,7 @@
 #ifndef MINDSPORE_CORE_MINDRT_INCLUDE_ACTOR_MSG_H
 #define MINDSPORE_CORE_MINDRT_INCLUDE_ACTOR_MSG_H
 
+#include <atomic>
 #include <utility>
 #include <string>
 
@@ -24,6 +25,19 @@
 
 namespace mindspore {
 class ActorBase;
+class MessageBase;
+
+// The link of a message queued in an intrusive mailbox, it is owned by the mailbox and never copied with the message.
+class MailBoxLink {
+ public:
+  MailBoxLink() = default;
+  MailBoxLink(const MailBoxLink &) {}
+  MailBoxLink &operator=(const MailBoxLink &) { return *this; }
+  ~MailBoxLink() = default;
+
+  std::atomic<MessageBase *> next{nullptr};
+};
+
 class MessageBase {
  public:
   enum class Type : char {
@@ -79,6 +93,7 @@ class MessageBase {
   std::string name;
   std::string body;
   Type type;
+  MailBoxLink mailboxLink;
 };
 }  // namespace mindspore
 
@@ -17,8 +17,11 @@
 #ifndef MINDSPORE_CORE_MINDRT_INCLUDE_ASYNC_ASYNC_H
 #define MINDSPORE_CORE_MINDRT_INCLUDE_ASYNC_ASYNC_H
 
+#include <cstddef>
 #include <tuple>
 #include <memory>
+#include <new>
+#include <type_traits>
 #include <utility>
 
 #include "actor/actor.h"
@@ -30,17 +33,134 @@
 namespace mindspore {
 using MessageHandler = std::function<void(ActorBase *)>;
 
-class MessageAsync : public MessageBase {
+// A move only callable run on the destination actor. Callables up to kInlineSize bytes, which covers a member
+// function pointer with a few captured arguments, are stored in place, so an async message needs no allocation for
+// its handler. Larger callables fall back to the heap.
+class AsyncHandler {
  public:
-  explicit MessageAsync(MessageHandler &&h) : MessageBase("Async", Type::KASYNC), handler(h) {}
-  virtual ~MessageAsync() = default;
-  void Run(ActorBase *actor) override { (handler)(actor); }
+  static constexpr size_t kInlineSize = 64;
+
+  AsyncHandler() = default;
+  template <typename F, typename Fn = typename std::decay<F>::type,
+            typename = typename std::enable_if<!std::is_same<Fn, AsyncHandler>::value>::type>
+  AsyncHandler(F &&f) {  // NOLINT(runtime/explicit)
+    if constexpr (Manager<Fn>::kInline) {
+      (void)new (&storage_) Fn(std::forward<F>(f));
+    } else {
+      auto target = new (std::nothrow) Fn(std::forward<F>(f));
+      MINDRT_OOM_EXIT(target);
+      *reinterpret_cast<Fn **>(&storage_) = target;
+    }
+    ops_ = &Manager<Fn>::kOps;
+  }
+  AsyncHandler(AsyncHandler &&other) noexcept : ops_(other.ops_) {
+    if (ops_ != nullptr) {
+      ops_->relocate(&storage_, &other.storage_);
+      other.ops_ = nullptr;
+    }
+  }
+  AsyncHandler &operator=(AsyncHandler &&other) noexcept {
+    if (this != &other) {
+      Reset();
+      ops_ = other.ops_;
+      if (ops_ != nullptr) {
+        ops_->relocate(&storage_, &other.storage_);
+        other.ops_ = nullptr;
+      }
+    }
+    return *this;
+  }
+  AsyncHandler(const AsyncHandler &) = delete;
+  AsyncHandler &operator=(const AsyncHandler &) = delete;
+  ~AsyncHandler() { Reset(); }
+
+  explicit operator bool() const { return ops_ != nullptr; }
+  void operator()(ActorBase *actor) {
+    MINDRT_ASSERT(ops_ != nullptr);
+    ops_->invoke(&storage_, actor);
+  }
+
+ private:
+  struct Ops {
+    void (*invoke)(void *storage, ActorBase *actor);
+    // Move the callable from src storage into the uninitialized dst storage, and destroy the source.
+    void (*relocate)(void *dst, void *src);
+    void (*destroy)(void *storage);
+  };
+
+  template <typename Fn>
+  struct Manager {
+    static constexpr bool kInline = sizeof(Fn) <= kInlineSize && alignof(Fn) <= alignof(std::max_align_t) &&
+                                    std::is_nothrow_move_constructible<Fn>::value;
+    static Fn *Target(void *storage) {
+      if constexpr (kInline) {
+        return static_cast<Fn *>(storage);
+      } else {
+        return *static_cast<Fn **>(storage);
+      }
+    }
+    static void Invoke(void *storage, ActorBase *actor) { (*Target(storage))(actor); }
+    static void Relocate(void *dst, void *src) {
+      if constexpr (kInline) {
+        auto source = static_cast<Fn *>(src);
+        (void)new (dst) Fn(std::move(*source));
+        source->~Fn();
+      } else {
+        *static_cast<Fn **>(dst) = *static_cast<Fn **>(src);
+      }
+    }
+    static void Destroy(void *storage) {
+      if constexpr (kInline) {
+        static_cast<Fn *>(storage)->~Fn();
+      } else {
+        delete *static_cast<Fn **>(storage);
+      }
+    }
+    static constexpr Ops kOps{&Invoke, &Relocate, &Destroy};
+  };
+
+  void Reset() {
+    if (ops_ != nullptr) {
+      ops_->destroy(&storage_);
+      ops_ = nullptr;
+    }
+  }
+
+  typename std::aligned_storage<kInlineSize, alignof(std::max_align_t)>::type storage_;
+  const Ops *ops_{nullptr};
+};
+
+// The async messages are fixed size, so they are recycled through per thread caches instead of the global heap. The
+// caches exchange batches of free messages with a shared depot, because the messages are usually created on the
+// sending thread and freed on the thread running the destination actor.
+class MS_CORE_API MessageAsync final : public MessageBase {
+ public:
+  explicit MessageAsync(AsyncHandler &&h) : MessageBase("Async", Type::KASYNC), handler(std::move(h)) {}
+  ~MessageAsync() override = default;
+  void Run(ActorBase *actor) override { handler(actor); }
+
+  static void *operator new(size_t size);
+  static void *operator new(size_t size, const std::nothrow_t &) noexcept;
+  static void operator delete(void *ptr) noexcept;
+  static void operator delete(void *ptr, const std::nothrow_t &) noexcept;
 
  private:
-  MessageHandler handler;
+  AsyncHandler handler;
 };
 
 namespace internal {
+inline void SendAsync(const AID &aid, AsyncHandler &&handler) {
+  auto msg = std::unique_ptr<MessageBase>(new (std::nothrow) MessageAsync(std::move(handler)));
+  MINDRT_OOM_EXIT(msg);
+  (void)ActorMgr::GetActorMgrRef()->Send(aid, std::move(msg));
+}
+
+// Send to a local actor resolved in advance, which skips the name lookup of the actor manager.
+inline void SendAsync(ActorBase *actor, AsyncHandler &&handler) {
+  auto msg = std::unique_ptr<MessageBase>(new (std::nothrow) MessageAsync(std::move(handler)));
+  MINDRT_OOM_EXIT(msg);
+  (void)ActorMgr::GetActorMgrRef()->Send(actor, std::move(msg));
+}
 
 template <typename R>
 struct AsyncHelper;
@@ -50,10 +170,8 @@ template <>
 struct AsyncHelper<void> {
   template <typename F>
   void operator()(const AID &aid, F &&f) {
-    std::function<void(ActorBase *)> handler = [=](ActorBase *) { f(); };
-    auto msg = std::unique_ptr<MessageBase>(new (std::nothrow) MessageAsync(std::move(handler)));
-    MINDRT_OOM_EXIT(msg);
-    (void)ActorMgr::GetActorMgrRef()->Send(aid, std::move(msg));
+    auto handler = [=](ActorBase *) { f(); };
+    SendAsync(aid, std::move(handler));
   }
 };
 
@@ -65,11 +183,8 @@ struct AsyncHelper<Future<R>> {
     MINDRT_OOM_EXIT(promise);
     Future<R> future = promise->GetFuture();
 
-    MessageHandler handler = [=](ActorBase *) { promise->Associate(f()); };
-
-    auto msg = std::unique_ptr<MessageBase>(new (std::nothrow) MessageAsync(std::move(handler)));
-    MINDRT_OOM_EXIT(msg);
-    (void)ActorMgr::GetActorMgrRef()->Send(aid, std::move(msg));
+    auto handler = [=](ActorBase *) { promise->Associate(f()); };
+    SendAsync(aid, std::move(handler));
     return future;
   }
 };
@@ -82,10 +197,8 @@ struct AsyncHelper {
     MINDRT_OOM_EXIT(promise);
     Future<R> future = promise->GetFuture();
 
-    std::function<void(ActorBase *)> handler = [=](ActorBase *) { promise->SetValue(f()); };
-    auto msg = std::unique_ptr<MessageBase>(new (std::nothrow) MessageAsync(std::move(handler)));
-    MINDRT_OOM_EXIT(msg);
-    (void)ActorMgr::GetActorMgrRef()->Send(aid, std::move(msg));
+    auto handler = [=](ActorBase *) { promise->SetValue(f()); };
+    SendAsync(aid, std::move(handler));
     return future;
   }
 };
@@ -95,41 +208,35 @@ struct AsyncHelper {
 // return void
 template <typename T>
 void Async(const AID &aid, void (T::*method)()) {
-  std::function<void(ActorBase *)> handler = [method](ActorBase *actor) {
+  auto handler = [method](ActorBase *actor) {
     MINDRT_ASSERT(actor != nullptr);
     T *t = static_cast<T *>(actor);
     MINDRT_ASSERT(t != nullptr);
     (t->*method)();
   };
-  auto msg = std::unique_ptr<MessageBase>(new (std::nothrow) MessageAsync(std::move(handler)));
-  MINDRT_OOM_EXIT(msg);
-  (void)ActorMgr::GetActorMgrRef()->Send(aid, std::move(msg));
+  internal::SendAsync(aid, std::move(handler));
 }
 
 template <typename T, typename Arg0, typename Arg1>
 void Async(const AID &aid, void (T::*method)(Arg0), Arg1 &&arg) {
-  std::function<void(ActorBase *)> handler = [method, arg](ActorBase *actor) {
+  auto handler = [method, arg](ActorBase *actor) {
     MINDRT_ASSERT(actor != nullptr);
     T *t = static_cast<T *>(actor);
     MINDRT_ASSERT(t != nullptr);
     (t->*method)(arg);
   };
-  auto msg = std::unique_ptr<MessageBase>(new (std::nothrow) MessageAsync(std::move(handler)));
-  MINDRT_OOM_EXIT(msg);
-  (void)ActorMgr::GetActorMgrRef()->Send(aid, std::move(msg));
+  internal::SendAsync(aid, std::move(handler));
 }
 
 template <typename T, typename... Args0, typename... Args1>
 void Async(const AID &aid, void (T::*method)(Args0...), std::tuple<Args1...> &&tuple) {
-  std::function<void(ActorBase *)> handler = [method, tuple](ActorBase *actor) {
+  auto handler = [method, tuple = std::move(tuple)](ActorBase *actor) {
     MINDRT_ASSERT(actor != nullptr);
     T *t = static_cast<T *>(actor);
     MINDRT_ASSERT(t != nullptr);
     Apply(t, method, tuple);
   };
-  auto msg = std::unique_ptr<MessageBase>(new (std::nothrow) MessageAsync(std::move(handler)));
-  MINDRT_OOM_EXIT(msg);
-  (void)ActorMgr::GetActorMgrRef()->Send(aid, std::move(msg));
+  internal::SendAsync(aid, std::move(handler));
 }
 
 template <typename T, typename... Args0, typename... Args1>
@@ -138,6 +245,24 @@ void Async(const AID &aid, void (T::*method)(Args0...), Args1 &&... args) {
   Async(aid, method, std::move(tuple));
 }
 
+// Send to a local actor resolved in advance by ActorMgr::GetActor, the actor must stay spawned until the message runs.
+template <typename T, typename... Args0, typename... Args1>
+void Async(ActorBase *actor, void (T::*method)(Args0...), std::tuple<Args1...> &&tuple) {
+  MINDRT_ASSERT(actor != nullptr);
+  auto handler = [method, tuple = std::move(tuple)](ActorBase *to) {
+    T *t = static_cast<T *>(to);
+    MINDRT_ASSERT(t != nullptr);
+    Apply(t, method, tuple);
+  };
+  internal::SendAsync(actor, std::move(handler));
+}
+
+template <typename T, typename... Args0, typename... Args1>
+void Async(ActorBase *actor, void (T::*method)(Args0...), Args1 &&... args) {
+  auto tuple = std::make_tuple(std::forward<Args1>(args)...);
+  Async(actor, method, std::move(tuple));
+}
+
 // return future
 template <typename R, typename T>
 Future<R> Async(const AID &aid, Future<R> (T::*method)()) {
@@ -145,15 +270,13 @@ Future<R> Async(const AID &aid, Future<R> (T::*method)()) {
   MINDRT_OOM_EXIT(promise);
   Future<R> future = promise->GetFuture();
 
-  std::function<void(ActorBase *)> handler = [promise, method](ActorBase *actor) {
+  auto handler = [promise, method](ActorBase *actor) {
     MINDRT_ASSERT(actor != nullptr);
     T *t = static_cast<T *>(actor);
     MINDRT_ASSERT(t != nullptr);
     promise->Associate((t->*method)());
   };
-  std::unique_ptr<MessageBase> msg(new (std::nothrow) MessageAsync(std::move(handler)));
-  MINDRT_OOM_EXIT(msg);
-  (void)ActorMgr::GetActorMgrRef()->Send(aid, std::move(msg));
+  internal::SendAsync(aid, std::move(handler));
   return future;
 }
 
@@ -163,16 +286,13 @@ Future<R> Async(const AID &aid, Future<R> (T::*method)(Arg0), Arg1 &&arg) {
   MINDRT_OOM_EXIT(promise);
   Future<R> future = promise->GetFuture();
 
-  std::function<void(ActorBase *)> handler = [promise, method, arg](ActorBase *actor) {
+  auto handler = [promise, method, arg](ActorBase *actor) {
     MINDRT_ASSERT(actor != nullptr);
     T *t = static_cast<T *>(actor);
     MINDRT_ASSERT(t != nullptr);
     promise->Associate((t->*method)(arg));
   };
-
-  auto msg = std::unique_ptr<MessageBase>(new (std::nothrow) MessageAsync(std::move(handler)));
-  MINDRT_OOM_EXIT(msg);
-  (void)ActorMgr::GetActorMgrRef()->Send(aid, std::move(msg));
+  internal::SendAsync(aid, std::move(handler));
   return future;
 }
 
@@ -182,16 +302,13 @@ Future<R> Async(const AID &aid, Future<R> (T::*method)(Args0...), std::tuple<Arg
   MINDRT_OOM_EXIT(promise);
   Future<R> future = promise->GetFuture();
 
-  std::function<void(ActorBase *)> handler = [promise, method, tuple](ActorBase *actor) {
+  auto handler = [promise, method, tuple = std::move(tuple)](ActorBase *actor) {
     MINDRT_ASSERT(actor != nullptr);
     T *t = static_cast<T *>(actor);
     MINDRT_ASSERT(t != nullptr);
     promise->Associate(Apply(t, method, tuple));
   };
-
-  auto msg = std::unique_ptr<MessageBase>(new (std::nothrow) MessageAsync(std::move(handler)));
-  MINDRT_OOM_EXIT(msg);
-  (void)ActorMgr::GetActorMgrRef()->Send(aid, std::move(msg));
+  internal::SendAsync(aid, std::move(handler));
   return future;
 }
 
@@ -209,16 +326,13 @@ Future<R> Async(const AID &aid, R (T::*method)()) {
   MINDRT_OOM_EXIT(promise);
   Future<R> future = promise->GetFuture();
 
-  std::function<void(ActorBase *)> handler = [promise, method](ActorBase *actor) {
+  auto handler = [promise, method](ActorBase *actor) {
     MINDRT_ASSERT(actor != nullptr);
     T *t = static_cast<T *>(actor);
     MINDRT_ASSERT(t != nullptr);
     promise->SetValue((t->*method)());
   };
-
-  std::unique_ptr<MessageBase> msg(new (std::nothrow) MessageAsync(std::move(handler)));
-  MINDRT_OOM_EXIT(msg);
-  (void)ActorMgr::GetActorMgrRef()->Send(aid, std::move(msg));
+  internal::SendAsync(aid, std::move(handler));
   return future;
 }
 
@@ -230,15 +344,13 @@ Future<R> Async(const AID &aid, R (T::*method)(Arg0), Arg1 &&arg) {
   MINDRT_OOM_EXIT(promise);
   Future<R> future = promise->GetFuture();
 
-  std::function<void(ActorBase *)> handler = [promise, method, arg](ActorBase *actor) {
+  auto handler = [promise, method, arg](ActorBase *actor) {
     MINDRT_ASSERT(actor != nullptr);
     T *t = static_cast<T *>(actor);
     MINDRT_ASSERT(t != nullptr);
     promise->SetValue((t->*method)(arg));
   };
-  auto msg = std::unique_ptr<MessageBase>(new (std::nothrow) MessageAsync(std::move(handler)));
-  MINDRT_OOM_EXIT(msg);
-  (void)ActorMgr::GetActorMgrRef()->Send(aid, std::move(msg));
+  internal::SendAsync(aid, std::move(handler));
   return future;
 }
 
@@ -250,15 +362,13 @@ Future<R> Async(const AID &aid, R (T::*method)(Args0...), std::tuple<Args1...> &
   MINDRT_OOM_EXIT(promise);
   Future<R> future = promise->GetFuture();
 
-  std::function<void(ActorBase *)> handler = [promise, method, tuple](ActorBase *actor) {
+  auto handler = [promise, method, tuple = std::move(tuple)](ActorBase *actor) {
     MINDRT_ASSERT(actor != nullptr);
     T *t = static_cast<T *>(actor);
     MINDRT_ASSERT(t != nullptr);
     promise->SetValue(Apply(t, method, tuple));
   };
-  auto msg = std::unique_ptr<MessageBase>(new (std::nothrow) MessageAsync(std::move(handler)));
-  MINDRT_OOM_EXIT(msg);
-  (void)ActorMgr::GetActorMgrRef()->Send(aid, std::move(msg));
+  internal::SendAsync(aid, std::move(handler));
   return future;
 }
 
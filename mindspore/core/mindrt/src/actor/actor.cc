@@ -141,10 +141,18 @@ void ActorBase::Run() {
       msgs->clear();
     }
   } else {
+    size_t msgNum = 0;
     while (auto msg = mailbox->GetMsg()) {
       if (msgHandler(msg) == ACTOR_TERMINATED) {
         return;
       }
+      if (!mailbox->DoneMsg()) {
+        return;
+      }
+      // Take the pending messages in one run, but no more than MAX_MSG_NUM_PER_RUN to let the other ready actors run.
+      if (++msgNum >= MAX_MSG_NUM_PER_RUN && mailbox->Reschedule()) {
+        return;
+      }
     }
   }
   return;
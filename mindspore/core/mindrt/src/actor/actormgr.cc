@@ -226,6 +226,13 @@ int ActorMgr::Send(const AID &to, std::unique_ptr<MessageBase> msg, bool remoteL
   }
 }
 
+int ActorMgr::Send(ActorBase *to, std::unique_ptr<MessageBase> msg) const {
+  if (to == nullptr) {
+    return ACTOR_NOT_FIND;
+  }
+  return to->EnqueMessage(std::move(msg));
+}
+
 AID ActorMgr::Spawn(const ActorReference &actor, bool shareThread) {
   actorsMutex.lock();
   if (actors.find(actor->GetAID().Name()) != actors.end()) {
@@ -236,7 +243,7 @@ AID ActorMgr::Spawn(const ActorReference &actor, bool shareThread) {
   MS_LOG(DEBUG) << "ACTOR was spawned,a=" << actor->GetAID().Name().c_str();
 
   if (shareThread) {
-    auto mailbox = std::unique_ptr<MailBox>(new (std::nothrow) NonblockingMailBox());
+    auto mailbox = std::unique_ptr<MailBox>(new (std::nothrow) MpscMailBox());
     auto hook = std::unique_ptr<std::function<void()>>(
       new std::function<void()>([actor]() { ActorMgr::GetActorMgrRef()->SetActorReady(actor); }));
     // the mailbox has this hook, the hook holds the actor reference, the actor has the mailbox. this is a cycle which
@@ -61,6 +61,8 @@ class MS_CORE_API ActorMgr {
   void AddUrl(const std::string &protocol, const std::string &url);
   void AddIOMgr(const std::string &protocol, const std::shared_ptr<IOMgr> &ioMgr);
   int Send(const AID &to, std::unique_ptr<MessageBase> msg, bool remoteLink = false, bool isExactNotRemote = false);
+  // Send to a local actor resolved by GetActor in advance, which skips the name lookup.
+  int Send(ActorBase *to, std::unique_ptr<MessageBase> msg) const;
   AID Spawn(const ActorReference &actor, bool shareThread = true);
   void Terminate(const AID &id);
   void TerminateAll();
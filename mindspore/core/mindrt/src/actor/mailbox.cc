@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 #include "actor/mailbox.h"
+#include <thread>
 
 namespace mindspore {
 int BlockingMailBox::EnqueueMessage(std::unique_ptr<mindspore::MessageBase> msg) {
@@ -85,4 +86,76 @@ std::unique_ptr<MessageBase> HQueMailBox::GetMsg() {
   std::unique_ptr<MessageBase> msg(mailbox.Dequeue());
   return msg;
 }
+
+MpscMailBox::~MpscMailBox() {
+  while (auto msg = Pop()) {
+    delete msg;
+  }
+}
+
+void MpscMailBox::Push(MessageBase *msg) {
+  msg->mailboxLink.next.store(nullptr, std::memory_order_relaxed);
+  auto prev = head.exchange(msg, std::memory_order_acq_rel);
+  prev->mailboxLink.next.store(msg, std::memory_order_release);
+}
+
+MessageBase *MpscMailBox::Pop() {
+  auto first = tail;
+  auto next = first->mailboxLink.next.load(std::memory_order_acquire);
+  if (first == &stub) {
+    if (next == nullptr) {
+      return nullptr;
+    }
+    tail = next;
+    first = next;
+    next = next->mailboxLink.next.load(std::memory_order_acquire);
+  }
+  if (next != nullptr) {
+    tail = next;
+    return first;
+  }
+  // A producer has exchanged the head but not linked its message yet.
+  if (first != head.load(std::memory_order_acquire)) {
+    return nullptr;
+  }
+  // The last message can be taken only after the stub is queued behind it.
+  Push(&stub);
+  next = first->mailboxLink.next.load(std::memory_order_acquire);
+  if (next != nullptr) {
+    tail = next;
+    return first;
+  }
+  return nullptr;
+}
+
+int MpscMailBox::EnqueueMessage(std::unique_ptr<MessageBase> msg) {
+  Push(msg.release());
+  if (pendingNum.fetch_add(1, std::memory_order_acq_rel) == 0 && notifyHook) {
+    (*notifyHook.get())();
+  }
+  return 0;
+}
+
+std::unique_ptr<MessageBase> MpscMailBox::GetMsg() {
+  if (pendingNum.load(std::memory_order_acquire) == 0) {
+    return nullptr;
+  }
+  // The message is counted, wait for the producer to finish linking it.
+  MessageBase *msg = Pop();
+  while (msg == nullptr) {
+    std::this_thread::yield();
+    msg = Pop();
+  }
+  return std::unique_ptr<MessageBase>(msg);
+}
+
+bool MpscMailBox::DoneMsg() { return pendingNum.fetch_sub(1, std::memory_order_acq_rel) > 1; }
+
+bool MpscMailBox::Reschedule() {
+  if (notifyHook == nullptr) {
+    return false;
+  }
+  (*notifyHook.get())();
+  return true;
+}
 }  // namespace mindspore
@@ -16,6 +16,7 @@
 
 #ifndef MINDSPORE_MAILBOX_H
 #define MINDSPORE_MAILBOX_H
+#include <atomic>
 #include <list>
 #include <memory>
 #include <mutex>
@@ -34,6 +35,10 @@ class MailBox {
   virtual std::unique_ptr<MessageBase> GetMsg() = 0;
   inline void SetNotifyHook(std::unique_ptr<std::function<void()>> &&hook) { notifyHook = std::move(hook); }
   inline bool TakeAllMsgsEachTime() { return takeAllMsgsEachTime; }
+  // Called after the message taken by GetMsg is handled, returns whether there are more messages to take.
+  virtual bool DoneMsg() { return true; }
+  // Schedule the actor again to take the remaining messages later, returns whether it is scheduled.
+  virtual bool Reschedule() { return false; }
   void SwapMailBox(std::list<std::unique_ptr<MessageBase>> **box1, std::list<std::unique_ptr<MessageBase>> **box2) {
     std::list<std::unique_ptr<MessageBase>> *tmp = *box1;
     *box1 = *box2;
@@ -87,6 +92,33 @@ class NonblockingMailBox : public MailBox {
   bool released_ = true;
 };
 
+// A lock free multi producer single consumer mailbox which links the messages through MessageBase::mailboxLink, so
+// that enqueuing needs neither a lock nor an allocation. The number of pending messages decides who runs the actor:
+// the enqueue taking it from zero notifies the hook to schedule the actor, and the actor keeps taking messages until
+// DoneMsg brings it back to zero. So the actor is never run by two threads at the same time.
+class MpscMailBox : public MailBox {
+ public:
+  MpscMailBox() : head(&stub), tail(&stub) { takeAllMsgsEachTime = false; }
+  ~MpscMailBox() override;
+  int EnqueueMessage(std::unique_ptr<MessageBase> msg) override;
+  std::list<std::unique_ptr<MessageBase>> *GetMsgs() override { return nullptr; }
+  std::unique_ptr<MessageBase> GetMsg() override;
+  bool DoneMsg() override;
+  bool Reschedule() override;
+
+ private:
+  static constexpr size_t kCacheLineSize = 64;
+  void Push(MessageBase *msg);
+  MessageBase *Pop();
+
+  MessageBase stub;
+  // Written by the producers.
+  alignas(kCacheLineSize) std::atomic<MessageBase *> head;
+  std::atomic<size_t> pendingNum{0};
+  // Only accessed by the thread running the actor.
+  alignas(kCacheLineSize) MessageBase *tail;
+};
+
 class HQueMailBox : public MailBox {
  public:
   HQueMailBox() { takeAllMsgsEachTime = false; }
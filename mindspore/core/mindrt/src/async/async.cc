@@ -0,0 +1,145 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "async/async.h"
+#include <mutex>
+#include <vector>
+
+namespace mindspore {
+namespace {
+// A thread keeps at most kLocalCacheLimit free messages, and gives kTransferBatch of them back to the depot when the
+// limit is reached. A receiving thread would otherwise gather all the messages sent by the other threads.
+constexpr size_t kLocalCacheLimit = 256;
+constexpr size_t kTransferBatch = 128;
+static_assert(kTransferBatch < kLocalCacheLimit, "The transfer batch must be smaller than the cache limit.");
+
+struct FreeMessage {
+  FreeMessage *next;
+};
+static_assert(sizeof(FreeMessage) <= sizeof(MessageAsync), "A free message must fit in a MessageAsync.");
+
+struct FreeBatch {
+  FreeMessage *head;
+  size_t count;
+};
+
+class MessageAsyncDepot {
+ public:
+  static MessageAsyncDepot &GetInstance() {
+    // Never destroyed, the thread caches may flush into it while the process exits.
+    static auto *depot = new MessageAsyncDepot();
+    return *depot;
+  }
+
+  void Push(const FreeBatch &batch) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    batches_.push_back(batch);
+  }
+
+  FreeBatch Pop() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (batches_.empty()) {
+      return {nullptr, 0};
+    }
+    auto batch = batches_.back();
+    batches_.pop_back();
+    return batch;
+  }
+
+ private:
+  MessageAsyncDepot() = default;
+  std::mutex mutex_;
+  std::vector<FreeBatch> batches_;
+};
+
+// The cache is plain thread local data, so that it stays usable while the thread local objects are destroyed. The
+// guard returns the cached messages to the depot when the thread exits, later frees on this thread go to the depot.
+thread_local FreeBatch local_cache = {nullptr, 0};
+thread_local bool local_cache_released = false;
+
+class LocalCacheGuard {
+ public:
+  LocalCacheGuard() = default;
+  ~LocalCacheGuard() {
+    if (local_cache.head != nullptr) {
+      MessageAsyncDepot::GetInstance().Push(local_cache);
+    }
+    local_cache = {nullptr, 0};
+    local_cache_released = true;
+  }
+  void Touch() const {}
+};
+
+thread_local LocalCacheGuard local_cache_guard;
+
+void *AllocateMessage() {
+  if (local_cache.head == nullptr && !local_cache_released) {
+    local_cache_guard.Touch();
+    local_cache = MessageAsyncDepot::GetInstance().Pop();
+  }
+  auto message = local_cache.head;
+  if (message == nullptr) {
+    return ::operator new(sizeof(MessageAsync), std::nothrow);
+  }
+  local_cache.head = message->next;
+  --local_cache.count;
+  return message;
+}
+
+void FreeMessageAsync(void *ptr) {
+  if (ptr == nullptr) {
+    return;
+  }
+  auto message = static_cast<FreeMessage *>(ptr);
+  if (local_cache_released) {
+    message->next = nullptr;
+    MessageAsyncDepot::GetInstance().Push({message, 1});
+    return;
+  }
+  local_cache_guard.Touch();
+  message->next = local_cache.head;
+  local_cache.head = message;
+  if (++local_cache.count < kLocalCacheLimit) {
+    return;
+  }
+  // Detach the first kTransferBatch messages and give them to the depot.
+  FreeBatch batch = {local_cache.head, kTransferBatch};
+  auto tail = local_cache.head;
+  for (size_t i = 1; i < kTransferBatch; ++i) {
+    tail = tail->next;
+  }
+  local_cache.head = tail->next;
+  local_cache.count -= kTransferBatch;
+  tail->next = nullptr;
+  MessageAsyncDepot::GetInstance().Push(batch);
+}
+}  // namespace
+
+void *MessageAsync::operator new(size_t size) {
+  auto ptr = MessageAsync::operator new(size, std::nothrow);
+  if (ptr == nullptr) {
+    throw std::bad_alloc();
+  }
+  return ptr;
+}
+
+// MessageAsync is final, so the requested size is always sizeof(MessageAsync).
+void *MessageAsync::operator new(size_t, const std::nothrow_t &) noexcept { return AllocateMessage(); }
+
+void MessageAsync::operator delete(void *ptr) noexcept { FreeMessageAsync(ptr); }
+
+void MessageAsync::operator delete(void *ptr, const std::nothrow_t &) noexcept { FreeMessageAsync(ptr); }
+}  // namespace mindspore
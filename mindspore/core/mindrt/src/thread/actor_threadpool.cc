@@ -21,15 +21,45 @@
 #include "thread/core_affinity.h"
 
 namespace mindspore {
-constexpr size_t MAX_READY_ACTOR_NR = 4096;
-void ActorWorker::CreateThread(ActorThreadPool *pool) {
+namespace {
+// The actor worker running on the current thread, used to put the actors it makes ready into its own queue.
+thread_local ActorWorker *current_actor_worker = nullptr;
+}  // namespace
+
+void ActorReadyQueue::Push(ActorBase *actor) {
+  lock_.Lock();
+  actors_.push_back({actor->priority(), sequence_++, actor});
+  std::push_heap(actors_.begin(), actors_.end(), ReadyActorCompare());
+  size_.store(actors_.size(), std::memory_order_release);
+  lock_.Unlock();
+}
+
+ActorBase *ActorReadyQueue::Pop() {
+  if (Empty()) {
+    return nullptr;
+  }
+  ActorBase *actor = nullptr;
+  lock_.Lock();
+  if (!actors_.empty()) {
+    std::pop_heap(actors_.begin(), actors_.end(), ReadyActorCompare());
+    actor = actors_.back().actor_;
+    actors_.pop_back();
+    size_.store(actors_.size(), std::memory_order_release);
+  }
+  lock_.Unlock();
+  return actor;
+}
+
+void ActorWorker::CreateThread(ActorThreadPool *pool, size_t index) {
   THREAD_RETURN_IF_NULL(pool);
   pool_ = pool;
+  index_ = index;
   thread_ = std::thread(&ActorWorker::RunWithSpin, this);
 }
 
 void ActorWorker::RunWithSpin() {
   SetAffinity();
+  current_actor_worker = this;
 #if !defined(__APPLE__) && !defined(SUPPORT_MSVC)
   static std::atomic_int index = {0};
   (void)pthread_setname_np(pthread_self(), ("ActorThread_" + std::to_string(index++)).c_str());
@@ -55,7 +85,7 @@ void ActorWorker::RunWithSpin() {
 
 bool ActorWorker::RunQueueActorTask() {
   THREAD_ERROR_IF_NULL(pool_);
-  auto actor = pool_->PopActorFromQueue();
+  auto actor = pool_->PopActorFromQueue(index_);
   if (actor == nullptr) {
     return false;
   }
@@ -76,19 +106,23 @@ bool ActorWorker::ActorActive() {
   return true;
 }
 
+void ActorWorker::Stop() {
+  {
+    std::lock_guard<std::mutex> _l(mutex_);
+    alive_ = false;
+  }
+  cond_var_.notify_one();
+  if (thread_.joinable()) {
+    thread_.join();
+  }
+}
+
 ActorThreadPool::~ActorThreadPool() {
   // wait until actor queue is empty
   bool terminate = false;
   int count = 0;
   do {
-    {
-#ifdef USE_HQUEUE
-      terminate = actor_queue_.Empty();
-#else
-      std::lock_guard<std::mutex> _l(actor_mutex_);
-      terminate = actor_queue_.empty();
-#endif
-    }
+    terminate = ActorQueueEmpty();
     if (!terminate) {
       for (auto &worker : workers_) {
         worker->Active();
@@ -96,42 +130,59 @@ ActorThreadPool::~ActorThreadPool() {
       std::this_thread::yield();
     }
   } while (!terminate && count++ < kMaxCount);
+  for (size_t i = 0; i < actor_thread_num_ && i < workers_.size(); ++i) {
+    reinterpret_cast<ActorWorker *>(workers_[i])->Stop();
+  }
   for (auto &worker : workers_) {
     delete worker;
     worker = nullptr;
   }
   workers_.clear();
-#ifdef USE_HQUEUE
-  actor_queue_.Clean();
-#endif
 }
 
-ActorBase *ActorThreadPool::PopActorFromQueue() {
-#ifdef USE_HQUEUE
-  return actor_queue_.Dequeue();
-#else
-  std::lock_guard<std::mutex> _l(actor_mutex_);
-  if (actor_queue_.empty()) {
-    return nullptr;
+bool ActorThreadPool::ActorQueueEmpty() const {
+  if (!actor_queue_.Empty()) {
+    return false;
   }
-  auto actor = actor_queue_.front();
-  actor_queue_.pop();
-  return actor;
-#endif
+  for (size_t i = 0; i < actor_thread_num_ && i < workers_.size(); ++i) {
+    auto worker = reinterpret_cast<ActorWorker *>(workers_[i]);
+    if (!worker->ready_queue()->Empty()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+ActorBase *ActorThreadPool::PopActorFromQueue(size_t worker_index) {
+  auto worker = reinterpret_cast<ActorWorker *>(workers_[worker_index]);
+  auto actor = worker->ready_queue()->Pop();
+  if (actor != nullptr) {
+    return actor;
+  }
+  actor = actor_queue_.Pop();
+  if (actor != nullptr) {
+    return actor;
+  }
+  // Steal from the other threads, starting from the next one to spread the stealing threads.
+  for (size_t i = 1; i < actor_thread_num_; ++i) {
+    auto victim = reinterpret_cast<ActorWorker *>(workers_[(worker_index + i) % actor_thread_num_]);
+    actor = victim->ready_queue()->Pop();
+    if (actor != nullptr) {
+      return actor;
+    }
+  }
+  return nullptr;
 }
 
 void ActorThreadPool::PushActorToQueue(ActorBase *actor) {
   if (!actor) {
     return;
   }
-  {
-#ifdef USE_HQUEUE
-    while (!actor_queue_.Enqueue(actor)) {
-    }
-#else
-    std::lock_guard<std::mutex> _l(actor_mutex_);
-    actor_queue_.push(actor);
-#endif
+  auto worker = current_actor_worker;
+  if (worker != nullptr && worker->pool() == this) {
+    worker->ready_queue()->Push(actor);
+  } else {
+    actor_queue_.Push(actor);
   }
   THREAD_DEBUG("actor[%s] enqueue success", actor->GetAID().Name().c_str());
   // active one idle actor thread if exist
@@ -144,12 +195,6 @@ void ActorThreadPool::PushActorToQueue(ActorBase *actor) {
 }
 
 int ActorThreadPool::CreateThreads(size_t actor_thread_num, size_t all_thread_num, const std::vector<int> &core_list) {
-#ifdef USE_HQUEUE
-  if (actor_queue_.Init(MAX_READY_ACTOR_NR) != true) {
-    THREAD_ERROR("init actor queue failed.");
-    return THREAD_ERROR;
-  }
-#endif
   if (affinity_ != nullptr) {
     affinity_->SetCoreId(core_list);
   }
@@ -160,14 +205,21 @@ int ActorThreadPool::CreateThreads(size_t actor_thread_num, size_t all_thread_nu
     THREAD_ERROR("thread num is invalid");
     return THREAD_ERROR;
   }
-  for (size_t i = 0; i < actor_thread_num_; ++i) {
+  // The actor threads steal from each other through workers_, so all the actor workers are created before any thread
+  // starts, and the kernel workers appended later don't reallocate workers_.
+  {
     std::lock_guard<std::mutex> _l(pool_mutex_);
-    auto worker = new (std::nothrow) ActorWorker();
-    THREAD_ERROR_IF_NULL(worker);
-    worker->InitWorkerMask(core_list, workers_.size());
-    worker->CreateThread(this);
-    workers_.push_back(worker);
-    THREAD_INFO("create actor thread[%zu]", i);
+    workers_.reserve(workers_.size() + all_thread_num);
+    for (size_t i = 0; i < actor_thread_num_; ++i) {
+      auto worker = new (std::nothrow) ActorWorker();
+      THREAD_ERROR_IF_NULL(worker);
+      worker->InitWorkerMask(core_list, workers_.size());
+      workers_.push_back(worker);
+    }
+    for (size_t i = 0; i < actor_thread_num_; ++i) {
+      reinterpret_cast<ActorWorker *>(workers_[i])->CreateThread(this, i);
+      THREAD_INFO("create actor thread[%zu]", i);
+    }
   }
   size_t kernel_thread_num = all_thread_num - actor_thread_num_;
   if (kernel_thread_num > 0) {
@@ -17,7 +17,7 @@
 #ifndef MINDSPORE_CORE_MINDRT_RUNTIME_ACTOR_THREADPOOL_H_
 #define MINDSPORE_CORE_MINDRT_RUNTIME_ACTOR_THREADPOOL_H_
 
-#include <queue>
+#include <algorithm>
 #include <vector>
 #include <mutex>
 #include <atomic>
@@ -25,20 +25,55 @@
 #include "thread/threadpool.h"
 #include "thread/core_affinity.h"
 #include "actor/actor.h"
-#include "thread/hqueue.h"
-#define USE_HQUEUE
+#include "async/spinlock.h"
 namespace mindspore {
 class ActorThreadPool;
+
+// A queue of ready actors, which pops the actor with the highest priority and keeps the pushing order among the actors
+// with the same priority. The size is kept apart, so that the idle threads looking for actors to steal don't touch the
+// lock of the empty queues.
+class ActorReadyQueue {
+ public:
+  void Push(ActorBase *actor);
+  ActorBase *Pop();
+  bool Empty() const { return size_.load(std::memory_order_acquire) == 0; }
+
+ private:
+  struct ReadyActor {
+    int64_t priority_;
+    uint64_t sequence_;
+    ActorBase *actor_;
+  };
+  // The top of the heap is the actor with the highest priority, pushed first.
+  struct ReadyActorCompare {
+    bool operator()(const ReadyActor &lhs, const ReadyActor &rhs) const {
+      return lhs.priority_ != rhs.priority_ ? lhs.priority_ < rhs.priority_ : lhs.sequence_ > rhs.sequence_;
+    }
+  };
+
+  SpinLock lock_;
+  std::vector<ReadyActor> actors_;
+  uint64_t sequence_{0};
+  std::atomic<size_t> size_{0};
+};
+
 class ActorWorker : public Worker {
  public:
-  void CreateThread(ActorThreadPool *pool);
+  void CreateThread(ActorThreadPool *pool, size_t index);
   bool ActorActive();
+  // Stop and join the thread, so that it no longer steals from the other actor threads.
+  void Stop();
+  ActorReadyQueue *ready_queue() { return &ready_queue_; }
+  const ActorThreadPool *pool() const { return pool_; }
 
  private:
   void RunWithSpin();
   bool RunQueueActorTask();
 
   ActorThreadPool *pool_{nullptr};
+  size_t index_{0};
+  // The actors made ready by this thread, which are run by this thread first and stolen by the idle threads.
+  ActorReadyQueue ready_queue_;
 };
 
 class ActorThreadPool : public ThreadPool {
@@ -52,21 +87,20 @@ class ActorThreadPool : public ThreadPool {
   static ActorThreadPool *CreateThreadPool(size_t thread_num);
   ~ActorThreadPool() override;
 
+  // The actor made ready by an actor thread of this pool goes to the queue of that thread, otherwise to the shared
+  // queue.
   void PushActorToQueue(ActorBase *actor);
-  ActorBase *PopActorFromQueue();
+  // Take the actor from the queue of the worker, then the shared queue, then steal from the other actor threads. The
+  // actor with the highest priority is taken from each queue.
+  ActorBase *PopActorFromQueue(size_t worker_index);
 
  private:
   ActorThreadPool() {}
   int CreateThreads(size_t actor_thread_num, size_t all_thread_num, const std::vector<int> &core_list);
+  bool ActorQueueEmpty() const;
   size_t actor_thread_num_{0};
 
-  std::mutex actor_mutex_;
-  std::condition_variable actor_cond_;
-#ifdef USE_HQUEUE
-  HQueue<ActorBase> actor_queue_;
-#else
-  std::queue<ActorBase *> actor_queue_;
-#endif
+  ActorReadyQueue actor_queue_;
 };
 }  // namespace mindspore
 #endif  // MINDSPORE_CORE_MINDRT_RUNTIME_ACTOR_THREADPOOL_H_
@@ -994,6 +994,10 @@ def set_ps_context(**kwargs):
         enable_ssl (bool): Set PS SSL mode enabled or disabled. Default: False.
         client_password (str): Password to decrypt the secret key stored in the client certificate. Default: ''.
         server_password (str): Password to decrypt the secret key stored in the server certificate. Default: ''.
+        gradient_compression (str): The compression of the dense gradients pushed to the servers, in the format of
+                                    "[param_name=]method;...". The method is one of "none", "topk:<ratio>",
+                                    "randomk:<ratio>", "int8" and "1bit", and the one without the parameter name
+                                    applies to all the parameters. Default: ''.
 
     Raises:
         ValueError: If input key is not the attribute in parameter server training mode context.
@@ -77,7 +77,8 @@ _set_ps_context_func_map = {
     "sign_eps": ps_context().set_sign_eps,
     "sign_thr_ratio": ps_context().set_sign_thr_ratio,
     "sign_global_lr": ps_context().set_sign_global_lr,
-    "sign_dim_out": ps_context().set_sign_dim_out
+    "sign_dim_out": ps_context().set_sign_dim_out,
+    "gradient_compression": ps_context().set_gradient_compression
 }
 
 _get_ps_context_func_map = {
@@ -124,7 +125,8 @@ _get_ps_context_func_map = {
     "sign_eps": ps_context().sign_eps,
     "sign_thr_ratio": ps_context().sign_thr_ratio,
     "sign_global_lr": ps_context().sign_global_lr,
-    "sign_dim_out": ps_context().sign_dim_out
+    "sign_dim_out": ps_context().sign_dim_out,
+    "gradient_compression": ps_context().gradient_compression
 }
 
 _check_positive_int_keys = ["server_num", "scheduler_port", "fl_server_port",
@@ -174,6 +176,10 @@ def _set_ps_context(**kwargs):
         enable_ssl (bool): Set PS SSL mode enabled or disabled. Default: False.
         client_password (str): Password to decrypt the secret key stored in the client certificate. Default: ''.
         server_password (str): Password to decrypt the secret key stored in the server certificate. Default: ''.
+        gradient_compression (str): The compression of the dense gradients pushed to the servers, in the format of
+                                    "[param_name=]method;...". The method is one of "none", "topk:<ratio>",
+                                    "randomk:<ratio>", "int8" and "1bit", and the one without the parameter name
+                                    applies to all the parameters. Default: ''.
 
     Raises:
         ValueError: If input key is not the attribute in parameter server training mode context.
@@ -0,0 +1,306 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cstdlib>
+#include <map>
+#include <memory>
+#include <vector>
+
+#include "common/common_test.h"
+#define private public
+#define protected public
+#include "common/mem_reuse/mem_dynamic_allocator.h"
+#undef private
+#undef protected
+
+namespace mindspore {
+namespace device {
+namespace {
+constexpr size_t kKB = 1 << 10;
+constexpr size_t kMB = 1 << 20;
+// The free device memory must not be smaller than the minimum alloc size 10MB when adding the memory block.
+constexpr size_t kDeviceMemSize = 32 * kMB;
+// The device memory is divided into the memory blocks of the alloc unit size.
+constexpr size_t kBlockNum = 4;
+constexpr size_t kBlockSize = kDeviceMemSize / kBlockNum;
+}  // namespace
+
+// The memory pool which allocates the host memory as the device memory of limited size.
+class TestDynamicMemPool : public DynamicMemPoolBestFit {
+ public:
+  TestDynamicMemPool() { SetMemAllocUintSize(kBlockSize, kBlockSize); }
+  ~TestDynamicMemPool() override { ReleaseDeviceRes(); }
+
+  size_t AllocDeviceMem(size_t size, DeviceMemPtr *addr) override {
+    if (used_device_mem_size_ + size > kDeviceMemSize) {
+      return 0;
+    }
+    *addr = malloc(size);
+    if (*addr == nullptr) {
+      return 0;
+    }
+    device_mem_sizes_[*addr] = size;
+    used_device_mem_size_ += size;
+    ++alloc_device_mem_num_;
+    return size;
+  }
+  bool FreeDeviceMem(const DeviceMemPtr &addr) override {
+    used_device_mem_size_ -= device_mem_sizes_[addr];
+    (void)device_mem_sizes_.erase(addr);
+    free(addr);
+    ++free_device_mem_num_;
+    return true;
+  }
+  size_t free_mem_size() override { return kDeviceMemSize - used_device_mem_size_; }
+  bool ReleaseDeviceMem(const DeviceMemPtr &addr, size_t) override {
+    if (!support_release_) {
+      return false;
+    }
+    ++release_device_mem_num_;
+    return FreeDeviceMem(addr);
+  }
+
+  bool support_release_{true};
+  size_t release_device_mem_num_{0};
+  std::map<DeviceMemPtr, size_t> device_mem_sizes_;
+  size_t used_device_mem_size_{0};
+  size_t alloc_device_mem_num_{0};
+  size_t free_device_mem_num_{0};
+};
+
+class DynamicMemPoolBestFitTest : public UT::Common {
+ public:
+  DynamicMemPoolBestFitTest() = default;
+
+  void SetUp() override { mem_pool_ = std::make_shared<TestDynamicMemPool>(); }
+  void TearDown() override { mem_pool_ = nullptr; }
+
+  // Fill the device memory by the memory blocks of the same size, and free them.
+  void FillAndFreeDeviceMem(size_t block_num) {
+    auto block_size = kDeviceMemSize / block_num;
+    mem_pool_->SetMemAllocUintSize(block_size, block_size);
+    std::vector<DeviceMemPtr> addrs;
+    for (size_t i = 0; i < block_num; ++i) {
+      addrs.push_back(mem_pool_->AllocTensorMem(block_size));
+      ASSERT_NE(addrs.back(), nullptr);
+    }
+    EXPECT_EQ(mem_pool_->free_mem_size(), 0);
+    for (auto addr : addrs) {
+      mem_pool_->FreeTensorMem(addr);
+    }
+    EXPECT_EQ(mem_pool_->FragmentationStatistics().idle_block_count_, block_num);
+  }
+
+  std::shared_ptr<TestDynamicMemPool> mem_pool_;
+};
+
+/// Feature: the size-classed cache of small memory bufs in the dynamic memory pool.
+/// Description: free the small memory bufs and alloc them again in the same and the other size classes.
+/// Expectation: the freed memory buf is fetched from the cache by the alloc of the same size class only, and the
+/// memory buf larger than the max cached size goes back to the idle memory bufs.
+TEST_F(DynamicMemPoolBestFitTest, CacheHitAfterFree) {
+  auto addr = mem_pool_->AllocTensorMem(kKB);
+  ASSERT_NE(addr, nullptr);
+  mem_pool_->FreeTensorMem(addr);
+  EXPECT_EQ(mem_pool_->CachedMemStatistics(), kKB);
+  EXPECT_EQ(mem_pool_->common_mem()->idle_mem_buf_map_.size(), 1);
+
+  // The alloc in the other size class doesn't hit the cache.
+  auto other_addr = mem_pool_->AllocTensorMem(2 * kKB);
+  ASSERT_NE(other_addr, nullptr);
+  EXPECT_NE(other_addr, addr);
+  EXPECT_EQ(mem_pool_->CachedMemStatistics(), kKB);
+  // The alloc size is aligned to the size class of the cached memory buf.
+  EXPECT_EQ(mem_pool_->AllocTensorMem(kKB - 1), addr);
+  EXPECT_EQ(mem_pool_->CachedMemStatistics(), 0);
+
+  auto large_addr = mem_pool_->AllocTensorMem(DYNAMIC_MEM_CACHE_MAX_SIZE + DYNAMIC_MEM_ALIGN_SIZE);
+  ASSERT_NE(large_addr, nullptr);
+  auto idle_mem_size = mem_pool_->FragmentationStatistics().idle_mem_size_;
+  mem_pool_->FreeTensorMem(large_addr);
+  EXPECT_EQ(mem_pool_->CachedMemStatistics(), 0);
+  EXPECT_EQ(mem_pool_->FragmentationStatistics().idle_mem_size_,
+            idle_mem_size + DYNAMIC_MEM_CACHE_MAX_SIZE + DYNAMIC_MEM_ALIGN_SIZE);
+}
+
+/// Feature: the size-classed cache of small memory bufs in the dynamic memory pool.
+/// Description: fill the device memory, free the small memory buf into the cache, and alloc the whole device memory.
+/// Expectation: the cache is flushed when the alloc fails, and the cached memory buf is combined for the alloc.
+TEST_F(DynamicMemPoolBestFitTest, FlushCacheOnAllocFail) {
+  mem_pool_->SetMemAllocUintSize(kDeviceMemSize, kDeviceMemSize);
+  auto small_addr = mem_pool_->AllocTensorMem(kKB);
+  auto rest_addr = mem_pool_->AllocTensorMem(kDeviceMemSize - kKB);
+  ASSERT_NE(small_addr, nullptr);
+  ASSERT_NE(rest_addr, nullptr);
+  mem_pool_->FreeTensorMem(small_addr);
+  mem_pool_->FreeTensorMem(rest_addr);
+  EXPECT_EQ(mem_pool_->CachedMemStatistics(), kKB);
+
+  EXPECT_EQ(mem_pool_->AllocTensorMem(kDeviceMemSize), small_addr);
+  EXPECT_EQ(mem_pool_->CachedMemStatistics(), 0);
+  EXPECT_EQ(mem_pool_->alloc_device_mem_num_, 1);
+}
+
+/// Feature: the size-classed cache of small memory bufs in the dynamic memory pool.
+/// Description: alloc and free the small memory bufs, and check the memory statistics.
+/// Expectation: the cached memory bufs are counted in the cached memory, but neither in the used memory nor in the
+/// idle memory of fragmentation statistics.
+TEST_F(DynamicMemPoolBestFitTest, CachedMemStatistics) {
+  auto addr1 = mem_pool_->AllocTensorMem(kKB);
+  auto addr2 = mem_pool_->AllocTensorMem(4 * kKB);
+  ASSERT_NE(addr1, nullptr);
+  ASSERT_NE(addr2, nullptr);
+  auto total_mem_size = mem_pool_->TotalMemStatistics();
+  EXPECT_EQ(total_mem_size, kBlockSize);
+  EXPECT_EQ(mem_pool_->TotalUsedMemStatistics(), 5 * kKB);
+  EXPECT_EQ(mem_pool_->FragmentationStatistics().idle_mem_size_, total_mem_size - 5 * kKB);
+
+  mem_pool_->FreeTensorMem(addr1);
+  EXPECT_EQ(mem_pool_->CachedMemStatistics(), kKB);
+  EXPECT_EQ(mem_pool_->TotalUsedMemStatistics(), 4 * kKB);
+  EXPECT_EQ(mem_pool_->TotalMemStatistics(), total_mem_size);
+  EXPECT_EQ(mem_pool_->UsedMemPeakStatistics(), 5 * kKB);
+  EXPECT_EQ(mem_pool_->FragmentationStatistics().idle_mem_size_, total_mem_size - 5 * kKB);
+
+  mem_pool_->FreeTensorMem(addr2);
+  EXPECT_EQ(mem_pool_->CachedMemStatistics(), 5 * kKB);
+  EXPECT_EQ(mem_pool_->TotalUsedMemStatistics(), 0);
+}
+
+/// Feature: the size-classed cache of small memory bufs in the dynamic memory pool.
+/// Description: free the small memory bufs into the cache, release the device resource, and alloc again.
+/// Expectation: the cache is cleared with the memory blocks, and the alloc after releasing adds the new memory block
+/// instead of returning the released memory buf.
+TEST_F(DynamicMemPoolBestFitTest, ClearCacheOnRelease) {
+  std::vector<DeviceMemPtr> addrs;
+  for (size_t i = 1; i <= 4; ++i) {
+    addrs.push_back(mem_pool_->AllocTensorMem(i * kKB));
+    ASSERT_NE(addrs.back(), nullptr);
+  }
+  for (auto addr : addrs) {
+    mem_pool_->FreeTensorMem(addr);
+  }
+  EXPECT_EQ(mem_pool_->CachedMemStatistics(), 10 * kKB);
+
+  mem_pool_->ReleaseDeviceRes();
+  EXPECT_EQ(mem_pool_->CachedMemStatistics(), 0);
+  EXPECT_EQ(mem_pool_->free_device_mem_num_, 1);
+  EXPECT_TRUE(mem_pool_->common_mem()->mem_block_list_.empty());
+  for (size_t i = 0; i < DYNAMIC_MEM_CACHE_MAX_SIZE / DYNAMIC_MEM_ALIGN_SIZE; ++i) {
+    EXPECT_EQ(mem_pool_->mem_buf_cache_[i].Pop(), nullptr);
+  }
+
+  auto addr = mem_pool_->AllocTensorMem(kKB);
+  ASSERT_NE(addr, nullptr);
+  EXPECT_EQ(mem_pool_->alloc_device_mem_num_, 2);
+  EXPECT_EQ(mem_pool_->common_mem()->mem_block_list_.size(), 1);
+  EXPECT_EQ(mem_pool_->common_mem()->mem_block_list_[0]->device_addr(), addr);
+}
+
+/// Feature: the release policy of the fully idle memory blocks in the dynamic memory pool.
+/// Description: alloc two memory blocks and free them with the release policy of never, free and not supported device.
+/// Expectation: the fully idle memory block is released to the device as soon as it is freed only with the free
+/// policy of the supported device, and the last memory block is kept.
+TEST_F(DynamicMemPoolBestFitTest, ReleasePolicyOnFree) {
+  auto run_and_check = [this](DynamicMemReleasePolicy release_policy, bool support_release, size_t expect_block_num) {
+    SetUp();
+    mem_pool_->set_release_policy(release_policy);
+    mem_pool_->support_release_ = support_release;
+    auto addr1 = mem_pool_->AllocTensorMem(kBlockSize);
+    auto addr2 = mem_pool_->AllocTensorMem(kBlockSize);
+    ASSERT_NE(addr1, nullptr);
+    ASSERT_NE(addr2, nullptr);
+    EXPECT_EQ(mem_pool_->common_mem()->mem_block_list_.size(), 2);
+    mem_pool_->FreeTensorMem(addr1);
+    mem_pool_->FreeTensorMem(addr2);
+    EXPECT_EQ(mem_pool_->common_mem()->mem_block_list_.size(), expect_block_num);
+    EXPECT_EQ(mem_pool_->TotalMemStatistics(), expect_block_num * kBlockSize);
+    EXPECT_EQ(mem_pool_->used_device_mem_size_, expect_block_num * kBlockSize);
+    EXPECT_EQ(mem_pool_->release_device_mem_num_, 2 - expect_block_num);
+    EXPECT_EQ(mem_pool_->FragmentationStatistics().idle_block_count_, expect_block_num);
+  };
+  run_and_check(DynamicMemReleasePolicy::kNever, true, 2);
+  run_and_check(DynamicMemReleasePolicy::kOnFree, true, 1);
+  run_and_check(DynamicMemReleasePolicy::kOnFree, false, 2);
+}
+
+/// Feature: the release policy of the fully idle memory blocks in the dynamic memory pool.
+/// Description: fill the device memory by the memory blocks, free them and alloc the memory larger than the block.
+/// Expectation: the alloc fails with the never policy, and succeeds with the alloc fail policy which releases all the
+/// fully idle memory blocks to add the larger memory block.
+TEST_F(DynamicMemPoolBestFitTest, ReleasePolicyOnAllocFail) {
+  constexpr size_t kLargeBlockNum = 2;
+  mem_pool_->set_release_policy(DynamicMemReleasePolicy::kNever);
+  FillAndFreeDeviceMem(kLargeBlockNum);
+  EXPECT_EQ(mem_pool_->AllocTensorMem(kDeviceMemSize), nullptr);
+  EXPECT_EQ(mem_pool_->release_device_mem_num_, 0);
+  EXPECT_EQ(mem_pool_->common_mem()->mem_block_list_.size(), kLargeBlockNum);
+
+  SetUp();
+  mem_pool_->set_release_policy(DynamicMemReleasePolicy::kOnAllocFail);
+  FillAndFreeDeviceMem(kLargeBlockNum);
+  EXPECT_NE(mem_pool_->AllocTensorMem(kDeviceMemSize), nullptr);
+  EXPECT_EQ(mem_pool_->release_device_mem_num_, kLargeBlockNum);
+  EXPECT_EQ(mem_pool_->common_mem()->mem_block_list_.size(), 1);
+  EXPECT_EQ(mem_pool_->TotalMemStatistics(), kDeviceMemSize);
+  EXPECT_EQ(mem_pool_->TotalUsedMemStatistics(), kDeviceMemSize);
+}
+
+/// Feature: the fragmentation statistics of the dynamic memory pool.
+/// Description: alloc four memory bufs filling the memory block, free them out of order, and alloc the persistent
+/// memory.
+/// Expectation: the idle memory bufs which are not adjacent are counted separately, the adjacent ones are combined,
+/// and the persistent memory blocks are counted together with the common memory blocks.
+TEST_F(DynamicMemPoolBestFitTest, FragmentationStatistics) {
+  constexpr size_t kBufNum = 4;
+  constexpr size_t kBufSize = kBlockSize / kBufNum;
+  std::vector<DeviceMemPtr> addrs;
+  for (size_t i = 0; i < kBufNum; ++i) {
+    addrs.push_back(mem_pool_->AllocTensorMem(kBufSize));
+    ASSERT_NE(addrs.back(), nullptr);
+  }
+  auto fragmentation = mem_pool_->FragmentationStatistics();
+  EXPECT_EQ(fragmentation.block_count_, 1);
+  EXPECT_EQ(fragmentation.idle_mem_size_, 0);
+  EXPECT_FLOAT_EQ(fragmentation.FragmentationRatio(), 0);
+
+  mem_pool_->FreeTensorMem(addrs[1]);
+  mem_pool_->FreeTensorMem(addrs[3]);
+  fragmentation = mem_pool_->FragmentationStatistics();
+  EXPECT_EQ(fragmentation.idle_block_count_, 0);
+  EXPECT_EQ(fragmentation.idle_mem_size_, 2 * kBufSize);
+  EXPECT_EQ(fragmentation.idle_mem_buf_count_, 2);
+  EXPECT_EQ(fragmentation.largest_idle_mem_buf_size_, kBufSize);
+  EXPECT_FLOAT_EQ(fragmentation.FragmentationRatio(), 0.5);
+
+  mem_pool_->FreeTensorMem(addrs[2]);
+  fragmentation = mem_pool_->FragmentationStatistics();
+  EXPECT_EQ(fragmentation.idle_mem_buf_count_, 1);
+  EXPECT_EQ(fragmentation.largest_idle_mem_buf_size_, 3 * kBufSize);
+  EXPECT_FLOAT_EQ(fragmentation.FragmentationRatio(), 0);
+
+  mem_pool_->FreeTensorMem(addrs[0]);
+  ASSERT_NE(mem_pool_->AllocTensorMem(kBufSize, true), nullptr);
+  fragmentation = mem_pool_->FragmentationStatistics();
+  EXPECT_EQ(fragmentation.block_count_, 2);
+  EXPECT_EQ(fragmentation.idle_block_count_, 1);
+  EXPECT_EQ(fragmentation.idle_mem_size_, 7 * kBufSize);
+  EXPECT_EQ(fragmentation.idle_mem_buf_count_, 2);
+  EXPECT_EQ(fragmentation.largest_idle_mem_buf_size_, 4 * kBufSize);
+  EXPECT_FLOAT_EQ(fragmentation.FragmentationRatio(), 3.0f / 7);
+}
+}  // namespace device
+}  // namespace mindspore
@@ -0,0 +1,126 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include "common/common_test.h"
+#include "common/mem_reuse/host_mem_pool.h"
+#include "runtime/device/memory_manager.h"
+
+namespace mindspore {
+namespace device {
+namespace {
+constexpr size_t kKB = 1 << 10;
+constexpr size_t kMB = 1 << 20;
+// The slabs and the large host memory bufs are aligned to the huge page.
+constexpr size_t kHugePageSize = 2 * kMB;
+// All the size classes are the multiples of the quarter of the minimum size class 4KB.
+constexpr size_t kHostMemBufAlignSize = kKB;
+
+bool IsAligned(const void *addr, size_t align_size) { return reinterpret_cast<uintptr_t>(addr) % align_size == 0; }
+}  // namespace
+
+// The memory manager which only serves the host memory of swap.
+class TestMemoryManager : public MemoryManager {
+ public:
+  TestMemoryManager() = default;
+  ~TestMemoryManager() override = default;
+
+  void Initialize() override {}
+  void Finalize() override {}
+
+ protected:
+  uint8_t *MallocStaticMem(size_t, bool, uint32_t) override { return nullptr; }
+};
+
+class HostMemPoolTest : public UT::Common {
+ public:
+  HostMemPoolTest() = default;
+
+  void SetUp() override { HostMemPool::GetInstance().ReleaseHostRes(); }
+  void TearDown() override { HostMemPool::GetInstance().ReleaseHostRes(); }
+
+  TestMemoryManager memory_manager1_;
+  TestMemoryManager memory_manager2_;
+};
+
+/// Feature: the host memory pool shared by the memory managers for MallocHost and FreeHost.
+/// Description: malloc and free the host memory by one memory manager, and malloc the host memory of the sizes in the
+/// same and the other size classes by the other memory manager.
+/// Expectation: the freed host memory is reused by the size in the same size class from any memory manager, and the
+/// used memory is counted by the size class.
+TEST_F(HostMemPoolTest, MallocHostReuse) {
+  auto &host_mem_pool = HostMemPool::GetInstance();
+  // The sizes 5000 and 5100 are in the size class 5KB, and 7000 is in the size class 7KB.
+  auto host_addr = memory_manager1_.MallocHost(5000);
+  ASSERT_NE(host_addr, nullptr);
+  EXPECT_EQ(host_mem_pool.TotalMemStatistics(), HOST_MEM_SLAB_SIZE);
+  EXPECT_EQ(host_mem_pool.TotalUsedMemStatistics(), 5 * kKB);
+  memory_manager1_.FreeHost(host_addr);
+  EXPECT_EQ(host_mem_pool.TotalUsedMemStatistics(), 0);
+
+  auto other_addr = memory_manager2_.MallocHost(7000);
+  EXPECT_NE(other_addr, host_addr);
+  EXPECT_EQ(memory_manager2_.MallocHost(5100), host_addr);
+  EXPECT_EQ(host_mem_pool.TotalUsedMemStatistics(), 12 * kKB);
+  memory_manager2_.FreeHost(host_addr);
+  memory_manager2_.FreeHost(other_addr);
+
+  // The large host memory buf is mapped alone and reused in the same way.
+  auto large_addr = memory_manager1_.MallocHost(HOST_MEM_SLAB_MAX_CLASS_SIZE + 1);
+  ASSERT_NE(large_addr, nullptr);
+  auto total_mem_size = host_mem_pool.TotalMemStatistics();
+  EXPECT_GT(total_mem_size, HOST_MEM_SLAB_SIZE);
+  memory_manager1_.FreeHost(large_addr);
+  EXPECT_EQ(memory_manager2_.MallocHost(HOST_MEM_SLAB_MAX_CLASS_SIZE + kMB), large_addr);
+  EXPECT_EQ(host_mem_pool.TotalMemStatistics(), total_mem_size);
+  memory_manager2_.FreeHost(large_addr);
+}
+
+/// Feature: the host memory pool shared by the memory managers for MallocHost and FreeHost.
+/// Description: malloc the host memory of various sizes from the slab and the large host memory, and write them.
+/// Expectation: the host memory bufs carved from the slab are aligned to 1KB and don't overlap, the first one and the
+/// large host memory are aligned to the huge page, and all the host memory is writable.
+TEST_F(HostMemPoolTest, MallocHostAlignment) {
+  std::vector<size_t> sizes = {1, 4 * kKB, 4 * kKB + 1, 9000, 100 * kKB + 7, kMB - 3, 3 * kMB, 17};
+  std::vector<uint8_t *> host_addrs;
+  for (auto size : sizes) {
+    auto host_addr = static_cast<uint8_t *>(memory_manager1_.MallocHost(size));
+    ASSERT_NE(host_addr, nullptr);
+    EXPECT_TRUE(IsAligned(host_addr, kHostMemBufAlignSize));
+    (void)memset(host_addr, static_cast<int>(host_addrs.size()), size);
+    host_addrs.push_back(host_addr);
+  }
+  EXPECT_TRUE(IsAligned(host_addrs[0], kHugePageSize));
+  for (size_t i = 0; i < sizes.size(); ++i) {
+    EXPECT_EQ(host_addrs[i][0], i);
+    EXPECT_EQ(host_addrs[i][sizes[i] - 1], i);
+  }
+
+  auto large_addr = static_cast<uint8_t *>(memory_manager2_.MallocHost(HOST_MEM_SLAB_MAX_CLASS_SIZE * 2 + 1));
+  ASSERT_NE(large_addr, nullptr);
+  EXPECT_TRUE(IsAligned(large_addr, kHugePageSize));
+  (void)memset(large_addr, 1, HOST_MEM_SLAB_MAX_CLASS_SIZE * 2 + 1);
+  for (auto host_addr : host_addrs) {
+    memory_manager2_.FreeHost(host_addr);
+  }
+  memory_manager1_.FreeHost(large_addr);
+  EXPECT_EQ(HostMemPool::GetInstance().TotalUsedMemStatistics(), 0);
+}
+}  // namespace device
+}  // namespace mindspore
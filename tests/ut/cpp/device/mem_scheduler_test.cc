@@ -14,8 +14,10 @@
  * limitations under the License.
  */
 
+#include <algorithm>
 #include <vector>
 #include <map>
+#include <set>
 #include "common/common_test.h"
 #include "runtime/device/memory_scheduler.h"
 namespace mindspore::device {
@@ -232,4 +234,67 @@ TEST_F(TestMemScheduler, test_manual_mem_scheduler) {
   // run
   Run(scheduler);
 }
-}  // namespace mindspore::device
\ No newline at end of file
+
+/// Feature: MemOffloadStrategy and MemOffloadSimulator
+/// Description: Schedule the swap in ahead by the compute time and copy bandwidth, and simulate the stall time
+/// Expectation: The swap in is moved ahead within the memory size, and the stall time is hidden by the compute
+TEST_F(TestMemScheduler, test_offload_strategy_prefetch) {
+  // 6 step tensor usage, the size of tensor 0 and 1 is 4, the others is 1, and the memory size is 6.
+  //
+  // 0---------------0
+  //    1  1
+  //          2
+  //             3
+  std::vector<uint8_t> tensor_keys(4, 0);
+  std::vector<size_t> tensor_sizes = {4, 4, 1, 1};
+  std::vector<std::vector<size_t>> tensor_used_steps = {{0, 5}, {1, 2}, {3}, {4}};
+  std::map<const void *, MemPriority> mem_priority;
+  std::map<const void *, std::vector<std::shared_ptr<MemEvent>>> mem_events;
+  for (size_t i = 0; i < tensor_keys.size(); ++i) {
+    const void *key = tensor_keys.data() + i;
+    mem_priority[key] = kMemPriorityLow;
+    auto malloc_event = std::make_shared<MemEvent>(kMalloc, tensor_used_steps[i][0]);
+    malloc_event->key = key;
+    malloc_event->mem_size = tensor_sizes[i];
+    mem_events[key].emplace_back(malloc_event);
+    for (auto step : tensor_used_steps[i]) {
+      auto get_event = std::make_shared<MemEvent>(kGet, step);
+      get_event->key = key;
+      get_event->mem_size = tensor_sizes[i];
+      mem_events[key].emplace_back(get_event);
+    }
+  }
+  std::set<const void *> manual_offload_keys;
+  std::map<const void *, std::vector<size_t>> high_priority_updated_step;
+  constexpr size_t kTotalStep = 6;
+  constexpr size_t kMemSize = 6;
+  // The copy of tensor 0 takes the compute time of 2 steps.
+  const std::vector<double> compute_time(kTotalStep, 10.0);
+  constexpr double kCopyBandwidth = 0.2;
+
+  MemOffloadStrategy on_demand_strategy(mem_priority, mem_events, manual_offload_keys, high_priority_updated_step,
+                                        kTotalStep);
+  on_demand_strategy.set_mem_size(kMemSize);
+  on_demand_strategy.Execute();
+  ASSERT_TRUE(on_demand_strategy.need_swap());
+  MemOffloadSimulator simulator(compute_time, kCopyBandwidth);
+  auto on_demand_result = simulator.Simulate(&on_demand_strategy);
+
+  MemOffloadStrategy prefetch_strategy(mem_priority, mem_events, manual_offload_keys, high_priority_updated_step,
+                                       kTotalStep);
+  prefetch_strategy.set_mem_size(kMemSize);
+  prefetch_strategy.SetComputeTime(compute_time);
+  prefetch_strategy.SetCopyBandwidth(kCopyBandwidth);
+  prefetch_strategy.Execute();
+  // The swap in of tensor 0 can't be earlier than step 3, because tensor 1 uses the memory in step 2.
+  const auto &swap_in_events = prefetch_strategy.GetPreComputeEvents(3);
+  ASSERT_TRUE(std::any_of(swap_in_events.begin(), swap_in_events.end(),
+                          [](const std::shared_ptr<MemEvent> &event) { return event->type == kSwapIn; }));
+  auto prefetch_result = simulator.Simulate(&prefetch_strategy);
+
+  ASSERT_EQ(on_demand_result.swap_in_size, prefetch_result.swap_in_size);
+  ASSERT_DOUBLE_EQ(on_demand_result.stall_time, 20.0);
+  ASSERT_DOUBLE_EQ(prefetch_result.stall_time, 0.0);
+  ASSERT_LT(prefetch_result.total_time, on_demand_result.total_time);
+}
+}  // namespace mindspore::device
@@ -15,11 +15,21 @@
  */
 
 #include <sys/resource.h>
+#include <sys/socket.h>
 #include <sys/types.h>
+#include <sys/un.h>
+#include <unistd.h>
 #include <dirent.h>
+#include <algorithm>
 #include <atomic>
+#include <cstddef>
+#include <cstring>
 #include <string>
+#include <vector>
+#include <memory>
+#include <mutex>
 #include <thread>
+#include <chrono>
 #include <csignal>
 
 #include <gtest/gtest.h>
@@ -58,6 +68,17 @@ static void IncrDataMsgNum(size_t number) { g_data_msg_num += number; }
 
 static size_t GetDataMsgNum() { return g_data_msg_num; }
 
+static std::string g_recv_payload;
+static std::atomic<size_t> g_released_buffer_msg_num(0);
+
+static std::atomic<size_t> g_recv_msg_num(0);
+static std::atomic<int64_t> g_total_latency_us(0);
+
+static int64_t NowInUs() {
+  return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch())
+    .count();
+}
+
 std::atomic<int> m_sendNum(0);
 std::string m_localIP = "127.0.0.1";
 bool m_notRemote = false;
@@ -72,7 +93,11 @@ class TCPTest : public UT::Common {
   pid_t pids[pid_num];
 
   void SetUp() {}
-  void TearDown() {}
+  // The environment variables of the rpc set by the test case are unset even if the test case fails.
+  void TearDown() {
+    (void)unsetenv("MS_DEV_RPC_REACTOR_NUM");
+    (void)unsetenv("MS_DEV_RPC_REUSE_PORT");
+  }
 
   std::unique_ptr<MessageBase> CreateMessage(const std::string &serverUrl, const std::string &client_url);
 
@@ -217,6 +242,288 @@ TEST_F(TCPTest, sendTwoMessages) {
   client->Finalize();
   server->Finalize();
 }
+
+/// Feature: test sending the message which references the external buffers.
+/// Description: send a buffer message with a body and two buffers to the server which receives into allocated memory.
+/// Expectation: the server received the body and buffers as one payload, and the buffers are released after sent.
+TEST_F(TCPTest, SendBufferMessage) {
+  Init();
+  g_recv_payload.clear();
+  g_released_buffer_msg_num = 0;
+
+  // Start the tcp server.
+  auto server_url = "127.0.0.1:8081";
+  std::unique_ptr<TCPServer> server = std::make_unique<TCPServer>();
+  bool ret = server->Initialize(server_url);
+  ASSERT_TRUE(ret);
+
+  server->SetMessageHandler([](std::unique_ptr<MessageBase> &&message) -> void {
+    auto buffer_msg = dynamic_cast<BufferMessage *>(message.get());
+    if (buffer_msg != nullptr && buffer_msg->buffers().size() == 1) {
+      const auto &buffer = buffer_msg->buffers()[0];
+      g_recv_payload.assign(reinterpret_cast<char *>(buffer.data), buffer.size);
+    }
+    IncrDataMsgNum(1);
+  });
+  server->SetMemAllocator([](size_t size) -> void * { return malloc(size); }, [](void *data) { free(data); });
+
+  // Start the tcp client.
+  auto client_url = "127.0.0.1:1234";
+  std::unique_ptr<TCPClient> client = std::make_unique<TCPClient>();
+  ret = client->Initialize();
+  ASSERT_TRUE(ret);
+
+  // Create the buffer message, the large buffer makes the sending partial.
+  std::string buffer1(100, 'B');
+  std::string buffer2(8 * 1024 * 1024, 'C');
+  std::vector<BufferMessage::Buffer> buffers = {{const_cast<char *>(buffer1.data()), buffer1.size()},
+                                                {const_cast<char *>(buffer2.data()), buffer2.size()}};
+  auto message = std::make_unique<BufferMessage>(AID("client", client_url), AID("server", server_url), "testname",
+                                                 std::move(buffers), []() { ++g_released_buffer_msg_num; });
+  message->body = "A";
+
+  // Send the message.
+  client->Connect(server_url);
+  client->Send(std::move(message));
+
+  // Wait timeout: 5s
+  WaitForDataMsg(1, 5);
+
+  // Check result
+  EXPECT_EQ(1, GetDataMsgNum());
+  EXPECT_EQ(1, g_released_buffer_msg_num);
+  EXPECT_EQ("A" + buffer1 + buffer2, g_recv_payload);
+
+  // Destroy
+  client->Disconnect(server_url);
+  client->Finalize();
+  server->Finalize();
+}
+
+/// Feature: test sending the messages to the server on the same host by shared memory.
+/// Description: start the server with the shm url, and send a small message and a buffer message larger than the ring.
+/// Expectation: the client is connected by the shared memory channel, and the server received all the messages.
+TEST_F(TCPTest, SendByShm) {
+  Init();
+  g_recv_payload.clear();
+  g_released_buffer_msg_num = 0;
+
+  // Start the tcp server which also accepts the clients on the same host by shared memory.
+  auto server_url = "shm://127.0.0.1:8081";
+  std::unique_ptr<TCPServer> server = std::make_unique<TCPServer>();
+  bool ret = server->Initialize(server_url);
+  ASSERT_TRUE(ret);
+
+  server->SetMessageHandler([](std::unique_ptr<MessageBase> &&message) -> void {
+    auto buffer_msg = dynamic_cast<BufferMessage *>(message.get());
+    if (buffer_msg != nullptr && buffer_msg->buffers().size() == 1 && buffer_msg->buffers()[0].size > 100) {
+      const auto &buffer = buffer_msg->buffers()[0];
+      g_recv_payload.assign(reinterpret_cast<char *>(buffer.data), buffer.size);
+    }
+    IncrDataMsgNum(1);
+  });
+  server->SetMemAllocator([](size_t size) -> void * { return malloc(size); }, [](void *data) { free(data); });
+
+  // Start the tcp client.
+  auto client_url = "127.0.0.1:1234";
+  std::unique_ptr<TCPClient> client = std::make_unique<TCPClient>();
+  ret = client->Initialize();
+  ASSERT_TRUE(ret);
+  ASSERT_TRUE(client->Connect(server_url));
+  size_t shm_channel_num = 0;
+  for (auto &reactor : client->tcp_comm_->reactors_) {
+    shm_channel_num += reactor.shm_send_channels.size();
+  }
+  EXPECT_EQ(1, shm_channel_num);
+
+  // The buffer message larger than the ring is streamed through it.
+  std::string buffer(SHM_RING_SIZE + SHM_RING_SIZE / 2, 'C');
+  std::vector<BufferMessage::Buffer> buffers = {{const_cast<char *>(buffer.data()), buffer.size()}};
+  auto message = std::make_unique<BufferMessage>(AID("client", client_url), AID("server", server_url), "testname",
+                                                 std::move(buffers), []() { ++g_released_buffer_msg_num; });
+  message->body = "A";
+  client->Send(CreateMessage(server_url, client_url));
+  client->Send(std::move(message));
+  client->Send(CreateMessage(server_url, client_url));
+
+  // Wait timeout: 5s
+  WaitForDataMsg(3, 5);
+
+  // Check result
+  EXPECT_EQ(3, GetDataMsgNum());
+  EXPECT_EQ(1, g_released_buffer_msg_num);
+  EXPECT_TRUE("A" + buffer == g_recv_payload);
+
+  // Destroy
+  EXPECT_TRUE(client->Disconnect(server_url));
+  client->Finalize();
+  server->Finalize();
+}
+
+/// Feature: test the shared memory handshake which is read in the event loop of the server.
+/// Description: start the server with the shm url, connect its unix socket without sending the handshake, and then
+/// send a message from another client by shared memory.
+/// Expectation: the silent client waits for its handshake without blocking the server, and the message is received
+/// long before the handshake timeout of the client.
+TEST_F(TCPTest, ShmHandshakeNotBlocking) {
+  Init();
+
+  // Start the tcp server which also accepts the clients on the same host by shared memory.
+  auto server_url = "shm://127.0.0.1:8081";
+  std::unique_ptr<TCPServer> server = std::make_unique<TCPServer>();
+  bool ret = server->Initialize(server_url);
+  ASSERT_TRUE(ret);
+  server->SetMessageHandler([](std::unique_ptr<MessageBase> &&message) -> void { IncrDataMsgNum(1); });
+
+  // Connect the abstract unix socket of the server without sending the handshake.
+  std::string name = std::string(SHM_SOCKET_NAME_PREFIX) + "127.0.0.1:8081";
+  struct sockaddr_un addr;
+  (void)memset(&addr, 0, sizeof(addr));
+  addr.sun_family = AF_UNIX;
+  (void)memcpy(addr.sun_path + 1, name.data(), name.size());
+  int silent_fd = socket(AF_UNIX, SOCK_STREAM, 0);
+  ASSERT_GE(silent_fd, 0);
+  ASSERT_EQ(0, connect(silent_fd, reinterpret_cast<struct sockaddr *>(&addr),
+                       static_cast<socklen_t>(offsetof(struct sockaddr_un, sun_path) + 1 + name.size())));
+
+  // Start the tcp client connected by shared memory.
+  auto client_url = "127.0.0.1:1234";
+  std::unique_ptr<TCPClient> client = std::make_unique<TCPClient>();
+  ret = client->Initialize();
+  ASSERT_TRUE(ret);
+  ASSERT_TRUE(client->Connect(server_url));
+  client->Send(CreateMessage(server_url, client_url));
+
+  // Wait timeout: 2s, less than the handshake timeout.
+  WaitForDataMsg(1, 2);
+  EXPECT_EQ(1, GetDataMsgNum());
+  size_t handshake_fd_num = 0;
+  for (auto &reactor : server->tcp_comm_->reactors_) {
+    std::lock_guard<std::mutex> lock(*reactor.conn_mutex);
+    handshake_fd_num += reactor.shm_handshake_fds.size();
+  }
+  EXPECT_EQ(1, handshake_fd_num);
+
+  // Destroy
+  (void)close(silent_fd);
+  EXPECT_TRUE(client->Disconnect(server_url));
+  client->Finalize();
+  server->Finalize();
+}
+
+/// Feature: test connecting the server without shared memory by the shm url.
+/// Description: start the server with the tcp url, and the client connects it with the shm url.
+/// Expectation: the client falls back to tcp, and the server received the message.
+TEST_F(TCPTest, ShmFallbackToTcp) {
+  Init();
+
+  // Start the tcp server.
+  std::unique_ptr<TCPServer> server = std::make_unique<TCPServer>();
+  bool ret = server->Initialize("127.0.0.1:8081");
+  ASSERT_TRUE(ret);
+
+  server->SetMessageHandler([](std::unique_ptr<MessageBase> &&message) -> void { IncrDataMsgNum(1); });
+
+  // Start the tcp client.
+  auto server_url = "shm://127.0.0.1:8081";
+  auto client_url = "127.0.0.1:1234";
+  std::unique_ptr<TCPClient> client = std::make_unique<TCPClient>();
+  ret = client->Initialize();
+  ASSERT_TRUE(ret);
+  ASSERT_TRUE(client->Connect(server_url));
+  for (auto &reactor : client->tcp_comm_->reactors_) {
+    EXPECT_TRUE(reactor.shm_send_channels.empty());
+  }
+
+  // Send the message.
+  client->Send(CreateMessage(server_url, client_url));
+
+  // Wait timeout: 5s
+  WaitForDataMsg(1, 5);
+
+  // Check result
+  EXPECT_EQ(1, GetDataMsgNum());
+
+  // Destroy
+  client->Disconnect(server_url);
+  client->Finalize();
+  server->Finalize();
+}
+
+/// Feature: test many clients sending to the server driven by multiple reactors.
+/// Description: start the server and clients with 4 reactors and SO_REUSEPORT, and every client sends messages in its
+/// own thread.
+/// Expectation: the server received all the messages, and the throughput and latency are logged.
+TEST_F(TCPTest, MultiClientThroughput) {
+  (void)setenv("MS_DEV_RPC_REACTOR_NUM", "4", 1);
+  (void)setenv("MS_DEV_RPC_REUSE_PORT", "1", 1);
+  g_recv_msg_num = 0;
+  g_total_latency_us = 0;
+  // The message number of one client is less than the send queue length, so no message is dropped.
+  const size_t client_num = 16;
+  const size_t msg_num = 500;
+  const size_t msg_size = 4096;
+
+  // Start the tcp server, the send time is carried in the message body.
+  auto server_url = "127.0.0.1:8081";
+  std::unique_ptr<TCPServer> server = std::make_unique<TCPServer>();
+  bool ret = server->Initialize(server_url);
+  ASSERT_TRUE(ret);
+  server->SetMessageHandler([](std::unique_ptr<MessageBase> &&message) -> void {
+    int64_t send_time = 0;
+    (void)memcpy(&send_time, message->body.data(), sizeof(send_time));
+    g_total_latency_us += NowInUs() - send_time;
+    ++g_recv_msg_num;
+  });
+
+  // Start the tcp clients.
+  std::vector<std::unique_ptr<TCPClient>> clients;
+  for (size_t i = 0; i < client_num; ++i) {
+    auto client = std::make_unique<TCPClient>();
+    ASSERT_TRUE(client->Initialize());
+    ASSERT_TRUE(client->Connect(server_url));
+    clients.emplace_back(std::move(client));
+  }
+
+  // Send the messages.
+  auto start_time = NowInUs();
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < client_num; ++i) {
+    threads.emplace_back([&clients, &server_url, i, msg_num, msg_size]() {
+      for (size_t j = 0; j < msg_num; ++j) {
+        auto message = std::make_unique<MessageBase>(AID("client" + std::to_string(i), "127.0.0.1:1234"),
+                                                     AID("server", server_url), "testname");
+        message->body.resize(msg_size);
+        int64_t send_time = NowInUs();
+        (void)memcpy(&message->body[0], &send_time, sizeof(send_time));
+        clients[i]->Send(std::move(message));
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+
+  // Wait timeout: 30s
+  const int64_t timeout_in_us = 30 * 1000 * 1000;
+  while (g_recv_msg_num < client_num * msg_num && NowInUs() - start_time < timeout_in_us) {
+    usleep(1000);
+  }
+  auto cost_in_us = NowInUs() - start_time;
+
+  // Check result
+  EXPECT_EQ(client_num * msg_num, g_recv_msg_num);
+  MS_LOG(INFO) << "Received " << g_recv_msg_num << " messages in " << cost_in_us << " us, "
+               << g_recv_msg_num * 1e6 / cost_in_us << " msgs/s, " << g_recv_msg_num * msg_size / cost_in_us
+               << " MB/s, average latency " << g_total_latency_us / std::max<int64_t>(g_recv_msg_num, 1) << " us.";
+
+  // Destroy
+  for (auto &client : clients) {
+    client->Disconnect(server_url);
+    client->Finalize();
+  }
+  server->Finalize();
+}
 }  // namespace rpc
 }  // namespace distributed
 }  // namespace mindspore
@@ -0,0 +1,318 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <map>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "common/common_test.h"
+#define private public
+#define protected public
+#include "fl/server/collective_ops_impl.h"
+#undef private
+#undef protected
+
+namespace mindspore {
+namespace fl {
+namespace server {
+namespace {
+// The float count whose AllReduce is larger than the threshold of halving-doubling, so the ring algorithm is used.
+constexpr size_t kRingCount = 3 * kRingSegmentSize / sizeof(float) + 7;
+constexpr uint16_t kServerPort = 6666;
+
+// The server node which delivers the collective messages to the peer nodes in the same process instead of by tcp.
+// The receiving side is the same as the real node: the messages are matched by the rank request ids.
+class LocalServerNode : public ps::core::ServerNode {
+ public:
+  LocalServerNode(uint32_t rank_id, uint32_t server_num, std::map<uint32_t, std::shared_ptr<LocalServerNode>> *nodes)
+      : nodes_(nodes) {
+    node_info_.rank_id_ = rank_id;
+    node_info_.node_role_ = ps::core::NodeRole::SERVER;
+    server_num_ = server_num;
+  }
+  ~LocalServerNode() override = default;
+
+  uint64_t CollectiveSendAsync(const ps::core::NodeRole &, const uint32_t &rank_id, const void *data,
+                               size_t size) override {
+    auto meta = std::make_shared<ps::core::MessageMeta>();
+    meta->set_cmd(ps::core::NodeCommand::COLLECTIVE_SEND_DATA);
+    meta->set_rank_id(node_info_.rank_id_);
+    meta->set_role(node_info_.node_role_);
+    meta->set_request_id(AddMessageTrack(1));
+    nodes_->at(rank_id)->RunReceiveCallback(meta, ps::core::Protos::RAW, data, size);
+    ++send_num_;
+    NotifyMessageArrival(meta);
+    return meta->request_id();
+  }
+
+  std::map<uint32_t, std::shared_ptr<LocalServerNode>> *nodes_;
+  std::atomic<size_t> send_num_{0};
+};
+
+CommunicationGroupInfo MakeGroupInfo(const std::vector<uint32_t> &global_ranks) {
+  CommunicationGroupInfo group_info;
+  group_info.size = static_cast<uint32_t>(global_ranks.size());
+  group_info.group_ranks = global_ranks;
+  for (uint32_t i = 0; i < global_ranks.size(); ++i) {
+    group_info.global_to_group_ranks[global_ranks[i]] = i;
+    group_info.group_to_global_ranks[i] = global_ranks[i];
+  }
+  return group_info;
+}
+
+std::vector<uint32_t> Ranks(uint32_t rank_size) {
+  std::vector<uint32_t> global_ranks(rank_size);
+  for (uint32_t i = 0; i < rank_size; ++i) {
+    global_ranks[i] = i;
+  }
+  return global_ranks;
+}
+}  // namespace
+
+class TestCollectiveOpsImpl : public UT::Common {
+ public:
+  TestCollectiveOpsImpl() = default;
+  virtual ~TestCollectiveOpsImpl() = default;
+
+  void SetUp() override {}
+  void TearDown() override {
+    server_ops_.clear();
+    nodes_.clear();
+  }
+
+  // Run the AllReduce or the ReduceScatter of the group in one thread per rank, and check the results of all the ranks
+  // by the reduction of the inputs. The global ranks of the group are not required to be contiguous.
+  void RunAndCheck(const std::vector<uint32_t> &global_ranks, size_t count, CollectiveOpReduceType reduce_op,
+                   bool reduce_scatter) {
+    uint32_t server_num = *std::max_element(global_ranks.begin(), global_ranks.end()) + 1;
+    nodes_.clear();
+    for (auto rank : global_ranks) {
+      nodes_[rank] = std::make_shared<LocalServerNode>(rank, server_num, &nodes_);
+    }
+    size_t rank_size = global_ranks.size();
+    size_t input_count = reduce_scatter ? count * rank_size : count;
+    size_t output_count = count;
+    // One more element is allocated so that the buffers of the empty data are not null.
+    std::vector<std::vector<float>> inputs(rank_size, std::vector<float>(input_count + 1));
+    std::vector<std::vector<float>> outputs(rank_size, std::vector<float>(output_count + 1, -1.0));
+    std::vector<float> expect(input_count);
+    for (size_t j = 0; j < input_count; ++j) {
+      for (size_t r = 0; r < rank_size; ++r) {
+        inputs[r][j] = static_cast<float>((r * 7 + j * 3) % 11 + 1);
+        if (r == 0) {
+          expect[j] = inputs[r][j];
+        } else {
+          expect[j] =
+            (reduce_op == device::Reduce_Sum) ? expect[j] + inputs[r][j] : std::max(expect[j], inputs[r][j]);
+        }
+      }
+    }
+
+    auto group_info = MakeGroupInfo(global_ranks);
+    std::vector<int> results(rank_size, 0);
+    std::vector<std::thread> threads;
+    for (size_t r = 0; r < rank_size; ++r) {
+      threads.emplace_back([&, r]() {
+        CollectiveOpsImpl collective_ops;
+        auto node = nodes_[global_ranks[r]];
+        auto rank_group_info = group_info;
+        rank_group_info.global_rank = global_ranks[r];
+        results[r] =
+          reduce_scatter
+            ? collective_ops.ReduceScatter<float>(inputs[r].data(), outputs[r].data(), count, reduce_op, node,
+                                                  rank_group_info)
+            : collective_ops.AllReduce<float>(inputs[r].data(), outputs[r].data(), count, reduce_op, node,
+                                              rank_group_info);
+      });
+    }
+    for (auto &thread : threads) {
+      thread.join();
+    }
+
+    for (size_t r = 0; r < rank_size; ++r) {
+      ASSERT_TRUE(results[r]) << "rank size " << rank_size << ", count " << count;
+      size_t offset = reduce_scatter ? r * count : 0;
+      for (size_t j = 0; j < output_count; ++j) {
+        ASSERT_EQ(outputs[r][j], expect[offset + j]) << "rank " << r << " of rank size " << rank_size << ", count "
+                                                     << count << ", index " << j;
+      }
+      // All the messages sent are received.
+      EXPECT_TRUE(nodes_[global_ranks[r]]->received_data_.empty());
+    }
+  }
+
+  // Run the AllReduce of the servers in one thread per server, where the server of rank i is on the host of ips[i] and
+  // the empty ip is unknown. Check the results of all the servers by the sum of the inputs and return them. The
+  // CollectiveOpsImpl of the servers are kept for checking the host topology.
+  std::vector<std::vector<float>> RunServerAllReduce(const std::vector<std::string> &ips, size_t count) {
+    uint32_t server_num = static_cast<uint32_t>(ips.size());
+    nodes_.clear();
+    server_ops_.clear();
+    for (uint32_t rank = 0; rank < server_num; ++rank) {
+      auto node = std::make_shared<LocalServerNode>(rank, server_num, &nodes_);
+      for (uint32_t peer = 0; peer < server_num; ++peer) {
+        if (!ips[peer].empty()) {
+          node->nodes_address_[std::make_pair(ps::core::NodeRole::SERVER, peer)] =
+            std::make_pair(ips[peer], kServerPort);
+        }
+      }
+      nodes_[rank] = node;
+      auto collective_ops = std::make_unique<CollectiveOpsImpl>();
+      collective_ops->server_node_ = node;
+      collective_ops->rank_id_ = rank;
+      collective_ops->server_num_ = server_num;
+      server_ops_.push_back(std::move(collective_ops));
+    }
+    std::vector<std::vector<float>> inputs(server_num, std::vector<float>(count));
+    std::vector<std::vector<float>> outputs(server_num, std::vector<float>(count, -1.0));
+    std::vector<float> expect(count, 0);
+    for (size_t j = 0; j < count; ++j) {
+      for (uint32_t r = 0; r < server_num; ++r) {
+        inputs[r][j] = static_cast<float>((r * 7 + j * 3) % 11 + 1);
+        expect[j] += inputs[r][j];
+      }
+    }
+
+    std::vector<int> results(server_num, 0);
+    std::vector<std::thread> threads;
+    for (uint32_t r = 0; r < server_num; ++r) {
+      threads.emplace_back([&, r]() {
+        results[r] = server_ops_[r]->AllReduce<float>(inputs[r].data(), outputs[r].data(), count);
+      });
+    }
+    for (auto &thread : threads) {
+      thread.join();
+    }
+    for (uint32_t r = 0; r < server_num; ++r) {
+      EXPECT_TRUE(results[r]) << "rank " << r << ", count " << count;
+      EXPECT_EQ(outputs[r], expect) << "rank " << r << ", count " << count;
+      EXPECT_TRUE(nodes_[r]->received_data_.empty());
+    }
+    return outputs;
+  }
+
+  size_t SendNum(uint32_t rank) { return nodes_[rank]->send_num_; }
+
+  std::map<uint32_t, std::shared_ptr<LocalServerNode>> nodes_;
+  std::vector<std::unique_ptr<CollectiveOpsImpl>> server_ops_;
+};
+
+/// Feature: the AllReduce of the server collective communication within the group.
+/// Description: AllReduce the small data by the group sizes of power of two and not, including the count smaller than
+/// the group size and the group whose global ranks are not contiguous, by sum and max.
+/// Expectation: the recursive halving-doubling algorithm is used, and every rank gets the reduction of all the ranks.
+TEST_F(TestCollectiveOpsImpl, HalvingDoublingAllReduce) {
+  for (auto reduce_op : {device::Reduce_Sum, device::Reduce_Max}) {
+    for (uint32_t rank_size : {1, 2, 3, 4, 5, 6, 7, 8}) {
+      for (size_t count : {1, 3, 1000}) {
+        RunAndCheck(Ranks(rank_size), count, reduce_op, false);
+      }
+    }
+    RunAndCheck({7, 2, 4, 0, 5}, 17, reduce_op, false);
+  }
+  // The power of two processes exchange with log(n) peers twice.
+  RunAndCheck(Ranks(8), 1000, device::Reduce_Sum, false);
+  for (uint32_t rank = 0; rank < 8; ++rank) {
+    EXPECT_EQ(SendNum(rank), 6);
+  }
+}
+
+/// Feature: the AllReduce of the server collective communication within the group.
+/// Description: AllReduce the data larger than the threshold of halving-doubling by the group sizes of power of two and
+/// not, by sum and max.
+/// Expectation: the ring algorithm pipelines the segments of each chunk, and every rank gets the reduction of all the
+/// ranks.
+TEST_F(TestCollectiveOpsImpl, RingPipelineAllReduce) {
+  for (auto reduce_op : {device::Reduce_Sum, device::Reduce_Max}) {
+    for (uint32_t rank_size : {2, 3, 4}) {
+      RunAndCheck(Ranks(rank_size), kRingCount, reduce_op, false);
+    }
+  }
+  // Each chunk of 2 ranks is 2 segments, which are sent in one step of ReduceScatter and one step of AllGather.
+  RunAndCheck(Ranks(2), kRingCount, device::Reduce_Sum, false);
+  EXPECT_EQ(SendNum(0), 4);
+  EXPECT_EQ(SendNum(1), 4);
+}
+
+/// Feature: the ReduceScatter of the server collective communication within the group.
+/// Description: ReduceScatter the data by the group sizes of power of two and not, including the empty data and the
+/// data larger than the threshold of halving-doubling, by sum and max.
+/// Expectation: each rank gets the reduction of its own chunk of all the ranks.
+TEST_F(TestCollectiveOpsImpl, ReduceScatter) {
+  for (auto reduce_op : {device::Reduce_Sum, device::Reduce_Max}) {
+    for (uint32_t rank_size : {1, 2, 3, 4, 5, 8}) {
+      for (size_t recv_count : {0, 1, 3, 1000}) {
+        RunAndCheck(Ranks(rank_size), recv_count, reduce_op, true);
+      }
+    }
+    RunAndCheck(Ranks(4), kRingCount / 4, reduce_op, true);
+    RunAndCheck({6, 1, 3}, kRingCount / 3, reduce_op, true);
+  }
+  // The power of two processes halve the data log(n) times.
+  RunAndCheck(Ranks(4), 1000, device::Reduce_Sum, true);
+  for (uint32_t rank = 0; rank < 4; ++rank) {
+    EXPECT_EQ(SendNum(rank), 2);
+  }
+}
+
+/// Feature: the hierarchical AllReduce of the servers on multiple hosts.
+/// Description: AllReduce the data of the servers on the hosts of 3, 1 and 2 servers whose ranks are interleaved, by
+/// the sizes of the data smaller than the server number, of halving-doubling and of the ring among the host leaders.
+/// Expectation: the servers are grouped by the hosts in the order of the leaders which are the smallest ranks, the
+/// other servers only send their data to the leaders, and the results are the same as the flat AllReduce.
+TEST_F(TestCollectiveOpsImpl, HierarchicalAllReduce) {
+  std::vector<std::string> ips = {"10.0.0.2", "10.0.0.1", "10.0.0.2", "10.0.0.3", "10.0.0.2", "10.0.0.3"};
+  std::vector<std::vector<uint32_t>> expect_host_ranks = {{0, 2, 4}, {1}, {3, 5}};
+  std::vector<uint32_t> expect_host_indices = {0, 1, 0, 2, 0, 2};
+  for (size_t count : std::vector<size_t>{1, 5, 1000, kRingCount}) {
+    auto outputs = RunServerAllReduce(ips, count);
+    for (uint32_t rank = 0; rank < ips.size(); ++rank) {
+      EXPECT_EQ(server_ops_[rank]->host_ranks_, expect_host_ranks);
+      EXPECT_EQ(server_ops_[rank]->host_index_, expect_host_indices[rank]);
+    }
+    for (uint32_t rank : {2, 4, 5}) {
+      EXPECT_EQ(SendNum(rank), 1) << "rank " << rank << ", count " << count;
+    }
+
+    auto flat_outputs = RunServerAllReduce(std::vector<std::string>(ips.size()), count);
+    EXPECT_EQ(outputs, flat_outputs) << "count " << count;
+  }
+}
+
+/// Feature: the hierarchical AllReduce of the servers on multiple hosts.
+/// Description: AllReduce the data of the servers when the ip of one server is unknown, and when all the servers are
+/// on the same host.
+/// Expectation: the host topology is not used, and the servers run the flat ring AllReduce.
+TEST_F(TestCollectiveOpsImpl, HierarchicalAllReduceFallback) {
+  std::vector<std::string> ips = {"10.0.0.2", "10.0.0.1", "10.0.0.2", "10.0.0.3", "", "10.0.0.3"};
+  std::vector<std::string> same_host_ips(ips.size(), "10.0.0.1");
+  for (const auto &server_ips : {ips, same_host_ips}) {
+    (void)RunServerAllReduce(server_ips, 1000);
+    for (uint32_t rank = 0; rank < server_ips.size(); ++rank) {
+      EXPECT_TRUE(server_ops_[rank]->host_topology_inited_);
+      EXPECT_LE(server_ops_[rank]->host_ranks_.size(), 1);
+      // The ring sends one chunk in each step of ReduceScatter and AllGather.
+      EXPECT_EQ(SendNum(rank), 2 * (server_ips.size() - 1));
+    }
+  }
+}
+}  // namespace server
+}  // namespace fl
+}  // namespace mindspore
@@ -0,0 +1,151 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "common/common_test.h"
+#define private public
+#include "fl/server/kernel/fed_avg_accumulator.h"
+#undef private
+#include "utils/log_adapter.h"
+
+namespace mindspore {
+namespace fl {
+namespace server {
+namespace kernel {
+class TestFedAvgAccumulator : public UT::Common {
+ public:
+  TestFedAvgAccumulator() = default;
+  virtual ~TestFedAvgAccumulator() = default;
+
+  void SetUp() override {}
+  void TearDown() override {}
+};
+
+/// Feature: federated average of the federated learning server.
+/// Description: accumulate the float32 and float16 weights, then merge the partial sums twice.
+/// Expectation: the sum of the weights and data sizes is merged, and the partial sums are cleared after merging.
+TEST_F(TestFedAvgAccumulator, AccumulateAndMerge) {
+  FedAvgAccumulator accumulator;
+  accumulator.Init(3, 2);
+  std::vector<float> weight = {1.0, -2.0, 3.0};
+  std::vector<float16> fp16_weight = {float16(0.5), float16(0.25), float16(-1.0)};
+  ASSERT_TRUE(accumulator.Accumulate(weight.data(), weight.size(), 10));
+  ASSERT_TRUE(accumulator.Accumulate(fp16_weight.data(), fp16_weight.size(), 5));
+  EXPECT_FALSE(accumulator.Accumulate(weight.data(), 2, 1));
+
+  std::vector<float> result(3, 100.0);
+  size_t data_size = 0;
+  ASSERT_TRUE(accumulator.Merge(result.data(), result.size(), &data_size));
+  std::vector<float> expect = {1.5, -1.75, 2.0};
+  EXPECT_EQ(result, expect);
+  EXPECT_EQ(data_size, 15);
+
+  ASSERT_TRUE(accumulator.Merge(result.data(), result.size(), &data_size));
+  EXPECT_EQ(result, std::vector<float>(3, 0));
+  EXPECT_EQ(data_size, 0);
+
+  ASSERT_TRUE(accumulator.Accumulate(weight.data(), weight.size(), 10));
+  accumulator.Clear();
+  ASSERT_TRUE(accumulator.Merge(result.data(), result.size(), &data_size));
+  EXPECT_EQ(result, std::vector<float>(3, 0));
+}
+
+/// Feature: federated average of the federated learning server.
+/// Description: init the accumulator with more partial sums than the cores, and accumulate the weights from one thread.
+/// Expectation: the partial sums are capped by the cores, and only the partial sum used by the thread is allocated.
+TEST_F(TestFedAvgAccumulator, AllocPartialSumLazily) {
+  constexpr size_t kWeightLen = 1024;
+  size_t core_num = std::max<size_t>(1, std::thread::hardware_concurrency());
+  FedAvgAccumulator accumulator;
+  accumulator.Init(kWeightLen, core_num + 1);
+  ASSERT_EQ(accumulator.partial_sums_.size(), core_num);
+  for (const auto &partial_sum : accumulator.partial_sums_) {
+    EXPECT_TRUE(partial_sum->weight.empty());
+  }
+
+  std::vector<float> weight(kWeightLen, 1.0);
+  std::vector<float16> fp16_weight(kWeightLen, float16(2.0));
+  ASSERT_TRUE(accumulator.Accumulate(weight.data(), weight.size(), 1));
+  ASSERT_TRUE(accumulator.Accumulate(fp16_weight.data(), fp16_weight.size(), 1));
+  auto alloc_num = std::count_if(accumulator.partial_sums_.begin(), accumulator.partial_sums_.end(),
+                                 [](const auto &partial_sum) { return !partial_sum->weight.empty(); });
+  EXPECT_EQ(alloc_num, 1);
+
+  std::vector<float> result(kWeightLen, 0);
+  size_t data_size = 0;
+  ASSERT_TRUE(accumulator.Merge(result.data(), result.size(), &data_size));
+  EXPECT_EQ(result, std::vector<float>(kWeightLen, 3.0));
+  EXPECT_EQ(data_size, 2);
+}
+
+/// Feature: federated average of the federated learning server.
+/// Description: simulate the concurrent clients which upload the weights to the accumulator and to one locked sum.
+/// Expectation: the merged sum is exact, and the throughputs of both ways are logged.
+TEST_F(TestFedAvgAccumulator, ConcurrentClients) {
+  constexpr size_t kClientThreadNum = 8;
+  constexpr size_t kUpdateNumPerThread = 64;
+  constexpr size_t kWeightLen = 256 * 1024;
+  std::vector<float> weight(kWeightLen, 1.0);
+  FedAvgAccumulator accumulator;
+  accumulator.Init(kWeightLen);
+
+  auto run_clients = [&](const std::function<void()> &update) {
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> clients;
+    for (size_t i = 0; i < kClientThreadNum; ++i) {
+      clients.emplace_back([&]() {
+        for (size_t j = 0; j < kUpdateNumPerThread; ++j) {
+          update();
+        }
+      });
+    }
+    for (auto &client : clients) {
+      client.join();
+    }
+    auto cost = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return kClientThreadNum * kUpdateNumPerThread / cost;
+  };
+
+  double accumulator_rate =
+    run_clients([&]() { EXPECT_TRUE(accumulator.Accumulate(weight.data(), weight.size(), 1)); });
+  std::vector<float> result(kWeightLen, 0);
+  size_t data_size = 0;
+  ASSERT_TRUE(accumulator.Merge(result.data(), result.size(), &data_size));
+  EXPECT_EQ(data_size, kClientThreadNum * kUpdateNumPerThread);
+  EXPECT_EQ(result, std::vector<float>(kWeightLen, static_cast<float>(kClientThreadNum * kUpdateNumPerThread)));
+
+  // The scalar sum under one lock, which is the way before the accumulator.
+  std::mutex sum_mutex;
+  std::vector<float> locked_sum(kWeightLen, 0);
+  double locked_rate = run_clients([&]() {
+    std::unique_lock<std::mutex> lock(sum_mutex);
+    for (size_t i = 0; i < kWeightLen; ++i) {
+      locked_sum[i] += weight[i];
+    }
+  });
+  MS_LOG(INFO) << kClientThreadNum << " client threads, " << kWeightLen << " values: " << accumulator_rate
+               << " updates/s by the accumulator, " << locked_rate << " updates/s by the locked sum.";
+}
+}  // namespace kernel
+}  // namespace server
+}  // namespace fl
+}  // namespace mindspore
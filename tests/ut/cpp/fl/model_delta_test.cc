@@ -0,0 +1,103 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <string>
+#include <vector>
+
+#include "common/common_test.h"
+#include "fl/server/model_delta.h"
+
+namespace mindspore {
+namespace fl {
+namespace server {
+class TestModelDelta : public UT::Common {
+ public:
+  TestModelDelta() = default;
+  virtual ~TestModelDelta() = default;
+
+  void SetUp() override {}
+  void TearDown() override {}
+};
+
+/// Feature: model distribution of the federated learning server.
+/// Description: encode the delta between two models in which a few values are changed, then decode it.
+/// Expectation: the new model is decoded from the base model, and the delta is much smaller than the model.
+TEST_F(TestModelDelta, EncodeAndDecode) {
+  constexpr size_t kWeightLen = 10000;
+  std::vector<float> base(kWeightLen);
+  for (size_t i = 0; i < kWeightLen; ++i) {
+    base[i] = 0.001 * i;
+  }
+  std::vector<float> weight = base;
+  weight[7] += 0.5;
+  weight[5000] = -1.0;
+  weight[kWeightLen - 1] *= 1.0001;
+  // The bias has a tail shorter than one word and is not in the base model.
+  std::vector<uint8_t> bias = {1, 0, 0, 0, 0, 0, 2};
+
+  ModelDeltaEncoder encoder(3, 4);
+  encoder.AddWeight("bias", nullptr, bias.data(), bias.size());
+  encoder.AddWeight("weight", base.data(), weight.data(), weight.size() * sizeof(float));
+  encoder.AddWeight("empty", nullptr, nullptr, 0);
+  std::string delta = encoder.Finish();
+  EXPECT_LT(delta.size(), kWeightLen * sizeof(float) / 100);
+
+  ModelDeltaDecoder decoder;
+  ASSERT_TRUE(decoder.Parse(delta.data(), delta.size()));
+  EXPECT_EQ(decoder.base_iteration(), 3);
+  EXPECT_EQ(decoder.iteration(), 4);
+  const auto &weights = decoder.weights();
+  ASSERT_EQ(weights.size(), 3);
+  EXPECT_EQ(weights[0].name, "bias");
+  EXPECT_EQ(weights[1].name, "weight");
+  ASSERT_EQ(weights[1].size, kWeightLen * sizeof(float));
+
+  std::vector<uint8_t> decoded_bias(bias.size());
+  ASSERT_TRUE(ModelDeltaDecoder::DecodeWeight(weights[0], nullptr, decoded_bias.data()));
+  EXPECT_EQ(decoded_bias, bias);
+  std::vector<float> decoded_weight(kWeightLen);
+  ASSERT_TRUE(ModelDeltaDecoder::DecodeWeight(weights[1], base.data(), decoded_weight.data()));
+  EXPECT_EQ(decoded_weight, weight);
+  EXPECT_TRUE(ModelDeltaDecoder::DecodeWeight(weights[2], nullptr, nullptr));
+}
+
+/// Feature: model distribution of the federated learning server.
+/// Description: parse the truncated and corrupted model deltas.
+/// Expectation: the invalid deltas are rejected.
+TEST_F(TestModelDelta, InvalidDelta) {
+  std::vector<float> weight = {1.0, 2.0, 3.0};
+  ModelDeltaEncoder encoder(0, 1);
+  encoder.AddWeight("weight", nullptr, weight.data(), weight.size() * sizeof(float));
+  std::string delta = encoder.Finish();
+
+  ModelDeltaDecoder decoder;
+  EXPECT_FALSE(decoder.Parse(delta.data(), delta.size() - 1));
+  std::string bad_magic = delta;
+  bad_magic[0] = 0;
+  EXPECT_FALSE(decoder.Parse(bad_magic.data(), bad_magic.size()));
+
+  // The run of zeros which is longer than the weight is rejected.
+  ASSERT_TRUE(decoder.Parse(delta.data(), delta.size()));
+  ModelDeltaWeight bad_weight = decoder.weights()[0];
+  std::vector<uint8_t> bad_runs = {100, 0};
+  bad_weight.delta = bad_runs.data();
+  bad_weight.delta_size = bad_runs.size();
+  std::vector<float> output(weight.size());
+  EXPECT_FALSE(ModelDeltaDecoder::DecodeWeight(bad_weight, nullptr, output.data()));
+}
+}  // namespace server
+}  // namespace fl
+}  // namespace mindspore
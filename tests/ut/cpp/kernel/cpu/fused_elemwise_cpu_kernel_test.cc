@@ -0,0 +1,198 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cmath>
+#include <vector>
+#include "common/common_test.h"
+#include "ir/func_graph.h"
+#include "abstract/abstract_value.h"
+#define private public
+#define protected public
+#include "plugin/device/cpu/kernel/fused_elemwise_cpu_kernel.h"
+#undef private
+#undef protected
+
+namespace mindspore {
+namespace kernel {
+namespace {
+constexpr float kGeLUCoeff = 0.044715;
+constexpr float kSqrtTwoDivPi = 0.7978845608028564;
+}  // namespace
+
+class FusedElemwiseCpuKernelTest : public UT::Common {
+ public:
+  FusedElemwiseCpuKernelTest() {}
+
+  void SetUp() override {
+    sub_graph_ = std::make_shared<FuncGraph>();
+    sub_graph_->set_attr(FUNC_GRAPH_ATTR_GRAPH_KERNEL, MakeValue("fused_elemwise"));
+  }
+
+  ParameterPtr NewParameter(const ShapeVector &shape) {
+    auto parameter = sub_graph_->add_parameter();
+    parameter->set_abstract(std::make_shared<abstract::AbstractTensor>(kFloat32, shape));
+    return parameter;
+  }
+
+  CNodePtr NewNode(const std::string &op_name, const AnfNodePtrList &inputs, const ShapeVector &shape) {
+    AnfNodePtrList node_inputs = {NewValueNode(std::make_shared<Primitive>(op_name))};
+    (void)node_inputs.insert(node_inputs.end(), inputs.begin(), inputs.end());
+    auto node = sub_graph_->NewCNode(node_inputs);
+    node->set_abstract(std::make_shared<abstract::AbstractTensor>(kFloat32, shape));
+    return node;
+  }
+
+  ValueNodePtr NewScalar(float value) {
+    auto tensor = std::make_shared<tensor::Tensor>(static_cast<double>(value), kFloat32);
+    auto value_node = NewValueNode(tensor);
+    value_node->set_abstract(tensor->ToAbstract());
+    return value_node;
+  }
+
+  // Creates the graph kernel node calling the sub graph in a main graph.
+  CNodePtr NewGraphKernelNode() {
+    auto main_graph = std::make_shared<FuncGraph>();
+    AnfNodePtrList inputs = {NewValueNode(sub_graph_)};
+    for (const auto &sub_parameter : sub_graph_->parameters()) {
+      auto parameter = main_graph->add_parameter();
+      parameter->set_abstract(sub_parameter->abstract());
+      inputs.push_back(parameter);
+    }
+    auto node = main_graph->NewCNode(inputs);
+    node->set_abstract(sub_graph_->output()->abstract());
+    main_graph->set_output(node);
+    return node;
+  }
+
+  AddressPtr CreateKernelAddress(void *addr, size_t elem_num) {
+    auto kernel_addr = std::make_shared<Address>();
+    kernel_addr->addr = addr;
+    kernel_addr->size = elem_num * sizeof(float);
+    return kernel_addr;
+  }
+
+  FuncGraphPtr sub_graph_;
+};
+
+/// Feature: FusedElemwiseCpuKernelMod which runs an elementwise graph kernel node without AKG.
+/// Description: run the expanded BiasAdd(NCHW) -> GeLU cluster fused, and run its operators one by one.
+/// Expectation: the fused outputs are equal to the outputs of the unfused operators.
+TEST_F(FusedElemwiseCpuKernelTest, bias_add_gelu_test) {
+  constexpr size_t kN = 4;
+  constexpr size_t kC = 3;
+  constexpr size_t kH = 16;
+  constexpr size_t kW = 32;
+  constexpr size_t kHW = kH * kW;
+  constexpr size_t kSize = kN * kC * kHW;
+  ShapeVector shape = {kN, kC, kH, kW};
+  auto x = NewParameter(shape);
+  auto bias = NewParameter({kC});
+  // BiasAdd on NCHW is expanded into Reshape(bias) and Add, GeLU into its tanh approximation.
+  auto reshape = NewNode("Reshape", {bias}, {kC, 1, 1});
+  auto bias_add = NewNode("Add", {x, reshape}, shape);
+  auto square = NewNode("Mul", {bias_add, bias_add}, shape);
+  auto cube = NewNode("Mul", {square, bias_add}, shape);
+  auto scaled_cube = NewNode("Mul", {cube, NewScalar(kGeLUCoeff)}, shape);
+  auto inner = NewNode("Add", {bias_add, scaled_cube}, shape);
+  auto y = NewNode("Mul", {inner, NewScalar(kSqrtTwoDivPi)}, shape);
+  auto tanh_y = NewNode("Tanh", {y}, shape);
+  auto tanh_y_add_one = NewNode("Add", {tanh_y, NewScalar(1.0)}, shape);
+  auto mul_x = NewNode("Mul", {bias_add, tanh_y_add_one}, shape);
+  auto gelu = NewNode("Mul", {NewScalar(0.5), mul_x}, shape);
+  auto output = sub_graph_->NewCNode({NewValueNode(prim::kPrimMakeTuple), gelu, bias_add});
+  output->set_abstract(std::make_shared<abstract::AbstractTuple>(
+    AbstractBasePtrList{gelu->abstract(), bias_add->abstract()}));
+  sub_graph_->set_output(output);
+  auto kernel_node = NewGraphKernelNode();
+  ASSERT_TRUE(FusedElemwiseCpuKernelMod::IsSupported(kernel_node));
+
+  std::vector<float> x_data(kSize);
+  std::vector<float> bias_data = {0.5, -1.0, 2.0};
+  for (size_t i = 0; i < kSize; ++i) {
+    x_data[i] = static_cast<float>(static_cast<int>(i % 37) - 18) * 0.1f;
+  }
+  // The unfused operators, every one makes a pass over the whole tensor.
+  std::vector<float> expect_bias_add(kSize);
+  for (size_t i = 0; i < kSize; ++i) {
+    expect_bias_add[i] = x_data[i] + bias_data[(i / kHW) % kC];
+  }
+  std::vector<float> tmp(kSize);
+  for (size_t i = 0; i < kSize; ++i) {
+    tmp[i] = expect_bias_add[i] * expect_bias_add[i];
+  }
+  for (size_t i = 0; i < kSize; ++i) {
+    tmp[i] = tmp[i] * expect_bias_add[i];
+  }
+  for (size_t i = 0; i < kSize; ++i) {
+    tmp[i] = tmp[i] * kGeLUCoeff;
+  }
+  for (size_t i = 0; i < kSize; ++i) {
+    tmp[i] = expect_bias_add[i] + tmp[i];
+  }
+  for (size_t i = 0; i < kSize; ++i) {
+    tmp[i] = tmp[i] * kSqrtTwoDivPi;
+  }
+  for (size_t i = 0; i < kSize; ++i) {
+    tmp[i] = std::tanh(tmp[i]);
+  }
+  for (size_t i = 0; i < kSize; ++i) {
+    tmp[i] = tmp[i] + 1.0f;
+  }
+  for (size_t i = 0; i < kSize; ++i) {
+    tmp[i] = expect_bias_add[i] * tmp[i];
+  }
+  std::vector<float> expect_gelu(kSize);
+  for (size_t i = 0; i < kSize; ++i) {
+    expect_gelu[i] = 0.5f * tmp[i];
+  }
+
+  auto fused = std::make_shared<FusedElemwiseCpuKernelMod>();
+  fused->InitKernel(kernel_node);
+  fused->input_size_list_ = {kSize * sizeof(float), kC * sizeof(float)};
+  fused->output_size_list_ = {kSize * sizeof(float), kSize * sizeof(float)};
+  std::vector<float> gelu_data(kSize);
+  std::vector<float> bias_add_data(kSize);
+  std::vector<AddressPtr> inputs = {CreateKernelAddress(x_data.data(), kSize),
+                                    CreateKernelAddress(bias_data.data(), kC)};
+  std::vector<AddressPtr> outputs = {CreateKernelAddress(gelu_data.data(), kSize),
+                                     CreateKernelAddress(bias_add_data.data(), kSize)};
+  ASSERT_TRUE(fused->Launch(inputs, {}, outputs));
+  for (size_t i = 0; i < kSize; ++i) {
+    EXPECT_FLOAT_EQ(bias_add_data[i], expect_bias_add[i]);
+    EXPECT_NEAR(gelu_data[i], expect_gelu[i], 1e-5);
+  }
+}
+
+/// Feature: FusedElemwiseCpuKernelMod which runs an elementwise graph kernel node without AKG.
+/// Description: check graph kernel nodes with a reduction and with a reshape of a computed value.
+/// Expectation: both are left to AKG.
+TEST_F(FusedElemwiseCpuKernelTest, unsupported_test) {
+  ShapeVector shape = {8, 16};
+  auto x = NewParameter(shape);
+  auto exp = NewNode("Exp", {x}, shape);
+  auto sum = NewNode("ReduceSum", {exp}, {8, 1});
+  sub_graph_->set_output(NewNode("RealDiv", {exp, sum}, shape));
+  EXPECT_FALSE(FusedElemwiseCpuKernelMod::IsSupported(NewGraphKernelNode()));
+
+  SetUp();
+  x = NewParameter(shape);
+  exp = NewNode("Exp", {x}, shape);
+  auto reshape = NewNode("Reshape", {exp}, {16, 8});
+  sub_graph_->set_output(NewNode("Neg", {reshape}, {16, 8}));
+  EXPECT_FALSE(FusedElemwiseCpuKernelMod::IsSupported(NewGraphKernelNode()));
+}
+}  // namespace kernel
+}  // namespace mindspore
@@ -0,0 +1,103 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <vector>
+#include "common/common_test.h"
+#include "plugin/device/cpu/kernel/reduce_engine.h"
+
+namespace mindspore {
+namespace kernel {
+class ReduceEngineTest : public UT::Common {
+ public:
+  ReduceEngineTest() = default;
+};
+
+TEST_F(ReduceEngineTest, canonicalize_axes) {
+  ReduceLayout layout;
+  // Adjacent reduced axes merge into one block.
+  EXPECT_TRUE(CanonicalizeReduceAxes({2, 3, 4, 5}, {1, 2}, &layout));
+  EXPECT_EQ(layout.outer_, 2);
+  EXPECT_EQ(layout.reduce_, 12);
+  EXPECT_EQ(layout.inner_, 5);
+  // A kept axis of size 1 does not split the block.
+  EXPECT_TRUE(CanonicalizeReduceAxes({2, 3, 1, 5}, {1, 3}, &layout));
+  EXPECT_EQ(layout.outer_, 2);
+  EXPECT_EQ(layout.reduce_, 15);
+  EXPECT_EQ(layout.inner_, 1);
+  // An empty axis list reduces everything.
+  EXPECT_TRUE(CanonicalizeReduceAxes({2, 3}, {}, &layout));
+  EXPECT_EQ(layout.outer_, 1);
+  EXPECT_EQ(layout.reduce_, 6);
+  EXPECT_EQ(layout.inner_, 1);
+  EXPECT_FALSE(CanonicalizeReduceAxes({2, 3, 4}, {0, 2}, &layout));
+}
+
+TEST_F(ReduceEngineTest, reduce_middle_axis) {
+  // Shape (3, 100, 300) reduced on axis 1, the inner axis spans more than one tile.
+  size_t outer = 3;
+  size_t reduce = 100;
+  size_t inner = 300;
+  std::vector<float> input(outer * reduce * inner);
+  for (size_t i = 0; i < input.size(); ++i) {
+    input[i] = static_cast<float>(i % 7);
+  }
+  ReduceLayout layout;
+  EXPECT_TRUE(CanonicalizeReduceAxes({outer, reduce, inner}, {1}, &layout));
+  std::vector<float> sum(outer * inner);
+  ReduceEngine<float, ReduceSumOp>(layout).Run(input.data(), sum.data());
+  std::vector<float> max(outer * inner);
+  ReduceEngine<float, ReduceMaxOp>(layout).Run(input.data(), max.data());
+  for (size_t o = 0; o < outer; ++o) {
+    for (size_t j = 0; j < inner; ++j) {
+      float expect_sum = 0;
+      float expect_max = 0;
+      for (size_t r = 0; r < reduce; ++r) {
+        float value = input[(o * reduce + r) * inner + j];
+        expect_sum += value;
+        expect_max = std::max(expect_max, value);
+      }
+      EXPECT_FLOAT_EQ(sum[o * inner + j], expect_sum);
+      EXPECT_EQ(max[o * inner + j], expect_max);
+    }
+  }
+}
+
+TEST_F(ReduceEngineTest, reduce_long_row) {
+  // A single long row is split over the reduce axis.
+  std::vector<int64_t> input(1000003);
+  int64_t expect = 0;
+  for (size_t i = 0; i < input.size(); ++i) {
+    input[i] = static_cast<int64_t>(i % 13) - 6;
+    expect += input[i];
+  }
+  ReduceLayout layout;
+  EXPECT_TRUE(CanonicalizeReduceAxes({input.size()}, {0}, &layout));
+  int64_t output = 0;
+  ReduceEngine<int64_t, ReduceSumOp>(layout).Run(input.data(), &output);
+  EXPECT_EQ(output, expect);
+
+  bool flags[] = {true, true, false, true, true, true, true, true, true, true};
+  EXPECT_TRUE(CanonicalizeReduceAxes({10}, {0}, &layout));
+  bool all = true;
+  ReduceEngine<bool, ReduceAndOp>(layout).Run(flags, &all);
+  EXPECT_FALSE(all);
+  bool any = false;
+  ReduceEngine<bool, ReduceOrOp>(layout).Run(flags, &any);
+  EXPECT_TRUE(any);
+}
+}  // namespace kernel
+}  // namespace mindspore
@@ -14,6 +14,8 @@
  * limitations under the License.
  */
 
+#include <cmath>
+#include <map>
 #include <vector>
 #include "common/common_test.h"
 #define private public
@@ -58,13 +60,17 @@ class SparseApplyAdamCpuKernelTest : public UT::Common {
     inputs_.push_back(CreateKernelAddress(indices.data()));
   }
 
-  void CreateWorkspaceAddress(std::vector<float> &new_grad, std::vector<int64_t> &new_indices,
-                              std::vector<float> &tmp_grad, std::vector<int64_t> &tmp_indices,
+  void CreateWorkspaceAddress(std::vector<int64_t> &new_indices, std::vector<int64_t> &tmp_indices,
                               std::vector<float> &m_t) {
-    workspace_.push_back(CreateKernelAddress(new_grad.data()));
     workspace_.push_back(CreateKernelAddress(new_indices.data()));
-    workspace_.push_back(CreateKernelAddress(tmp_grad.data()));
     workspace_.push_back(CreateKernelAddress(tmp_indices.data()));
+    radix_workspace_.resize(RadixUnique<int64_t, int64_t>::WorkspaceSize(new_indices.size()));
+    workspace_.push_back(CreateKernelAddress(radix_workspace_.data()));
+    workspace_.back()->size = radix_workspace_.size();
+    reduce_indices_.resize(new_indices.size());
+    reduce_values_.resize(grad_.size());
+    workspace_.push_back(CreateKernelAddress(reduce_indices_.data()));
+    workspace_.push_back(CreateKernelAddress(reduce_values_.data()));
     workspace_.push_back(CreateKernelAddress(m_t.data()));
   }
 
@@ -73,6 +79,9 @@ class SparseApplyAdamCpuKernelTest : public UT::Common {
   std::vector<float> v_;
   std::vector<float> grad_;
   std::vector<AddressPtr> inputs_;
+  std::vector<uint8_t> radix_workspace_;
+  std::vector<int64_t> reduce_indices_;
+  std::vector<float> reduce_values_;
   std::vector<AddressPtr> workspace_;
   std::vector<AddressPtr> outputs_;
   std::shared_ptr<SparseApplyAdamCpuKernelMod> sparse_adam_;
@@ -98,12 +107,10 @@ TEST_F(SparseApplyAdamCpuKernelTest, dense_test) {
 
   std::vector<int64_t> indices{0, 1, 2};
   CreateInputAddress(indices);
-  std::vector<float> new_grad(3 * 3 * 3);
   std::vector<int64_t> new_indices(3);
-  std::vector<float> tmp_grad(3 * 3 * 3);
   std::vector<int64_t> tmp_indices(3);
   std::vector<float> m_t(3 * 3 * 3);
-  CreateWorkspaceAddress(new_grad, new_indices, tmp_grad, tmp_indices, m_t);
+  CreateWorkspaceAddress(new_indices, tmp_indices, m_t);
   sparse_adam_->Launch(inputs_, workspace_, outputs_);
   for (size_t i = 0; i < 3 * 3 * 3; ++i) {
     EXPECT_TRUE(std::fabs(var_[i] - 0.999684) < 1e-6);
@@ -126,12 +133,10 @@ TEST_F(SparseApplyAdamCpuKernelTest, sparse_test1) {
 
   std::vector<int64_t> indices{0, 2};
   CreateInputAddress(indices);
-  std::vector<float> new_grad(3 * 3 * 3);
   std::vector<int64_t> new_indices(3);
-  std::vector<float> tmp_grad(3 * 3 * 3);
   std::vector<int64_t> tmp_indices(3);
   std::vector<float> m_t(3 * 3 * 3);
-  CreateWorkspaceAddress(new_grad, new_indices, tmp_grad, tmp_indices, m_t);
+  CreateWorkspaceAddress(new_indices, tmp_indices, m_t);
   sparse_adam_->Launch(inputs_, workspace_, outputs_);
   for (size_t i = 0; i < 3 * 3; ++i) {
     EXPECT_TRUE(std::fabs(var_[i] - 0.999684) < 1e-6);
@@ -158,12 +163,10 @@ TEST_F(SparseApplyAdamCpuKernelTest, sparse_test2) {
 
   std::vector<int64_t> indices{2, 2, 1};
   CreateInputAddress(indices);
-  std::vector<float> new_grad(3 * 3 * 3);
   std::vector<int64_t> new_indices(3);
-  std::vector<float> tmp_grad(3 * 3 * 3);
   std::vector<int64_t> tmp_indices(3);
   std::vector<float> m_t(3 * 3 * 3);
-  CreateWorkspaceAddress(new_grad, new_indices, tmp_grad, tmp_indices, m_t);
+  CreateWorkspaceAddress(new_indices, tmp_indices, m_t);
   sparse_adam_->Launch(inputs_, workspace_, outputs_);
   for (size_t i = 0; i < 3 * 3; ++i) {
     EXPECT_TRUE(std::fabs(var_[i] - 0.999715) < 1e-6);
@@ -175,5 +178,134 @@ TEST_F(SparseApplyAdamCpuKernelTest, sparse_test2) {
     EXPECT_TRUE(std::fabs(var_[i] - 0.999653) < 1e-6);
   }
 }
+/// Feature: SparseApplyAdam which deduplicates the sparse gradient fused with the row update.
+/// Description: launch with many duplicate indices, and launch with the gradient rows of equal indices summed before.
+/// Expectation: the var, m and v updated by the two launches are equal.
+TEST_F(SparseApplyAdamCpuKernelTest, fused_reduce_test) {
+  constexpr size_t kFirstDim = 1000;
+  constexpr size_t kOuterDim = 4;
+  constexpr size_t kIndicesSize = 20000;
+  // The last rows are not updated by the gradient.
+  constexpr size_t kUpdatedRows = 900;
+  std::vector<int64_t> indices(kIndicesSize);
+  std::vector<float> raw_grad(kIndicesSize * kOuterDim);
+  for (size_t i = 0; i < kIndicesSize; ++i) {
+    indices[i] = static_cast<int64_t>((i * 7919) % kUpdatedRows);
+    for (size_t j = 0; j < kOuterDim; ++j) {
+      raw_grad[i * kOuterDim + j] = 0.001 * ((i + j) % 17);
+    }
+  }
+
+  // The old path: reduce the gradient rows of equal indices first, then apply the unique rows.
+  std::map<int64_t, std::vector<float>> reduced;
+  for (size_t i = 0; i < kIndicesSize; ++i) {
+    auto &row = reduced[indices[i]];
+    row.resize(kOuterDim, 0);
+    for (size_t j = 0; j < kOuterDim; ++j) {
+      row[j] += raw_grad[i * kOuterDim + j];
+    }
+  }
+  ASSERT_EQ(reduced.size(), kUpdatedRows);
+  std::vector<int64_t> unique_indices;
+  std::vector<float> summed_grad;
+  for (const auto &item : reduced) {
+    unique_indices.push_back(item.first);
+    summed_grad.insert(summed_grad.end(), item.second.begin(), item.second.end());
+  }
+
+  var_.assign(kFirstDim * kOuterDim, 1.0);
+  m_.assign(kFirstDim * kOuterDim, 1.0);
+  v_.assign(kFirstDim * kOuterDim, 1.0);
+  grad_ = summed_grad;
+  sparse_adam_->indices_size_ = kUpdatedRows;
+  sparse_adam_->var_first_dim_size_ = kFirstDim;
+  sparse_adam_->var_outer_dim_size_ = kOuterDim;
+  sparse_adam_->indices_data_type_ = kNumberTypeInt64;
+  CreateInputAddress(unique_indices);
+  std::vector<int64_t> first_pos(kIndicesSize);
+  std::vector<int64_t> inverse_indices(kIndicesSize);
+  std::vector<float> m_t(kFirstDim * kOuterDim);
+  CreateWorkspaceAddress(first_pos, inverse_indices, m_t);
+  sparse_adam_->Launch(inputs_, workspace_, outputs_);
+  std::vector<float> expect_var = var_;
+  std::vector<float> expect_m = m_;
+  std::vector<float> expect_v = v_;
+
+  // The fused path on the raw gradient.
+  var_.assign(kFirstDim * kOuterDim, 1.0);
+  m_.assign(kFirstDim * kOuterDim, 1.0);
+  v_.assign(kFirstDim * kOuterDim, 1.0);
+  grad_ = raw_grad;
+  inputs_.clear();
+  workspace_.clear();
+  auto fused_adam = std::make_shared<SparseApplyAdamCpuKernelMod>();
+  fused_adam->indices_size_ = kIndicesSize;
+  fused_adam->var_first_dim_size_ = kFirstDim;
+  fused_adam->var_outer_dim_size_ = kOuterDim;
+  fused_adam->indices_data_type_ = kNumberTypeInt64;
+  CreateInputAddress(indices);
+  CreateWorkspaceAddress(first_pos, inverse_indices, m_t);
+  fused_adam->Launch(inputs_, workspace_, outputs_);
+  for (size_t i = 0; i < kFirstDim * kOuterDim; ++i) {
+    EXPECT_NEAR(var_[i], expect_var[i], 1e-5);
+    EXPECT_NEAR(m_[i], expect_m[i], 1e-5);
+    EXPECT_NEAR(v_[i], expect_v[i], 1e-5);
+  }
+}
+
+/// Feature: SparseApplyAdam which deduplicates the sparse gradient fused with the row update.
+/// Description: launch by several threads with skewed indices, where one hot index takes most of the gradient rows.
+/// Expectation: the reduced rows fit into the workspace of the gradient size, and every row is updated by the sum of
+/// its gradient rows once.
+TEST_F(SparseApplyAdamCpuKernelTest, fused_skewed_reduce_test) {
+  constexpr size_t kFirstDim = 5000;
+  constexpr size_t kOuterDim = 3;
+  constexpr size_t kIndicesSize = 40000;
+  constexpr size_t kColdStride = 10;
+  constexpr size_t kThreadNum = 4;
+  constexpr int64_t kHotIndex = 7;
+  std::vector<int64_t> indices(kIndicesSize);
+  std::map<int64_t, std::vector<float>> reduced;
+  for (size_t i = 0; i < kIndicesSize; ++i) {
+    indices[i] = i % kColdStride == 0 ? static_cast<int64_t>((i / kColdStride) % kFirstDim) : kHotIndex;
+    auto &row = reduced[indices[i]];
+    row.resize(kOuterDim, 0);
+    for (size_t j = 0; j < kOuterDim; ++j) {
+      grad_.push_back(0.0001 * ((i + j) % 13));
+      row[j] += grad_.back();
+    }
+  }
+  var_.assign(kFirstDim * kOuterDim, 1.0);
+  m_.assign(kFirstDim * kOuterDim, 1.0);
+  v_.assign(kFirstDim * kOuterDim, 1.0);
+  sparse_adam_->indices_size_ = kIndicesSize;
+  sparse_adam_->var_first_dim_size_ = kFirstDim;
+  sparse_adam_->var_outer_dim_size_ = kOuterDim;
+  sparse_adam_->indices_data_type_ = kNumberTypeInt64;
+  CreateInputAddress(indices);
+  std::vector<int64_t> first_pos(kIndicesSize);
+  std::vector<int64_t> inverse_indices(kIndicesSize);
+  std::vector<float> m_t(kFirstDim * kOuterDim);
+  auto &thread_pool = common::ThreadPool::GetInstance();
+  auto max_thread_num = thread_pool.max_thread_num_;
+  thread_pool.max_thread_num_ = kThreadNum;
+  CreateWorkspaceAddress(first_pos, inverse_indices, m_t);
+  sparse_adam_->Launch(inputs_, workspace_, outputs_);
+  thread_pool.max_thread_num_ = max_thread_num;
+
+  float lr = lr_ * std::sqrt(1 - beta2_power_) / (1 - beta1_power_);
+  for (size_t row = 0; row < kFirstDim; ++row) {
+    for (size_t j = 0; j < kOuterDim; ++j) {
+      auto iter = reduced.find(static_cast<int64_t>(row));
+      float grad = iter == reduced.end() ? 0 : iter->second[j];
+      float m = beta1_ + (1 - beta1_) * grad;
+      float v = beta2_ + (1 - beta2_) * grad * grad;
+      size_t k = row * kOuterDim + j;
+      EXPECT_NEAR(m_[k], m, 1e-5) << "row " << row;
+      EXPECT_NEAR(v_[k], v, 1e-5) << "row " << row;
+      EXPECT_NEAR(var_[k], 1 - lr * m / (std::sqrt(v) + epsilon_), 1e-5) << "row " << row;
+    }
+  }
+}
 }  // namespace kernel
 }  // namespace mindspore
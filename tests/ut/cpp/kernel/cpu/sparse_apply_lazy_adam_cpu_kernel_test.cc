@@ -58,12 +58,16 @@ class SparseApplyLazyAdamCpuKernelTest : public UT::Common {
     inputs_.push_back(CreateKernelAddress(indices.data()));
   }
 
-  void CreateWorkspaceAddress(std::vector<float> &new_grad, std::vector<int64_t> &new_indices,
-                              std::vector<float> &tmp_grad, std::vector<int64_t> &tmp_indices) {
-    workspace_.push_back(CreateKernelAddress(new_grad.data()));
+  void CreateWorkspaceAddress(std::vector<int64_t> &new_indices, std::vector<int64_t> &tmp_indices) {
     workspace_.push_back(CreateKernelAddress(new_indices.data()));
-    workspace_.push_back(CreateKernelAddress(tmp_grad.data()));
     workspace_.push_back(CreateKernelAddress(tmp_indices.data()));
+    radix_workspace_.resize(RadixUnique<int64_t, int64_t>::WorkspaceSize(new_indices.size()));
+    workspace_.push_back(CreateKernelAddress(radix_workspace_.data()));
+    workspace_.back()->size = radix_workspace_.size();
+    reduce_indices_.resize(new_indices.size());
+    reduce_values_.resize(grad_.size());
+    workspace_.push_back(CreateKernelAddress(reduce_indices_.data()));
+    workspace_.push_back(CreateKernelAddress(reduce_values_.data()));
   }
 
   std::vector<float> var_;
@@ -71,6 +75,9 @@ class SparseApplyLazyAdamCpuKernelTest : public UT::Common {
   std::vector<float> v_;
   std::vector<float> grad_;
   std::vector<AddressPtr> inputs_;
+  std::vector<uint8_t> radix_workspace_;
+  std::vector<int64_t> reduce_indices_;
+  std::vector<float> reduce_values_;
   std::vector<AddressPtr> workspace_;
   std::vector<AddressPtr> outputs_;
   std::shared_ptr<SparseApplyLazyAdamCpuKernelMod> sparse_lazy_adam_;
@@ -96,11 +103,9 @@ TEST_F(SparseApplyLazyAdamCpuKernelTest, dense_test) {
 
   std::vector<int64_t> indices{0, 1, 2};
   CreateInputAddress(indices);
-  std::vector<float> new_grad(3 * 3 * 3);
   std::vector<int64_t> new_indices(3);
-  std::vector<float> tmp_grad(3 * 3 * 3);
   std::vector<int64_t> tmp_indices(3);
-  CreateWorkspaceAddress(new_grad, new_indices, tmp_grad, tmp_indices);
+  CreateWorkspaceAddress(new_indices, tmp_indices);
   sparse_lazy_adam_->Launch(inputs_, workspace_, outputs_);
   for (size_t i = 0; i < 3 * 3 * 3; ++i) {
     EXPECT_TRUE(std::fabs(var_[i] - 0.999684) < 1e-6);
@@ -123,11 +128,9 @@ TEST_F(SparseApplyLazyAdamCpuKernelTest, sparse_test1) {
 
   std::vector<int64_t> indices{0, 2};
   CreateInputAddress(indices);
-  std::vector<float> new_grad(3 * 3 * 3);
   std::vector<int64_t> new_indices(3);
-  std::vector<float> tmp_grad(3 * 3 * 3);
   std::vector<int64_t> tmp_indices(3);
-  CreateWorkspaceAddress(new_grad, new_indices, tmp_grad, tmp_indices);
+  CreateWorkspaceAddress(new_indices, tmp_indices);
   sparse_lazy_adam_->Launch(inputs_, workspace_, outputs_);
   for (size_t i = 0; i < 3 * 3; ++i) {
     EXPECT_TRUE(std::fabs(var_[i] - 0.999684) < 1e-6);
@@ -154,11 +157,9 @@ TEST_F(SparseApplyLazyAdamCpuKernelTest, sparse_test2) {
 
   std::vector<int64_t> indices{2, 2, 1};
   CreateInputAddress(indices);
-  std::vector<float> new_grad(3 * 3 * 3);
   std::vector<int64_t> new_indices(3);
-  std::vector<float> tmp_grad(3 * 3 * 3);
   std::vector<int64_t> tmp_indices(3);
-  CreateWorkspaceAddress(new_grad, new_indices, tmp_grad, tmp_indices);
+  CreateWorkspaceAddress(new_indices, tmp_indices);
   sparse_lazy_adam_->Launch(inputs_, workspace_, outputs_);
   for (size_t i = 0; i < 3 * 3; ++i) {
     EXPECT_EQ(var_[i], 1.0);
@@ -61,6 +61,11 @@ TEST_F(CommonUtilTest, BucketReduceSparseGradient1) {
   param.output_grad_ = &unique_grad;
   param.max_index_ = 6;
   param.value_stride_ = 2;
+  std::vector<int> inverse_indices(input_grad.indices_size_);
+  std::vector<uint8_t> radix_workspace(RadixUnique<int, int>::WorkspaceSize(input_grad.indices_size_));
+  param.inverse_indices_ = inverse_indices.data();
+  param.radix_workspace_ = radix_workspace.data();
+  param.radix_workspace_size_ = radix_workspace.size();
   SparseOptimizerCpuKernelMod::BucketReduceSparseGradient(param);
 
   EXPECT_EQ(unique_grad.indices_size_, 3);
@@ -113,6 +118,11 @@ TEST_F(CommonUtilTest, BucketReduceSparseGradient2) {
   param.output_grad_ = &unique_grad;
   param.max_index_ = 6;
   param.value_stride_ = 2;
+  std::vector<int> inverse_indices(input_grad.indices_size_);
+  std::vector<uint8_t> radix_workspace(RadixUnique<int, int>::WorkspaceSize(input_grad.indices_size_));
+  param.inverse_indices_ = inverse_indices.data();
+  param.radix_workspace_ = radix_workspace.data();
+  param.radix_workspace_size_ = radix_workspace.size();
   SparseOptimizerCpuKernelMod::BucketReduceSparseGradient(param);
 
   EXPECT_EQ(unique_grad.indices_size_, 2);
@@ -130,5 +140,59 @@ TEST_F(CommonUtilTest, BucketReduceSparseGradient2) {
     EXPECT_EQ(unique_grad.value_[i], expect_value[i]);
   }
 }
+TEST_F(CommonUtilTest, BucketReduceSparseGradientLargeInput) {
+  // Enough indices to split the reduction into several radix partitions, every fourth index is out of range.
+  constexpr size_t kIndicesSize = 100000;
+  constexpr size_t kMaxIndex = 3000;
+  constexpr size_t kValueStride = 2;
+  std::vector<int> indices(kIndicesSize);
+  std::vector<float> grad(kIndicesSize * kValueStride);
+  for (size_t i = 0; i < kIndicesSize; ++i) {
+    indices[i] = static_cast<int>((i * 13) % (kMaxIndex + kMaxIndex / 3));
+    grad[i * kValueStride] = 1;
+    grad[i * kValueStride + 1] = static_cast<float>(i % 2);
+  }
+  std::vector<int> unique_indices(kIndicesSize);
+  std::vector<float> summed_grad(kIndicesSize * kValueStride);
+  std::vector<int> tmp_indices(kIndicesSize);
+  std::vector<float> tmp_grad(kIndicesSize * kValueStride);
+  SparseGradient<int> unique_grad({summed_grad.data(), unique_indices.data(), kIndicesSize});
+  SparseGradient<int> workspace_grad({tmp_grad.data(), tmp_indices.data(), kIndicesSize});
+  SparseGradient<int> input_grad({grad.data(), indices.data(), kIndicesSize});
+
+  ReduceSparseGradientParam<int> param;
+  param.input_grad_ = &input_grad;
+  param.workspace_grad_ = &workspace_grad;
+  param.output_grad_ = &unique_grad;
+  param.max_index_ = kMaxIndex;
+  param.value_stride_ = kValueStride;
+  std::vector<int> inverse_indices(input_grad.indices_size_);
+  std::vector<uint8_t> radix_workspace(RadixUnique<int, int>::WorkspaceSize(input_grad.indices_size_));
+  param.inverse_indices_ = inverse_indices.data();
+  param.radix_workspace_ = radix_workspace.data();
+  param.radix_workspace_size_ = radix_workspace.size();
+  SparseOptimizerCpuKernelMod::BucketReduceSparseGradient(param);
+
+  std::vector<int> expect_indices;
+  std::vector<float> expect_value(kMaxIndex * kValueStride, 0);
+  for (size_t i = 0; i < kIndicesSize; ++i) {
+    int index = indices[i];
+    if (static_cast<size_t>(index) >= kMaxIndex) {
+      continue;
+    }
+    if (expect_value[index * kValueStride] == 0) {
+      expect_indices.push_back(index);
+    }
+    expect_value[index * kValueStride] += grad[i * kValueStride];
+    expect_value[index * kValueStride + 1] += grad[i * kValueStride + 1];
+  }
+  EXPECT_EQ(unique_grad.indices_size_, expect_indices.size());
+  for (size_t i = 0; i < unique_grad.indices_size_; ++i) {
+    int index = unique_grad.indices_[i];
+    EXPECT_EQ(index, expect_indices[i]);
+    EXPECT_EQ(unique_grad.value_[i * kValueStride], expect_value[index * kValueStride]);
+    EXPECT_EQ(unique_grad.value_[i * kValueStride + 1], expect_value[index * kValueStride + 1]);
+  }
+}
 }  // namespace kernel
 }  // namespace mindspore
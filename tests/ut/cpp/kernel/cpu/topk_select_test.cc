@@ -0,0 +1,88 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <numeric>
+#include <vector>
+#include "common/common_test.h"
+#include "plugin/device/cpu/kernel/topk_select.h"
+
+namespace mindspore {
+namespace kernel {
+class TopKSelectTest : public UT::Common {
+ public:
+  TopKSelectTest() = default;
+
+  // Positions of the k largest values, equal values in position order.
+  static std::vector<int> ExpectTopK(const std::vector<float> &row, size_t k) {
+    std::vector<int> positions(row.size());
+    std::iota(positions.begin(), positions.end(), 0);
+    std::stable_sort(positions.begin(), positions.end(), [&row](int a, int b) { return row[a] > row[b]; });
+    positions.resize(k);
+    return positions;
+  }
+};
+
+TEST_F(TopKSelectTest, heap_select) {
+  std::vector<float> row{3, 1, 4, 1, 5, 9, 2, 6, 5, 3, 5, -0.0, 0};
+  size_t k = 6;
+  std::vector<uint64_t> ranks(row.size());
+  std::vector<float> values(k);
+  std::vector<int> indices(k);
+  TopKSelector<float>(row.size(), k, true).Select(row.data(), 1, ranks.data(), values.data(), indices.data());
+  EXPECT_EQ(indices, ExpectTopK(row, k));
+  EXPECT_EQ(values, std::vector<float>({9, 6, 5, 5, 5, 4}));
+}
+
+TEST_F(TopKSelectTest, radix_select_long_row) {
+  // Large k takes the radix path, and the row is long enough to be split over threads.
+  size_t size = 100000;
+  size_t k = 1000;
+  std::vector<float> row(size);
+  for (size_t i = 0; i < size; ++i) {
+    row[i] = static_cast<float>((i * 7919) % 1000) - 500;
+  }
+  std::vector<uint64_t> ranks(size);
+  std::vector<float> values(k);
+  std::vector<int> indices(k);
+  auto expect = ExpectTopK(row, k);
+  TopKSelector<float>(size, k, true).Select(row.data(), 4, ranks.data(), values.data(), indices.data());
+  EXPECT_EQ(indices, expect);
+  // Unsorted output is in position order.
+  TopKSelector<float>(size, k, false).Select(row.data(), 4, ranks.data(), values.data(), indices.data());
+  std::sort(expect.begin(), expect.end());
+  EXPECT_EQ(indices, expect);
+}
+
+TEST_F(TopKSelectTest, parallel_sort_ranks) {
+  size_t size = 100000;
+  std::vector<float> row(size);
+  for (size_t i = 0; i < size; ++i) {
+    row[i] = static_cast<float>((i * 31) % 97);
+  }
+  std::vector<uint64_t> ranks(size);
+  std::vector<uint64_t> buffer(size);
+  for (size_t i = 0; i < size; ++i) {
+    ranks[i] = DescendingRank(row[i], i);
+  }
+  uint64_t *sorted = ParallelSortRanks(ranks.data(), buffer.data(), size, 4);
+  auto expect = ExpectTopK(row, size);
+  for (size_t i = 0; i < size; ++i) {
+    EXPECT_EQ(RankPosition(sorted[i]), static_cast<size_t>(expect[i]));
+  }
+}
+}  // namespace kernel
+}  // namespace mindspore
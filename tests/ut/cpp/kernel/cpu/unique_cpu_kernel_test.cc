@@ -14,6 +14,8 @@
  * limitations under the License.
  */
 
+#include <cmath>
+#include <limits>
 #include <vector>
 #include "common/common_test.h"
 #define private public
@@ -49,6 +51,8 @@ class UniqueCpuKernelTest : public UT::Common {
     workspace_.push_back(CreateKernelAddress(workspace_idx_.data()));
     workspace_.push_back(CreateKernelAddress(workspace_idx_.data()));
     workspace_.push_back(CreateKernelAddress(workspace_idx_.data()));
+    // The radix workspace is only used by inputs of at least 100000 elements.
+    workspace_.push_back(CreateKernelAddress(workspace_idx_.data()));
   }
 
   std::vector<float> x_;
@@ -75,5 +79,107 @@ TEST_F(UniqueCpuKernelTest, compute_test) {
   EXPECT_TRUE(y_ == expect_y);
   EXPECT_TRUE(idx_ == expect_idx);
 }
+TEST_F(UniqueCpuKernelTest, radix_compute_test) {
+  // Inputs of at least 100000 elements take the radix partitioned path.
+  constexpr size_t kInputSize = 200000;
+  constexpr size_t kUniqueSize = 1000;
+  unique_->input_size_ = kInputSize;
+  for (size_t i = 0; i < kInputSize; ++i) {
+    x_.push_back(static_cast<float>(kUniqueSize - 1 - (i * 7) % kUniqueSize));
+  }
+  y_.resize(kInputSize);
+  idx_.resize(kInputSize);
+  std::vector<int64_t> input_idx(kInputSize);
+  std::vector<int64_t> workspace_data(kInputSize);
+  workspace_idx_.resize(kInputSize);
+  inputs_.push_back(CreateKernelAddress(x_.data()));
+  outputs_.push_back(CreateKernelAddress(y_.data()));
+  outputs_.push_back(CreateKernelAddress(idx_.data()));
+  workspace_.push_back(CreateKernelAddress(input_idx.data()));
+  workspace_.push_back(CreateKernelAddress(workspace_data.data()));
+  workspace_.push_back(CreateKernelAddress(workspace_idx_.data()));
+  std::vector<uint8_t> radix_workspace(RadixUnique<float, int>::WorkspaceSize(kInputSize));
+  workspace_.push_back(CreateKernelAddress(radix_workspace.data()));
+  workspace_.back()->size = radix_workspace.size();
+
+  // Without sorting the unique values keep their first-occurrence order.
+  unique_->sorted_ = false;
+  unique_->Launch(inputs_, workspace_, outputs_);
+  EXPECT_EQ(unique_->output_size_, kUniqueSize);
+  for (size_t i = 0; i < kUniqueSize; ++i) {
+    EXPECT_EQ(y_[i], x_[i]);
+  }
+  for (size_t i = 0; i < kInputSize; ++i) {
+    EXPECT_EQ(y_[idx_[i]], x_[i]);
+  }
+
+  unique_->sorted_ = true;
+  unique_->Launch(inputs_, workspace_, outputs_);
+  EXPECT_EQ(unique_->output_size_, kUniqueSize);
+  for (size_t i = 0; i < kUniqueSize; ++i) {
+    EXPECT_EQ(y_[i], static_cast<float>(i));
+  }
+  for (size_t i = 0; i < kInputSize; ++i) {
+    EXPECT_EQ(y_[idx_[i]], x_[i]);
+  }
+}
+
+/// Feature: the radix partitioned unique on skewed inputs.
+/// Description: unique a large input where one hot value takes most of the elements along with NaNs, so the partition
+/// of the hot value is too large for the per-thread hash table.
+/// Expectation: the hot value is deduplicated by sorting, every NaN stays unique, and the unique values keep their
+/// first-occurrence order.
+TEST_F(UniqueCpuKernelTest, radix_skewed_test) {
+  constexpr size_t kInputSize = 400000;
+  constexpr size_t kColdSize = 1000;
+  constexpr size_t kNanStride = 5000;
+  constexpr size_t kThreadNum = 4;
+  constexpr float kHotValue = -1;
+  unique_->input_size_ = kInputSize;
+  unique_->sorted_ = false;
+  size_t nan_num = 0;
+  for (size_t i = 0; i < kInputSize; ++i) {
+    if (i % kNanStride == 1) {
+      x_.push_back(std::numeric_limits<float>::quiet_NaN());
+      ++nan_num;
+    } else {
+      x_.push_back(i < kColdSize ? static_cast<float>(i) : kHotValue);
+    }
+  }
+  y_.resize(kInputSize);
+  idx_.resize(kInputSize);
+  std::vector<int64_t> input_idx(kInputSize);
+  std::vector<int64_t> workspace_data(kInputSize);
+  workspace_idx_.resize(kInputSize);
+  auto &thread_pool = common::ThreadPool::GetInstance();
+  auto max_thread_num = thread_pool.max_thread_num_;
+  thread_pool.max_thread_num_ = kThreadNum;
+  std::vector<uint8_t> radix_workspace(RadixUnique<float, int>::WorkspaceSize(kInputSize));
+  inputs_.push_back(CreateKernelAddress(x_.data()));
+  outputs_.push_back(CreateKernelAddress(y_.data()));
+  outputs_.push_back(CreateKernelAddress(idx_.data()));
+  workspace_.push_back(CreateKernelAddress(input_idx.data()));
+  workspace_.push_back(CreateKernelAddress(workspace_data.data()));
+  workspace_.push_back(CreateKernelAddress(workspace_idx_.data()));
+  workspace_.push_back(CreateKernelAddress(radix_workspace.data()));
+  workspace_.back()->size = radix_workspace.size();
+  unique_->Launch(inputs_, workspace_, outputs_);
+  thread_pool.max_thread_num_ = max_thread_num;
+
+  // The cold values except the NaN at 1, each NaN, and the hot value.
+  EXPECT_EQ(unique_->output_size_, (kColdSize - 1) + nan_num + 1);
+  size_t id = 0;
+  for (size_t i = 0; i < kInputSize; ++i) {
+    if (std::isnan(x_[i])) {
+      EXPECT_EQ(idx_[i], id) << "index " << i;
+      EXPECT_TRUE(std::isnan(y_[id++]));
+    } else if (x_[i] == kHotValue && i != kColdSize) {
+      EXPECT_EQ(y_[idx_[i]], kHotValue) << "index " << i;
+    } else {
+      EXPECT_EQ(idx_[i], id) << "index " << i;
+      EXPECT_EQ(y_[id++], x_[i]);
+    }
+  }
+}
 }  // namespace kernel
 }  // namespace mindspore
@@ -50,6 +50,8 @@ class UniqueWithPadCpuKernelTest : public UT::Common {
     workspace_.push_back(CreateKernelAddress(workspace_idx_.data()));
     workspace_.push_back(CreateKernelAddress(workspace_idx_.data()));
     workspace_.push_back(CreateKernelAddress(workspace_idx_.data()));
+    // The radix workspace is only used by inputs of at least 100000 elements.
+    workspace_.push_back(CreateKernelAddress(workspace_idx_.data()));
   }
 
   std::vector<int64_t> x_;
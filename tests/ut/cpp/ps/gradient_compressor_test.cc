@@ -0,0 +1,116 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cmath>
+#include <string>
+#include <vector>
+
+#include "common/common_test.h"
+#include "ps/gradient_compressor.h"
+
+namespace mindspore {
+namespace ps {
+class TestGradientCompressor : public UT::Common {
+ public:
+  TestGradientCompressor() = default;
+  virtual ~TestGradientCompressor() = default;
+
+  void SetUp() override {}
+  void TearDown() override {}
+};
+
+/// Feature: gradient compression of parameter server.
+/// Description: parse the valid and invalid compression methods.
+/// Expectation: the valid methods are parsed, and the invalid ones are rejected.
+TEST_F(TestGradientCompressor, ParseGradientCompression) {
+  GradientCompressionConfig config;
+  EXPECT_TRUE(ParseGradientCompression("topk:0.25", &config));
+  EXPECT_EQ(config.type, GradientCompressionType::kTopK);
+  EXPECT_FLOAT_EQ(config.ratio, 0.25);
+  EXPECT_TRUE(ParseGradientCompression("randomk:1", &config));
+  EXPECT_EQ(config.type, GradientCompressionType::kRandomK);
+  EXPECT_TRUE(ParseGradientCompression("int8", &config));
+  EXPECT_EQ(config.type, GradientCompressionType::kInt8);
+  EXPECT_TRUE(ParseGradientCompression("1bit", &config));
+  EXPECT_EQ(config.type, GradientCompressionType::kOneBit);
+  EXPECT_TRUE(ParseGradientCompression("none", &config));
+  EXPECT_EQ(config.type, GradientCompressionType::kNone);
+
+  EXPECT_FALSE(ParseGradientCompression("topk", &config));
+  EXPECT_FALSE(ParseGradientCompression("topk:0", &config));
+  EXPECT_FALSE(ParseGradientCompression("topk:1.5", &config));
+  EXPECT_FALSE(ParseGradientCompression("int8:0.5", &config));
+  EXPECT_FALSE(ParseGradientCompression("fp8", &config));
+}
+
+/// Feature: gradient compression of parameter server.
+/// Description: compress the gradient by top-k twice.
+/// Expectation: the largest values are sent, and the unsent values are sent in the next step by the error feedback.
+TEST_F(TestGradientCompressor, TopKWithErrorFeedback) {
+  GradientCompressor compressor({GradientCompressionType::kTopK, 0.5}, 0);
+  std::vector<float> grad = {0.1, -4.0, 0.2, 3.0};
+  std::string data = compressor.Compress(grad.data(), grad.size());
+  EXPECT_EQ(data.size(), sizeof(CompressedGradientHeader) + 2 * (sizeof(uint32_t) + sizeof(float)));
+
+  std::vector<float> result(grad.size(), 1.0);
+  ASSERT_TRUE(GradientCompressor::DecompressAccumulate(data.data(), data.size(), result.data(), result.size()));
+  std::vector<float> expect = {1.0, -3.0, 1.0, 4.0};
+  EXPECT_EQ(result, expect);
+  std::vector<float> expect_residual = {0.1, 0, 0.2, 0};
+  EXPECT_EQ(compressor.residual(), expect_residual);
+
+  std::vector<float> zero_grad(grad.size(), 0);
+  data = compressor.Compress(zero_grad.data(), zero_grad.size());
+  std::vector<float> next_result(grad.size(), 0);
+  ASSERT_TRUE(
+    GradientCompressor::DecompressAccumulate(data.data(), data.size(), next_result.data(), next_result.size()));
+  std::vector<float> next_expect = {0.1, 0, 0.2, 0};
+  EXPECT_EQ(next_result, next_expect);
+}
+
+/// Feature: gradient compression of parameter server.
+/// Description: compress the gradient by random-k, int8 and 1bit.
+/// Expectation: the decompressed gradient added with the residual equals the original gradient.
+TEST_F(TestGradientCompressor, ErrorFeedbackKeepsLostPart) {
+  std::vector<float> grad = {0.5, -1.25, 2.0, 0.0, -0.75, 3.5, 1.0, -2.5, 0.25};
+  std::vector<GradientCompressionConfig> configs = {{GradientCompressionType::kRandomK, 0.3},
+                                                    {GradientCompressionType::kInt8, 1.0},
+                                                    {GradientCompressionType::kOneBit, 1.0}};
+  for (const auto &config : configs) {
+    GradientCompressor compressor(config, 1);
+    std::string data = compressor.Compress(grad.data(), grad.size());
+    std::vector<float> result(grad.size(), 0);
+    ASSERT_TRUE(GradientCompressor::DecompressAccumulate(data.data(), data.size(), result.data(), result.size()));
+    for (size_t i = 0; i < grad.size(); ++i) {
+      EXPECT_NEAR(result[i] + compressor.residual()[i], grad[i], 1e-5);
+    }
+  }
+}
+
+/// Feature: gradient compression of parameter server.
+/// Description: decompress the truncated data and the data of mismatched length.
+/// Expectation: the invalid data is rejected.
+TEST_F(TestGradientCompressor, InvalidData) {
+  GradientCompressor compressor({GradientCompressionType::kInt8, 1.0}, 0);
+  std::vector<float> grad = {1.0, 2.0, 3.0};
+  std::string data = compressor.Compress(grad.data(), grad.size());
+  std::vector<float> result(grad.size(), 0);
+  EXPECT_FALSE(GradientCompressor::DecompressAccumulate(data.data(), data.size() - 1, result.data(), result.size()));
+  EXPECT_FALSE(GradientCompressor::DecompressAccumulate(data.data(), data.size(), result.data(), result.size() - 1));
+  EXPECT_TRUE(GradientCompressor::DecompressAccumulate(data.data(), data.size(), result.data(), result.size()));
+}
+}  // namespace ps
+}  // namespace mindspore
@@ -0,0 +1,198 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <map>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "common/common_test.h"
+#define private public
+#define protected public
+#include "ps/parameter_server.h"
+#undef private
+#undef protected
+
+namespace mindspore {
+namespace ps {
+namespace {
+constexpr size_t kTestWorkerNum = 4;
+constexpr size_t kSmallSize = 100;
+// The gradient larger than the minimum range size of the dense optimizers, which is split into multiple ranges.
+constexpr size_t kLargeSize = 200003;
+constexpr size_t kApplyThreadNum = 4;
+constexpr float kTestLearningRate = 0.01;
+constexpr float kTestMomentum = 0.9;
+
+// The momentum kernel which counts the executions.
+class CountMomentumPSKernelMod : public kernel::ps::ApplyMomentumPSKernelMod {
+ public:
+  CountMomentumPSKernelMod() : ApplyMomentumPSKernelMod(0, 1, kTestWorkerNum) {}
+  ~CountMomentumPSKernelMod() override = default;
+
+  bool Execute(const std::vector<AddressPtr> &inputs, const std::vector<AddressPtr> &workspace,
+               const std::vector<AddressPtr> &outputs) override {
+    ++execute_num_;
+    return ApplyMomentumPSKernelMod::Execute(inputs, workspace, outputs);
+  }
+
+  std::atomic<size_t> execute_num_{0};
+};
+
+// The buffers of the momentum inputs of one key.
+struct MomentumBuffers {
+  std::vector<float> weight_;
+  std::vector<float> accum_;
+  std::vector<float> lr_;
+  std::vector<float> grad_;
+  std::vector<float> momentum_;
+};
+
+float InitWeight(size_t index) { return static_cast<float>(index % 5); }
+float WorkerGrad(size_t worker, size_t index) { return static_cast<float>(worker + 1 + index % 3); }
+}  // namespace
+
+class TestParameterServer : public UT::Common {
+ public:
+  TestParameterServer() = default;
+  virtual ~TestParameterServer() = default;
+
+  void SetUp() override {
+    ps_ = std::make_unique<ParameterServer>();
+    ps_->worker_num_ = kTestWorkerNum;
+    ps_->pserver_num_ = 1;
+    ps_->server_node_ = std::make_shared<core::PSServerNode>();
+    // The keys 0 and 64 share the same key mutex.
+    keys_ = {0, 1, 2, 3, 64, 5};
+    for (auto key : keys_) {
+      size_t size = (key == keys_.back()) ? kLargeSize : kSmallSize;
+      auto &buffers = buffers_[key];
+      buffers.weight_.resize(size);
+      for (size_t i = 0; i < size; ++i) {
+        buffers.weight_[i] = InitWeight(i);
+      }
+      buffers.accum_.assign(size, 0);
+      buffers.lr_.assign(1, 0);
+      buffers.grad_.assign(size, 0);
+      buffers.momentum_.assign(1, kTestMomentum);
+      ps_->optim_infos_[key] = std::make_shared<MomentumOptimInfo>(
+        Address(&buffers.weight_), Address(&buffers.accum_), Address(&buffers.lr_), Address(&buffers.grad_),
+        Address(&buffers.momentum_));
+      auto optimizer = std::make_shared<CountMomentumPSKernelMod>();
+      optimizers_[key] = optimizer;
+      ps_->optimizers_[key] = optimizer;
+      ps_->grads_accum_counter_[key] = 0;
+    }
+  }
+
+  void TearDown() override {
+    ps_ = nullptr;
+    optimizers_.clear();
+    buffers_.clear();
+  }
+
+  static AddressPtr Address(std::vector<float> *buffer) {
+    return std::make_shared<kernel::Address>(buffer->data(), buffer->size() * sizeof(float));
+  }
+
+  // Push the gradients of all the keys from the workers concurrently, each worker in its own order of keys.
+  void PushGradients() {
+    std::vector<std::thread> threads;
+    for (size_t worker = 0; worker < kTestWorkerNum; ++worker) {
+      threads.emplace_back([this, worker]() {
+        std::vector<Key> keys = keys_;
+        std::rotate(keys.begin(), keys.begin() + worker, keys.end());
+        for (auto key : keys) {
+          size_t size = buffers_[key].grad_.size();
+          // The values of the momentum are sent in the order of lr, grad and momentum.
+          Values values = {kTestLearningRate};
+          for (size_t i = 0; i < size; ++i) {
+            values.push_back(WorkerGrad(worker, i));
+          }
+          values.push_back(kTestMomentum);
+          Lengths lengths = {1, static_cast<int>(size), 1};
+          ps_->AccumGrad({key}, values, lengths);
+        }
+      });
+    }
+    for (auto &thread : threads) {
+      thread.join();
+    }
+  }
+
+  std::unique_ptr<ParameterServer> ps_;
+  std::vector<Key> keys_;
+  std::map<Key, MomentumBuffers> buffers_;
+  std::map<Key, std::shared_ptr<CountMomentumPSKernelMod>> optimizers_;
+};
+
+/// Feature: the accumulation of the dense gradients pushed by the workers in the parameter server.
+/// Description: push the gradients of several keys from the workers concurrently, where some keys share the key mutex.
+/// Expectation: the gradients of every key are the sums of all the workers, the learning rate is updated, and every key
+/// is counted once as ready after all the workers push it.
+TEST_F(TestParameterServer, AccumGradConcurrently) {
+  PushGradients();
+  for (auto key : keys_) {
+    const auto &buffers = buffers_[key];
+    for (size_t i = 0; i < buffers.grad_.size(); ++i) {
+      float expect = 0;
+      for (size_t worker = 0; worker < kTestWorkerNum; ++worker) {
+        expect += WorkerGrad(worker, i);
+      }
+      ASSERT_EQ(buffers.grad_[i], expect) << "key " << key << ", index " << i;
+    }
+    EXPECT_EQ(buffers.lr_[0], kTestLearningRate);
+    EXPECT_EQ(ps_->grads_accum_counter_[key], kTestWorkerNum);
+  }
+  EXPECT_EQ(ps_->grad_accum_count_, keys_.size());
+  EXPECT_EQ(ps_->grad_accum_count_, ps_->grads_accum_counter_.size());
+}
+
+/// Feature: the dense optimizers applied in parallel by the parameter server.
+/// Description: apply the momentum optimizers of the keys by multiple threads after the gradients of all the workers
+/// are accumulated.
+/// Expectation: every weight is updated by the mean of the gradients once, the gradients are reset, and the large
+/// gradient is split into the ranges applied by multiple executions.
+TEST_F(TestParameterServer, ApplyDenseOptimizers) {
+  PushGradients();
+  auto &thread_pool = common::ThreadPool::GetInstance();
+  auto max_thread_num = thread_pool.max_thread_num_;
+  thread_pool.max_thread_num_ = kApplyThreadNum;
+  ps_->ApplyDenseOptimizers(keys_);
+  thread_pool.max_thread_num_ = max_thread_num;
+  for (auto key : keys_) {
+    const auto &buffers = buffers_[key];
+    for (size_t i = 0; i < buffers.weight_.size(); ++i) {
+      float mean_grad = 0;
+      for (size_t worker = 0; worker < kTestWorkerNum; ++worker) {
+        mean_grad += WorkerGrad(worker, i);
+      }
+      mean_grad /= kTestWorkerNum;
+      ASSERT_FLOAT_EQ(buffers.accum_[i], mean_grad) << "key " << key << ", index " << i;
+      ASSERT_FLOAT_EQ(buffers.weight_[i], InitWeight(i) - mean_grad * kTestLearningRate) << "key " << key << ", index "
+                                                                                     << i;
+      ASSERT_EQ(buffers.grad_[i], 0) << "key " << key << ", index " << i;
+    }
+    if (key != keys_.back()) {
+      EXPECT_EQ(optimizers_[key]->execute_num_, 1);
+    }
+  }
+  EXPECT_GT(optimizers_[keys_.back()]->execute_num_, 1);
+}
+}  // namespace ps
+}  // namespace mindspore
@@ -0,0 +1,145 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cmath>
+#include <string>
+#include <vector>
+
+#include "common/common_test.h"
+#include "ps/raw_kv_frame.h"
+
+namespace mindspore {
+namespace ps {
+class TestRawKVFrame : public UT::Common {
+ public:
+  TestRawKVFrame() = default;
+  virtual ~TestRawKVFrame() = default;
+
+  void SetUp() override {}
+  void TearDown() override {}
+};
+
+/// Feature: raw kv frame of parameter server.
+/// Description: build the float32 frame of two keys and read it back.
+/// Expectation: the keys, lengths and values are the same as the built ones.
+TEST_F(TestRawKVFrame, Float32RoundTrip) {
+  std::vector<float> values1 = {1.5, -2.25, 3.0};
+  std::vector<float> values2 = {4.125, 5.0};
+  RawKVFrameBuilder builder(RawKVDataType::kFloat32);
+  builder.Add(7, values1.data(), values1.size());
+  builder.Add(9, values2.data(), values2.size());
+  std::string frame = builder.Build();
+  EXPECT_EQ(frame.size(), builder.FrameSize());
+
+  RawKVFrameReader reader;
+  ASSERT_TRUE(reader.Parse(frame.data(), frame.size()));
+  EXPECT_EQ(reader.data_type(), RawKVDataType::kFloat32);
+  ASSERT_EQ(reader.key_num(), 2);
+  EXPECT_EQ(reader.key(0), 7);
+  EXPECT_EQ(reader.len(0), 3);
+  EXPECT_EQ(reader.key(1), 9);
+  EXPECT_EQ(reader.len(1), 2);
+  ASSERT_EQ(reader.value_num(), 5);
+
+  std::vector<float> result(reader.value_num());
+  ASSERT_TRUE(reader.CopyValues(result.data(), result.size()));
+  std::vector<float> expect = {1.5, -2.25, 3.0, 4.125, 5.0};
+  EXPECT_EQ(result, expect);
+}
+
+/// Feature: raw kv frame of parameter server.
+/// Description: build the float16 and bfloat16 frames and read them back.
+/// Expectation: the values are decompressed within the precision of the data types.
+TEST_F(TestRawKVFrame, CompressedRoundTrip) {
+  std::vector<float> values = {0.1, -3.3, 1024.5, 0.0};
+  for (auto data_type : {RawKVDataType::kFloat16, RawKVDataType::kBFloat16}) {
+    RawKVFrameBuilder builder(data_type);
+    builder.Add(1, values.data(), values.size());
+    std::string frame = builder.Build();
+    EXPECT_EQ(frame.size(), sizeof(RawKVFrameHeader) + sizeof(RawKVFrameEntry) + values.size() * sizeof(uint16_t));
+
+    RawKVFrameReader reader;
+    ASSERT_TRUE(reader.Parse(frame.data(), frame.size()));
+    EXPECT_EQ(reader.data_type(), data_type);
+    std::vector<float> result(values.size());
+    ASSERT_TRUE(reader.CopyValues(result.data(), result.size()));
+    float tolerance = data_type == RawKVDataType::kFloat16 ? 1e-3 : 1e-2;
+    for (size_t i = 0; i < values.size(); ++i) {
+      EXPECT_LE(std::fabs(result[i] - values[i]), tolerance * std::fabs(values[i]));
+    }
+  }
+}
+
+/// Feature: raw kv frame of parameter server.
+/// Description: build the frame of the optimizer inputs in which only the gradient is in float16, and read it back.
+/// Expectation: the gradient is decompressed within the precision of float16, and the other inputs are exact.
+TEST_F(TestRawKVFrame, CompressGradientOnly) {
+  std::vector<float> weight = {0.1, 0.2, 0.3};
+  std::vector<float> grad = {0.1, -3.3, 1024.5};
+  std::vector<float> lr = {0.0001};
+  RawKVFrameBuilder builder(RawKVDataType::kFloat32);
+  builder.Add(5, weight.data(), weight.size());
+  builder.Add(5, grad.data(), grad.size(), RawKVDataType::kFloat16);
+  builder.Add(5, lr.data(), lr.size());
+  std::string frame = builder.Build();
+  EXPECT_EQ(frame.size(), sizeof(RawKVFrameHeader) + 3 * sizeof(RawKVFrameEntry) +
+                            (weight.size() + lr.size()) * sizeof(float) + grad.size() * sizeof(uint16_t));
+
+  RawKVFrameReader reader;
+  ASSERT_TRUE(reader.Parse(frame.data(), frame.size()));
+  EXPECT_EQ(reader.data_type(), RawKVDataType::kFloat32);
+  ASSERT_EQ(reader.key_num(), 3);
+  EXPECT_EQ(reader.data_type(0), RawKVDataType::kFloat32);
+  EXPECT_EQ(reader.data_type(1), RawKVDataType::kFloat16);
+  EXPECT_EQ(reader.data_type(2), RawKVDataType::kFloat32);
+  ASSERT_EQ(reader.value_num(), 7);
+  std::vector<float> result(reader.value_num());
+  ASSERT_TRUE(reader.CopyValues(result.data(), result.size()));
+  for (size_t i = 0; i < weight.size(); ++i) {
+    EXPECT_EQ(result[i], weight[i]);
+    EXPECT_LE(std::fabs(result[weight.size() + i] - grad[i]), 1e-3 * std::fabs(grad[i]));
+  }
+  EXPECT_EQ(result.back(), lr[0]);
+
+  // The frame whose entry is in the invalid data type is rejected.
+  std::string bad_data_type = frame;
+  size_t data_type_offset = sizeof(RawKVFrameHeader) + sizeof(RawKVFrameEntry) + 2 * sizeof(uint64_t);
+  bad_data_type[data_type_offset] = static_cast<char>(7);
+  EXPECT_FALSE(reader.Parse(bad_data_type.data(), bad_data_type.size()));
+}
+
+/// Feature: raw kv frame of parameter server.
+/// Description: parse the truncated frame and the frame with invalid magic.
+/// Expectation: the invalid frames are rejected.
+TEST_F(TestRawKVFrame, InvalidFrame) {
+  std::vector<float> values = {1.0, 2.0};
+  RawKVFrameBuilder builder(RawKVDataType::kFloat32);
+  builder.Add(3, values.data(), values.size());
+  std::string frame = builder.Build();
+
+  RawKVFrameReader reader;
+  EXPECT_FALSE(reader.Parse(frame.data(), frame.size() - 1));
+  EXPECT_FALSE(reader.Parse(frame.data(), sizeof(RawKVFrameHeader) - 1));
+  std::string bad_magic = frame;
+  bad_magic[0] = static_cast<char>(bad_magic[0] + 1);
+  EXPECT_FALSE(reader.Parse(bad_magic.data(), bad_magic.size()));
+
+  std::vector<float> result(1);
+  ASSERT_TRUE(reader.Parse(frame.data(), frame.size()));
+  EXPECT_FALSE(reader.CopyValues(result.data(), result.size()));
+}
+}  // namespace ps
+}  // namespace mindspore
@@ -0,0 +1,307 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "common/common_test.h"
+#include "utils/log_adapter.h"
+#include "actor/actor.h"
+#include "async/async.h"
+#include "thread/actor_threadpool.h"
+
+namespace mindspore {
+namespace {
+constexpr size_t kActorThreadNum = 4;
+constexpr size_t kStealThreadNum = 2;
+constexpr int64_t kWaitSeconds = 30;
+// The mark of actor B in the running order of RescheduleAfterMaxMessagesPerRun.
+constexpr size_t kMarkOfB = std::numeric_limits<size_t>::max();
+
+// Wait until the condition holds, and return false when it still doesn't hold after kWaitSeconds.
+bool WaitFor(const std::function<bool()> &condition) {
+  auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(kWaitSeconds);
+  while (!condition()) {
+    if (std::chrono::steady_clock::now() > deadline) {
+      return false;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  return true;
+}
+
+// The actor which records the messages it runs, and whether two threads run it at the same time.
+class RecordActor : public ActorBase {
+ public:
+  RecordActor(const std::string &name, ActorThreadPool *pool) : ActorBase(name, pool) {}
+  ~RecordActor() override = default;
+
+  // Every message of the test runs between Enter and Leave.
+  void Enter() {
+    if (running_.fetch_add(1) != 0) {
+      overlapped_ = true;
+    }
+    ++run_num_;
+    std::lock_guard<std::mutex> lock(run_threads_mutex_);
+    run_thread_ = std::this_thread::get_id();
+  }
+  void Leave() { (void)running_.fetch_sub(1); }
+
+  std::thread::id run_thread() {
+    std::lock_guard<std::mutex> lock(run_threads_mutex_);
+    return run_thread_;
+  }
+
+  std::atomic<int> running_{0};
+  std::atomic<bool> overlapped_{false};
+  std::atomic<size_t> run_num_{0};
+
+ private:
+  std::mutex run_threads_mutex_;
+  std::thread::id run_thread_;
+};
+using RecordActorPtr = std::shared_ptr<RecordActor>;
+
+// Run the message on the actor of the ring, and forward the token to the next actor until the hops run out.
+void ForwardToken(const std::vector<RecordActor *> *ring, size_t index, size_t hops, std::atomic<size_t> *done_num) {
+  auto actor = (*ring)[index];
+  actor->Enter();
+  // Widen the running window, so that an actor run by two threads at once is noticed.
+  std::this_thread::yield();
+  actor->Leave();
+  if (hops == 0) {
+    ++(*done_num);
+    return;
+  }
+  auto next = (index + 1) % ring->size();
+  Async((*ring)[next]->GetAID(), [ring, next, hops, done_num]() { ForwardToken(ring, next, hops - 1, done_num); });
+}
+}  // namespace
+
+class ActorMailboxTest : public UT::Common {
+ public:
+  ActorMailboxTest() = default;
+
+  void TearDown() override {
+    auto actor_manager = ActorMgr::GetActorMgrRef();
+    for (auto &actor : actors_) {
+      actor_manager->Terminate(actor->GetAID());
+    }
+    actors_.clear();
+    delete pool_;
+    pool_ = nullptr;
+  }
+
+  // The actors of the test run on their own pool, so that the number of actor threads is known.
+  void CreatePool(size_t actor_thread_num) {
+    pool_ = ActorThreadPool::CreateThreadPool(actor_thread_num);
+    ASSERT_NE(pool_, nullptr);
+  }
+
+  RecordActorPtr SpawnActor(const std::string &name) {
+    auto actor = std::make_shared<RecordActor>(name, pool_);
+    (void)ActorMgr::GetActorMgrRef()->Spawn(actor);
+    actors_.push_back(actor);
+    return actor;
+  }
+
+  // All the messages sent to the actor before are run when the returned future is ready.
+  static void WaitActor(const RecordActorPtr &actor) { Async(actor->GetAID(), []() { return true; }).Wait(); }
+
+  ActorThreadPool *pool_{nullptr};
+  std::vector<RecordActorPtr> actors_;
+};
+
+/// Feature: the lock free mailbox of the actors sharing the actor threads.
+/// Description: several threads send the numbered messages to one actor at the same time.
+/// Expectation: every message is run once, the messages of each sending thread are run in the sending order, and the
+/// actor is never run by two threads at once.
+TEST_F(ActorMailboxTest, MultiProducerEnqueue) {
+  constexpr size_t kProducerNum = 8;
+  constexpr size_t kMessageNum = 20000;
+  CreatePool(kActorThreadNum);
+  auto actor = SpawnActor("mailbox_multi_producer");
+
+  // Only accessed by the thread running the actor.
+  std::vector<std::vector<size_t>> received(kProducerNum);
+  std::vector<std::thread> producers;
+  for (size_t producer = 0; producer < kProducerNum; ++producer) {
+    (void)producers.emplace_back([&actor, &received, producer]() {
+      auto actor_ptr = actor.get();
+      auto received_ptr = &received[producer];
+      for (size_t i = 0; i < kMessageNum; ++i) {
+        Async(actor->GetAID(), [actor_ptr, received_ptr, i]() {
+          actor_ptr->Enter();
+          received_ptr->push_back(i);
+          actor_ptr->Leave();
+        });
+      }
+    });
+  }
+  for (auto &producer : producers) {
+    producer.join();
+  }
+  WaitActor(actor);
+
+  EXPECT_FALSE(actor->overlapped_);
+  EXPECT_EQ(actor->run_num_.load(), kProducerNum * kMessageNum);
+  for (size_t producer = 0; producer < kProducerNum; ++producer) {
+    ASSERT_EQ(received[producer].size(), kMessageNum);
+    for (size_t i = 0; i < kMessageNum; ++i) {
+      ASSERT_EQ(received[producer][i], i);
+    }
+  }
+}
+
+/// Feature: the actor runs on one thread at a time while it moves between the ready queues of the actor threads.
+/// Description: the tokens are forwarded around a ring of actors. An actor made ready by an actor thread goes to the
+/// queue of that thread, and the idle actor threads steal it from there.
+/// Expectation: all the tokens finish their hops, and no actor is run by two threads at once.
+TEST_F(ActorMailboxTest, ActorNeverRunsOnTwoThreads) {
+  constexpr size_t kRingSize = 8;
+  constexpr size_t kTokenNum = 64;
+  constexpr size_t kHopNum = 500;
+  CreatePool(kActorThreadNum);
+  std::vector<RecordActor *> ring;
+  for (size_t i = 0; i < kRingSize; ++i) {
+    ring.push_back(SpawnActor("mailbox_ring_" + std::to_string(i)).get());
+  }
+
+  std::atomic<size_t> done_num{0};
+  for (size_t token = 0; token < kTokenNum; ++token) {
+    auto index = token % kRingSize;
+    auto ring_ptr = &ring;
+    auto done_ptr = &done_num;
+    Async(ring[index]->GetAID(), [ring_ptr, index, done_ptr]() { ForwardToken(ring_ptr, index, kHopNum, done_ptr); });
+  }
+  ASSERT_TRUE(WaitFor([&done_num]() { return done_num == kTokenNum; }));
+
+  size_t run_num = 0;
+  for (auto &actor : actors_) {
+    EXPECT_FALSE(actor->overlapped_) << actor->GetAID().Name();
+    run_num += actor->run_num_;
+  }
+  EXPECT_EQ(run_num, kTokenNum * (kHopNum + 1));
+}
+
+/// Feature: the actor gives up the thread after MAX_MSG_NUM_PER_RUN messages in one run.
+/// Description: on one actor thread, actor A has more than MAX_MSG_NUM_PER_RUN pending messages, and its first message
+/// makes actor B ready.
+/// Expectation: B runs right after the first MAX_MSG_NUM_PER_RUN messages of A, and A is rescheduled and runs all its
+/// remaining messages in order.
+TEST_F(ActorMailboxTest, RescheduleAfterMaxMessagesPerRun) {
+  constexpr size_t kPendingNum = 2 * MAX_MSG_NUM_PER_RUN + 1;
+  CreatePool(1);
+  auto actor_a = SpawnActor("mailbox_reschedule_a");
+  auto actor_b = SpawnActor("mailbox_reschedule_b");
+
+  // Only accessed by the only actor thread.
+  std::vector<size_t> run_order;
+  std::atomic<bool> started{false};
+  std::atomic<bool> released{false};
+  auto a_ptr = actor_a.get();
+  auto b_ptr = actor_b.get();
+  auto order_ptr = &run_order;
+  auto started_ptr = &started;
+  auto released_ptr = &released;
+  Async(actor_a->GetAID(), [a_ptr, b_ptr, order_ptr, started_ptr, released_ptr]() {
+    a_ptr->Enter();
+    order_ptr->push_back(0);
+    // B is made ready by the actor thread, so it waits in the queue of that thread behind nothing.
+    Async(b_ptr->GetAID(), [b_ptr, order_ptr]() {
+      b_ptr->Enter();
+      order_ptr->push_back(kMarkOfB);
+      b_ptr->Leave();
+    });
+    *started_ptr = true;
+    // Hold the thread until the other messages of A are pending.
+    while (!*released_ptr) {
+      std::this_thread::yield();
+    }
+    a_ptr->Leave();
+  });
+  ASSERT_TRUE(WaitFor([&started]() { return started.load(); }));
+  for (size_t i = 1; i <= kPendingNum; ++i) {
+    Async(actor_a->GetAID(), [a_ptr, order_ptr, i]() {
+      a_ptr->Enter();
+      order_ptr->push_back(i);
+      a_ptr->Leave();
+    });
+  }
+  released = true;
+  WaitActor(actor_a);
+  WaitActor(actor_b);
+
+  ASSERT_EQ(run_order.size(), kPendingNum + 2);
+  EXPECT_EQ(run_order[MAX_MSG_NUM_PER_RUN], kMarkOfB);
+  size_t expect = 0;
+  for (size_t i = 0; i < run_order.size(); ++i) {
+    if (i == MAX_MSG_NUM_PER_RUN) {
+      continue;
+    }
+    EXPECT_EQ(run_order[i], expect);
+    ++expect;
+  }
+  EXPECT_EQ(actor_a->run_num_.load(), kPendingNum + 1);
+  EXPECT_EQ(actor_b->run_num_.load(), 1);
+}
+
+/// Feature: the idle actor thread steals the ready actor from the queue of another actor thread.
+/// Description: actor A makes actor B ready, so B goes to the queue of the thread running A, and A holds that thread
+/// until B has run.
+/// Expectation: B runs while A still holds its thread, so it is run by the other actor thread.
+TEST_F(ActorMailboxTest, IdleThreadStealsReadyActor) {
+  if (std::thread::hardware_concurrency() < kStealThreadNum) {
+    MS_LOG(WARNING) << "The stealing needs " << kStealThreadNum << " actor threads, but the core num is "
+                    << std::thread::hardware_concurrency() << ", skip the test.";
+    return;
+  }
+  CreatePool(kStealThreadNum);
+  auto actor_a = SpawnActor("mailbox_steal_a");
+  auto actor_b = SpawnActor("mailbox_steal_b");
+
+  std::atomic<bool> b_ran{false};
+  std::atomic<bool> b_ran_while_a_held{false};
+  std::atomic<bool> a_done{false};
+  auto a_ptr = actor_a.get();
+  auto b_ptr = actor_b.get();
+  auto b_ran_ptr = &b_ran;
+  auto held_ptr = &b_ran_while_a_held;
+  auto a_done_ptr = &a_done;
+  Async(actor_a->GetAID(), [a_ptr, b_ptr, b_ran_ptr, held_ptr, a_done_ptr]() {
+    a_ptr->Enter();
+    Async(b_ptr->GetAID(), [b_ptr, b_ran_ptr]() {
+      b_ptr->Enter();
+      b_ptr->Leave();
+      *b_ran_ptr = true;
+    });
+    *held_ptr = WaitFor([b_ran_ptr]() { return b_ran_ptr->load(); });
+    a_ptr->Leave();
+    *a_done_ptr = true;
+  });
+  ASSERT_TRUE(WaitFor([&a_done]() { return a_done.load(); }));
+
+  EXPECT_TRUE(b_ran_while_a_held);
+  EXPECT_NE(actor_a->run_thread(), actor_b->run_thread());
+}
+}  // namespace mindspore
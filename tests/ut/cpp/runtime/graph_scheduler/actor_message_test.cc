@@ -0,0 +1,214 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "common/common_test.h"
+#include "utils/log_adapter.h"
+#define private public
+#define protected public
+#include "runtime/graph_scheduler/actor/abstract_actor.h"
+#undef private
+#undef protected
+
+namespace mindspore {
+namespace runtime {
+namespace {
+constexpr size_t kActorThreadNum = 4;
+constexpr size_t kActorAndKernelThreadNum = 8;
+
+// The async message before the handler was stored in place and the messages were pooled.
+class LegacyMessageAsync : public MessageBase {
+ public:
+  explicit LegacyMessageAsync(std::function<void(ActorBase *)> &&h)
+      : MessageBase("Async", Type::KASYNC), handler(std::move(h)) {}
+  ~LegacyMessageAsync() override = default;
+  void Run(ActorBase *actor) override { handler(actor); }
+
+ private:
+  std::function<void(ActorBase *)> handler;
+};
+
+// The actor like the kernel actor, which only passes the control to the output actors.
+class RelayActor : public AbstractActor {
+ public:
+  RelayActor(const std::string &name, bool legacy)
+      : AbstractActor(name, KernelTransformType::kKernelActor, nullptr), legacy_(legacy) {}
+  ~RelayActor() override = default;
+
+  size_t run_num_{0};
+
+ protected:
+  void Run(OpContext<DeviceTensor> *const context) override {
+    ++run_num_;
+    EraseInput(context);
+    if (!legacy_) {
+      SendOutput(context);
+      return;
+    }
+
+    // The sending before the output actors are resolved in advance, which looks up the actor by name and wraps the
+    // handler in a heap allocated message for every output control.
+    auto from_aid = const_cast<AID *>(&GetAID());
+    for (auto &output_control : output_control_arrows_) {
+      auto handler = [from_aid, context](ActorBase *actor) {
+        static_cast<OpActor<DeviceTensor> *>(actor)->RunOpControl(from_aid, context);
+      };
+      (void)ActorMgr::GetActorMgrRef()->Send(output_control,
+                                             std::unique_ptr<MessageBase>(new LegacyMessageAsync(std::move(handler))));
+    }
+    if (output_control_arrows_.empty()) {
+      SET_OPCONTEXT_SUCCESS_RET((*context));
+    }
+  }
+
+ private:
+  bool legacy_;
+};
+using RelayActorPtr = std::shared_ptr<RelayActor>;
+}  // namespace
+
+class ActorMessageTest : public UT::Common {
+ public:
+  ActorMessageTest() = default;
+
+  void SetUp() override {
+    auto actor_manager = ActorMgr::GetActorMgrRef();
+    (void)actor_manager->Initialize(true, kActorThreadNum, kActorAndKernelThreadNum);
+  }
+
+  void TearDown() override {
+    auto actor_manager = ActorMgr::GetActorMgrRef();
+    for (auto &actor : actors_) {
+      actor_manager->Terminate(actor->GetAID());
+    }
+    actors_.clear();
+  }
+
+  // Build the actors in the shape of an actor set: the entrance actor fans out to the parallel kernel actor chains,
+  // and the chains join at the exit actor.
+  void BuildActorSet(const std::string &prefix, size_t width, size_t depth, bool legacy) {
+    auto entrance = std::make_shared<RelayActor>(prefix + "_entrance", legacy);
+    auto exit = std::make_shared<RelayActor>(prefix + "_exit", legacy);
+    entrance->input_controls_num_ = 1;
+    exit->input_controls_num_ = width;
+    actors_.push_back(entrance);
+    for (size_t i = 0; i < width; ++i) {
+      RelayActorPtr from = entrance;
+      for (size_t j = 0; j < depth; ++j) {
+        auto kernel = std::make_shared<RelayActor>(prefix + "_kernel_" + std::to_string(i) + "_" + std::to_string(j),
+                                                   legacy);
+        kernel->input_controls_num_ = 1;
+        (void)from->output_control_arrows_.emplace_back(kernel->GetAID());
+        actors_.push_back(kernel);
+        from = kernel;
+      }
+      (void)from->output_control_arrows_.emplace_back(exit->GetAID());
+    }
+    actors_.push_back(exit);
+
+    auto actor_manager = ActorMgr::GetActorMgrRef();
+    for (auto &actor : actors_) {
+      (void)actor_manager->Spawn(actor);
+    }
+  }
+
+  // Run the steps one by one like the graph scheduler, and return the running time in seconds.
+  double RunSteps(size_t step_num) {
+    auto entrance = actors_.front().get();
+    AID source("source");
+    auto start = std::chrono::steady_clock::now();
+    for (size_t step = 0; step < step_num; ++step) {
+      OpContext<DeviceTensor> op_context;
+      std::vector<Promise<int>> result(1);
+      op_context.sequential_num_ = static_cast<int>(step);
+      op_context.results_ = &result;
+      ActorDispatcher::Send(entrance, &OpActor<DeviceTensor>::RunOpControl, &source, &op_context);
+      auto result_future = result[0].GetFuture();
+      result_future.Wait();
+      EXPECT_TRUE(result_future.IsOK());
+    }
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  }
+
+  std::vector<RelayActorPtr> actors_;
+};
+
+/// Feature: the async messages of actors which are pooled and sent to the output actors resolved in advance.
+/// Description: run the same actor set by the messages sent to the resolved actors and by the heap allocated messages
+/// sent by the actor names.
+/// Expectation: every actor runs once per step in both ways, and the message rates of both ways are logged.
+TEST_F(ActorMessageTest, ActorSetMessageRate) {
+  constexpr size_t kWidth = 8;
+  constexpr size_t kDepth = 16;
+  constexpr size_t kStepNum = 500;
+  // The sent messages per step: the entrance, the kernel actors and the exit actor each receive one message from
+  // every input actor.
+  constexpr size_t kMessageNumPerStep = 1 + kWidth * kDepth + kWidth;
+
+  auto run_actor_set = [&](const std::string &prefix, bool legacy) {
+    BuildActorSet(prefix, kWidth, kDepth, legacy);
+    (void)RunSteps(1);
+    auto cost = RunSteps(kStepNum);
+    for (auto &actor : actors_) {
+      EXPECT_EQ(actor->run_num_, kStepNum + 1);
+      EXPECT_TRUE(actor->input_op_controls_.empty());
+    }
+    TearDown();
+    return cost;
+  };
+  auto resolved_cost = run_actor_set("resolved", false);
+  auto legacy_cost = run_actor_set("legacy", true);
+
+  constexpr size_t kMessageNum = kMessageNumPerStep * kStepNum;
+  MS_LOG(INFO) << "Pooled messages sent to the resolved actors: " << kMessageNum / resolved_cost << " msg/s";
+  MS_LOG(INFO) << "Heap messages sent by the actor names: " << kMessageNum / legacy_cost << " msg/s";
+}
+
+/// Feature: the output actors resolved in advance are dropped when the output arrows are relinked.
+/// Description: run a step, relink the output control arrow of the entrance actor to another exit actor with the same
+/// arrows number, and run another step.
+/// Expectation: the second step is sent to the relinked exit actor instead of the resolved one.
+TEST_F(ActorMessageTest, RelinkOutputActors) {
+  auto entrance = std::make_shared<RelayActor>("relink_entrance", false);
+  auto exit_a = std::make_shared<RelayActor>("relink_exit_a", false);
+  auto exit_b = std::make_shared<RelayActor>("relink_exit_b", false);
+  entrance->input_controls_num_ = 1;
+  exit_a->input_controls_num_ = 1;
+  exit_b->input_controls_num_ = 1;
+  (void)entrance->output_control_arrows_.emplace_back(exit_a->GetAID());
+  actors_ = {entrance, exit_a, exit_b};
+  auto actor_manager = ActorMgr::GetActorMgrRef();
+  for (auto &actor : actors_) {
+    (void)actor_manager->Spawn(actor);
+  }
+
+  (void)RunSteps(1);
+  EXPECT_EQ(exit_a->run_num_, 1);
+  EXPECT_EQ(exit_b->run_num_, 0);
+
+  entrance->output_control_arrows_[0] = exit_b->GetAID();
+  entrance->ResetOutputActors();
+  (void)RunSteps(1);
+  EXPECT_EQ(exit_a->run_num_, 1);
+  EXPECT_EQ(exit_b->run_num_, 1);
+}
+}  // namespace runtime
+}  // namespace mindspore
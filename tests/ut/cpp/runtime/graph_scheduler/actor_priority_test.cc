@@ -0,0 +1,112 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "common/common_test.h"
+#define private public
+#define protected public
+#include "runtime/graph_scheduler/graph_scheduler.h"
+#include "thread/actor_threadpool.h"
+#undef private
+#undef protected
+
+namespace mindspore {
+namespace runtime {
+namespace {
+// The launch cost of the copy actor in the estimation of upward rank.
+constexpr int64_t kCopyActorCost = 4096;
+}  // namespace
+
+class ActorPriorityTest : public UT::Common {
+ public:
+  ActorPriorityTest() = default;
+
+  CopyActorPtr NewCopyActor(const std::string &name) { return std::make_shared<CopyActor>(name, memory_manager_aid_); }
+
+  AID memory_manager_aid_{"memory_manager"};
+};
+
+/// Feature: the priority of actors by the upward rank in the actor set.
+/// Description: set the priority of the actor set: data prepare -> {copy_a -> copy_b, copy_c} -> loop count, and the
+/// loop count actor links back to the data prepare actor.
+/// Expectation: the priority is the cost of the longest path to the end of step, and the loop arrow is skipped.
+TEST_F(ActorPriorityTest, SetActorPriority) {
+  auto actor_set = std::make_shared<ActorSet>("actor_set");
+  actor_set->data_prepare_actor_ =
+    std::make_shared<DataPrepareActor>("data_prepare", memory_manager_aid_, nullptr, nullptr, nullptr, nullptr);
+  actor_set->loop_count_actor_ =
+    std::make_shared<LoopCountActor>("loop_count", 1, memory_manager_aid_, nullptr, nullptr);
+  auto copy_a = NewCopyActor("copy_a");
+  auto copy_b = NewCopyActor("copy_b");
+  auto copy_c = NewCopyActor("copy_c");
+  actor_set->copy_actors_ = {copy_a, copy_b, copy_c};
+
+  auto &data_prepare = actor_set->data_prepare_actor_;
+  auto &loop_count = actor_set->loop_count_actor_;
+  (void)data_prepare->output_data_arrows_.emplace_back(std::make_shared<DataArrow>(0, copy_a->GetAID(), 0));
+  (void)data_prepare->output_control_arrows_.emplace_back(copy_c->GetAID());
+  (void)copy_a->output_data_arrows_.emplace_back(std::make_shared<DataArrow>(0, copy_b->GetAID(), 0));
+  (void)copy_b->output_control_arrows_.emplace_back(loop_count->GetAID());
+  (void)copy_c->output_control_arrows_.emplace_back(loop_count->GetAID());
+  (void)loop_count->output_control_arrows_.emplace_back(data_prepare->GetAID());
+
+  GraphScheduler::GetInstance().SetActorPriority(actor_set.get());
+  EXPECT_EQ(loop_count->priority(), 0);
+  EXPECT_EQ(copy_b->priority(), kCopyActorCost);
+  EXPECT_EQ(copy_c->priority(), kCopyActorCost);
+  EXPECT_EQ(copy_a->priority(), 2 * kCopyActorCost);
+  EXPECT_EQ(data_prepare->priority(), 2 * kCopyActorCost);
+}
+
+/// Feature: the ready queue of the actor thread pool ordered by the priority of actors.
+/// Description: push the actors with the different priorities and the same priority, and pop them all.
+/// Expectation: the actors are popped from the highest priority, and in the pushing order for the same priority.
+TEST_F(ActorPriorityTest, ReadyQueuePopOrder) {
+  std::vector<std::shared_ptr<ActorBase>> actors;
+  std::vector<int64_t> priorities = {1, 3, 0, 3, 2, 1};
+  for (size_t i = 0; i < priorities.size(); ++i) {
+    auto actor = std::make_shared<ActorBase>("actor_" + std::to_string(i));
+    actor->set_priority(priorities[i]);
+    actors.push_back(actor);
+  }
+
+  ActorReadyQueue ready_queue;
+  EXPECT_TRUE(ready_queue.Empty());
+  EXPECT_EQ(ready_queue.Pop(), nullptr);
+  for (auto &actor : actors) {
+    ready_queue.Push(actor.get());
+  }
+  EXPECT_FALSE(ready_queue.Empty());
+  std::vector<size_t> expect_order = {1, 3, 4, 0, 5, 2};
+  for (auto index : expect_order) {
+    EXPECT_EQ(ready_queue.Pop(), actors[index].get());
+  }
+  EXPECT_TRUE(ready_queue.Empty());
+
+  // The actor pushed later with a higher priority overtakes the waiting ones.
+  ready_queue.Push(actors[0].get());
+  ready_queue.Push(actors[2].get());
+  ready_queue.Push(actors[1].get());
+  EXPECT_EQ(ready_queue.Pop(), actors[1].get());
+  EXPECT_EQ(ready_queue.Pop(), actors[0].get());
+  EXPECT_EQ(ready_queue.Pop(), actors[2].get());
+  EXPECT_EQ(ready_queue.Pop(), nullptr);
+}
+}  // namespace runtime
+}  // namespace mindspore
@@ -0,0 +1,231 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef TESTS_UT_CPP_RUNTIME_GRAPH_SCHEDULER_ACTOR_TEST_COMMON_H_
+#define TESTS_UT_CPP_RUNTIME_GRAPH_SCHEDULER_ACTOR_TEST_COMMON_H_
+
+#include <atomic>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "ir/func_graph.h"
+#include "kernel/kernel.h"
+#include "runtime/device/kernel_info.h"
+#include "backend/common/session/anf_runtime_algorithm.h"
+#include "runtime/graph_scheduler/actor/abstract_actor.h"
+#include "runtime/hardware/device_context.h"
+
+namespace mindspore {
+namespace runtime {
+namespace test {
+using device::DeviceAddress;
+using device::DeviceAddressPtr;
+using device::DeviceAddressType;
+using kernel::AddressPtr;
+
+// The device address of the host memory.
+class TestDeviceAddress : public DeviceAddress {
+ public:
+  TestDeviceAddress(void *ptr, size_t size) : DeviceAddress(ptr, size) {}
+  ~TestDeviceAddress() override = default;
+
+  bool SyncDeviceToHost(const ShapeVector &, size_t, TypeId, void *) const override { return true; }
+  bool SyncHostToDevice(const ShapeVector &, size_t, TypeId, const void *, const std::string &) const override {
+    return true;
+  }
+  void ClearDeviceMemory() override {}
+  DeviceAddressType DeviceType() const override { return DeviceAddressType::kCPU; }
+};
+
+// The device context which allocates the host memory and launches the kernel mod in the caller thread.
+class TestDeviceContext : public DeviceContext {
+ public:
+  TestDeviceContext() : DeviceContext({"CPU", 0}) {}
+  ~TestDeviceContext() override = default;
+
+  void Initialize() override {}
+
+  bool AllocateMemory(DeviceAddress *const &address, size_t size) const override {
+    MS_EXCEPTION_IF_NULL(address);
+    auto ptr = AllocateMemory(size);
+    if (ptr == nullptr) {
+      return false;
+    }
+    address->set_ptr(ptr);
+    return true;
+  }
+  void FreeMemory(DeviceAddress *const &address) const override {
+    MS_EXCEPTION_IF_NULL(address);
+    FreeMemory(address->GetMutablePtr());
+    address->set_ptr(nullptr);
+  }
+  void *AllocateMemory(size_t size) const override {
+    ++alloc_num_;
+    return malloc(size);
+  }
+  void FreeMemory(void *const ptr) const override {
+    ++free_num_;
+    free(ptr);
+  }
+
+  DeviceAddressPtr CreateDeviceAddress(void *const device_ptr, size_t device_size, const string &,
+                                       TypeId) const override {
+    return std::make_shared<TestDeviceAddress>(device_ptr, device_size);
+  }
+  DeviceAddressType GetDeviceAddressType() const override { return DeviceAddressType::kCPU; }
+
+  void SetOperatorInfo(const std::vector<CNodePtr> &) const override {}
+  void CreateKernel(const std::vector<CNodePtr> &) const override {}
+
+  bool LaunchKernel(const CNodePtr &kernel, const std::vector<AddressPtr> &inputs,
+                    const std::vector<AddressPtr> &workspace, const std::vector<AddressPtr> &outputs,
+                    bool) const override {
+    auto kernel_mod = AnfAlgo::GetKernelMod(kernel);
+    MS_EXCEPTION_IF_NULL(kernel_mod);
+    ++launch_num_;
+    return kernel_mod->Launch(inputs, workspace, outputs, nullptr);
+  }
+
+  mutable std::atomic<size_t> alloc_num_{0};
+  mutable std::atomic<size_t> free_num_{0};
+  mutable std::atomic<size_t> launch_num_{0};
+};
+
+// The kernel which adds a value to the float32 input elementwise.
+class AddValueKernelMod : public kernel::KernelMod {
+ public:
+  AddValueKernelMod(size_t elem_num, float value) : elem_num_(elem_num), value_(value) {
+    input_size_list_ = {elem_num * sizeof(float)};
+    output_size_list_ = {elem_num * sizeof(float)};
+  }
+  ~AddValueKernelMod() override = default;
+
+  bool Launch(const std::vector<AddressPtr> &inputs, const std::vector<AddressPtr> &,
+              const std::vector<AddressPtr> &outputs, void *) override {
+    if ((inputs.size() != 1) || (outputs.size() != 1) || (inputs[0]->addr == nullptr) ||
+        (outputs[0]->addr == nullptr)) {
+      return false;
+    }
+    auto input = static_cast<const float *>(inputs[0]->addr);
+    auto output = static_cast<float *>(outputs[0]->addr);
+    for (size_t i = 0; i < elem_num_; ++i) {
+      output[i] = input[i] + value_;
+    }
+    return true;
+  }
+
+ private:
+  size_t elem_num_;
+  float value_;
+};
+
+// Create the kernel of AddValueKernelMod which outputs the device address with the reference count.
+inline CNodePtr NewAddValueKernel(const FuncGraphPtr &graph, const AnfNodePtr &input, size_t elem_num, float value,
+                                  size_t ref_count) {
+  MS_EXCEPTION_IF_NULL(graph);
+  auto kernel = graph->NewCNode({NewValueNode(std::make_shared<Primitive>("AddValue")), input});
+  auto kernel_info = std::make_shared<device::KernelInfo>();
+  kernel_info->set_kernel_mod(std::make_shared<AddValueKernelMod>(elem_num, value));
+  auto output_address = std::make_shared<TestDeviceAddress>(nullptr, elem_num * sizeof(float));
+  output_address->set_original_ref_count(ref_count);
+  output_address->ResetRefCount();
+  (void)kernel_info->SetOutputAddr(output_address, 0);
+  kernel->set_kernel_info(kernel_info);
+  return kernel;
+}
+
+// The actor which sends the prepared output data at the beginning of step, like the data prepare actor.
+class TestSourceActor : public AbstractActor {
+ public:
+  explicit TestSourceActor(const std::string &name)
+      : AbstractActor(name, KernelTransformType::kDataPrepareActor, nullptr) {
+    input_controls_num_ = 1;
+  }
+  ~TestSourceActor() override = default;
+
+  // Create the output data of the output data arrows, which send the device tensor.
+  void PrepareOutputData(DeviceTensor *const device_tensor) {
+    output_data_.clear();
+    ResetOutputActors();
+    for (const auto &data_arrow : output_data_arrows_) {
+      MS_EXCEPTION_IF_NULL(data_arrow);
+      (void)output_data_.emplace_back(
+        std::make_unique<OpData<DeviceTensor>>(data_arrow->to_op_id_, device_tensor, data_arrow->to_input_index_));
+    }
+  }
+
+ protected:
+  void Run(OpContext<DeviceTensor> *const context) override {
+    EraseInput(context);
+    SendOutput(context);
+  }
+};
+
+// The actor which copies the float32 input data at the end of step, like the output actor.
+class TestSinkActor : public AbstractActor {
+ public:
+  explicit TestSinkActor(const std::string &name) : AbstractActor(name, KernelTransformType::kOutputActor, nullptr) {}
+  ~TestSinkActor() override = default;
+
+  std::vector<float> result_;
+
+ protected:
+  void Run(OpContext<DeviceTensor> *const context) override {
+    const auto &data_iter = input_op_datas_.find(context->sequential_num_);
+    if ((data_iter == input_op_datas_.end()) || data_iter->second.empty()) {
+      SET_OPCONTEXT_FAIL_RET_WITH_ERROR((*context), "The sink actor has no input data.");
+    }
+    auto device_tensor = data_iter->second[0]->data_;
+    MS_EXCEPTION_IF_NULL(device_tensor);
+    auto data = static_cast<const float *>(device_tensor->GetPtr());
+    MS_EXCEPTION_IF_NULL(data);
+    result_.assign(data, data + device_tensor->GetSize() / sizeof(float));
+    EraseInput(context);
+    SET_OPCONTEXT_SUCCESS_RET((*context));
+  }
+};
+
+// Link the data arrow from the first output of from actor to the input of to actor.
+inline void LinkDataArrow(AbstractActor *const from_actor, const AnfNodePtr &from_node, AbstractActor *const to_actor,
+                          size_t to_input_index) {
+  MS_EXCEPTION_IF_NULL(from_actor);
+  MS_EXCEPTION_IF_NULL(to_actor);
+  (void)from_actor->output_data_arrows_.emplace_back(
+    std::make_shared<DataArrow>(0, to_actor->GetAID(), SizeToInt(to_input_index)));
+  (void)from_actor->output_data_nodes_.emplace_back(from_node);
+  ++to_actor->input_datas_num_;
+  (void)to_actor->input_data_arrow_aids_.emplace_back(from_actor->GetAID());
+}
+
+// Run one step from the source actor, and return whether the step succeeds.
+inline bool RunStep(AbstractActor *const source_actor, int sequential_num) {
+  MS_EXCEPTION_IF_NULL(source_actor);
+  OpContext<DeviceTensor> op_context;
+  std::vector<Promise<int>> result(1);
+  op_context.sequential_num_ = sequential_num;
+  op_context.results_ = &result;
+  auto from_aid = const_cast<AID *>(&source_actor->GetAID());
+  ActorDispatcher::Send(source_actor, &OpActor<DeviceTensor>::RunOpControl, from_aid, &op_context);
+  auto result_future = result[0].GetFuture();
+  result_future.Wait();
+  return result_future.IsOK();
+}
+}  // namespace test
+}  // namespace runtime
+}  // namespace mindspore
+#endif  // TESTS_UT_CPP_RUNTIME_GRAPH_SCHEDULER_ACTOR_TEST_COMMON_H_
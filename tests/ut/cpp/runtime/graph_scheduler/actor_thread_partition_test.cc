@@ -0,0 +1,246 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "common/common_test.h"
+#define private public
+#define protected public
+#include "runtime/graph_scheduler/graph_scheduler.h"
+#include "runtime/graph_scheduler/actor/memory_manager_actor.h"
+#include "runtime/graph_scheduler/actor_test_common.h"
+#undef private
+#undef protected
+
+namespace mindspore {
+namespace runtime {
+namespace {
+constexpr size_t kActorThreadNum = 4;
+constexpr size_t kActorAndKernelThreadNum = 8;
+constexpr size_t kPartitionThreadNum = 2;
+constexpr size_t kChainLength = 8;
+constexpr size_t kElemNum = 64;
+
+// The kernel which records the threads launching it.
+class ThreadRecordKernelMod : public test::AddValueKernelMod {
+ public:
+  ThreadRecordKernelMod(size_t elem_num, float value, std::set<std::thread::id> *const launch_threads,
+                        std::mutex *const launch_threads_mutex)
+      : AddValueKernelMod(elem_num, value),
+        launch_threads_(launch_threads),
+        launch_threads_mutex_(launch_threads_mutex) {}
+  ~ThreadRecordKernelMod() override = default;
+
+  bool Launch(const std::vector<kernel::AddressPtr> &inputs, const std::vector<kernel::AddressPtr> &workspace,
+              const std::vector<kernel::AddressPtr> &outputs, void *stream_ptr) override {
+    {
+      std::lock_guard<std::mutex> lock(*launch_threads_mutex_);
+      (void)launch_threads_->insert(std::this_thread::get_id());
+    }
+    return AddValueKernelMod::Launch(inputs, workspace, outputs, stream_ptr);
+  }
+
+ private:
+  std::set<std::thread::id> *launch_threads_;
+  std::mutex *launch_threads_mutex_;
+};
+}  // namespace
+
+class ActorThreadPartitionTest : public UT::Common {
+ public:
+  ActorThreadPartitionTest() = default;
+
+  void SetUp() override {
+    auto actor_manager = ActorMgr::GetActorMgrRef();
+    (void)actor_manager->Initialize(true, kActorThreadNum, kActorAndKernelThreadNum);
+    if (actor_manager->GetActor(AID("MemoryManagerActor")) == nullptr) {
+      memory_manager_actor_ = std::make_shared<MemoryManagerActor>();
+      (void)actor_manager->Spawn(memory_manager_actor_, true);
+    }
+    GraphScheduler::GetInstance().memory_manager_aid_ = AID("MemoryManagerActor");
+  }
+
+  void TearDown() override {
+    auto &graph_scheduler = GraphScheduler::GetInstance();
+    for (auto &actor_set_info : actor_set_infos_) {
+      if (graph_scheduler.actors_.count(actor_set_info->actor_set_->name_) > 0) {
+        graph_scheduler.Clear(actor_set_info->actor_set_->name_, {}, {}, nullptr);
+      }
+    }
+    auto actor_manager = ActorMgr::GetActorMgrRef();
+    for (auto &actor : spawned_actors_) {
+      actor_manager->Terminate(actor->GetAID());
+    }
+    spawned_actors_.clear();
+    if (memory_manager_actor_ != nullptr) {
+      actor_manager->Terminate(memory_manager_actor_->GetAID());
+      memory_manager_actor_ = nullptr;
+    }
+    // The memory of the tail output is kept for the sink actor.
+    for (auto &actor_set_info : actor_set_infos_) {
+      const auto &tail_kernel_actor = actor_set_info->kernel_actors_.back();
+      if ((!tail_kernel_actor->output_device_tensors_.empty()) &&
+          (tail_kernel_actor->output_device_tensors_[0]->GetPtr() != nullptr)) {
+        device_context_.FreeMemory(tail_kernel_actor->output_device_tensors_[0]);
+      }
+    }
+    actor_set_infos_.clear();
+    ClearAllActors();
+  }
+
+  struct ActorSetInfo {
+    ActorSetPtr actor_set_;
+    std::vector<KernelActorPtr> kernel_actors_;
+    std::shared_ptr<test::TestSourceActor> source_;
+    std::shared_ptr<test::TestSinkActor> sink_;
+    std::shared_ptr<test::TestDeviceAddress> input_address_;
+    std::vector<float> input_;
+    std::set<std::thread::id> launch_threads_;
+    std::mutex launch_threads_mutex_;
+  };
+
+  // Build the actor set: source -> the chain of kernel actors adding 1 -> sink, where only the kernel actors belong to
+  // the actor set and the source and sink actors run on the shared actor thread pool.
+  ActorSetInfo *BuildActorSet(const std::string &name) {
+    auto &info = *actor_set_infos_.emplace_back(std::make_unique<ActorSetInfo>());
+    auto graph = std::make_shared<FuncGraph>();
+    info.actor_set_ = std::make_shared<ActorSet>(name);
+    info.source_ = std::make_shared<test::TestSourceActor>(name + "_source");
+    info.sink_ = std::make_shared<test::TestSinkActor>(name + "_sink");
+    InsertActor(info.source_.get());
+    InsertActor(info.sink_.get());
+
+    info.input_.resize(kElemNum);
+    for (size_t i = 0; i < kElemNum; ++i) {
+      info.input_[i] = static_cast<float>(i);
+    }
+    info.input_address_ = std::make_shared<test::TestDeviceAddress>(info.input_.data(), kElemNum * sizeof(float));
+    info.input_address_->set_original_ref_count(SIZE_MAX);
+    info.input_address_->ResetRefCount();
+    auto parameter_kernel_info = std::make_shared<device::KernelInfo>();
+    (void)parameter_kernel_info->SetOutputAddr(info.input_address_, 0);
+    AnfNodePtr input_node = graph->add_parameter();
+    input_node->set_kernel_info(parameter_kernel_info);
+    AbstractActor *from_actor = info.source_.get();
+    for (size_t i = 0; i < kChainLength; ++i) {
+      size_t ref_count = (i + 1 < kChainLength) ? 2 : SIZE_MAX;
+      auto kernel = test::NewAddValueKernel(graph, input_node, kElemNum, 1.0, ref_count);
+      auto kernel_info = dynamic_cast<device::KernelInfo *>(kernel->kernel_info());
+      MS_EXCEPTION_IF_NULL(kernel_info);
+      kernel_info->set_kernel_mod(
+        std::make_shared<ThreadRecordKernelMod>(kElemNum, 1.0, &info.launch_threads_, &info.launch_threads_mutex_));
+      auto kernel_actor = std::make_shared<KernelActor>(
+        name + "_kernel_" + std::to_string(i), kernel, &device_context_, AID("MemoryManagerActor"), nullptr, nullptr,
+        GraphExecutionStrategy::kPipeline, std::set<size_t>(), std::set<size_t>());
+      InsertActor(kernel_actor.get());
+      test::LinkDataArrow(from_actor, input_node, kernel_actor.get(), 0);
+      (void)info.actor_set_->kernel_actors_.emplace_back(kernel_actor);
+      (void)info.kernel_actors_.emplace_back(kernel_actor);
+      from_actor = kernel_actor.get();
+      input_node = kernel;
+    }
+    test::LinkDataArrow(from_actor, input_node, info.sink_.get(), 0);
+    info.source_->PrepareOutputData(info.input_address_.get());
+    GraphScheduler::GetInstance().actors_[name] = info.actor_set_;
+    return &info;
+  }
+
+  void Spawn(const AbstractActorPtr &actor) {
+    (void)ActorMgr::GetActorMgrRef()->Spawn(actor);
+    spawned_actors_.push_back(actor);
+  }
+
+  test::TestDeviceContext device_context_;
+  std::shared_ptr<MemoryManagerActor> memory_manager_actor_;
+  std::vector<AbstractActorPtr> spawned_actors_;
+  std::vector<std::unique_ptr<ActorSetInfo>> actor_set_infos_;
+};
+
+/// Feature: the actor sets which run concurrently on their own actor thread partitions.
+/// Description: schedule two actor sets with the thread partitions of two threads, run them from two threads at the
+/// same time, and clear them one by one.
+/// Expectation: the kernel actors of each actor set run on the dedicated thread pool of its partition, both actor sets
+/// output the right results in every step, and the concurrent run is disabled after all the partitioned actor sets are
+/// cleared.
+TEST_F(ActorThreadPartitionTest, RunActorSetsConcurrently) {
+  auto &graph_scheduler = GraphScheduler::GetInstance();
+  std::vector<ActorSetInfo *> infos = {BuildActorSet("actor_set_a"), BuildActorSet("actor_set_b")};
+  for (auto info : infos) {
+    graph_scheduler.SetThreadPartition(info->actor_set_->name_, ActorThreadPartition{kPartitionThreadNum, {}});
+    graph_scheduler.Schedule(info->actor_set_.get());
+    Spawn(info->source_);
+    Spawn(info->sink_);
+  }
+  ASSERT_EQ(graph_scheduler.actor_set_thread_pools_.size(), infos.size());
+  EXPECT_TRUE(graph_scheduler.enable_concurrent_run_);
+  for (auto info : infos) {
+    auto thread_pool = graph_scheduler.actor_set_thread_pools_[info->actor_set_->name_].get();
+    ASSERT_NE(thread_pool, nullptr);
+    EXPECT_NE(thread_pool, ActorMgr::GetActorMgrRef()->GetActorThreadPool());
+    for (auto &kernel_actor : info->kernel_actors_) {
+      EXPECT_EQ(kernel_actor->pool_, thread_pool);
+    }
+    // The thread partition can't be changed after the actor set is scheduled.
+    EXPECT_ANY_THROW(graph_scheduler.SetThreadPartition(info->actor_set_->name_, ActorThreadPartition{1, {}}));
+  }
+
+  constexpr int kStepNum = 50;
+  std::vector<std::thread> run_threads;
+  std::vector<int> success_step_nums(infos.size(), 0);
+  for (size_t i = 0; i < infos.size(); ++i) {
+    run_threads.emplace_back([&, i]() {
+      auto info = infos[i];
+      for (int step = 0; step < kStepNum; ++step) {
+        info->sink_->result_.clear();
+        if (!test::RunStep(info->source_.get(), step) || (info->sink_->result_.size() != kElemNum)) {
+          continue;
+        }
+        bool success = true;
+        for (size_t j = 0; j < kElemNum; ++j) {
+          success = success && (info->sink_->result_[j] == info->input_[j] + static_cast<float>(kChainLength));
+        }
+        success_step_nums[i] += success ? 1 : 0;
+      }
+    });
+  }
+  for (auto &run_thread : run_threads) {
+    run_thread.join();
+  }
+  for (size_t i = 0; i < infos.size(); ++i) {
+    EXPECT_EQ(success_step_nums[i], kStepNum);
+    EXPECT_GE(infos[i]->launch_threads_.size(), 1);
+    EXPECT_LE(infos[i]->launch_threads_.size(), kPartitionThreadNum);
+  }
+  for (auto thread_id : infos[0]->launch_threads_) {
+    EXPECT_EQ(infos[1]->launch_threads_.count(thread_id), 0);
+  }
+  EXPECT_EQ(device_context_.launch_num_, infos.size() * kStepNum * kChainLength);
+
+  graph_scheduler.Clear(infos[0]->actor_set_->name_, {}, {}, nullptr);
+  EXPECT_EQ(graph_scheduler.actor_set_thread_pools_.size(), 1);
+  EXPECT_TRUE(graph_scheduler.enable_concurrent_run_);
+  graph_scheduler.Clear(infos[1]->actor_set_->name_, {}, {}, nullptr);
+  EXPECT_TRUE(graph_scheduler.actor_set_thread_pools_.empty());
+  EXPECT_TRUE(graph_scheduler.thread_partitions_.empty());
+  EXPECT_FALSE(graph_scheduler.enable_concurrent_run_);
+}
+}  // namespace runtime
+}  // namespace mindspore
@@ -0,0 +1,175 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "common/common_test.h"
+#define private public
+#define protected public
+#include "runtime/graph_scheduler/graph_scheduler.h"
+#include "runtime/graph_scheduler/actor/memory_manager_actor.h"
+#include "runtime/graph_scheduler/actor_test_common.h"
+#undef private
+#undef protected
+#include "mindrt/include/async/async.h"
+
+namespace mindspore {
+namespace runtime {
+namespace {
+constexpr size_t kActorThreadNum = 4;
+constexpr size_t kActorAndKernelThreadNum = 8;
+}  // namespace
+
+class FusionActorTest : public UT::Common {
+ public:
+  FusionActorTest() = default;
+
+  void SetUp() override {
+    auto actor_manager = ActorMgr::GetActorMgrRef();
+    (void)actor_manager->Initialize(true, kActorThreadNum, kActorAndKernelThreadNum);
+    if (actor_manager->GetActor(AID("MemoryManagerActor")) == nullptr) {
+      memory_manager_actor_ = std::make_shared<MemoryManagerActor>();
+      (void)actor_manager->Spawn(memory_manager_actor_, true);
+    }
+    GraphScheduler::GetInstance().memory_manager_aid_ = AID("MemoryManagerActor");
+  }
+
+  void TearDown() override {
+    auto actor_manager = ActorMgr::GetActorMgrRef();
+    for (auto &actor : spawned_actors_) {
+      actor_manager->Terminate(actor->GetAID());
+    }
+    spawned_actors_.clear();
+    if (memory_manager_actor_ != nullptr) {
+      actor_manager->Terminate(memory_manager_actor_->GetAID());
+      memory_manager_actor_ = nullptr;
+    }
+    ClearAllActors();
+  }
+
+  // The actors send the memory free requests after the outputs, so the step may finish before the frees. Waits the
+  // actors to finish their current messages and then the memory manager actor to finish the free requests.
+  void WaitMemoryFree(const std::vector<AbstractActorPtr> &actors) {
+    for (auto &actor : actors) {
+      Async(actor->GetAID(), []() { return true; }).Wait();
+    }
+    Async(AID("MemoryManagerActor"), []() { return true; }).Wait();
+  }
+
+  void Spawn(const AbstractActorPtr &actor) {
+    (void)ActorMgr::GetActorMgrRef()->Spawn(actor);
+    spawned_actors_.push_back(actor);
+  }
+
+  test::TestDeviceContext device_context_;
+  std::shared_ptr<MemoryManagerActor> memory_manager_actor_;
+  std::vector<AbstractActorPtr> spawned_actors_;
+};
+
+/// Feature: the fusion actor which launches a linear chain of kernel actors in one actor.
+/// Description: fuse the chain longer than the max fusion number: source -> 20 kernel actors adding 1 -> sink, and run
+/// two steps of the fused actors.
+/// Expectation: the chain is split into the fusion actors of 16 and 4 kernel actors, the arrows of source, sink and
+/// the split point are relinked to the fusion actors, and the sink receives the input added by 20 in every step.
+TEST_F(FusionActorTest, SplitLongChain) {
+  constexpr size_t kChainLength = kMaxFusionKernelActorNum + 4;
+  constexpr size_t kElemNum = 64;
+  auto graph = std::make_shared<FuncGraph>();
+  auto source = std::make_shared<test::TestSourceActor>("source");
+  auto sink = std::make_shared<test::TestSinkActor>("sink");
+  InsertActor(source.get());
+  InsertActor(sink.get());
+
+  auto actor_set = std::make_shared<ActorSet>("actor_set");
+  std::vector<float> input(kElemNum);
+  for (size_t i = 0; i < kElemNum; ++i) {
+    input[i] = static_cast<float>(i) * 0.5f;
+  }
+  auto input_address = std::make_shared<test::TestDeviceAddress>(input.data(), kElemNum * sizeof(float));
+  input_address->set_original_ref_count(SIZE_MAX);
+  input_address->ResetRefCount();
+  auto parameter_kernel_info = std::make_shared<device::KernelInfo>();
+  (void)parameter_kernel_info->SetOutputAddr(input_address, 0);
+  AnfNodePtr input_node = graph->add_parameter();
+  input_node->set_kernel_info(parameter_kernel_info);
+  AbstractActor *from_actor = source.get();
+  for (size_t i = 0; i < kChainLength; ++i) {
+    // The outputs in the chain are freed by the kernel actor itself and the user, and the tail output is kept for the
+    // sink actor.
+    size_t ref_count = (i + 1 < kChainLength) ? 2 : SIZE_MAX;
+    auto kernel = test::NewAddValueKernel(graph, input_node, kElemNum, 1.0, ref_count);
+    auto kernel_actor =
+      std::make_shared<KernelActor>("kernel_" + std::to_string(i), kernel, &device_context_, AID("MemoryManagerActor"),
+                                    nullptr, nullptr, GraphExecutionStrategy::kPipeline, std::set<size_t>(),
+                                    std::set<size_t>());
+    InsertActor(kernel_actor.get());
+    test::LinkDataArrow(from_actor, input_node, kernel_actor.get(), 0);
+    (void)actor_set->kernel_actors_.emplace_back(kernel_actor);
+    from_actor = kernel_actor.get();
+    input_node = kernel;
+  }
+  test::LinkDataArrow(from_actor, input_node, sink.get(), 0);
+
+  GraphScheduler::GetInstance().FuseKernelActors(actor_set.get());
+  EXPECT_TRUE(actor_set->kernel_actors_.empty());
+  ASSERT_EQ(actor_set->fusion_actors_.size(), 2);
+  const auto &head_fusion = actor_set->fusion_actors_[0];
+  const auto &tail_fusion = actor_set->fusion_actors_[1];
+  ASSERT_EQ(head_fusion->kernel_actors_.size(), kMaxFusionKernelActorNum);
+  ASSERT_EQ(tail_fusion->kernel_actors_.size(), kChainLength - kMaxFusionKernelActorNum);
+  EXPECT_EQ(head_fusion->kernel_actors_.front()->GetAID().Name(), "kernel_0");
+  EXPECT_EQ(tail_fusion->kernel_actors_.front()->GetAID().Name(), "kernel_" + std::to_string(kMaxFusionKernelActorNum));
+  // The fused kernel actors can't be fetched, and the arrows are relinked to the fusion actors.
+  EXPECT_EQ(FetchActor("kernel_0"), nullptr);
+  EXPECT_EQ(FetchActor(head_fusion->GetAID().Name()), head_fusion.get());
+  ASSERT_EQ(source->output_data_arrows_.size(), 1);
+  EXPECT_EQ(source->output_data_arrows_[0]->to_op_id_.Name(), head_fusion->GetAID().Name());
+  EXPECT_EQ(head_fusion->input_datas_num_, 1);
+  EXPECT_EQ(head_fusion->input_data_arrow_aids_[0].Name(), "source");
+  ASSERT_EQ(head_fusion->output_data_arrows_.size(), 1);
+  EXPECT_EQ(head_fusion->output_data_arrows_[0]->to_op_id_.Name(), tail_fusion->GetAID().Name());
+  EXPECT_EQ(tail_fusion->input_datas_num_, 1);
+  EXPECT_EQ(tail_fusion->input_data_arrow_aids_[0].Name(), head_fusion->GetAID().Name());
+  ASSERT_EQ(tail_fusion->output_data_arrows_.size(), 1);
+  EXPECT_EQ(tail_fusion->output_data_arrows_[0]->to_op_id_.Name(), "sink");
+  EXPECT_EQ(sink->input_data_arrow_aids_[0].Name(), tail_fusion->GetAID().Name());
+
+  source->PrepareOutputData(input_address.get());
+  Spawn(source);
+  Spawn(head_fusion);
+  Spawn(tail_fusion);
+  Spawn(sink);
+
+  constexpr int kStepNum = 2;
+  for (int step = 0; step < kStepNum; ++step) {
+    sink->result_.clear();
+    ASSERT_TRUE(test::RunStep(source.get(), step));
+    ASSERT_EQ(sink->result_.size(), kElemNum);
+    for (size_t i = 0; i < kElemNum; ++i) {
+      EXPECT_FLOAT_EQ(sink->result_[i], input[i] + static_cast<float>(kChainLength));
+    }
+  }
+  EXPECT_EQ(device_context_.launch_num_, kStepNum * kChainLength);
+  WaitMemoryFree({head_fusion, tail_fusion});
+  // The memory of the tail output is kept for the sink actor, and the other outputs are freed in every step.
+  EXPECT_EQ(device_context_.alloc_num_, (kChainLength - 1) * kStepNum + 1);
+  EXPECT_EQ(device_context_.free_num_, (kChainLength - 1) * kStepNum);
+  device_context_.FreeMemory(tail_fusion->kernel_actors_.back()->output_device_tensors_[0]);
+}
+}  // namespace runtime
+}  // namespace mindspore
@@ -0,0 +1,188 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+#include "common/common_test.h"
+#define private public
+#define protected public
+#include "runtime/graph_scheduler/step_memory_planner.h"
+#include "runtime/graph_scheduler/actor_test_common.h"
+#undef private
+#undef protected
+
+namespace mindspore {
+namespace runtime {
+namespace {
+constexpr size_t kKB = 1 << 10;
+// The planned device tensors start after the guard of the arena.
+constexpr size_t kArenaGuardSize = 512;
+}  // namespace
+
+class StepMemoryPlannerTest : public UT::Common {
+ public:
+  StepMemoryPlannerTest() = default;
+
+  void SetUp() override {
+    planner_ = std::make_shared<StepMemoryPlanner>();
+    planner_->state_ = StepMemoryPlanner::PlanState::kRecording;
+    tensor_a_ = std::make_shared<test::TestDeviceAddress>(nullptr, kKB);
+    tensor_b_ = std::make_shared<test::TestDeviceAddress>(nullptr, 2 * kKB);
+    tensor_c_ = std::make_shared<test::TestDeviceAddress>(nullptr, kKB);
+    output_ = std::make_shared<test::TestDeviceAddress>(nullptr, kKB);
+  }
+
+  void TearDown() override {
+    if (output_->GetPtr() != nullptr) {
+      device_context_.FreeMemory(output_.get());
+    }
+    planner_->Reset();
+    planner_ = nullptr;
+  }
+
+  // Allocate the memory from the planner, or from the device context like the memory manager actor.
+  bool Allocate(const DeviceTensorPtr &device_tensor, int run_id) {
+    if (planner_->Allocate(device_tensor.get(), &device_context_, run_id)) {
+      return true;
+    }
+    EXPECT_TRUE(device_context_.AllocateMemory(device_tensor.get(), device_tensor->GetSize()));
+    return false;
+  }
+  bool Free(const DeviceTensorPtr &device_tensor) {
+    if (planner_->Free(device_tensor.get())) {
+      return true;
+    }
+    device_context_.FreeMemory(device_tensor.get());
+    return false;
+  }
+
+  // The run: alloc a, alloc b, free a, alloc c, free b, free c, so the lifetime of a overlaps b, b overlaps c, and a
+  // doesn't overlap c. The output is allocated in the run and freed in the next run.
+  void RecordRun(int run_id) {
+    EXPECT_FALSE(Allocate(tensor_a_, run_id));
+    FreeLastOutput();
+    EXPECT_FALSE(Allocate(tensor_b_, run_id));
+    EXPECT_FALSE(Free(tensor_a_));
+    EXPECT_FALSE(Allocate(tensor_c_, run_id));
+    EXPECT_FALSE(Allocate(output_, run_id));
+    EXPECT_FALSE(Free(tensor_b_));
+    EXPECT_FALSE(Free(tensor_c_));
+  }
+
+  void FreeLastOutput() {
+    if (output_->GetPtr() != nullptr) {
+      EXPECT_FALSE(Free(output_));
+    }
+  }
+
+  void *ArenaAddress(const DeviceTensorPtr &device_tensor) {
+    return AddressOffset(planner_->arena_, kArenaGuardSize + planner_->planned_tensors_[device_tensor.get()].offset_);
+  }
+
+  test::TestDeviceContext device_context_;
+  std::shared_ptr<StepMemoryPlanner> planner_;
+  DeviceTensorPtr tensor_a_;
+  DeviceTensorPtr tensor_b_;
+  DeviceTensorPtr tensor_c_;
+  DeviceTensorPtr output_;
+};
+
+/// Feature: the step memory planner which replays the recorded memory trace from the arena.
+/// Description: record two runs of the device tensors a, b, c and the output, and replay the later runs in the same
+/// order and in the different order.
+/// Expectation: a, b and c are planned in the arena of 3KB where a shares the memory with c, the output is not planned,
+/// and the device tensor whose range is still used in the different order falls back to the device context.
+TEST_F(StepMemoryPlannerTest, RecordAndReplay) {
+  RecordRun(0);
+  RecordRun(1);
+  EXPECT_EQ(planner_->state_, StepMemoryPlanner::PlanState::kRecording);
+  auto alloc_num = device_context_.alloc_num_.load();
+
+  // The first allocation of the third run solves the plan and allocates the arena.
+  EXPECT_TRUE(Allocate(tensor_a_, 2));
+  ASSERT_EQ(planner_->state_, StepMemoryPlanner::PlanState::kReplaying);
+  EXPECT_EQ(device_context_.alloc_num_, alloc_num + 1);
+  ASSERT_EQ(planner_->planned_tensors_.size(), 3);
+  EXPECT_EQ(planner_->planned_tensors_.count(output_.get()), 0);
+  const auto &planned_a = planner_->planned_tensors_[tensor_a_.get()];
+  const auto &planned_b = planner_->planned_tensors_[tensor_b_.get()];
+  const auto &planned_c = planner_->planned_tensors_[tensor_c_.get()];
+  EXPECT_EQ(planned_a.offset_, planned_c.offset_);
+  EXPECT_TRUE((planned_a.offset_ + planned_a.size_ <= planned_b.offset_) ||
+              (planned_b.offset_ + planned_b.size_ <= planned_a.offset_));
+  EXPECT_EQ(std::max(planned_a.offset_ + planned_a.size_, planned_b.offset_ + planned_b.size_), 3 * kKB);
+
+  // Replay the third run in the recorded order.
+  EXPECT_EQ(tensor_a_->GetPtr(), ArenaAddress(tensor_a_));
+  EXPECT_FALSE(tensor_a_->from_mem_pool());
+  FreeLastOutput();
+  EXPECT_TRUE(Allocate(tensor_b_, 2));
+  EXPECT_EQ(tensor_b_->GetPtr(), ArenaAddress(tensor_b_));
+  EXPECT_TRUE(Free(tensor_a_));
+  EXPECT_EQ(tensor_a_->GetPtr(), nullptr);
+  EXPECT_TRUE(Allocate(tensor_c_, 2));
+  EXPECT_EQ(tensor_c_->GetPtr(), ArenaAddress(tensor_c_));
+  EXPECT_FALSE(Allocate(output_, 2));
+  EXPECT_TRUE(Free(tensor_b_));
+  EXPECT_TRUE(Free(tensor_c_));
+  EXPECT_TRUE(planner_->live_ranges_.empty());
+
+  // Replay the fourth run in the different order, c is allocated before a is freed.
+  alloc_num = device_context_.alloc_num_.load();
+  EXPECT_TRUE(Allocate(tensor_a_, 3));
+  FreeLastOutput();
+  EXPECT_FALSE(Allocate(tensor_c_, 3));
+  EXPECT_EQ(device_context_.alloc_num_, alloc_num + 1);
+  EXPECT_TRUE(Free(tensor_a_));
+  EXPECT_FALSE(Free(tensor_c_));
+  EXPECT_EQ(planner_->state_, StepMemoryPlanner::PlanState::kReplaying);
+}
+
+/// Feature: the step memory planner which replays the recorded memory trace from the arena.
+/// Description: replay the plan and grow the size of the planned device tensor b while a is still using the arena.
+/// Expectation: b falls back to the device context, the arena is released after a is freed, and the planner records
+/// the trace again.
+TEST_F(StepMemoryPlannerTest, FallbackWhenTensorGrows) {
+  RecordRun(0);
+  RecordRun(1);
+  EXPECT_TRUE(Allocate(tensor_a_, 2));
+  ASSERT_EQ(planner_->state_, StepMemoryPlanner::PlanState::kReplaying);
+  auto free_num = device_context_.free_num_.load();
+
+  tensor_b_->SetSize(4 * kKB);
+  EXPECT_FALSE(Allocate(tensor_b_, 2));
+  EXPECT_EQ(planner_->state_, StepMemoryPlanner::PlanState::kInvalid);
+  EXPECT_NE(tensor_b_->GetPtr(), nullptr);
+  EXPECT_NE(planner_->arena_, nullptr);
+  // The invalid plan doesn't serve the later allocations.
+  EXPECT_FALSE(Allocate(tensor_c_, 2));
+
+  // The arena is released when the last device tensor in it is freed.
+  EXPECT_TRUE(Free(tensor_a_));
+  EXPECT_EQ(planner_->arena_, nullptr);
+  EXPECT_EQ(device_context_.free_num_, free_num + 1);
+  EXPECT_EQ(planner_->state_, StepMemoryPlanner::PlanState::kRecording);
+  EXPECT_EQ(planner_->replan_num_, 1);
+  EXPECT_TRUE(planner_->planned_tensors_.empty());
+  EXPECT_FALSE(Free(tensor_b_));
+  EXPECT_FALSE(Free(tensor_c_));
+  EXPECT_FALSE(Allocate(tensor_a_, 3));
+  EXPECT_FALSE(Free(tensor_a_));
+}
+}  // namespace runtime
+}  // namespace mindspore